@@ -0,0 +1,292 @@
+/*
+ * BitPlaneRenderer.cpp
+ *
+ * Реалізація рендерера бітових площин та карти різниці.
+ * Рядки обробляються ядрами SSE2 (базовий набір для x86-64, тому
+ * перевірка під час виконання не потрібна) або скалярно.
+ */
+
+#include "BitPlaneRenderer.h"
+#include <QVector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define BITPLANE_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define BITPLANE_HAS_SSE2 0
+#endif
+
+/// Кількість пікселів за ітерацію векторного шляху.
+static const int SIMD_PIXELS = 16;
+
+/**
+ * @brief Формат, з яким працюють ядра (32 біти на піксель без передмноження).
+ */
+static QImage toKernelFormat(const QImage& image) {
+    if (image.isNull() || image.format() == QImage::Format_RGB32 ||
+        image.format() == QImage::Format_ARGB32) {
+        return image;
+    }
+    return image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32
+                                                         : QImage::Format_RGB32);
+}
+
+/* ============================================================================
+ *                          ЗОБРАЖЕННЯ ТА РЕЖИМИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Встановлення зображень.
+ *
+ * @param original Оригінальне зображення.
+ * @param modified Модифіковане зображення.
+ */
+void BitPlaneRenderer::setImages(const QImage& original, const QImage& modified) {
+    this->original = toKernelFormat(original);
+    this->modified = toKernelFormat(modified);
+}
+
+/**
+ * @brief Чи є що показувати.
+ * @return true якщо жодного зображення немає.
+ */
+bool BitPlaneRenderer::isNull() const {
+    return original.isNull() && modified.isNull();
+}
+
+/**
+ * @brief Розмір зображення.
+ * @return Ширина та висота в пікселях.
+ */
+QSize BitPlaneRenderer::size() const {
+    return modified.isNull() ? original.size() : modified.size();
+}
+
+/**
+ * @brief Чи доступний режим.
+ * @param mode Режим.
+ * @return true якщо режим можна показати.
+ */
+bool BitPlaneRenderer::supports(Mode mode) const {
+    switch (mode) {
+    case Mode::Alpha:
+        return (modified.isNull() ? original : modified).hasAlphaChannel();
+    case Mode::Difference:
+        return !original.isNull() && original.size() == modified.size();
+    default:
+        return !isNull();
+    }
+}
+
+/* ============================================================================
+ *                          ОБЧИСЛЕННЯ ДІЛЯНКИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Обчислення ділянки.
+ *
+ * При step > 1 кожен рядок спершу збирається з кожного step-го пікселя
+ * в суцільний буфер, тому ті самі векторні ядра працюють і для
+ * зменшеного масштабу.
+ *
+ * @param mode Режим.
+ * @param area Ділянка в координатах зображення.
+ * @param step Крок проріджування.
+ * @return Індексоване зображення.
+ */
+QImage BitPlaneRenderer::render(Mode mode, const QRect& area, int step) const {
+    const QRect bounds = area.intersected(QRect(QPoint(0, 0), size()));
+    if (bounds.isEmpty() || !supports(mode)) {
+        return QImage();
+    }
+
+    step = qMax(1, step);
+    const int outWidth = (bounds.width() + step - 1) / step;
+    const int outHeight = (bounds.height() + step - 1) / step;
+
+    QImage result(outWidth, outHeight, QImage::Format_Indexed8);
+    result.setColorTable(mode == Mode::Difference ? heatColors() : planeColors());
+
+    const QImage& planeSource = modified.isNull() ? original : modified;
+    int shift = 0;
+    switch (mode) {
+    case Mode::Red:   shift = 16; break;
+    case Mode::Green: shift = 8;  break;
+    case Mode::Blue:  shift = 0;  break;
+    case Mode::Alpha: shift = 24; break;
+    case Mode::Difference: break;
+    }
+
+    // Буфери для проріджених рядків.
+    QVector<QRgb> gatherA(step > 1 ? outWidth : 0);
+    QVector<QRgb> gatherB(step > 1 ? outWidth : 0);
+
+    auto rowPixels = [&](const QImage& image, int y, QVector<QRgb>& gather) -> const QRgb* {
+        const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y)) + bounds.x();
+        if (step == 1) {
+            return line;
+        }
+        for (int i = 0; i < outWidth; ++i) {
+            gather[i] = line[qint64(i) * step];
+        }
+        return gather.constData();
+    };
+
+    for (int row = 0; row < outHeight; ++row) {
+        const int y = bounds.y() + row * step;
+        uchar* dst = result.scanLine(row);
+
+        if (mode == Mode::Difference) {
+            differenceRow(rowPixels(original, y, gatherA), rowPixels(modified, y, gatherB),
+                          dst, outWidth);
+        } else {
+            extractPlaneRow(rowPixels(planeSource, y, gatherA), dst, outWidth, shift);
+        }
+    }
+
+    return result;
+}
+
+/* ============================================================================
+ *                          ЯДРА ОБРОБКИ РЯДКІВ
+ * ============================================================================
+ */
+
+/**
+ * @brief Молодші біти одного каналу для рядка пікселів.
+ *
+ * Векторний шлях: 4 регістри по 4 пікселі зсуваються, маскуються і
+ * пакуються з насиченням 32 → 16 → 8 бітів (значення 0/1 не змінюються).
+ *
+ * @param src Пікселі.
+ * @param dst Індекси 0/1.
+ * @param count Кількість пікселів.
+ * @param shift Зсув каналу.
+ */
+void BitPlaneRenderer::extractPlaneRow(const QRgb* src, uchar* dst, int count, int shift) {
+    int i = 0;
+
+#if BITPLANE_HAS_SSE2
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i count128 = _mm_cvtsi32_si128(shift);
+    for (; i + SIMD_PIXELS <= count; i += SIMD_PIXELS) {
+        const __m128i* in = reinterpret_cast<const __m128i*>(src + i);
+        const __m128i p0 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(in + 0), count128), one);
+        const __m128i p1 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(in + 1), count128), one);
+        const __m128i p2 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(in + 2), count128), one);
+        const __m128i p3 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(in + 3), count128), one);
+
+        const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), packed);
+    }
+#endif
+
+    // Скалярний залишок (або весь рядок без SSE2).
+    for (; i < count; ++i) {
+        dst[i] = uchar((src[i] >> shift) & 1);
+    }
+}
+
+#if BITPLANE_HAS_SSE2
+
+/**
+ * @brief Сума модулів різниць чотирьох байтів кожного пікселя (SSE2).
+ *
+ * |a - b| по байтах - як OR двох насичених різниць; далі байти
+ * кожного 32-бітового слова додаються зсувами.
+ */
+static inline __m128i sumAbsDiff(__m128i a, __m128i b) {
+    const __m128i byteMask = _mm_set1_epi32(0xff);
+    const __m128i d = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+
+    __m128i sum = _mm_and_si128(d, byteMask);
+    sum = _mm_add_epi32(sum, _mm_and_si128(_mm_srli_epi32(d, 8), byteMask));
+    sum = _mm_add_epi32(sum, _mm_and_si128(_mm_srli_epi32(d, 16), byteMask));
+    return _mm_add_epi32(sum, _mm_srli_epi32(d, 24));
+}
+
+#endif
+
+/**
+ * @brief Індекси теплової карти для рядка пікселів.
+ *
+ * Індекс = min(255, (|ΔA| + |ΔR| + |ΔG| + |ΔB|) × DIFFERENCE_GAIN): зміна
+ * одного молодшого біта вже помітна, а зміни 4 бітів - насичені.
+ * Сума не перевищує 1020, тому після пакування в 16 біт множення на
+ * GAIN не переповнюється, а пакування в 8 біт обмежує результат 255.
+ *
+ * @param original Пікселі оригіналу.
+ * @param modified Пікселі модифікованого зображення.
+ * @param dst Індекси.
+ * @param count Кількість пікселів.
+ */
+void BitPlaneRenderer::differenceRow(const QRgb* original, const QRgb* modified,
+                                     uchar* dst, int count) {
+    int i = 0;
+
+#if BITPLANE_HAS_SSE2
+    const __m128i gain = _mm_set1_epi16(DIFFERENCE_GAIN);
+    for (; i + SIMD_PIXELS <= count; i += SIMD_PIXELS) {
+        const __m128i* a = reinterpret_cast<const __m128i*>(original + i);
+        const __m128i* b = reinterpret_cast<const __m128i*>(modified + i);
+        const __m128i s0 = sumAbsDiff(_mm_loadu_si128(a + 0), _mm_loadu_si128(b + 0));
+        const __m128i s1 = sumAbsDiff(_mm_loadu_si128(a + 1), _mm_loadu_si128(b + 1));
+        const __m128i s2 = sumAbsDiff(_mm_loadu_si128(a + 2), _mm_loadu_si128(b + 2));
+        const __m128i s3 = sumAbsDiff(_mm_loadu_si128(a + 3), _mm_loadu_si128(b + 3));
+
+        const __m128i lo = _mm_mullo_epi16(_mm_packs_epi32(s0, s1), gain);
+        const __m128i hi = _mm_mullo_epi16(_mm_packs_epi32(s2, s3), gain);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const QRgb a = original[i];
+        const QRgb b = modified[i];
+        const int sum = qAbs(qAlpha(a) - qAlpha(b)) + qAbs(qRed(a) - qRed(b)) +
+                        qAbs(qGreen(a) - qGreen(b)) + qAbs(qBlue(a) - qBlue(b));
+        dst[i] = uchar(qMin(255, sum * DIFFERENCE_GAIN));
+    }
+}
+
+/* ============================================================================
+ *                          ПАЛІТРИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Палітра площин.
+ * @return Таблиця кольорів.
+ */
+const QVector<QRgb>& BitPlaneRenderer::planeColors() {
+    static const QVector<QRgb> colors = { qRgb(0, 0, 0), qRgb(255, 255, 255) };
+    return colors;
+}
+
+/**
+ * @brief Палітра теплової карти.
+ *
+ * Чотири лінійні відрізки: чорний → синій → червоний → жовтий → білий.
+ *
+ * @return Таблиця з 256 кольорів.
+ */
+const QVector<QRgb>& BitPlaneRenderer::heatColors() {
+    static const QVector<QRgb> colors = []() {
+        QVector<QRgb> table(256);
+        for (int i = 0; i < 256; ++i) {
+            const int segment = i / 64;
+            const int t = (i % 64) * 4;   // 0-252 в межах відрізка.
+            switch (segment) {
+            case 0:  table[i] = qRgb(0, 0, t); break;
+            case 1:  table[i] = qRgb(t, 0, 255 - t); break;
+            case 2:  table[i] = qRgb(255, t, 0); break;
+            default: table[i] = qRgb(255, 255, t); break;
+            }
+        }
+        table[255] = qRgb(255, 255, 255);
+        return table;
+    }();
+    return colors;
+}
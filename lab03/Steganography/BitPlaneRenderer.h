@@ -0,0 +1,129 @@
+/*
+ * BitPlaneRenderer.h
+ *
+ * Заголовочний файл рендерера бітових площин та карти різниці.
+ * Перетворює прямокутну ділянку зображення на 8-бітове індексоване
+ * зображення: молодший біт вибраного каналу (0/1) або теплова карта
+ * сумарної різниці каналів між оригіналом та модифікованим зображенням.
+ *
+ * Основні можливості:
+ * - Векторні ядра SSE2 (16 пікселів за ітерацію) зі скалярним залишком.
+ * - Проріджування (step) для зменшеного масштабу: робота пропорційна
+ *   розміру результату, а не ділянки.
+ * - Ділянки незалежні, тому їх можна обчислювати лише для видимих тайлів.
+ */
+
+#ifndef BITPLANERENDERER_H
+#define BITPLANERENDERER_H
+
+#include <QImage>
+#include <QRect>
+#include <QSize>
+
+/**
+ * @class BitPlaneRenderer
+ * @brief Обчислення бітових площин та карти різниці по ділянках.
+ *
+ * Після setImages() об'єкт лише читає зображення, тому render()
+ * можна викликати з кількох потоків одночасно.
+ */
+class BitPlaneRenderer {
+public:
+    /**
+     * @enum Mode
+     * @brief Що показувати.
+     */
+    enum class Mode {
+        Red,         ///< Молодший біт червоного каналу.
+        Green,       ///< Молодший біт зеленого каналу.
+        Blue,        ///< Молодший біт синього каналу.
+        Alpha,       ///< Молодший біт альфа-каналу.
+        Difference   ///< Теплова карта |оригінал - модифіковане|.
+    };
+
+    /// Підсилення різниці: сума модулів різниць каналів × GAIN (до 255).
+    static constexpr int DIFFERENCE_GAIN = 16;
+
+    /**
+     * @brief Конструктор порожнього рендерера.
+     */
+    BitPlaneRenderer() = default;
+
+    /**
+     * @brief Встановлення зображень.
+     *
+     * Площини беруться з модифікованого зображення (якщо його немає -
+     * з оригіналу); карта різниці потребує обох зображень однакового розміру.
+     *
+     * @param original Оригінальне зображення.
+     * @param modified Модифіковане зображення.
+     */
+    void setImages(const QImage& original, const QImage& modified);
+
+    /**
+     * @brief Чи є що показувати.
+     * @return true якщо жодного зображення немає.
+     */
+    bool isNull() const;
+
+    /**
+     * @brief Розмір зображення.
+     * @return Ширина та висота в пікселях.
+     */
+    QSize size() const;
+
+    /**
+     * @brief Чи доступний режим.
+     * @param mode Режим.
+     * @return false для альфа-каналу без альфи та різниці без пари зображень.
+     */
+    bool supports(Mode mode) const;
+
+    /**
+     * @brief Обчислення ділянки.
+     *
+     * @param mode Режим.
+     * @param area Ділянка в координатах зображення (обрізається до нього).
+     * @param step Крок проріджування (1 - кожен піксель).
+     * @return Індексоване зображення розміром ⌈area / step⌉ (Format_Indexed8).
+     */
+    QImage render(Mode mode, const QRect& area, int step) const;
+
+private:
+    /**
+     * @brief Молодші біти одного каналу для рядка пікселів.
+     *
+     * @param src Пікселі (ARGB32).
+     * @param dst Індекси 0/1.
+     * @param count Кількість пікселів.
+     * @param shift Зсув каналу (16 - R, 8 - G, 0 - B, 24 - A).
+     */
+    static void extractPlaneRow(const QRgb* src, uchar* dst, int count, int shift);
+
+    /**
+     * @brief Індекси теплової карти для рядка пікселів.
+     *
+     * @param original Пікселі оригіналу.
+     * @param modified Пікселі модифікованого зображення.
+     * @param dst Індекси 0-255.
+     * @param count Кількість пікселів.
+     */
+    static void differenceRow(const QRgb* original, const QRgb* modified, uchar* dst, int count);
+
+    /**
+     * @brief Палітра площин (0 - чорний, 1 - білий).
+     * @return Таблиця кольорів.
+     */
+    static const QVector<QRgb>& planeColors();
+
+    /**
+     * @brief Палітра теплової карти (чорний - синій - червоний - жовтий - білий).
+     * @return Таблиця з 256 кольорів.
+     */
+    static const QVector<QRgb>& heatColors();
+
+    QImage original;   ///< Оригінал (ARGB32 або RGB32).
+    QImage modified;   ///< Модифіковане зображення (ARGB32 або RGB32).
+};
+
+#endif // BITPLANERENDERER_H
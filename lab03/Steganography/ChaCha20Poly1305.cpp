@@ -0,0 +1,658 @@
+/*
+ * ChaCha20Poly1305.cpp
+ *
+ * Реалізація AEAD-шифру ChaCha20-Poly1305 (RFC 8439).
+ * Ключовий потік генерується скалярно або по 8 блоків з AVX2
+ * (вибір під час виконання), Poly1305 - на 26-бітових складових.
+ */
+
+#include "ChaCha20Poly1305.h"
+#include <QtEndian>
+#include <cstring>
+
+// Векторний шлях доступний лише для x86 з компілятором GCC/Clang (у т.ч. MinGW).
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CHACHA_HAS_AVX2_PATH 1
+#include <immintrin.h>
+#else
+#define CHACHA_HAS_AVX2_PATH 0
+#endif
+
+/// Розмір блока ChaCha20 в байтах.
+static const int CHACHA_BLOCK = 64;
+
+/// Кількість блоків, що обробляються за раз у векторному шляху.
+static const int CHACHA_LANES = 8;
+
+/// Маска 26-бітової складової Poly1305.
+static const quint32 POLY_MASK = 0x3ffffff;
+
+/* ============================================================================
+ *                          ДОПОМІЖНІ ФУНКЦІЇ
+ * ============================================================================
+ */
+
+/**
+ * @brief Циклічний зсув 32-бітового слова вліво.
+ */
+static inline quint32 rotl32(quint32 value, int shift) {
+    return (value << shift) | (value >> (32 - shift));
+}
+
+/**
+ * @brief Чверть-раунд ChaCha20.
+ */
+static inline void quarterRound(quint32* x, int a, int b, int c, int d) {
+    x[a] += x[b]; x[d] = rotl32(x[d] ^ x[a], 16);
+    x[c] += x[d]; x[b] = rotl32(x[b] ^ x[c], 12);
+    x[a] += x[b]; x[d] = rotl32(x[d] ^ x[a], 8);
+    x[c] += x[d]; x[b] = rotl32(x[b] ^ x[c], 7);
+}
+
+/**
+ * @brief Обчислення одного блока ключового потоку (20 раундів).
+ * @param state Вхідний стан (16 слів).
+ * @param out Вихідний блок (64 байти).
+ */
+static void chachaBlock(const quint32 state[16], uchar out[CHACHA_BLOCK]) {
+    quint32 x[16];
+    std::memcpy(x, state, sizeof(x));
+
+    for (int i = 0; i < 10; ++i) {
+        // Стовпці.
+        quarterRound(x, 0, 4, 8, 12);
+        quarterRound(x, 1, 5, 9, 13);
+        quarterRound(x, 2, 6, 10, 14);
+        quarterRound(x, 3, 7, 11, 15);
+        // Діагоналі.
+        quarterRound(x, 0, 5, 10, 15);
+        quarterRound(x, 1, 6, 11, 12);
+        quarterRound(x, 2, 7, 8, 13);
+        quarterRound(x, 3, 4, 9, 14);
+    }
+
+    for (int i = 0; i < 16; ++i) {
+        qToLittleEndian<quint32>(x[i] + state[i], out + 4 * i);
+    }
+}
+
+/**
+ * @brief XOR даних з ключовим потоком, обчисленим скалярно.
+ * @param state Початковий стан (лічильник замінюється).
+ * @param counter Номер першого блока.
+ * @param data Дані (модифікуються).
+ * @param size Кількість байтів.
+ */
+static void xorKeyStreamScalar(const quint32 state[16], quint32 counter, uchar* data, qsizetype size) {
+    quint32 blockState[16];
+    std::memcpy(blockState, state, sizeof(blockState));
+    uchar keyStream[CHACHA_BLOCK];
+
+    for (qsizetype offset = 0; offset < size; offset += CHACHA_BLOCK, ++counter) {
+        blockState[12] = counter;
+        chachaBlock(blockState, keyStream);
+
+        const qsizetype count = qMin<qsizetype>(CHACHA_BLOCK, size - offset);
+        for (qsizetype i = 0; i < count; ++i) {
+            data[offset + i] ^= keyStream[i];
+        }
+    }
+}
+
+#if CHACHA_HAS_AVX2_PATH
+
+/**
+ * @brief Чи підтримує процесор AVX2 (перевіряється один раз).
+ */
+static bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+__attribute__((target("avx2")))
+static inline __m256i rotlVec(__m256i v, int shift) {
+    return _mm256_or_si256(_mm256_slli_epi32(v, shift), _mm256_srli_epi32(v, 32 - shift));
+}
+
+/**
+ * @brief XOR даних з ключовим потоком, 8 блоків (512 байтів) за ітерацію.
+ *
+ * Кожен регістр містить одне слово стану для 8 послідовних блоків,
+ * тому 20 раундів виконуються без перестановок. Після раундів 8×8 слів
+ * транспонуються, щоб отримати суцільні 64-байтові блоки.
+ *
+ * @param state Початковий стан.
+ * @param counter Номер першого блока.
+ * @param data Дані (розмір кратний 512).
+ * @param size Кількість байтів.
+ */
+__attribute__((target("avx2")))
+static void xorKeyStreamAvx2(const quint32 state[16], quint32 counter, uchar* data, qsizetype size) {
+    const __m256i rot16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                           2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    const __m256i rot8 = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+                                          3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+    const __m256i laneOffsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    __m256i input[16];
+    for (int i = 0; i < 16; ++i) {
+        input[i] = _mm256_set1_epi32(int(state[i]));
+    }
+
+    for (qsizetype offset = 0; offset < size; offset += CHACHA_BLOCK * CHACHA_LANES) {
+        input[12] = _mm256_add_epi32(_mm256_set1_epi32(int(counter)), laneOffsets);
+
+        __m256i x[16];
+        for (int i = 0; i < 16; ++i) {
+            x[i] = input[i];
+        }
+
+#define CHACHA_QR_AVX2(a, b, c, d)                                              \
+        x[a] = _mm256_add_epi32(x[a], x[b]);                                   \
+        x[d] = _mm256_shuffle_epi8(_mm256_xor_si256(x[d], x[a]), rot16);       \
+        x[c] = _mm256_add_epi32(x[c], x[d]);                                   \
+        x[b] = rotlVec(_mm256_xor_si256(x[b], x[c]), 12);                      \
+        x[a] = _mm256_add_epi32(x[a], x[b]);                                   \
+        x[d] = _mm256_shuffle_epi8(_mm256_xor_si256(x[d], x[a]), rot8);        \
+        x[c] = _mm256_add_epi32(x[c], x[d]);                                   \
+        x[b] = rotlVec(_mm256_xor_si256(x[b], x[c]), 7);
+
+        for (int i = 0; i < 10; ++i) {
+            CHACHA_QR_AVX2(0, 4, 8, 12)
+            CHACHA_QR_AVX2(1, 5, 9, 13)
+            CHACHA_QR_AVX2(2, 6, 10, 14)
+            CHACHA_QR_AVX2(3, 7, 11, 15)
+            CHACHA_QR_AVX2(0, 5, 10, 15)
+            CHACHA_QR_AVX2(1, 6, 11, 12)
+            CHACHA_QR_AVX2(2, 7, 8, 13)
+            CHACHA_QR_AVX2(3, 4, 9, 14)
+        }
+
+#undef CHACHA_QR_AVX2
+
+        for (int i = 0; i < 16; ++i) {
+            x[i] = _mm256_add_epi32(x[i], input[i]);
+        }
+
+        // Транспонування: половина h - слова 8h..8h+7 кожного блока.
+        uchar* out = data + offset;
+        for (int h = 0; h < 2; ++h) {
+            const __m256i* a = x + 8 * h;
+
+            const __m256i t0 = _mm256_unpacklo_epi32(a[0], a[1]);
+            const __m256i t1 = _mm256_unpackhi_epi32(a[0], a[1]);
+            const __m256i t2 = _mm256_unpacklo_epi32(a[2], a[3]);
+            const __m256i t3 = _mm256_unpackhi_epi32(a[2], a[3]);
+            const __m256i t4 = _mm256_unpacklo_epi32(a[4], a[5]);
+            const __m256i t5 = _mm256_unpackhi_epi32(a[4], a[5]);
+            const __m256i t6 = _mm256_unpacklo_epi32(a[6], a[7]);
+            const __m256i t7 = _mm256_unpackhi_epi32(a[6], a[7]);
+
+            const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+            const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+            const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+            const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+            const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+            const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+            const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+            const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+
+            // u0..u3 - слова 0-3 блоків (0..3 | 4..7), u4..u7 - слова 4-7.
+            const __m256i blocks[CHACHA_LANES] = {
+                _mm256_permute2x128_si256(u0, u4, 0x20), _mm256_permute2x128_si256(u1, u5, 0x20),
+                _mm256_permute2x128_si256(u2, u6, 0x20), _mm256_permute2x128_si256(u3, u7, 0x20),
+                _mm256_permute2x128_si256(u0, u4, 0x31), _mm256_permute2x128_si256(u1, u5, 0x31),
+                _mm256_permute2x128_si256(u2, u6, 0x31), _mm256_permute2x128_si256(u3, u7, 0x31),
+            };
+
+            for (int b = 0; b < CHACHA_LANES; ++b) {
+                __m256i* target = reinterpret_cast<__m256i*>(out + b * CHACHA_BLOCK + h * 32);
+                _mm256_storeu_si256(target, _mm256_xor_si256(_mm256_loadu_si256(target), blocks[b]));
+            }
+        }
+
+        counter += CHACHA_LANES;
+    }
+}
+
+#endif // CHACHA_HAS_AVX2_PATH
+
+/**
+ * @brief Обробка повних 16-байтових блоків Poly1305.
+ *
+ * h = (h + m + 2^128) × r mod (2^130 - 5) на 26-бітових складових.
+ *
+ * @param h Акумулятор (5 складових).
+ * @param r Ключ r (5 складових, після clamp).
+ * @param m Дані.
+ * @param blocks Кількість блоків.
+ */
+static void poly1305Blocks(quint32 h[5], const quint32 r[5], const uchar* m, qsizetype blocks) {
+    const quint32 s1 = r[1] * 5, s2 = r[2] * 5, s3 = r[3] * 5, s4 = r[4] * 5;
+    quint32 h0 = h[0], h1 = h[1], h2 = h[2], h3 = h[3], h4 = h[4];
+
+    for (; blocks > 0; --blocks, m += 16) {
+        h0 += qFromLittleEndian<quint32>(m) & POLY_MASK;
+        h1 += (qFromLittleEndian<quint32>(m + 3) >> 2) & POLY_MASK;
+        h2 += (qFromLittleEndian<quint32>(m + 6) >> 4) & POLY_MASK;
+        h3 += (qFromLittleEndian<quint32>(m + 9) >> 6) & POLY_MASK;
+        h4 += (qFromLittleEndian<quint32>(m + 12) >> 8) | (1u << 24);
+
+        const quint64 d0 = quint64(h0) * r[0] + quint64(h1) * s4 + quint64(h2) * s3 +
+                           quint64(h3) * s2 + quint64(h4) * s1;
+        quint64 d1 = quint64(h0) * r[1] + quint64(h1) * r[0] + quint64(h2) * s4 +
+                     quint64(h3) * s3 + quint64(h4) * s2;
+        quint64 d2 = quint64(h0) * r[2] + quint64(h1) * r[1] + quint64(h2) * r[0] +
+                     quint64(h3) * s4 + quint64(h4) * s3;
+        quint64 d3 = quint64(h0) * r[3] + quint64(h1) * r[2] + quint64(h2) * r[1] +
+                     quint64(h3) * r[0] + quint64(h4) * s4;
+        quint64 d4 = quint64(h0) * r[4] + quint64(h1) * r[3] + quint64(h2) * r[2] +
+                     quint64(h3) * r[1] + quint64(h4) * r[0];
+
+        // Перенесення між складовими.
+        quint32 carry = quint32(d0 >> 26); h0 = quint32(d0) & POLY_MASK;
+        d1 += carry; carry = quint32(d1 >> 26); h1 = quint32(d1) & POLY_MASK;
+        d2 += carry; carry = quint32(d2 >> 26); h2 = quint32(d2) & POLY_MASK;
+        d3 += carry; carry = quint32(d3 >> 26); h3 = quint32(d3) & POLY_MASK;
+        d4 += carry; carry = quint32(d4 >> 26); h4 = quint32(d4) & POLY_MASK;
+        h0 += carry * 5; carry = h0 >> 26; h0 &= POLY_MASK;
+        h1 += carry;
+    }
+
+    h[0] = h0; h[1] = h1; h[2] = h2; h[3] = h3; h[4] = h4;
+}
+
+/**
+ * @brief Обробка даних, доповнених нулями до кратного 16 розміру.
+ */
+static void poly1305Padded(quint32 h[5], const quint32 r[5], const QByteArray& data) {
+    const uchar* bytes = reinterpret_cast<const uchar*>(data.constData());
+    const qsizetype fullBlocks = data.size() / 16;
+    poly1305Blocks(h, r, bytes, fullBlocks);
+
+    const qsizetype tail = data.size() % 16;
+    if (tail > 0) {
+        uchar block[16] = {};
+        std::memcpy(block, bytes + fullBlocks * 16, size_t(tail));
+        poly1305Blocks(h, r, block, 1);
+    }
+}
+
+/* ============================================================================
+ *                              ПУБЛІЧНІ МЕТОДИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор.
+ * @param key Ключ (KEY_SIZE байтів; коротший доповнюється нулями).
+ */
+ChaCha20Poly1305::ChaCha20Poly1305(const QByteArray& key) {
+    uchar bytes[KEY_SIZE] = {};
+    std::memcpy(bytes, key.constData(), size_t(qMin<qsizetype>(key.size(), KEY_SIZE)));
+    for (int i = 0; i < 8; ++i) {
+        keyWords[i] = qFromLittleEndian<quint32>(bytes + 4 * i);
+    }
+}
+
+/**
+ * @brief Шифрування даних на місці.
+ *
+ * @param data Відкритий текст (замінюється шифротекстом).
+ * @param nonce Одноразове значення (NONCE_SIZE байтів).
+ * @param aad Додаткові автентифіковані дані (не шифруються).
+ * @return Тег автентичності (TAG_SIZE байтів).
+ */
+QByteArray ChaCha20Poly1305::encrypt(QByteArray& data, const QByteArray& nonce,
+                                     const QByteArray& aad) const {
+    Stream stream(*this, nonce, aad);
+    stream.encrypt(reinterpret_cast<uchar*>(data.data()), data.size());
+    return stream.finish();
+}
+
+/**
+ * @brief Перевірка тегу та дешифрування даних на місці.
+ *
+ * @param data Шифротекст (замінюється відкритим текстом).
+ * @param nonce Одноразове значення (NONCE_SIZE байтів).
+ * @param aad Додаткові автентифіковані дані.
+ * @param tag Тег автентичності (TAG_SIZE байтів).
+ * @return true якщо тег правильний.
+ */
+bool ChaCha20Poly1305::decrypt(QByteArray& data, const QByteArray& nonce,
+                               const QByteArray& aad, const QByteArray& tag) const {
+    if (tag.size() != TAG_SIZE) {
+        return false;
+    }
+
+    // Спершу лише автентифікація: при невірному тегу дані не змінюються.
+    Stream check(*this, nonce, aad);
+    check.authenticate(reinterpret_cast<const uchar*>(data.constData()), data.size());
+    if (!check.verify(tag)) {
+        return false;
+    }
+
+    quint32 state[16];
+    initState(nonce, state);
+    xorKeyStream(state, 1, reinterpret_cast<uchar*>(data.data()), data.size());
+    return true;
+}
+
+/* ============================================================================
+ *                          ПРИВАТНІ МЕТОДИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Формування початкового стану блока ChaCha20.
+ * @param nonce Одноразове значення.
+ * @param state Стан (16 слів), лічильник - 0.
+ */
+void ChaCha20Poly1305::initState(const QByteArray& nonce, quint32 state[16]) const {
+    // "expand 32-byte k".
+    state[0] = 0x61707865;
+    state[1] = 0x3320646e;
+    state[2] = 0x79622d32;
+    state[3] = 0x6b206574;
+    for (int i = 0; i < 8; ++i) {
+        state[4 + i] = keyWords[i];
+    }
+    state[12] = 0;
+
+    uchar nonceBytes[NONCE_SIZE] = {};
+    std::memcpy(nonceBytes, nonce.constData(), size_t(qMin<qsizetype>(nonce.size(), NONCE_SIZE)));
+    for (int i = 0; i < 3; ++i) {
+        state[13 + i] = qFromLittleEndian<quint32>(nonceBytes + 4 * i);
+    }
+}
+
+/**
+ * @brief XOR даних з ключовим потоком, починаючи з блока counter.
+ *
+ * @param state Початковий стан (лічильник замінюється).
+ * @param counter Номер першого блока.
+ * @param data Дані (модифікуються).
+ * @param size Кількість байтів.
+ */
+void ChaCha20Poly1305::xorKeyStream(const quint32 state[16], quint32 counter,
+                                    uchar* data, qsizetype size) {
+    qsizetype offset = 0;
+
+#if CHACHA_HAS_AVX2_PATH
+    const qsizetype groupBytes = CHACHA_BLOCK * CHACHA_LANES;
+    if (size >= groupBytes && cpuHasAvx2()) {
+        offset = size / groupBytes * groupBytes;
+        xorKeyStreamAvx2(state, counter, data, offset);
+        counter += quint32(offset / CHACHA_BLOCK);
+    }
+#endif
+
+    // Скалярний шлях: решта блоків (або всі без AVX2).
+    xorKeyStreamScalar(state, counter, data + offset, size - offset);
+}
+
+/* ============================================================================
+ *                          ПОТОКОВИЙ РЕЖИМ
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор потоку.
+ *
+ * Одноразовий ключ Poly1305 - блок 0 ключового потоку; додаткові дані
+ * автентифікуються одразу (RFC 8439, розділ 2.8: aad || доповнення).
+ *
+ * @param cipher Шифр з ключем.
+ * @param nonce Одноразове значення.
+ * @param aad Додаткові автентифіковані дані.
+ */
+ChaCha20Poly1305::Stream::Stream(const ChaCha20Poly1305& cipher, const QByteArray& nonce,
+                                 const QByteArray& aad) {
+    cipher.initState(nonce, state);
+
+    // ========== Одноразовий ключ Poly1305 - блок 0 ==========
+    uchar block[CHACHA_BLOCK];
+    chachaBlock(state, block);
+    std::memcpy(polyKey, block, sizeof(polyKey));
+
+    // r з обмеженням бітів (clamp), розкладений на 26-бітові складові.
+    r[0] = qFromLittleEndian<quint32>(polyKey) & 0x3ffffff;
+    r[1] = (qFromLittleEndian<quint32>(polyKey + 3) >> 2) & 0x3ffff03;
+    r[2] = (qFromLittleEndian<quint32>(polyKey + 6) >> 4) & 0x3ffc0ff;
+    r[3] = (qFromLittleEndian<quint32>(polyKey + 9) >> 6) & 0x3f03fff;
+    r[4] = (qFromLittleEndian<quint32>(polyKey + 12) >> 8) & 0x00fffff;
+
+    for (int i = 0; i < 5; ++i) {
+        h[i] = 0;
+    }
+
+    poly1305Padded(h, r, aad);
+    aadSize = quint64(aad.size());
+}
+
+/**
+ * @brief Шифрування фрагмента на місці.
+ * @param data Дані (замінюються шифротекстом).
+ * @param size Кількість байтів (кратна 64, крім останнього фрагмента).
+ */
+void ChaCha20Poly1305::Stream::encrypt(uchar* data, qsizetype size) {
+    xorKeyStream(state, counter, data, size);
+    counter += quint32((size + CHACHA_BLOCK - 1) / CHACHA_BLOCK);
+    authenticate(data, size);
+}
+
+/**
+ * @brief Дешифрування фрагмента на місці.
+ * @param data Шифротекст (замінюється відкритим текстом).
+ * @param size Кількість байтів (кратна 64, крім останнього фрагмента).
+ */
+void ChaCha20Poly1305::Stream::decrypt(uchar* data, qsizetype size) {
+    authenticate(data, size);
+    xorKeyStream(state, counter, data, size);
+    counter += quint32((size + CHACHA_BLOCK - 1) / CHACHA_BLOCK);
+}
+
+/**
+ * @brief Автентифікація фрагмента шифротексту.
+ *
+ * Неповний 16-байтовий блок зберігається до наступного фрагмента.
+ *
+ * @param data Шифротекст.
+ * @param size Кількість байтів.
+ */
+void ChaCha20Poly1305::Stream::authenticate(const uchar* data, qsizetype size) {
+    textSize += quint64(size);
+
+    // Доповнюємо неповний блок з попереднього фрагмента.
+    if (pendingSize > 0) {
+        const int count = int(qMin<qsizetype>(16 - pendingSize, size));
+        std::memcpy(pending + pendingSize, data, size_t(count));
+        pendingSize += count;
+        data += count;
+        size -= count;
+        if (pendingSize < 16) {
+            return;
+        }
+        poly1305Blocks(h, r, pending, 1);
+        pendingSize = 0;
+    }
+
+    const qsizetype fullBlocks = size / 16;
+    poly1305Blocks(h, r, data, fullBlocks);
+
+    pendingSize = int(size % 16);
+    std::memcpy(pending, data + fullBlocks * 16, size_t(pendingSize));
+}
+
+/**
+ * @brief Завершення та обчислення тегу.
+ *
+ * Повідомлення Poly1305 (RFC 8439, розділ 2.8):
+ * aad || доповнення || шифротекст || доповнення || len(aad) || len(шифротекст).
+ *
+ * @return Тег (TAG_SIZE байтів).
+ */
+QByteArray ChaCha20Poly1305::Stream::finish() {
+    // ========== КРОК 1: Залишок шифротексту з доповненням ==========
+    if (pendingSize > 0) {
+        std::memset(pending + pendingSize, 0, size_t(16 - pendingSize));
+        poly1305Blocks(h, r, pending, 1);
+        pendingSize = 0;
+    }
+
+    uchar lengths[16];
+    qToLittleEndian<quint64>(aadSize, lengths);
+    qToLittleEndian<quint64>(textSize, lengths + 8);
+    poly1305Blocks(h, r, lengths, 1);
+
+    // ========== КРОК 2: Повне зведення за модулем 2^130 - 5 ==========
+    quint32 carry = h[1] >> 26; h[1] &= POLY_MASK;
+    h[2] += carry; carry = h[2] >> 26; h[2] &= POLY_MASK;
+    h[3] += carry; carry = h[3] >> 26; h[3] &= POLY_MASK;
+    h[4] += carry; carry = h[4] >> 26; h[4] &= POLY_MASK;
+    h[0] += carry * 5; carry = h[0] >> 26; h[0] &= POLY_MASK;
+    h[1] += carry;
+
+    // g = h + 5 - 2^130; якщо g >= 0, то результат - g.
+    quint32 g[5];
+    g[0] = h[0] + 5; carry = g[0] >> 26; g[0] &= POLY_MASK;
+    g[1] = h[1] + carry; carry = g[1] >> 26; g[1] &= POLY_MASK;
+    g[2] = h[2] + carry; carry = g[2] >> 26; g[2] &= POLY_MASK;
+    g[3] = h[3] + carry; carry = g[3] >> 26; g[3] &= POLY_MASK;
+    g[4] = h[4] + carry - (1u << 26);
+
+    const quint32 selectG = (g[4] >> 31) - 1;
+    for (int i = 0; i < 5; ++i) {
+        h[i] = (h[i] & ~selectG) | (g[i] & selectG);
+    }
+
+    // ========== КРОК 3: tag = (h + s) mod 2^128 ==========
+    const quint32 words[4] = {
+        h[0] | (h[1] << 26),
+        (h[1] >> 6) | (h[2] << 20),
+        (h[2] >> 12) | (h[3] << 14),
+        (h[3] >> 18) | (h[4] << 8),
+    };
+
+    QByteArray tag(TAG_SIZE, '\0');
+    uchar* out = reinterpret_cast<uchar*>(tag.data());
+    quint64 sum = 0;
+    for (int i = 0; i < 4; ++i) {
+        sum += quint64(words[i]) + qFromLittleEndian<quint32>(polyKey + 16 + 4 * i);
+        qToLittleEndian<quint32>(quint32(sum), out + 4 * i);
+        sum >>= 32;
+    }
+
+    return tag;
+}
+
+/**
+ * @brief Завершення та порівняння тегу за сталий час.
+ *
+ * Час порівняння не залежить від позиції розбіжності.
+ *
+ * @param tag Очікуваний тег.
+ * @return true якщо тег правильний.
+ */
+bool ChaCha20Poly1305::Stream::verify(const QByteArray& tag) {
+    if (tag.size() != TAG_SIZE) {
+        return false;
+    }
+
+    const QByteArray expected = finish();
+    uchar difference = 0;
+    for (int i = 0; i < TAG_SIZE; ++i) {
+        difference |= uchar(expected[i] ^ tag[i]);
+    }
+    return difference == 0;
+}
+
+/* ============================================================================
+ *                          САМОПЕРЕВІРКА
+ * ============================================================================
+ */
+
+/**
+ * @brief Чи генерується ключовий потік векторно (AVX2) на цьому процесорі.
+ * @return true якщо доступний шлях по 8 блоків.
+ */
+bool ChaCha20Poly1305::hasVectorPath() {
+#if CHACHA_HAS_AVX2_PATH
+    return cpuHasAvx2();
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Перевірка на тестовому векторі RFC 8439 (розділ 2.8.2).
+ *
+ * @param vectorized Перевіряти векторний шлях замість скалярного.
+ * @return true якщо результат збігся (false, якщо шлях недоступний).
+ */
+bool ChaCha20Poly1305::selfTest(bool vectorized) {
+    if (vectorized && !hasVectorPath()) {
+        return false;
+    }
+
+    // ========== КРОК 1: Тестовий вектор ==========
+    const QByteArray key = QByteArray::fromHex(
+        "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f");
+    const QByteArray nonce = QByteArray::fromHex("070000004041424344454647");
+    const QByteArray aad = QByteArray::fromHex("50515253c0c1c2c3c4c5c6c7");
+    const QByteArray plaintext("Ladies and Gentlemen of the class of '99: If I could offer you "
+                               "only one tip for the future, sunscreen would be it.");
+    const QByteArray expected = QByteArray::fromHex(
+        "d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d6"
+        "3dbea45e8ca9671282fafb69da92728b1a71de0a9e060b2905d6a5b67ecd3b36"
+        "92ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc"
+        "3ff4def08e4b7a9de576d26586cec64b6116");
+    const QByteArray expectedTag = QByteArray::fromHex("1ae10b594f09e26a7e902ecbd0600691");
+
+    const ChaCha20Poly1305 cipher(key);
+    quint32 state[16];
+    cipher.initState(nonce, state);
+
+    // ========== КРОК 2: Ключовий потік обраним шляхом ==========
+    // Одна група векторного шляху; текст займає перші два блоки, решта - нулі.
+    const qsizetype groupBytes = CHACHA_BLOCK * CHACHA_LANES;
+    QByteArray group(groupBytes, '\0');
+    std::memcpy(group.data(), plaintext.constData(), size_t(plaintext.size()));
+    uchar* groupData = reinterpret_cast<uchar*>(group.data());
+
+    QByteArray keyStream(groupBytes, '\0');
+    xorKeyStreamScalar(state, 1, reinterpret_cast<uchar*>(keyStream.data()), groupBytes);
+
+    if (vectorized) {
+#if CHACHA_HAS_AVX2_PATH
+        xorKeyStreamAvx2(state, 1, groupData, groupBytes);
+#endif
+        // Блоки 3-8 вектор не покриває: звіряємо їх зі скалярним шляхом.
+        if (group.mid(plaintext.size()) != keyStream.mid(plaintext.size())) {
+            return false;
+        }
+    } else {
+        xorKeyStreamScalar(state, 1, groupData, groupBytes);
+    }
+
+    // ========== КРОК 3: Шифротекст і тег ==========
+    const QByteArray ciphertext = group.left(plaintext.size());
+    Stream stream(cipher, nonce, aad);
+    stream.authenticate(reinterpret_cast<const uchar*>(ciphertext.constData()), ciphertext.size());
+    if (ciphertext != expected || stream.finish() != expectedTag) {
+        return false;
+    }
+
+    // ========== КРОК 4: Відкритий інтерфейс (скалярний шлях) ==========
+    if (!vectorized) {
+        QByteArray data = plaintext;
+        if (cipher.encrypt(data, nonce, aad) != expectedTag || data != expected) {
+            return false;
+        }
+        if (!cipher.decrypt(data, nonce, aad, expectedTag) || data != plaintext) {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,182 @@
+/*
+ * ChaCha20Poly1305.h
+ *
+ * Заголовочний файл автентифікованого потокового шифру
+ * ChaCha20-Poly1305 (RFC 8439) для шифрування навантаження.
+ *
+ * Основні можливості:
+ * - Шифрування та дешифрування байтів на місці.
+ * - 16-байтовий тег автентичності Poly1305 (дані + додаткові дані).
+ * - Перевірка тегу до дешифрування: неправильний ключ виявляється одразу.
+ * - Потокове шифрування фрагментами (Stream) для даних, що не вміщуються в пам'ять.
+ * - Генерація ключового потоку по 8 блоків за раз з AVX2 (якщо доступно).
+ * - Самоперевірка скалярного та векторного шляхів на векторі RFC 8439.
+ */
+
+#ifndef CHACHA20POLY1305_H
+#define CHACHA20POLY1305_H
+
+#include <QByteArray>
+#include <QtGlobal>
+
+/**
+ * @class ChaCha20Poly1305
+ * @brief AEAD-шифр ChaCha20-Poly1305 (RFC 8439).
+ *
+ * Ключ - 32 байти, nonce - 12 байтів (не повинен повторюватися для
+ * одного ключа), тег - 16 байтів. Ключ Poly1305 береться з нульового
+ * блока ключового потоку, дані шифруються блоками з лічильником від 1.
+ */
+class ChaCha20Poly1305 {
+public:
+    /// Розмір ключа в байтах.
+    static constexpr int KEY_SIZE = 32;
+
+    /// Розмір nonce в байтах.
+    static constexpr int NONCE_SIZE = 12;
+
+    /// Розмір тегу автентичності в байтах.
+    static constexpr int TAG_SIZE = 16;
+
+    /**
+     * @brief Конструктор.
+     * @param key Ключ (KEY_SIZE байтів; коротший доповнюється нулями).
+     */
+    explicit ChaCha20Poly1305(const QByteArray& key);
+
+    /**
+     * @brief Шифрування даних на місці.
+     *
+     * @param data Відкритий текст (замінюється шифротекстом).
+     * @param nonce Одноразове значення (NONCE_SIZE байтів).
+     * @param aad Додаткові автентифіковані дані (не шифруються).
+     * @return Тег автентичності (TAG_SIZE байтів).
+     */
+    QByteArray encrypt(QByteArray& data, const QByteArray& nonce, const QByteArray& aad) const;
+
+    /**
+     * @brief Перевірка тегу та дешифрування даних на місці.
+     *
+     * Тег перевіряється до дешифрування (порівняння за сталий час);
+     * якщо він не збігся, дані не змінюються.
+     *
+     * @param data Шифротекст (замінюється відкритим текстом).
+     * @param nonce Одноразове значення (NONCE_SIZE байтів).
+     * @param aad Додаткові автентифіковані дані.
+     * @param tag Тег автентичності (TAG_SIZE байтів).
+     * @return true якщо тег правильний.
+     */
+    bool decrypt(QByteArray& data, const QByteArray& nonce, const QByteArray& aad,
+                 const QByteArray& tag) const;
+
+    /**
+     * @brief Чи генерується ключовий потік векторно (AVX2) на цьому процесорі.
+     * @return true якщо доступний шлях по 8 блоків.
+     */
+    static bool hasVectorPath();
+
+    /**
+     * @brief Перевірка на тестовому векторі RFC 8439 (розділ 2.8.2).
+     *
+     * Відкритий текст вектора доповнюється нулями до групи з 8 блоків і
+     * шифрується обраним шляхом ключового потоку; шифротекст і тег
+     * порівнюються з очікуваними. Скалярна перевірка також проходить
+     * через encrypt()/decrypt(), векторна - звіряє решту блоків групи
+     * зі скалярним ключовим потоком.
+     *
+     * @param vectorized Перевіряти векторний шлях замість скалярного.
+     * @return true якщо результат збігся (false, якщо шлях недоступний).
+     */
+    static bool selfTest(bool vectorized);
+
+    /**
+     * @class Stream
+     * @brief Потокове шифрування або дешифрування фрагментами.
+     *
+     * Результат той самий, що й у encrypt()/decrypt() для з'єднаних
+     * фрагментів. Розмір кожного фрагмента, крім останнього, має бути
+     * кратним 64 байтам (блок ChaCha20). При дешифруванні тег відомий
+     * лише в кінці, тому відкритий текст не можна вважати автентичним,
+     * доки verify() не поверне true.
+     */
+    class Stream {
+    public:
+        /**
+         * @brief Конструктор.
+         * @param cipher Шифр з ключем.
+         * @param nonce Одноразове значення (NONCE_SIZE байтів).
+         * @param aad Додаткові автентифіковані дані.
+         */
+        Stream(const ChaCha20Poly1305& cipher, const QByteArray& nonce, const QByteArray& aad);
+
+        /**
+         * @brief Шифрування фрагмента на місці.
+         * @param data Дані (замінюються шифротекстом).
+         * @param size Кількість байтів.
+         */
+        void encrypt(uchar* data, qsizetype size);
+
+        /**
+         * @brief Дешифрування фрагмента на місці.
+         * @param data Шифротекст (замінюється відкритим текстом).
+         * @param size Кількість байтів.
+         */
+        void decrypt(uchar* data, qsizetype size);
+
+        /**
+         * @brief Автентифікація фрагмента шифротексту без дешифрування.
+         * @param data Шифротекст.
+         * @param size Кількість байтів.
+         */
+        void authenticate(const uchar* data, qsizetype size);
+
+        /**
+         * @brief Завершення та обчислення тегу.
+         * @return Тег автентичності (TAG_SIZE байтів).
+         */
+        QByteArray finish();
+
+        /**
+         * @brief Завершення та порівняння тегу за сталий час.
+         * @param tag Очікуваний тег.
+         * @return true якщо тег правильний.
+         */
+        bool verify(const QByteArray& tag);
+
+    private:
+        quint32 state[16];        ///< Початковий стан ChaCha20.
+        quint32 counter = 1;      ///< Номер наступного блока ключового потоку.
+        quint32 r[5];             ///< Ключ r Poly1305 (26-бітові складові).
+        quint32 h[5];             ///< Акумулятор Poly1305.
+        uchar polyKey[32];        ///< Одноразовий ключ Poly1305 (r || s).
+        uchar pending[16];        ///< Неповний 16-байтовий блок шифротексту.
+        int pendingSize = 0;      ///< Байтів у pending.
+        quint64 aadSize = 0;      ///< Довжина додаткових даних.
+        quint64 textSize = 0;     ///< Довжина шифротексту.
+    };
+
+private:
+    /**
+     * @brief Формування початкового стану блока ChaCha20.
+     * @param nonce Одноразове значення.
+     * @param state Стан (16 слів), лічильник - 0.
+     */
+    void initState(const QByteArray& nonce, quint32 state[16]) const;
+
+    /**
+     * @brief XOR даних з ключовим потоком, починаючи з блока counter.
+     *
+     * Повні групи по 8 блоків обробляються векторно (AVX2), якщо процесор
+     * це підтримує; решта - скалярно.
+     *
+     * @param state Початковий стан (лічильник замінюється).
+     * @param counter Номер першого блока.
+     * @param data Дані (модифікуються).
+     * @param size Кількість байтів.
+     */
+    static void xorKeyStream(const quint32 state[16], quint32 counter, uchar* data, qsizetype size);
+
+    quint32 keyWords[8];  ///< Ключ у вигляді 8 слів little-endian.
+};
+
+#endif // CHACHA20POLY1305_H
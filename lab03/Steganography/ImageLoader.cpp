@@ -0,0 +1,102 @@
+/*
+ * ImageLoader.cpp
+ *
+ * Реалізація фонового завантажувача зображень.
+ */
+
+#include "ImageLoader.h"
+#include <QImageReader>
+#include <QMetaObject>
+#include <QDebug>
+
+/**
+ * @brief Конструктор.
+ * @param parent Батьківський об'єкт.
+ */
+ImageLoader::ImageLoader(QObject* parent)
+    : QObject(parent),
+    lastRequestId(0)
+{
+    // Два потоки: перегляд нового файлу не чекає повного декодування іншого.
+    pool.setMaxThreadCount(2);
+}
+
+/**
+ * @brief Деструктор.
+ *
+ * Результати, що вже поставлені в чергу подій, знищуються разом з об'єктом.
+ */
+ImageLoader::~ImageLoader() {
+    pool.clear();
+    pool.waitForDone();
+}
+
+/**
+ * @brief Запит попереднього перегляду.
+ *
+ * @param path Шлях до файлу.
+ * @return Номер запиту.
+ */
+int ImageLoader::requestPreview(const QString& path) {
+    const int requestId = ++lastRequestId;
+    pool.start([this, requestId, path]() { load(requestId, path, false); });
+    return requestId;
+}
+
+/**
+ * @brief Запит повного зображення.
+ *
+ * @param path Шлях до файлу.
+ * @return Номер запиту.
+ */
+int ImageLoader::requestImage(const QString& path) {
+    const int requestId = ++lastRequestId;
+    pool.start([this, requestId, path]() { load(requestId, path, true); });
+    return requestId;
+}
+
+/**
+ * @brief Декодування в робочому потоці та надсилання результату.
+ *
+ * Розмір повного зображення читається із заголовка файлу, тому для
+ * перегляду піксели повного розміру не декодуються (JPEG масштабує
+ * при декодуванні, інші формати - одразу після нього, в цьому потоці).
+ *
+ * @param requestId Номер запиту.
+ * @param path Шлях до файлу.
+ * @param full Повне чи зменшене декодування.
+ */
+void ImageLoader::load(int requestId, const QString& path, bool full) {
+    QImageReader reader(path);
+    const QSize fullSize = reader.size();
+
+    if (!full && fullSize.isValid() &&
+        qMax(fullSize.width(), fullSize.height()) > ImagePreview::MAX_SIDE) {
+        reader.setScaledSize(fullSize.scaled(ImagePreview::MAX_SIDE, ImagePreview::MAX_SIDE,
+                                             Qt::KeepAspectRatio));
+    }
+
+    const QImage image = reader.read();
+    if (image.isNull()) {
+        qWarning() << "Failed to load image" << path << ":" << reader.errorString();
+        QMetaObject::invokeMethod(this, [this, requestId, path]() {
+            emit loadFailed(requestId, path);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    const ImagePreview preview = ImagePreview::fromImage(image, fullSize);
+    qDebug() << "Image loaded:" << path << (full ? "full" : "preview")
+             << image.size() << "levels:" << preview.levelCount();
+
+    // Сигнали надсилаються в потоці завантажувача.
+    if (full) {
+        QMetaObject::invokeMethod(this, [this, requestId, path, image, preview]() {
+            emit imageReady(requestId, path, image, preview);
+        }, Qt::QueuedConnection);
+    } else {
+        QMetaObject::invokeMethod(this, [this, requestId, path, preview]() {
+            emit previewReady(requestId, path, preview);
+        }, Qt::QueuedConnection);
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * ImageLoader.h
+ *
+ * Заголовочний файл фонового завантажувача зображень.
+ * Декодування виконується у власному пулі потоків, а результати
+ * надсилаються сигналами в потоці завантажувача (потоці інтерфейсу).
+ *
+ * Основні можливості:
+ * - Швидкий попередній перегляд: QImageReader::setScaledSize декодує
+ *   одразу зменшене зображення (для JPEG - без повного декодування).
+ * - Повне декодування лише на запит (для аналізу).
+ * - Номер запиту дозволяє відкидати застарілі результати.
+ */
+
+#ifndef IMAGELOADER_H
+#define IMAGELOADER_H
+
+#include <QObject>
+#include <QImage>
+#include <QString>
+#include <QThreadPool>
+#include "ImagePreview.h"
+
+/**
+ * @class ImageLoader
+ * @brief Асинхронне завантаження зображень та їх пірамід перегляду.
+ */
+class ImageLoader : public QObject {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Конструктор.
+     * @param parent Батьківський об'єкт.
+     */
+    explicit ImageLoader(QObject* parent = nullptr);
+
+    /**
+     * @brief Деструктор.
+     *
+     * Скасовує запити в черзі та чекає завершення поточних.
+     */
+    ~ImageLoader();
+
+    /**
+     * @brief Запит попереднього перегляду (зменшене декодування).
+     *
+     * @param path Шлях до файлу.
+     * @return Номер запиту (для previewReady або loadFailed).
+     */
+    int requestPreview(const QString& path);
+
+    /**
+     * @brief Запит повного зображення разом з пірамідою перегляду.
+     *
+     * @param path Шлях до файлу.
+     * @return Номер запиту (для imageReady або loadFailed).
+     */
+    int requestImage(const QString& path);
+
+signals:
+    /**
+     * @brief Попередній перегляд готовий.
+     * @param requestId Номер запиту.
+     * @param path Шлях до файлу.
+     * @param preview Піраміда перегляду (з розміром повного зображення).
+     */
+    void previewReady(int requestId, const QString& path, const ImagePreview& preview);
+
+    /**
+     * @brief Повне зображення готове.
+     * @param requestId Номер запиту.
+     * @param path Шлях до файлу.
+     * @param image Повне зображення.
+     * @param preview Піраміда перегляду.
+     */
+    void imageReady(int requestId, const QString& path, const QImage& image,
+                    const ImagePreview& preview);
+
+    /**
+     * @brief Не вдалося прочитати файл.
+     * @param requestId Номер запиту.
+     * @param path Шлях до файлу.
+     */
+    void loadFailed(int requestId, const QString& path);
+
+private:
+    /**
+     * @brief Декодування в робочому потоці та надсилання результату.
+     *
+     * @param requestId Номер запиту.
+     * @param path Шлях до файлу.
+     * @param full true - повне зображення, false - зменшене до ImagePreview::MAX_SIDE.
+     */
+    void load(int requestId, const QString& path, bool full);
+
+    QThreadPool pool;      ///< Потоки декодування.
+    int lastRequestId;     ///< Номер останнього запиту.
+};
+
+#endif // IMAGELOADER_H
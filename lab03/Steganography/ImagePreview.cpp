@@ -0,0 +1,93 @@
+/*
+ * ImagePreview.cpp
+ *
+ * Реалізація піраміди попереднього перегляду зображення.
+ */
+
+#include "ImagePreview.h"
+
+/**
+ * @brief Побудова піраміди із зображення.
+ *
+ * @param image Зображення.
+ * @param fullSize Розмір повного зображення.
+ * @return Піраміда.
+ */
+ImagePreview ImagePreview::fromImage(const QImage& image, const QSize& fullSize) {
+    ImagePreview preview;
+    if (image.isNull()) {
+        return preview;
+    }
+
+    preview.originalSize = fullSize.isValid() ? fullSize : image.size();
+
+    // Формати з 32 бітами на піксель масштабуються та конвертуються в
+    // QPixmap найшвидше.
+    QImage base = image.convertToFormat(image.hasAlphaChannel()
+                                            ? QImage::Format_ARGB32_Premultiplied
+                                            : QImage::Format_RGB32);
+    if (qMax(base.width(), base.height()) > MAX_SIDE) {
+        base = base.scaled(MAX_SIDE, MAX_SIDE, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    preview.levels.append(base);
+
+    // Кожен наступний рівень удвічі менший (сума рівнів < 4/3 базового).
+    while (qMax(preview.levels.last().width(), preview.levels.last().height()) / 2 >= MIN_SIDE) {
+        const QImage& previous = preview.levels.last();
+        const QSize half(qMax(1, previous.width() / 2), qMax(1, previous.height() / 2));
+        preview.levels.append(previous.scaled(half, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    }
+
+    return preview;
+}
+
+/**
+ * @brief Чи порожня піраміда.
+ * @return true якщо рівнів немає.
+ */
+bool ImagePreview::isNull() const {
+    return levels.isEmpty();
+}
+
+/**
+ * @brief Розмір повного зображення.
+ * @return Ширина та висота в пікселях.
+ */
+QSize ImagePreview::fullSize() const {
+    return originalSize;
+}
+
+/**
+ * @brief Кількість рівнів піраміди.
+ * @return Кількість рівнів.
+ */
+int ImagePreview::levelCount() const {
+    return levels.size();
+}
+
+/**
+ * @brief Зображення, вписане в прямокутник.
+ *
+ * @param box Прямокутник (розмір мітки).
+ * @return Зображення зі збереженими пропорціями.
+ */
+QImage ImagePreview::scaled(const QSize& box) const {
+    if (levels.isEmpty() || box.isEmpty()) {
+        return QImage();
+    }
+
+    const QSize target = levels.first().size().scaled(box, Qt::KeepAspectRatio);
+
+    // Найменший рівень, з якого ще можна зменшувати без втрати якості.
+    int level = 0;
+    while (level + 1 < levels.size() &&
+           levels[level + 1].width() >= target.width() &&
+           levels[level + 1].height() >= target.height()) {
+        ++level;
+    }
+
+    if (levels[level].size() == target) {
+        return levels[level];
+    }
+    return levels[level].scaled(target, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+}
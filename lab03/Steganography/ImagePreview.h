@@ -0,0 +1,88 @@
+/*
+ * ImagePreview.h
+ *
+ * Заголовочний файл піраміди попереднього перегляду зображення.
+ * Зберігає зменшену копію зображення та її половинні рівні (mip-рівні),
+ * щоб мітки будь-якого розміру масштабувались з найближчого рівня,
+ * а не з повного зображення.
+ *
+ * Основні можливості:
+ * - Базовий рівень не більший за MAX_SIDE пікселів по довшій стороні.
+ * - Кожен наступний рівень удвічі менший за попередній.
+ * - Розмір повного зображення зберігається окремо (для розрахунку ємності).
+ */
+
+#ifndef IMAGEPREVIEW_H
+#define IMAGEPREVIEW_H
+
+#include <QImage>
+#include <QSize>
+#include <QVector>
+
+/**
+ * @class ImagePreview
+ * @brief Піраміда попереднього перегляду одного зображення.
+ *
+ * Значення незмінне після створення (QImage розділяє дані неявно),
+ * тому його дешево копіювати між потоками та зберігати у вікні.
+ */
+class ImagePreview {
+public:
+    /// Максимальна довша сторона базового рівня.
+    static constexpr int MAX_SIDE = 1024;
+
+    /// Найменша довша сторона рівня (менші рівні не будуються).
+    static constexpr int MIN_SIDE = 32;
+
+    /**
+     * @brief Конструктор порожньої піраміди.
+     */
+    ImagePreview() = default;
+
+    /**
+     * @brief Побудова піраміди із зображення.
+     *
+     * Зображення, більше за MAX_SIDE, спершу один раз зменшується;
+     * далі кожен рівень отримується з попереднього.
+     *
+     * @param image Повне або вже зменшене (QImageReader::setScaledSize) зображення.
+     * @param fullSize Розмір повного зображення (порожній - розмір image).
+     * @return Піраміда.
+     */
+    static ImagePreview fromImage(const QImage& image, const QSize& fullSize = QSize());
+
+    /**
+     * @brief Чи порожня піраміда.
+     * @return true якщо рівнів немає.
+     */
+    bool isNull() const;
+
+    /**
+     * @brief Розмір повного зображення.
+     * @return Ширина та висота в пікселях.
+     */
+    QSize fullSize() const;
+
+    /**
+     * @brief Кількість рівнів піраміди.
+     * @return Кількість рівнів.
+     */
+    int levelCount() const;
+
+    /**
+     * @brief Зображення, вписане в прямокутник.
+     *
+     * Масштабується найменший рівень, що не менший за результат,
+     * тому робота пропорційна розміру мітки, а не зображення.
+     *
+     * @param box Прямокутник (розмір мітки).
+     * @return Зображення зі збереженими пропорціями.
+     */
+    QImage scaled(const QSize& box) const;
+
+private:
+    QVector<QImage> levels;   ///< Рівні від найбільшого до найменшого.
+    QSize originalSize;       ///< Розмір повного зображення.
+};
+
+#endif // IMAGEPREVIEW_H
@@ -0,0 +1,615 @@
+/*
+ * ImageStripReader.cpp
+ *
+ * Реалізація послідовного читання зображення смугами рядків.
+ * Містить потокові декодери PNG (zlib) та базового JPEG (libjpeg).
+ */
+
+#include "ImageStripReader.h"
+#include "JpegErrorManager.h"
+#include <QDebug>
+#include <QtEndian>
+#include <cstring>
+#include <jerror.h>
+#include <zlib.h>
+
+/// Сигнатура файлу PNG.
+static const char PNG_SIGNATURE[8] = {'\x89', 'P', 'N', 'G', '\r', '\n', '\x1a', '\n'};
+
+/// Розмір фрагмента стиснутих даних, що читається за раз.
+static const qint64 INPUT_CHUNK_SIZE = 64 * 1024;
+
+/**
+ * @struct JpegStripState
+ * @brief Стан потокового декодера JPEG.
+ *
+ * Зберігається в купі: після longjmp локальні змінні, змінені
+ * після setjmp, мають невизначені значення.
+ */
+struct JpegStripState {
+    jpeg_decompress_struct decoder;      ///< Декодер libjpeg.
+    JpegErrorManager errors;             ///< Обробник помилок декодера.
+    jpeg_source_mgr source;              ///< Джерело даних з файлу.
+    QFile* file = nullptr;               ///< Файл JPEG.
+    QByteArray* input = nullptr;         ///< Буфер стиснутих даних.
+    QByteArray row;                      ///< Рядок пікселів libjpeg (RGB або сірий).
+    bool created = false;                ///< Чи створено декодер.
+};
+
+/* ============================================================================
+ *                          ДЖЕРЕЛО ДАНИХ LIBJPEG
+ * ============================================================================
+ */
+
+/// Маркер кінця зображення, що підставляється при обриві файлу.
+static const JOCTET JPEG_FAKE_EOI[2] = {0xFF, JPEG_EOI};
+
+/**
+ * @brief Початок читання (нічого не потрібно).
+ */
+static void jpegInitSource(j_decompress_ptr) {
+}
+
+/**
+ * @brief Читання наступного фрагмента файлу.
+ *
+ * При обриві файлу підставляється маркер EOI, як у jpeg_stdio_src:
+ * libjpeg видає попередження, а відсутні рядки будуть сірими.
+ */
+static boolean jpegFillInput(j_decompress_ptr info) {
+    JpegStripState* state = static_cast<JpegStripState*>(info->client_data);
+    *state->input = state->file->read(INPUT_CHUNK_SIZE);
+
+    if (state->input->isEmpty()) {
+        WARNMS(info, JWRN_JPEG_EOF);
+        state->source.next_input_byte = JPEG_FAKE_EOI;
+        state->source.bytes_in_buffer = 2;
+    } else {
+        state->source.next_input_byte = reinterpret_cast<const JOCTET*>(state->input->constData());
+        state->source.bytes_in_buffer = size_t(state->input->size());
+    }
+    return TRUE;
+}
+
+/**
+ * @brief Пропуск даних (маркери, що не потрібні декодеру).
+ */
+static void jpegSkipInput(j_decompress_ptr info, long count) {
+    jpeg_source_mgr* source = info->src;
+    while (count > long(source->bytes_in_buffer)) {
+        count -= long(source->bytes_in_buffer);
+        jpegFillInput(info);
+    }
+    if (count > 0) {
+        source->next_input_byte += count;
+        source->bytes_in_buffer -= size_t(count);
+    }
+}
+
+/**
+ * @brief Завершення читання (нічого не потрібно).
+ */
+static void jpegTermSource(j_decompress_ptr) {
+}
+
+/* ============================================================================
+ *                      КОНСТРУКТОР ТА ДЕСТРУКТОР
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор.
+ * @param fileName Шлях до файлу зображення.
+ */
+ImageStripReader::ImageStripReader(const QString& fileName)
+    : fileName(fileName) {
+}
+
+/**
+ * @brief Деструктор.
+ */
+ImageStripReader::~ImageStripReader() {
+    if (inflater) {
+        inflateEnd(inflater);
+        delete inflater;
+    }
+    if (jpeg) {
+        if (jpeg->created) {
+            jpeg_destroy_decompress(&jpeg->decoder);
+        }
+        delete jpeg;
+    }
+}
+
+/* ============================================================================
+ *                          ВІДКРИТТЯ ТА ЧИТАННЯ
+ * ============================================================================
+ */
+
+/**
+ * @brief Відкриття файлу та зчитування розмірів.
+ *
+ * Спочатку пробуємо потоковий декодер PNG, потім - JPEG.
+ * Інші формати смугами не читаються: повне декодування заради
+ * кожної смуги (або одне, але з усім зображенням у пам'яті)
+ * суперечить призначенню поблокової обробки.
+ *
+ * @return true якщо файл можна читати смугами.
+ */
+bool ImageStripReader::open() {
+    nextRow = 0;
+
+    if (openPng()) {
+        streamingPng = true;
+        return true;
+    }
+    streamingPng = false;
+
+    if (!error.isEmpty()) {
+        return false;
+    }
+    if (openJpeg()) {
+        return true;
+    }
+
+    if (error.isEmpty()) {
+        error = "Only non-interlaced PNG and baseline JPEG can be read in strips";
+    }
+    return false;
+}
+
+/**
+ * @brief Розмір зображення.
+ * @return Ширина та висота в пікселях.
+ */
+QSize ImageStripReader::size() const {
+    return imageSize;
+}
+
+/**
+ * @brief Номер наступного рядка для читання.
+ * @return Кількість вже прочитаних рядків.
+ */
+int ImageStripReader::currentRow() const {
+    return nextRow;
+}
+
+/**
+ * @brief Опис останньої помилки.
+ * @return Текст помилки.
+ */
+QString ImageStripReader::errorString() const {
+    return error;
+}
+
+/**
+ * @brief Читання наступної смуги.
+ *
+ * @param rows Бажана кількість рядків.
+ * @return Смуга у форматі RGB32 або порожнє зображення.
+ */
+QImage ImageStripReader::readStrip(int rows) {
+    const int width = imageSize.width();
+    const int height = imageSize.height();
+
+    if (nextRow >= height || rows <= 0) {
+        return QImage();
+    }
+    rows = qMin(rows, height - nextRow);
+
+    QImage strip;
+
+    if (streamingPng) {
+        // ========== Потоковий PNG: рядок за рядком ==========
+        strip = QImage(width, rows, QImage::Format_RGB32);
+
+        for (int y = 0; y < rows; ++y) {
+            uchar* line = reinterpret_cast<uchar*>(currentLine.data());
+            uchar* previous = reinterpret_cast<uchar*>(previousLine.data()) + 1;
+
+            if (!inflateRow(line) || !unfilterRow(line[0], line + 1, previous)) {
+                return QImage();
+            }
+
+            convertRow(line + 1, reinterpret_cast<QRgb*>(strip.scanLine(y)));
+
+            // Поточний рядок стає попереднім для наступного.
+            currentLine.swap(previousLine);
+        }
+    } else {
+        // ========== Потоковий JPEG: наступні рядки libjpeg ==========
+        strip = QImage(width, rows, QImage::Format_RGB32);
+        if (!readJpegRows(strip)) {
+            return QImage();
+        }
+    }
+
+    nextRow += rows;
+    return strip;
+}
+
+/* ============================================================================
+ *                          ПОТОКОВИЙ ДЕКОДЕР PNG
+ * ============================================================================
+ */
+
+/**
+ * @brief Розбір сигнатури та заголовних блоків PNG до першого IDAT.
+ *
+ * Підтримуються всі типи кольору та глибини без інтерлейсу.
+ * Блоки, що не впливають на пікселі (gAMA, tEXt тощо), пропускаються.
+ *
+ * @return true якщо PNG підтримується потоковим декодером.
+ */
+bool ImageStripReader::openPng() {
+    file.setFileName(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = file.errorString();
+        return false;
+    }
+
+    // ========== КРОК 1: Сигнатура ==========
+    if (file.read(8) != QByteArray(PNG_SIGNATURE, 8)) {
+        return false;
+    }
+
+    // ========== КРОК 2: Блоки до першого IDAT ==========
+    bool headerFound = false;
+
+    for (;;) {
+        const QByteArray chunkHeader = file.read(8);
+        if (chunkHeader.size() != 8) {
+            error = "Unexpected end of PNG file";
+            return false;
+        }
+
+        const quint32 length = qFromBigEndian<quint32>(chunkHeader.constData());
+        const QByteArray type = chunkHeader.mid(4, 4);
+
+        if (type == "IDAT") {
+            if (!headerFound) {
+                return false;
+            }
+            chunkRemaining = length;
+            break;
+        }
+
+        const QByteArray data = file.read(length);
+        file.read(4);  // CRC блока.
+        if (data.size() != qsizetype(length)) {
+            error = "Unexpected end of PNG file";
+            return false;
+        }
+
+        if (type == "IHDR" && length >= 13) {
+            const uchar* ihdr = reinterpret_cast<const uchar*>(data.constData());
+            imageSize = QSize(int(qFromBigEndian<quint32>(ihdr)),
+                              int(qFromBigEndian<quint32>(ihdr + 4)));
+            bitDepth = ihdr[8];
+            colorType = ihdr[9];
+
+            // Інтерлейс (Adam7) не можна декодувати рядок за рядком.
+            if (ihdr[12] != 0) {
+                return false;
+            }
+            headerFound = true;
+        } else if (type == "PLTE") {
+            palette.clear();
+            for (int i = 0; i + 2 < data.size(); i += 3) {
+                palette.append(qRgb(uchar(data[i]), uchar(data[i + 1]), uchar(data[i + 2])));
+            }
+        } else if (type == "IEND") {
+            return false;
+        }
+    }
+
+    // ========== КРОК 3: Параметри рядка ==========
+    switch (colorType) {
+    case 0: channels = 1; break;  // Відтінки сірого.
+    case 2: channels = 3; break;  // RGB.
+    case 3: channels = 1; break;  // Палітра.
+    case 4: channels = 2; break;  // Сірий + альфа.
+    case 6: channels = 4; break;  // RGBA.
+    default: return false;
+    }
+
+    if (imageSize.isEmpty() || (bitDepth < 8 && colorType != 0 && colorType != 3)) {
+        return false;
+    }
+
+    const int bitsPerPixel = channels * bitDepth;
+    rowBytes = (qsizetype(imageSize.width()) * bitsPerPixel + 7) / 8;
+    pixelBytes = qMax(1, bitsPerPixel / 8);
+
+    // Обидва рядки мають байт фільтра на початку; попередній спочатку нульовий.
+    currentLine = QByteArray(rowBytes + 1, 0);
+    previousLine = QByteArray(rowBytes + 1, 0);
+
+    // ========== КРОК 4: Ініціалізація zlib ==========
+    inflater = new z_stream_s;
+    std::memset(inflater, 0, sizeof(z_stream_s));
+    if (inflateInit(inflater) != Z_OK) {
+        delete inflater;
+        inflater = nullptr;
+        error = "Cannot initialize zlib";
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Читання наступного стиснутого фрагмента з блоків IDAT.
+ *
+ * Стиснутий потік може бути розбитий на кілька послідовних блоків IDAT.
+ *
+ * @return true якщо дані отримано.
+ */
+bool ImageStripReader::fillInput() {
+    while (chunkRemaining == 0) {
+        file.read(4);  // CRC попереднього IDAT.
+        const QByteArray chunkHeader = file.read(8);
+        if (chunkHeader.size() != 8 || chunkHeader.mid(4, 4) != "IDAT") {
+            error = "Unexpected end of PNG image data";
+            return false;
+        }
+        chunkRemaining = qFromBigEndian<quint32>(chunkHeader.constData());
+    }
+
+    const qint64 size = qMin<qint64>(chunkRemaining, INPUT_CHUNK_SIZE);
+    input = file.read(size);
+    if (input.size() != size) {
+        error = "Unexpected end of PNG file";
+        return false;
+    }
+    chunkRemaining -= quint32(size);
+
+    inflater->next_in = reinterpret_cast<Bytef*>(input.data());
+    inflater->avail_in = uInt(size);
+    return true;
+}
+
+/**
+ * @brief Розпакування одного рядка PNG (байт фільтра + дані).
+ * @param row Буфер рядка розміром rowBytes + 1.
+ * @return true у разі успіху.
+ */
+bool ImageStripReader::inflateRow(uchar* row) {
+    inflater->next_out = row;
+    inflater->avail_out = uInt(rowBytes + 1);
+
+    while (inflater->avail_out > 0) {
+        if (inflater->avail_in == 0 && !fillInput()) {
+            return false;
+        }
+
+        const int status = inflate(inflater, Z_NO_FLUSH);
+        if (status == Z_STREAM_END) {
+            return inflater->avail_out == 0;
+        }
+        if (status != Z_OK && status != Z_BUF_ERROR) {
+            error = "Corrupted PNG image data";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Скасування фільтра рядка PNG на місці.
+ *
+ * Фільтри PNG: 0 - None, 1 - Sub, 2 - Up, 3 - Average, 4 - Paeth.
+ *
+ * @param filter Тип фільтра.
+ * @param row Дані рядка.
+ * @param previous Попередній рядок (без фільтра).
+ * @return true якщо тип фільтра коректний.
+ */
+bool ImageStripReader::unfilterRow(int filter, uchar* row, const uchar* previous) {
+    const qsizetype bpp = pixelBytes;
+
+    switch (filter) {
+    case 0:
+        break;
+    case 1:
+        for (qsizetype i = bpp; i < rowBytes; ++i) {
+            row[i] = uchar(row[i] + row[i - bpp]);
+        }
+        break;
+    case 2:
+        for (qsizetype i = 0; i < rowBytes; ++i) {
+            row[i] = uchar(row[i] + previous[i]);
+        }
+        break;
+    case 3:
+        for (qsizetype i = 0; i < rowBytes; ++i) {
+            const int left = i >= bpp ? row[i - bpp] : 0;
+            row[i] = uchar(row[i] + ((left + previous[i]) >> 1));
+        }
+        break;
+    case 4:
+        for (qsizetype i = 0; i < rowBytes; ++i) {
+            const int a = i >= bpp ? row[i - bpp] : 0;
+            const int b = previous[i];
+            const int c = i >= bpp ? previous[i - bpp] : 0;
+            const int p = a + b - c;
+            const int pa = qAbs(p - a);
+            const int pb = qAbs(p - b);
+            const int pc = qAbs(p - c);
+            const int predictor = (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+            row[i] = uchar(row[i] + predictor);
+        }
+        break;
+    default:
+        error = "Invalid PNG filter type";
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Перетворення рядка PNG у пікселі RGB32.
+ *
+ * 16-бітні канали зводяться до 8 біт з округленням, альфа-канал
+ * відкидається (як при QImage::convertToFormat(Format_RGB32)).
+ *
+ * @param row Дані рядка без фільтра.
+ * @param out Вихідний рядок RGB32.
+ */
+void ImageStripReader::convertRow(const uchar* row, QRgb* out) const {
+    const int width = imageSize.width();
+
+    // ========== Глибина менше 8 біт (сірий або палітра) ==========
+    if (bitDepth < 8) {
+        const int maxValue = (1 << bitDepth) - 1;
+        for (int x = 0; x < width; ++x) {
+            const int bitOffset = x * bitDepth;
+            const int value = (row[bitOffset >> 3] >> (8 - bitDepth - (bitOffset & 7))) & maxValue;
+            if (colorType == 3) {
+                out[x] = value < palette.size() ? palette[value] : qRgb(0, 0, 0);
+            } else {
+                const int gray = value * 255 / maxValue;
+                out[x] = qRgb(gray, gray, gray);
+            }
+        }
+        return;
+    }
+
+    // ========== 8 або 16 біт на канал ==========
+    const int sampleBytes = bitDepth / 8;
+    const int stride = channels * sampleBytes;
+
+    // Значення каналу 0-255 (16 біт ділиться на 257 з округленням, як у Qt).
+    auto sample = [sampleBytes](const uchar* data) {
+        if (sampleBytes == 1) {
+            return int(data[0]);
+        }
+        const int value = (data[0] << 8) | data[1];
+        return (value - (value >> 8) + 0x80) >> 8;
+    };
+
+    for (int x = 0; x < width; ++x) {
+        const uchar* pixel = row + qsizetype(x) * stride;
+        switch (colorType) {
+        case 0:
+        case 4: {
+            const int gray = sample(pixel);
+            out[x] = qRgb(gray, gray, gray);
+            break;
+        }
+        case 2:
+        case 6:
+            out[x] = qRgb(sample(pixel), sample(pixel + sampleBytes),
+                          sample(pixel + 2 * sampleBytes));
+            break;
+        case 3:
+            out[x] = pixel[0] < palette.size() ? palette[pixel[0]] : qRgb(0, 0, 0);
+            break;
+        }
+    }
+}
+
+/* ============================================================================
+ *                          ПОТОКОВИЙ ДЕКОДЕР JPEG
+ * ============================================================================
+ */
+
+/**
+ * @brief Початок декодування JPEG (заголовок і параметри виводу).
+ *
+ * Прогресивний JPEG libjpeg декодує лише з коефіцієнтами всього
+ * зображення в пам'яті, CMYK/YCCK не перетворюються в RGB,
+ * тому такі файли потоковим декодером не читаються.
+ *
+ * @return true якщо JPEG підтримується потоковим декодером.
+ */
+bool ImageStripReader::openJpeg() {
+    // ========== КРОК 1: Сигнатура (маркер SOI) ==========
+    // Файл уже відкрито для перевірки сигнатури PNG.
+    file.seek(0);
+    if (file.read(2) != QByteArray("\xFF\xD8", 2)) {
+        return false;
+    }
+    file.seek(0);
+
+    // ========== КРОК 2: Декодер з джерелом із файлу ==========
+    jpeg = new JpegStripState;
+    jpeg->file = &file;
+    jpeg->input = &input;
+
+    jpeg_decompress_struct& decoder = jpeg->decoder;
+    decoder.err = initErrorManager(jpeg->errors);
+    if (setjmp(jpeg->errors.jump)) {
+        error = QString::fromLatin1(jpeg->errors.message);
+        return false;
+    }
+
+    jpeg_create_decompress(&decoder);
+    jpeg->created = true;
+    decoder.client_data = jpeg;
+
+    jpeg->source.init_source = jpegInitSource;
+    jpeg->source.fill_input_buffer = jpegFillInput;
+    jpeg->source.skip_input_data = jpegSkipInput;
+    jpeg->source.resync_to_restart = jpeg_resync_to_restart;
+    jpeg->source.term_source = jpegTermSource;
+    jpeg->source.next_input_byte = nullptr;
+    jpeg->source.bytes_in_buffer = 0;
+    decoder.src = &jpeg->source;
+
+    // ========== КРОК 3: Заголовок ==========
+    jpeg_read_header(&decoder, TRUE);
+    if (decoder.progressive_mode) {
+        error = "Progressive JPEG cannot be read in strips";
+        return false;
+    }
+    if (decoder.jpeg_color_space == JCS_CMYK || decoder.jpeg_color_space == JCS_YCCK) {
+        error = "CMYK JPEG cannot be read in strips";
+        return false;
+    }
+
+    // ========== КРОК 4: Параметри виводу ==========
+    decoder.out_color_space = decoder.jpeg_color_space == JCS_GRAYSCALE ? JCS_GRAYSCALE : JCS_RGB;
+    jpeg_start_decompress(&decoder);
+
+    imageSize = QSize(int(decoder.output_width), int(decoder.output_height));
+    jpeg->row = QByteArray(qsizetype(decoder.output_width) * decoder.output_components, '\0');
+    return true;
+}
+
+/**
+ * @brief Декодування наступних рядків JPEG у смугу.
+ *
+ * Декодер продовжує з місця, де зупинився, тому кожен рядок
+ * файлу декодується рівно один раз.
+ *
+ * @param strip Смуга RGB32 потрібного розміру.
+ * @return true у разі успіху.
+ */
+bool ImageStripReader::readJpegRows(QImage& strip) {
+    jpeg_decompress_struct& decoder = jpeg->decoder;
+    if (setjmp(jpeg->errors.jump)) {
+        error = QString::fromLatin1(jpeg->errors.message);
+        return false;
+    }
+
+    const int width = strip.width();
+    const bool gray = decoder.output_components == 1;
+
+    for (int y = 0; y < strip.height(); ++y) {
+        JSAMPROW line = reinterpret_cast<JSAMPROW>(jpeg->row.data());
+        if (jpeg_read_scanlines(&decoder, &line, 1) != 1) {
+            error = "Unexpected end of JPEG image data";
+            return false;
+        }
+
+        QRgb* out = reinterpret_cast<QRgb*>(strip.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            out[x] = gray ? qRgb(line[x], line[x], line[x])
+                          : qRgb(line[3 * x], line[3 * x + 1], line[3 * x + 2]);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,163 @@
+/*
+ * ImageStripReader.h
+ *
+ * Заголовочний файл послідовного читання зображення смугами рядків.
+ * Дозволяє обробляти зображення, що не вміщуються в пам'ять повністю.
+ *
+ * Основні можливості:
+ * - Потокове декодування PNG (рядок за рядком, zlib).
+ * - Потокове декодування базового JPEG (рядок за рядком, libjpeg).
+ * - Кожна смуга повертається у форматі RGB32.
+ */
+
+#ifndef IMAGESTRIPREADER_H
+#define IMAGESTRIPREADER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QImage>
+#include <QFile>
+#include <QSize>
+#include <QVector>
+
+struct z_stream_s;
+struct JpegStripState;
+
+/**
+ * @class ImageStripReader
+ * @brief Послідовне читання зображення смугами рядків.
+ *
+ * Для неінтерлейсних PNG використовується власний потоковий декодер:
+ * у пам'яті знаходяться лише поточний і попередній рядки та смуга,
+ * що повертається. Базовий (не прогресивний) JPEG декодується libjpeg
+ * рядок за рядком з того самого місця файлу, тому кожен рядок
+ * декодується один раз.
+ *
+ * Інші формати (TIFF, BMP, прогресивний JPEG тощо) Qt не вміє читати
+ * частинами без повного декодування, тому open() для них повертає false;
+ * такі файли обробляються звичайним (не поблоковим) шляхом.
+ */
+class ImageStripReader {
+public:
+    /**
+     * @brief Конструктор.
+     * @param fileName Шлях до файлу зображення.
+     */
+    explicit ImageStripReader(const QString& fileName);
+
+    /**
+     * @brief Деструктор.
+     *
+     * Звільняє стан декодерів zlib та libjpeg.
+     */
+    ~ImageStripReader();
+
+    /**
+     * @brief Відкриття файлу та зчитування розмірів.
+     * @return true якщо файл можна читати смугами (PNG без інтерлейсу або базовий JPEG).
+     */
+    bool open();
+
+    /**
+     * @brief Розмір зображення.
+     * @return Ширина та висота в пікселях.
+     */
+    QSize size() const;
+
+    /**
+     * @brief Номер наступного рядка для читання.
+     * @return Кількість вже прочитаних рядків.
+     */
+    int currentRow() const;
+
+    /**
+     * @brief Читання наступної смуги.
+     *
+     * @param rows Бажана кількість рядків (остання смуга може бути меншою).
+     * @return Смуга у форматі RGB32 або порожнє зображення при помилці/кінці.
+     */
+    QImage readStrip(int rows);
+
+    /**
+     * @brief Опис останньої помилки.
+     * @return Текст помилки.
+     */
+    QString errorString() const;
+
+private:
+    // ========== Потоковий декодер PNG ==========
+
+    /**
+     * @brief Розбір сигнатури та заголовних блоків PNG до першого IDAT.
+     * @return true якщо PNG підтримується потоковим декодером.
+     */
+    bool openPng();
+
+    /**
+     * @brief Читання наступного стиснутого фрагмента з блоків IDAT.
+     * @return true якщо дані отримано.
+     */
+    bool fillInput();
+
+    /**
+     * @brief Розпакування одного рядка PNG (байт фільтра + дані).
+     * @param row Буфер рядка розміром rowBytes + 1.
+     * @return true у разі успіху.
+     */
+    bool inflateRow(uchar* row);
+
+    /**
+     * @brief Скасування фільтра рядка PNG на місці.
+     * @param filter Тип фільтра (0-4).
+     * @param row Дані рядка.
+     * @param previous Попередній рядок (без фільтра).
+     * @return true якщо тип фільтра коректний.
+     */
+    bool unfilterRow(int filter, uchar* row, const uchar* previous);
+
+    /**
+     * @brief Перетворення рядка PNG у пікселі RGB32.
+     * @param row Дані рядка без фільтра.
+     * @param out Вихідний рядок RGB32.
+     */
+    void convertRow(const uchar* row, QRgb* out) const;
+
+    // ========== Потоковий декодер JPEG ==========
+
+    /**
+     * @brief Початок декодування JPEG (заголовок і параметри виводу).
+     * @return true якщо JPEG підтримується потоковим декодером.
+     */
+    bool openJpeg();
+
+    /**
+     * @brief Декодування наступних рядків JPEG у смугу.
+     * @param strip Смуга RGB32 потрібного розміру.
+     * @return true у разі успіху.
+     */
+    bool readJpegRows(QImage& strip);
+
+    // ========== Дані ==========
+    QString fileName;          ///< Шлях до файлу.
+    QString error;             ///< Опис останньої помилки.
+    QSize imageSize;           ///< Розмір зображення.
+    int nextRow = 0;           ///< Наступний рядок для читання.
+    bool streamingPng = false; ///< Чи використовується потоковий декодер PNG.
+
+    QFile file;                       ///< Файл PNG або JPEG.
+    z_stream_s* inflater = nullptr;   ///< Стан розпакування zlib.
+    QByteArray input;                 ///< Буфер стиснутих даних (PNG та JPEG).
+    quint32 chunkRemaining = 0;       ///< Залишок даних поточного IDAT.
+    int bitDepth = 0;                 ///< Глибина кольору PNG (біт на канал).
+    int colorType = 0;                ///< Тип кольору PNG.
+    int channels = 0;                 ///< Кількість каналів.
+    int pixelBytes = 0;               ///< Байтів на піксель для фільтрів (мін. 1).
+    qsizetype rowBytes = 0;           ///< Байтів у рядку без байта фільтра.
+    QByteArray currentLine;           ///< Поточний рядок (байт фільтра + дані).
+    QByteArray previousLine;          ///< Попередній рядок без фільтра.
+    QVector<QRgb> palette;            ///< Палітра (тип кольору 3).
+
+    JpegStripState* jpeg = nullptr;   ///< Стан декодера libjpeg (потоковий JPEG).
+};
+
+#endif // IMAGESTRIPREADER_H
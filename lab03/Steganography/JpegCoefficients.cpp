@@ -0,0 +1,308 @@
+/*
+ * JpegCoefficients.cpp
+ *
+ * Реалізація читання та запису коефіцієнтів DCT через libjpeg.
+ * Помилки libjpeg перехоплюються через setjmp/longjmp (JpegErrorManager.h).
+ */
+
+#include "JpegCoefficients.h"
+#include "JpegErrorManager.h"
+#include <QFile>
+#include <QSaveFile>
+#include <cstdlib>
+#include <cstring>
+
+static_assert(sizeof(JCOEF) == sizeof(qint16), "JCOEF must be 16-bit");
+static_assert(DCTSIZE2 == JpegCoefficients::BLOCK_COEFFICIENTS, "DCT block must be 8x8");
+
+/// Максимальна довжина даних маркера APPn/COM.
+static const unsigned int MAX_MARKER_LENGTH = 0xFFFF;
+
+/**
+ * @struct JpegState
+ * @brief Стан декодера, потрібний до запису (таблиці та віртуальні масиви).
+ */
+struct JpegState {
+    jpeg_decompress_struct decoder;      ///< Декодер libjpeg.
+    JpegErrorManager errors;             ///< Обробник помилок декодера.
+    jvirt_barray_ptr* arrays = nullptr;  ///< Коефіцієнти компонентів (libjpeg).
+    QByteArray source;                   ///< Вміст файлу (джерело декодера).
+    bool created = false;                ///< Чи створено декодер.
+};
+
+/**
+ * @struct JpegEncoderState
+ * @brief Стан кодера під час запису.
+ *
+ * Локальні змінні, змінені після setjmp, після longjmp мають невизначені
+ * значення. Кодер і буфер (libjpeg перевиділяє його через вказівник)
+ * змінюються під час кодування, тому зберігаються в купі.
+ */
+struct JpegEncoderState {
+    jpeg_compress_struct encoder;        ///< Кодер libjpeg.
+    JpegErrorManager errors;             ///< Обробник помилок кодера.
+    unsigned char* buffer = nullptr;     ///< Закодований файл (виділяє libjpeg).
+    unsigned long bufferSize = 0;        ///< Розмір закодованого файлу.
+    bool created = false;                ///< Чи створено кодер.
+};
+
+/**
+ * @brief Знищення кодера та звільнення буфера.
+ * @param encoderState Стан кодера.
+ */
+static void destroyEncoder(JpegEncoderState* encoderState) {
+    if (encoderState->created) {
+        jpeg_destroy_compress(&encoderState->encoder);
+    }
+    free(encoderState->buffer);
+    delete encoderState;
+}
+
+/* ============================================================================
+ *                      КОНСТРУКТОР ТА ДЕСТРУКТОР
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор.
+ * @param fileName Шлях до файлу JPEG.
+ */
+JpegCoefficients::JpegCoefficients(const QString& fileName)
+    : fileName(fileName) {
+}
+
+/**
+ * @brief Деструктор.
+ */
+JpegCoefficients::~JpegCoefficients() {
+    if (state) {
+        if (state->created) {
+            jpeg_destroy_decompress(&state->decoder);
+        }
+        delete state;
+    }
+}
+
+/* ============================================================================
+ *                          ЧИТАННЯ ТА ЗАПИС
+ * ============================================================================
+ */
+
+/**
+ * @brief Читання коефіцієнтів з файлу.
+ *
+ * Алгоритм:
+ * 1. Зчитуємо файл у пам'ять (шляхи Unicode обробляє QFile).
+ * 2. Зберігаємо маркери APPn та COM для запису в результат.
+ * 3. jpeg_read_coefficients() декодує лише коди Хаффмана.
+ * 4. Копіюємо коефіцієнти у суцільний масив.
+ *
+ * @return true у разі успіху.
+ */
+bool JpegCoefficients::read() {
+    if (state) {
+        error = "File is already read";
+        return false;
+    }
+
+    // ========== КРОК 1: Вміст файлу ==========
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = file.errorString();
+        return false;
+    }
+
+    state = new JpegState;
+    state->source = file.readAll();
+    if (state->source.isEmpty()) {
+        error = "Empty file";
+        return false;
+    }
+
+    jpeg_decompress_struct& decoder = state->decoder;
+    decoder.err = initErrorManager(state->errors);
+    if (setjmp(state->errors.jump)) {
+        error = QString::fromLatin1(state->errors.message);
+        return false;
+    }
+
+    jpeg_create_decompress(&decoder);
+    state->created = true;
+    jpeg_mem_src(&decoder, reinterpret_cast<unsigned char*>(state->source.data()),
+                 static_cast<unsigned long>(state->source.size()));
+
+    // ========== КРОК 2: Маркери ==========
+    jpeg_save_markers(&decoder, JPEG_COM, MAX_MARKER_LENGTH);
+    for (int i = 0; i < 16; ++i) {
+        jpeg_save_markers(&decoder, JPEG_APP0 + i, MAX_MARKER_LENGTH);
+    }
+
+    // ========== КРОК 3: Коефіцієнти ==========
+    jpeg_read_header(&decoder, TRUE);
+    state->arrays = jpeg_read_coefficients(&decoder);
+
+    qint64 total = 0;
+    for (int c = 0; c < decoder.num_components; ++c) {
+        const jpeg_component_info& component = decoder.comp_info[c];
+        total += qint64(component.width_in_blocks) * component.height_in_blocks;
+    }
+    blocks.resize(total * BLOCK_COEFFICIENTS);
+
+    // ========== КРОК 4: Суцільний масив ==========
+    return transfer(false);
+}
+
+/**
+ * @brief Запис (змінених) коефіцієнтів у новий файл JPEG.
+ *
+ * Таблиці квантування та субдискретизація копіюються з оригіналу
+ * (jpeg_copy_critical_parameters), коефіцієнти записуються без змін -
+ * повторного квантування немає. Таблиці Хаффмана оптимізуються під
+ * нові коефіцієнти. Маркери JFIF та Adobe libjpeg записує сама,
+ * решта маркерів APPn/COM (EXIF, ICC тощо) копіюється з оригіналу.
+ *
+ * @param outputPath Шлях до вихідного файлу.
+ * @return true у разі успіху.
+ */
+bool JpegCoefficients::write(const QString& outputPath) {
+    if (!state || !state->arrays) {
+        error = "Coefficients are not read";
+        return false;
+    }
+
+    // ========== КРОК 1: Коефіцієнти назад у libjpeg ==========
+    if (!transfer(true)) {
+        return false;
+    }
+
+    // ========== КРОК 2: Кодування в пам'ять ==========
+    // Вказівник після setjmp не змінюється, тому після longjmp він коректний.
+    JpegEncoderState* const encoderState = new JpegEncoderState;
+    jpeg_compress_struct& encoder = encoderState->encoder;
+
+    encoder.err = initErrorManager(encoderState->errors);
+    if (setjmp(encoderState->errors.jump)) {
+        error = QString::fromLatin1(encoderState->errors.message);
+        destroyEncoder(encoderState);
+        return false;
+    }
+
+    jpeg_create_compress(&encoder);
+    encoderState->created = true;
+    jpeg_mem_dest(&encoder, &encoderState->buffer, &encoderState->bufferSize);
+
+    jpeg_copy_critical_parameters(&state->decoder, &encoder);
+    encoder.optimize_coding = TRUE;
+    jpeg_write_coefficients(&encoder, state->arrays);
+
+    for (jpeg_saved_marker_ptr marker = state->decoder.marker_list; marker; marker = marker->next) {
+        const bool jfif = marker->marker == JPEG_APP0 && marker->data_length >= 5 &&
+                          std::memcmp(marker->data, "JFIF", 5) == 0;
+        const bool adobe = marker->marker == JPEG_APP0 + 14 && marker->data_length >= 5 &&
+                           std::memcmp(marker->data, "Adobe", 5) == 0;
+        if ((jfif && encoder.write_JFIF_header) || (adobe && encoder.write_Adobe_marker)) {
+            continue;
+        }
+        jpeg_write_marker(&encoder, marker->marker, marker->data, marker->data_length);
+    }
+
+    jpeg_finish_compress(&encoder);
+
+    // ========== КРОК 3: Файл ==========
+    // QSaveFile: оригінал не пошкоджується, якщо запис не вдався.
+    const qint64 bufferSize = qint64(encoderState->bufferSize);
+    QSaveFile file(outputPath);
+    const bool saved = file.open(QIODevice::WriteOnly) &&
+                       file.write(reinterpret_cast<const char*>(encoderState->buffer), bufferSize) ==
+                           bufferSize &&
+                       file.commit();
+    if (!saved) {
+        error = file.errorString();
+    }
+    destroyEncoder(encoderState);
+    return saved;
+}
+
+/**
+ * @brief Перенесення коефіцієнтів між масивом і віртуальними масивами libjpeg.
+ *
+ * Віртуальні масиви доступні лише кількома рядками блоків за раз,
+ * тому копіюємо по одному рядку.
+ *
+ * @param store true - з масиву в libjpeg (перед записом), false - навпаки.
+ * @return true у разі успіху.
+ */
+bool JpegCoefficients::transfer(bool store) {
+    jpeg_decompress_struct& decoder = state->decoder;
+    if (setjmp(state->errors.jump)) {
+        error = QString::fromLatin1(state->errors.message);
+        return false;
+    }
+
+    qint16* block = blocks.data();
+    for (int c = 0; c < decoder.num_components; ++c) {
+        const jpeg_component_info& component = decoder.comp_info[c];
+        const size_t rowBytes = size_t(component.width_in_blocks) * sizeof(JBLOCK);
+
+        for (JDIMENSION row = 0; row < component.height_in_blocks; ++row) {
+            JBLOCKARRAY rows = (*decoder.mem->access_virt_barray)(
+                reinterpret_cast<j_common_ptr>(&decoder), state->arrays[c], row, 1,
+                store ? TRUE : FALSE);
+            if (store) {
+                std::memcpy(rows[0], block, rowBytes);
+            } else {
+                std::memcpy(block, rows[0], rowBytes);
+            }
+            block += qint64(component.width_in_blocks) * BLOCK_COEFFICIENTS;
+        }
+    }
+    return true;
+}
+
+/* ============================================================================
+ *                              ДОСТУП ДО ДАНИХ
+ * ============================================================================
+ */
+
+/**
+ * @brief Розмір зображення.
+ * @return Ширина та висота в пікселях (порожній, якщо файл не прочитано).
+ */
+QSize JpegCoefficients::size() const {
+    if (!state || !state->arrays) {
+        return QSize();
+    }
+    return QSize(int(state->decoder.image_width), int(state->decoder.image_height));
+}
+
+/**
+ * @brief Кількість блоків 8×8 усіх компонентів.
+ * @return Кількість блоків.
+ */
+qint64 JpegCoefficients::blockCount() const {
+    return blocks.size() / BLOCK_COEFFICIENTS;
+}
+
+/**
+ * @brief Коефіцієнти для зміни.
+ * @return blockCount() × 64 коефіцієнтів.
+ */
+qint16* JpegCoefficients::coefficients() {
+    return blocks.data();
+}
+
+/**
+ * @brief Коефіцієнти для читання.
+ * @return blockCount() × 64 коефіцієнтів.
+ */
+const qint16* JpegCoefficients::constCoefficients() const {
+    return blocks.constData();
+}
+
+/**
+ * @brief Опис останньої помилки.
+ * @return Текст помилки.
+ */
+QString JpegCoefficients::errorString() const {
+    return error;
+}
@@ -0,0 +1,114 @@
+/*
+ * JpegCoefficients.h
+ *
+ * Заголовочний файл читання та запису квантованих коефіцієнтів DCT
+ * файлу JPEG без декодування в пікселі.
+ *
+ * Основні можливості:
+ * - Читання коефіцієнтів усіх компонентів (libjpeg, jpeg_read_coefficients).
+ * - Доступ до коефіцієнтів суцільним масивом блоків 8×8.
+ * - Запис без повторного квантування (jpeg_write_coefficients) зі
+ *   збереженням таблиць квантування, субдискретизації та маркерів APPn/COM.
+ */
+
+#ifndef JPEGCOEFFICIENTS_H
+#define JPEGCOEFFICIENTS_H
+
+#include <QString>
+#include <QByteArray>
+#include <QSize>
+#include <QVector>
+
+struct JpegState;
+
+/**
+ * @class JpegCoefficients
+ * @brief Квантовані коефіцієнти DCT файлу JPEG.
+ *
+ * Декодується лише ентропійне кодування (Хаффман), тому читання
+ * в кілька разів швидше за декодування пікселів, а запис змінених
+ * коефіцієнтів не вносить жодних інших змін у зображення.
+ *
+ * Коефіцієнти зберігаються компонент за компонентом, рядок блоків
+ * за рядком; кожен блок - 64 коефіцієнти в природному (не зигзаг)
+ * порядку, коефіцієнт 0 - DC, решта - AC.
+ */
+class JpegCoefficients {
+public:
+    /**
+     * @brief Конструктор.
+     * @param fileName Шлях до файлу JPEG.
+     */
+    explicit JpegCoefficients(const QString& fileName);
+
+    /**
+     * @brief Деструктор.
+     *
+     * Звільняє стан декодера libjpeg.
+     */
+    ~JpegCoefficients();
+
+    /**
+     * @brief Читання коефіцієнтів з файлу.
+     * @return true у разі успіху.
+     */
+    bool read();
+
+    /**
+     * @brief Запис (змінених) коефіцієнтів у новий файл JPEG.
+     *
+     * @param outputPath Шлях до вихідного файлу.
+     * @return true у разі успіху.
+     */
+    bool write(const QString& outputPath);
+
+    /**
+     * @brief Розмір зображення.
+     * @return Ширина та висота в пікселях.
+     */
+    QSize size() const;
+
+    /**
+     * @brief Кількість блоків 8×8 усіх компонентів.
+     * @return Кількість блоків.
+     */
+    qint64 blockCount() const;
+
+    /**
+     * @brief Коефіцієнти для зміни.
+     * @return blockCount() × 64 коефіцієнтів.
+     */
+    qint16* coefficients();
+
+    /**
+     * @brief Коефіцієнти для читання.
+     * @return blockCount() × 64 коефіцієнтів.
+     */
+    const qint16* constCoefficients() const;
+
+    /**
+     * @brief Опис останньої помилки.
+     * @return Текст помилки.
+     */
+    QString errorString() const;
+
+    /// Кількість коефіцієнтів у блоці 8×8.
+    static constexpr int BLOCK_COEFFICIENTS = 64;
+
+private:
+    /**
+     * @brief Перенесення коефіцієнтів між масивом і віртуальними масивами libjpeg.
+     *
+     * @param store true - з масиву в libjpeg (перед записом), false - навпаки.
+     * @return true у разі успіху.
+     */
+    bool transfer(bool store);
+
+    // ========== Дані ==========
+    QString fileName;               ///< Шлях до файлу.
+    QString error;                  ///< Опис останньої помилки.
+    JpegState* state = nullptr;     ///< Стан декодера libjpeg.
+    QVector<qint16> blocks;         ///< Коефіцієнти всіх блоків.
+};
+
+#endif // JPEGCOEFFICIENTS_H
@@ -0,0 +1,63 @@
+/*
+ * JpegErrorManager.h
+ *
+ * Обробник помилок libjpeg з точкою повернення setjmp/longjmp.
+ * Спільний для читання коефіцієнтів DCT (JpegCoefficients) та
+ * читання пікселів смугами (ImageStripReader).
+ *
+ * libjpeg написана на C і не пропускає винятки C++ крізь свої кадри
+ * стека, тому фатальна помилка повертає керування до setjmp. Локальні
+ * змінні, змінені після setjmp, після longjmp мають невизначені значення,
+ * тому стан libjpeg зберігається в купі.
+ */
+
+#ifndef JPEGERRORMANAGER_H
+#define JPEGERRORMANAGER_H
+
+#include <QDebug>
+#include <csetjmp>
+#include <cstdio>
+#include <jpeglib.h>
+
+/**
+ * @struct JpegErrorManager
+ * @brief Обробник помилок libjpeg з точкою повернення.
+ */
+struct JpegErrorManager {
+    jpeg_error_mgr base;                 ///< Стандартний обробник (перше поле).
+    jmp_buf jump;                        ///< Точка повернення після помилки.
+    char message[JMSG_LENGTH_MAX];       ///< Текст останньої помилки.
+};
+
+/**
+ * @brief Фатальна помилка libjpeg: зберігаємо текст і повертаємося до setjmp.
+ */
+inline void jpegErrorExit(j_common_ptr info) {
+    JpegErrorManager* manager = reinterpret_cast<JpegErrorManager*>(info->err);
+    (*info->err->format_message)(info, manager->message);
+    longjmp(manager->jump, 1);
+}
+
+/**
+ * @brief Попередження libjpeg: у журнал замість stderr.
+ */
+inline void jpegOutputMessage(j_common_ptr info) {
+    char message[JMSG_LENGTH_MAX];
+    (*info->err->format_message)(info, message);
+    qDebug() << "libjpeg:" << message;
+}
+
+/**
+ * @brief Ініціалізація обробника помилок.
+ * @param manager Обробник.
+ * @return Вказівник для поля err структури libjpeg.
+ */
+inline jpeg_error_mgr* initErrorManager(JpegErrorManager& manager) {
+    jpeg_error_mgr* base = jpeg_std_error(&manager.base);
+    base->error_exit = jpegErrorExit;
+    base->output_message = jpegOutputMessage;
+    manager.message[0] = '\0';
+    return base;
+}
+
+#endif // JPEGERRORMANAGER_H
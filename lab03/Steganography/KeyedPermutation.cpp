@@ -0,0 +1,97 @@
+/*
+ * KeyedPermutation.cpp
+ *
+ * Реалізація ключової перестановки номерів пікселів
+ * (мережа Фейстеля з cycle-walking).
+ */
+
+#include "KeyedPermutation.h"
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QtEndian>
+
+/**
+ * @brief Конструктор.
+ *
+ * Раундові ключі - 4 слова по 64 біти з SHA-256 від ключа та розміру
+ * множини, тому для різних розмірів зображення порядок різний.
+ *
+ * @param key Ключ користувача.
+ * @param size Розмір множини N.
+ */
+KeyedPermutation::KeyedPermutation(const QString& key, quint64 size)
+    : domainSize(qMax<quint64>(1, size)) {
+    // Найменша парна кількість бітів 2h, для якої 2^(2h) >= N (щонайменше 2).
+    int bits = 0;
+    while (bits < 64 && (quint64(1) << bits) < domainSize) {
+        ++bits;
+    }
+    halfBits = qMax(1, (bits + 1) / 2);
+    halfMask = (quint64(1) << halfBits) - 1;
+
+    // ========== Раундові ключі ==========
+    QByteArray material = key.toUtf8();
+    material.append("|pixel-order|");
+    uchar sizeBytes[8];
+    qToBigEndian<quint64>(domainSize, sizeBytes);
+    material.append(reinterpret_cast<const char*>(sizeBytes), 8);
+
+    const QByteArray hash = QCryptographicHash::hash(material, QCryptographicHash::Sha256);
+    const uchar* words = reinterpret_cast<const uchar*>(hash.constData());
+    for (int r = 0; r < ROUNDS; ++r) {
+        roundKeys[r] = qFromBigEndian<quint64>(words + 8 * r);
+    }
+}
+
+/**
+ * @brief Образ індексу під дією перестановки.
+ *
+ * Cycle-walking: кожне значення належить циклу перестановки Фейстеля,
+ * і цей цикл містить лише скінченну кількість значень поза [0, N),
+ * тому цикл завершується, а результат - бієкція на [0, N).
+ *
+ * @param index Індекс з [0, N).
+ * @return π_K(index) з [0, N).
+ */
+quint64 KeyedPermutation::map(quint64 index) const {
+    quint64 value = index;
+    do {
+        value = encrypt(value);
+    } while (value >= domainSize);
+    return value;
+}
+
+/**
+ * @brief Розмір множини.
+ * @return N.
+ */
+quint64 KeyedPermutation::size() const {
+    return domainSize;
+}
+
+/**
+ * @brief Один прохід мережі Фейстеля по 2h-бітовому значенню.
+ *
+ * Раунд: (L, R) → (R, L ⊕ F(R)), де F - перемішування 64-бітового
+ * слова (фіналізатор SplitMix64) від R та раундового ключа.
+ *
+ * @param value Значення з [0, 2^(2h)).
+ * @return Зашифроване значення з того ж діапазону.
+ */
+quint64 KeyedPermutation::encrypt(quint64 value) const {
+    quint64 left = value >> halfBits;
+    quint64 right = value & halfMask;
+
+    for (int r = 0; r < ROUNDS; ++r) {
+        quint64 mixed = right + roundKeys[r];
+        mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ull;
+        mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBull;
+        mixed ^= mixed >> 31;
+
+        const quint64 next = left ^ (mixed & halfMask);
+        left = right;
+        right = next;
+    }
+
+    return (left << halfBits) | right;
+}
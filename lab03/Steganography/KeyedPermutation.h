@@ -0,0 +1,72 @@
+/*
+ * KeyedPermutation.h
+ *
+ * Заголовочний файл ключової перестановки номерів пікселів.
+ * Дозволяє розміщувати дані в псевдовипадковому порядку без
+ * зберігання перемішаного масиву індексів.
+ *
+ * Основні можливості:
+ * - Бієкція на [0, N) для довільного N (мережа Фейстеля + cycle-walking).
+ * - O(1) пам'яті, обчислення для будь-якого індексу незалежно.
+ * - Раундові ключі виводяться з ключа користувача через SHA-256.
+ */
+
+#ifndef KEYEDPERMUTATION_H
+#define KEYEDPERMUTATION_H
+
+#include <QString>
+#include <QtGlobal>
+
+/**
+ * @class KeyedPermutation
+ * @brief Ключова перестановка π_K на множині [0, N).
+ *
+ * Збалансована мережа Фейстеля з 4 раундами переставляє 2h-бітові
+ * значення, де 2^(2h) - найменший парний степінь двійки не менший за N.
+ * Значення, що виходять за межі [0, N), шифруються повторно (cycle-walking),
+ * доки не потраплять у діапазон. Оскільки домен Фейстеля менший за 4N,
+ * в середньому потрібно менше 4 ітерацій.
+ *
+ * Об'єкт незмінний після створення, тому map() можна викликати
+ * з кількох потоків одночасно.
+ */
+class KeyedPermutation {
+public:
+    /**
+     * @brief Конструктор.
+     * @param key Ключ користувача.
+     * @param size Розмір множини N.
+     */
+    KeyedPermutation(const QString& key, quint64 size);
+
+    /**
+     * @brief Образ індексу під дією перестановки.
+     * @param index Індекс з [0, N).
+     * @return π_K(index) з [0, N).
+     */
+    quint64 map(quint64 index) const;
+
+    /**
+     * @brief Розмір множини.
+     * @return N.
+     */
+    quint64 size() const;
+
+private:
+    /**
+     * @brief Один прохід мережі Фейстеля по 2h-бітовому значенню.
+     * @param value Значення з [0, 2^(2h)).
+     * @return Зашифроване значення з того ж діапазону.
+     */
+    quint64 encrypt(quint64 value) const;
+
+    /// Кількість раундів мережі Фейстеля.
+    static constexpr int ROUNDS = 4;
+
+    quint64 domainSize;          ///< Розмір множини N.
+    int halfBits;                ///< Кількість бітів половини блока (h).
+    quint64 halfMask;            ///< Маска половини блока.
+    quint64 roundKeys[ROUNDS];   ///< Раундові ключі.
+};
+
+#endif // KEYEDPERMUTATION_H
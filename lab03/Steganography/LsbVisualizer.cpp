@@ -0,0 +1,263 @@
+/*
+ * LsbVisualizer.cpp
+ *
+ * Реалізація віджета перегляду бітових площин та карти різниці.
+ */
+
+#include "LsbVisualizer.h"
+#include <QPainter>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QtMath>
+
+/**
+ * @brief Конструктор.
+ * @param parent Батьківський віджет.
+ */
+LsbVisualizer::LsbVisualizer(QWidget* parent)
+    : QWidget(parent),
+    viewMode(BitPlaneRenderer::Mode::Difference),
+    tiles(CACHE_BYTES),
+    zoom(1.0),
+    origin(0.0, 0.0),
+    panning(false)
+{
+    setMinimumSize(200, 150);
+    setCursor(Qt::OpenHandCursor);
+}
+
+/**
+ * @brief Встановлення зображень для перегляду.
+ *
+ * @param original Оригінальне зображення.
+ * @param modified Модифіковане зображення.
+ */
+void LsbVisualizer::setImages(const QImage& original, const QImage& modified) {
+    renderer.setImages(original, modified);
+    tiles.clear();
+    fitToView();
+}
+
+/**
+ * @brief Поточний режим.
+ * @return Режим перегляду.
+ */
+BitPlaneRenderer::Mode LsbVisualizer::mode() const {
+    return viewMode;
+}
+
+/**
+ * @brief Чи доступний режим для поточних зображень.
+ * @param mode Режим.
+ * @return true якщо режим можна показати.
+ */
+bool LsbVisualizer::supports(BitPlaneRenderer::Mode mode) const {
+    return renderer.supports(mode);
+}
+
+/**
+ * @brief Зміна режиму перегляду.
+ *
+ * Режим входить у ключ кешу, тому тайли інших режимів зберігаються.
+ *
+ * @param mode Режим.
+ */
+void LsbVisualizer::setMode(BitPlaneRenderer::Mode mode) {
+    viewMode = mode;
+    update();
+}
+
+/**
+ * @brief Вписати зображення у віджет.
+ */
+void LsbVisualizer::fitToView() {
+    const QSize imageSize = renderer.size();
+    if (imageSize.isEmpty() || width() <= 0 || height() <= 0) {
+        zoom = 1.0;
+        origin = QPointF(0.0, 0.0);
+        update();
+        return;
+    }
+
+    zoom = qMin(double(width()) / imageSize.width(), double(height()) / imageSize.height());
+    zoom = qMin(zoom, MAX_ZOOM);
+
+    // Центруємо зображення.
+    origin = QPointF(imageSize.width() / 2.0 - width() / (2.0 * zoom),
+                     imageSize.height() / 2.0 - height() / (2.0 * zoom));
+    update();
+}
+
+/**
+ * @brief Крок проріджування для поточного масштабу.
+ * @return Крок (степінь двійки).
+ */
+int LsbVisualizer::currentStep() const {
+    int step = 1;
+    while (step * 2 * zoom <= 1.0 && step < (1 << 14)) {
+        step *= 2;
+    }
+    return step;
+}
+
+/**
+ * @brief Тайл з кешу.
+ *
+ * Ключ: режим (4 біти) | log2(step) (4 біти) | tileY (28 бітів) | tileX (28 бітів).
+ *
+ * @param step Крок проріджування.
+ * @param tileX Номер тайла по горизонталі.
+ * @param tileY Номер тайла по вертикалі.
+ * @return Тайл або nullptr.
+ */
+const QImage* LsbVisualizer::tile(int step, int tileX, int tileY) {
+    const quint64 key = (quint64(viewMode) << 60) |
+                        (quint64(qCountTrailingZeroBits(quint32(step))) << 56) |
+                        (quint64(tileY) << 28) | quint64(tileX);
+
+    if (const QImage* cached = tiles.object(key)) {
+        return cached;
+    }
+
+    const int span = TILE_SIZE * step;
+    QImage* rendered = new QImage(renderer.render(viewMode,
+                                                  QRect(tileX * span, tileY * span, span, span),
+                                                  step));
+    if (rendered->isNull()) {
+        delete rendered;
+        return nullptr;
+    }
+
+    const qsizetype cost = rendered->sizeInBytes();
+    tiles.insert(key, rendered, cost);
+    return tiles.object(key);
+}
+
+/**
+ * @brief Малювання видимих тайлів.
+ *
+ * Обчислюються лише тайли, що перетинають видиму область; при
+ * збільшенні пікселі малюються без згладжування (видно окремі біти).
+ *
+ * @param event Подія малювання.
+ */
+void LsbVisualizer::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), QColor("#1a1a1a"));
+
+    const QSize imageSize = renderer.size();
+    if (imageSize.isEmpty() || !renderer.supports(viewMode)) {
+        painter.setPen(QColor("#888888"));
+        painter.drawText(rect(), Qt::AlignCenter,
+                         renderer.isNull() ? "Проведіть аналіз, щоб побачити бітові площини"
+                                           : "Режим недоступний для цих зображень");
+        return;
+    }
+
+    const int step = currentStep();
+    const int span = TILE_SIZE * step;
+
+    // Видима ділянка зображення.
+    const double left = qMax(0.0, origin.x());
+    const double top = qMax(0.0, origin.y());
+    const double right = qMin<double>(imageSize.width(), origin.x() + width() / zoom);
+    const double bottom = qMin<double>(imageSize.height(), origin.y() + height() / zoom);
+    if (right <= left || bottom <= top) {
+        return;
+    }
+
+    const int firstX = int(left) / span;
+    const int lastX = (int(qCeil(right)) - 1) / span;
+    const int firstY = int(top) / span;
+    const int lastY = (int(qCeil(bottom)) - 1) / span;
+
+    for (int tileY = firstY; tileY <= lastY; ++tileY) {
+        for (int tileX = firstX; tileX <= lastX; ++tileX) {
+            const QImage* image = tile(step, tileX, tileY);
+            if (!image) {
+                continue;
+            }
+
+            const QRectF target((tileX * span - origin.x()) * zoom,
+                                (tileY * span - origin.y()) * zoom,
+                                image->width() * step * zoom,
+                                image->height() * step * zoom);
+            painter.drawImage(target, *image);
+        }
+    }
+}
+
+/**
+ * @brief Масштабування колесом миші відносно курсора.
+ * @param event Подія колеса.
+ */
+void LsbVisualizer::wheelEvent(QWheelEvent* event) {
+    if (renderer.isNull()) {
+        return;
+    }
+
+    const QPointF cursor = event->position();
+    const QPointF anchor = origin + cursor / zoom;
+
+    // Найменший масштаб - вписане зображення, зменшене ще вчетверо.
+    const QSize imageSize = renderer.size();
+    const double minZoom = qMin(double(width()) / imageSize.width(),
+                                double(height()) / imageSize.height()) / 4.0;
+
+    const double factor = qPow(1.25, event->angleDelta().y() / 120.0);
+    zoom = qBound(minZoom, zoom * factor, MAX_ZOOM);
+
+    // Точка під курсором залишається на місці.
+    origin = anchor - cursor / zoom;
+    update();
+    event->accept();
+}
+
+/**
+ * @brief Початок перетягування.
+ * @param event Подія миші.
+ */
+void LsbVisualizer::mousePressEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton) {
+        panning = true;
+        lastMousePos = event->position();
+        setCursor(Qt::ClosedHandCursor);
+    }
+}
+
+/**
+ * @brief Зсув під час перетягування.
+ * @param event Подія миші.
+ */
+void LsbVisualizer::mouseMoveEvent(QMouseEvent* event) {
+    if (!panning) {
+        return;
+    }
+
+    const QPointF position = event->position();
+    origin -= (position - lastMousePos) / zoom;
+    lastMousePos = position;
+    update();
+}
+
+/**
+ * @brief Завершення перетягування.
+ * @param event Подія миші.
+ */
+void LsbVisualizer::mouseReleaseEvent(QMouseEvent* event) {
+    if (event->button() == Qt::LeftButton) {
+        panning = false;
+        setCursor(Qt::OpenHandCursor);
+    }
+}
+
+/**
+ * @brief Подвійне клацання - вписати зображення.
+ * @param event Подія миші.
+ */
+void LsbVisualizer::mouseDoubleClickEvent(QMouseEvent* event) {
+    Q_UNUSED(event);
+    fitToView();
+}
@@ -0,0 +1,118 @@
+/*
+ * LsbVisualizer.h
+ *
+ * Заголовочний файл віджета перегляду бітових площин та карти різниці.
+ * Зображення розбивається на тайли, які обчислюються лише тоді, коли
+ * потрапляють у видиму область, і зберігаються в кеші.
+ *
+ * Керування:
+ * - Колесо миші - масштаб відносно курсора.
+ * - Перетягування лівою кнопкою - зсув.
+ * - Подвійне клацання - вписати зображення у вікно.
+ */
+
+#ifndef LSBVISUALIZER_H
+#define LSBVISUALIZER_H
+
+#include <QWidget>
+#include <QCache>
+#include <QPointF>
+#include "BitPlaneRenderer.h"
+
+/**
+ * @class LsbVisualizer
+ * @brief Масштабований перегляд молодших бітів каналів та різниці зображень.
+ *
+ * При зменшенні тайл будується з кожного step-го пікселя (step - степінь
+ * двійки, за якого тайл не менший за свій розмір на екрані), тому
+ * кількість обчислень залежить від розміру віджета, а не зображення.
+ */
+class LsbVisualizer : public QWidget {
+    Q_OBJECT
+
+public:
+    /// Розмір тайла в пікселях результату.
+    static constexpr int TILE_SIZE = 256;
+
+    /// Максимальний обсяг кешу тайлів (байтів).
+    static constexpr int CACHE_BYTES = 64 * 1024 * 1024;
+
+    /// Максимальний масштаб (екранних пікселів на піксель зображення).
+    static constexpr double MAX_ZOOM = 32.0;
+
+    /**
+     * @brief Конструктор.
+     * @param parent Батьківський віджет.
+     */
+    explicit LsbVisualizer(QWidget* parent = nullptr);
+
+    /**
+     * @brief Встановлення зображень для перегляду.
+     *
+     * Кеш тайлів очищується, вид вписується у віджет.
+     *
+     * @param original Оригінальне зображення.
+     * @param modified Модифіковане зображення.
+     */
+    void setImages(const QImage& original, const QImage& modified);
+
+    /**
+     * @brief Поточний режим.
+     * @return Режим перегляду.
+     */
+    BitPlaneRenderer::Mode mode() const;
+
+    /**
+     * @brief Чи доступний режим для поточних зображень.
+     * @param mode Режим.
+     * @return true якщо режим можна показати.
+     */
+    bool supports(BitPlaneRenderer::Mode mode) const;
+
+public slots:
+    /**
+     * @brief Зміна режиму перегляду.
+     * @param mode Режим.
+     */
+    void setMode(BitPlaneRenderer::Mode mode);
+
+    /**
+     * @brief Вписати зображення у віджет.
+     */
+    void fitToView();
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void mouseDoubleClickEvent(QMouseEvent* event) override;
+
+private:
+    /**
+     * @brief Крок проріджування для поточного масштабу.
+     * @return Найбільший степінь двійки step, за якого step × масштаб ≤ 1 (мінімум 1).
+     */
+    int currentStep() const;
+
+    /**
+     * @brief Тайл з кешу (обчислюється при першому зверненні).
+     *
+     * @param step Крок проріджування.
+     * @param tileX Номер тайла по горизонталі.
+     * @param tileY Номер тайла по вертикалі.
+     * @return Вказівник на тайл у кеші (nullptr, якщо тайл порожній).
+     */
+    const QImage* tile(int step, int tileX, int tileY);
+
+    BitPlaneRenderer renderer;          ///< Обчислення тайлів.
+    BitPlaneRenderer::Mode viewMode;    ///< Поточний режим.
+    QCache<quint64, QImage> tiles;      ///< Кеш тайлів (вартість - байти).
+    double zoom;                        ///< Екранних пікселів на піксель зображення.
+    QPointF origin;                     ///< Точка зображення в лівому верхньому куті.
+    QPointF lastMousePos;               ///< Позиція миші при перетягуванні.
+    bool panning;                       ///< Чи триває перетягування.
+};
+
+#endif // LSBVISUALIZER_H
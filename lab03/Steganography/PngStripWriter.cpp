@@ -0,0 +1,267 @@
+/*
+ * PngStripWriter.cpp
+ *
+ * Реалізація послідовного запису PNG смугами рядків.
+ * Містить потокове стиснення zlib (фільтри рядків - спільні з PngWriter).
+ */
+
+#include "PngStripWriter.h"
+#include "PngWriter.h"
+#include <QDebug>
+#include <QtEndian>
+#include <cstring>
+#include <zlib.h>
+
+/// Сигнатура файлу PNG.
+static const char PNG_SIGNATURE[8] = {'\x89', 'P', 'N', 'G', '\r', '\n', '\x1a', '\n'};
+
+/// Розмір даних одного блока IDAT.
+static const int IDAT_SIZE = 64 * 1024;
+
+/// Байтів на піксель у вихідному файлі (8-бітний RGB).
+static const int PIXEL_BYTES = 3;
+
+/* ============================================================================
+ *                      КОНСТРУКТОР ТА ДЕСТРУКТОР
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор.
+ * @param fileName Шлях до вихідного файлу.
+ */
+PngStripWriter::PngStripWriter(const QString& fileName)
+    : file(fileName) {
+}
+
+/**
+ * @brief Деструктор.
+ */
+PngStripWriter::~PngStripWriter() {
+    if (deflater) {
+        deflateEnd(deflater);
+        delete deflater;
+    }
+}
+
+/* ============================================================================
+ *                              ЗАПИС ФАЙЛУ
+ * ============================================================================
+ */
+
+/**
+ * @brief Створення файлу та запис заголовка PNG.
+ *
+ * Записує сигнатуру та блок IHDR: 8 біт на канал, тип кольору 2 (RGB),
+ * без інтерлейсу.
+ *
+ * @param width Ширина зображення.
+ * @param height Висота зображення.
+ * @return true у разі успіху.
+ */
+bool PngStripWriter::open(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        error = "Invalid image size";
+        return false;
+    }
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        error = file.errorString();
+        return false;
+    }
+
+    imageWidth = width;
+    imageHeight = height;
+    rowsWritten = 0;
+
+    // ========== КРОК 1: Сигнатура та IHDR ==========
+    QByteArray ihdr(13, 0);
+    qToBigEndian<quint32>(quint32(width), ihdr.data());
+    qToBigEndian<quint32>(quint32(height), ihdr.data() + 4);
+    ihdr[8] = 8;   // Біт на канал.
+    ihdr[9] = 2;   // Тип кольору: RGB.
+    ihdr[10] = 0;  // Стиснення: deflate.
+    ihdr[11] = 0;  // Фільтрація: адаптивна.
+    ihdr[12] = 0;  // Без інтерлейсу.
+
+    if (file.write(PNG_SIGNATURE, 8) != 8 || !writeChunk("IHDR", ihdr)) {
+        return false;
+    }
+
+    // ========== КРОК 2: Буфери рядків ==========
+    const qsizetype rowBytes = qsizetype(width) * PIXEL_BYTES;
+    currentRow = QByteArray(rowBytes, 0);
+    previousRow = QByteArray(rowBytes, 0);
+    filtered = QByteArray(rowBytes + 1, 0);
+    candidate = QByteArray(rowBytes + 1, 0);
+    output = QByteArray(IDAT_SIZE, 0);
+
+    // ========== КРОК 3: Ініціалізація zlib ==========
+    deflater = new z_stream_s;
+    std::memset(deflater, 0, sizeof(z_stream_s));
+    if (deflateInit(deflater, Z_DEFAULT_COMPRESSION) != Z_OK) {
+        delete deflater;
+        deflater = nullptr;
+        error = "Cannot initialize zlib";
+        return false;
+    }
+
+    deflater->next_out = reinterpret_cast<Bytef*>(output.data());
+    deflater->avail_out = IDAT_SIZE;
+
+    return true;
+}
+
+/**
+ * @brief Запис наступної смуги рядків.
+ * @param strip Смуга у форматі RGB32 з шириною зображення.
+ * @return true у разі успіху.
+ */
+bool PngStripWriter::writeStrip(const QImage& strip) {
+    if (!deflater || strip.width() != imageWidth ||
+        rowsWritten + strip.height() > imageHeight) {
+        error = "Strip does not match image size";
+        return false;
+    }
+
+    for (int y = 0; y < strip.height(); ++y) {
+        // RGB32 (0xAARRGGBB) → 3 байти R, G, B.
+        const QRgb* line = reinterpret_cast<const QRgb*>(strip.constScanLine(y));
+        uchar* row = reinterpret_cast<uchar*>(currentRow.data());
+        for (int x = 0; x < imageWidth; ++x) {
+            row[3 * x] = uchar(qRed(line[x]));
+            row[3 * x + 1] = uchar(qGreen(line[x]));
+            row[3 * x + 2] = uchar(qBlue(line[x]));
+        }
+
+        PngWriter::filterRow(row, reinterpret_cast<const uchar*>(previousRow.constData()),
+                             reinterpret_cast<uchar*>(filtered.data()),
+                             reinterpret_cast<uchar*>(candidate.data()),
+                             qsizetype(imageWidth) * PIXEL_BYTES, PIXEL_BYTES,
+                             PngFilter::Adaptive);
+
+        deflater->next_in = reinterpret_cast<Bytef*>(filtered.data());
+        deflater->avail_in = uInt(filtered.size());
+        if (!deflateInput(Z_NO_FLUSH)) {
+            return false;
+        }
+
+        currentRow.swap(previousRow);
+        ++rowsWritten;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Завершення стиснення та запис блока IEND.
+ * @return true якщо записано всі рядки та файл закрито без помилок.
+ */
+bool PngStripWriter::close() {
+    if (!deflater) {
+        return false;
+    }
+
+    if (rowsWritten != imageHeight) {
+        error = QString("Only %1 of %2 rows written").arg(rowsWritten).arg(imageHeight);
+        return false;
+    }
+
+    deflater->next_in = nullptr;
+    deflater->avail_in = 0;
+    if (!deflateInput(Z_FINISH) || !writeChunk("IEND", QByteArray())) {
+        return false;
+    }
+
+    file.close();
+    if (file.error() != QFileDevice::NoError) {
+        error = file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Опис останньої помилки.
+ * @return Текст помилки.
+ */
+QString PngStripWriter::errorString() const {
+    return error;
+}
+
+/* ============================================================================
+ *                          ДОПОМІЖНІ МЕТОДИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Запис блока PNG (довжина, тип, дані, CRC).
+ * @param type Тип блока (4 символи).
+ * @param data Дані блока.
+ * @return true у разі успіху.
+ */
+bool PngStripWriter::writeChunk(const char* type, const QByteArray& data) {
+    QByteArray chunk(8, 0);
+    qToBigEndian<quint32>(quint32(data.size()), chunk.data());
+    std::memcpy(chunk.data() + 4, type, 4);
+
+    // CRC обчислюється по типу та даних.
+    uLong crc = crc32(0L, reinterpret_cast<const Bytef*>(type), 4);
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(data.constData()), uInt(data.size()));
+
+    QByteArray crcBytes(4, 0);
+    qToBigEndian<quint32>(quint32(crc), crcBytes.data());
+
+    if (file.write(chunk) != chunk.size() || file.write(data) != data.size() ||
+        file.write(crcBytes) != 4) {
+        error = file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Стиснення поточного вводу та запис заповнених блоків IDAT.
+ *
+ * Кожен раз, коли буфер стиснутих даних заповнюється, він записується
+ * окремим блоком IDAT. Після Z_FINISH дописується неповний залишок.
+ *
+ * @param flush Режим zlib (Z_NO_FLUSH або Z_FINISH).
+ * @return true у разі успіху.
+ */
+bool PngStripWriter::deflateInput(int flush) {
+    for (;;) {
+        const int status = deflate(deflater, flush);
+        if (status == Z_STREAM_ERROR) {
+            error = "zlib compression error";
+            return false;
+        }
+
+        // Буфер заповнено - записуємо блок IDAT.
+        if (deflater->avail_out == 0) {
+            if (!writeChunk("IDAT", output)) {
+                return false;
+            }
+            deflater->next_out = reinterpret_cast<Bytef*>(output.data());
+            deflater->avail_out = IDAT_SIZE;
+            continue;
+        }
+
+        const bool done = flush == Z_FINISH ? status == Z_STREAM_END
+                                            : deflater->avail_in == 0;
+        if (done) {
+            break;
+        }
+    }
+
+    if (flush == Z_FINISH) {
+        const int pending = IDAT_SIZE - int(deflater->avail_out);
+        if (pending > 0 && !writeChunk("IDAT", output.left(pending))) {
+            return false;
+        }
+    }
+
+    return true;
+}
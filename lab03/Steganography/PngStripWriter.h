@@ -0,0 +1,102 @@
+/*
+ * PngStripWriter.h
+ *
+ * Заголовочний файл послідовного запису PNG смугами рядків.
+ * Дозволяє зберігати зображення, що не вміщуються в пам'ять повністю.
+ *
+ * Основні можливості:
+ * - Запис 8-бітного RGB PNG рядок за рядком.
+ * - Адаптивний вибір фільтра для кожного рядка.
+ * - Потокове стиснення zlib з поступовим записом блоків IDAT.
+ */
+
+#ifndef PNGSTRIPWRITER_H
+#define PNGSTRIPWRITER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QImage>
+#include <QFile>
+
+struct z_stream_s;
+
+/**
+ * @class PngStripWriter
+ * @brief Послідовний запис PNG смугами рядків.
+ *
+ * У пам'яті знаходяться лише поточний і попередній рядки та буфер
+ * стиснутих даних; готові блоки IDAT одразу записуються у файл.
+ */
+class PngStripWriter {
+public:
+    /**
+     * @brief Конструктор.
+     * @param fileName Шлях до вихідного файлу.
+     */
+    explicit PngStripWriter(const QString& fileName);
+
+    /**
+     * @brief Деструктор.
+     *
+     * Звільняє стан zlib. Незавершений файл не дописується.
+     */
+    ~PngStripWriter();
+
+    /**
+     * @brief Створення файлу та запис заголовка PNG.
+     * @param width Ширина зображення.
+     * @param height Висота зображення.
+     * @return true у разі успіху.
+     */
+    bool open(int width, int height);
+
+    /**
+     * @brief Запис наступної смуги рядків.
+     * @param strip Смуга у форматі RGB32 з шириною зображення.
+     * @return true у разі успіху.
+     */
+    bool writeStrip(const QImage& strip);
+
+    /**
+     * @brief Завершення стиснення та запис блока IEND.
+     * @return true якщо записано всі рядки та файл закрито без помилок.
+     */
+    bool close();
+
+    /**
+     * @brief Опис останньої помилки.
+     * @return Текст помилки.
+     */
+    QString errorString() const;
+
+private:
+    /**
+     * @brief Запис блока PNG (довжина, тип, дані, CRC).
+     * @param type Тип блока (4 символи).
+     * @param data Дані блока.
+     * @return true у разі успіху.
+     */
+    bool writeChunk(const char* type, const QByteArray& data);
+
+    /**
+     * @brief Стиснення поточного вводу та запис заповнених блоків IDAT.
+     * @param flush Режим zlib (Z_NO_FLUSH або Z_FINISH).
+     * @return true у разі успіху.
+     */
+    bool deflateInput(int flush);
+
+    // ========== Дані ==========
+    QFile file;                      ///< Вихідний файл.
+    QString error;                   ///< Опис останньої помилки.
+    z_stream_s* deflater = nullptr;  ///< Стан стиснення zlib.
+    int imageWidth = 0;              ///< Ширина зображення.
+    int imageHeight = 0;             ///< Висота зображення.
+    int rowsWritten = 0;             ///< Кількість записаних рядків.
+    QByteArray currentRow;           ///< Поточний рядок RGB.
+    QByteArray previousRow;          ///< Попередній рядок RGB.
+    QByteArray filtered;             ///< Відфільтрований рядок для стиснення.
+    QByteArray candidate;            ///< Буфер для пробних фільтрів.
+    QByteArray output;               ///< Буфер стиснутих даних (один IDAT).
+};
+
+#endif // PNGSTRIPWRITER_H
@@ -0,0 +1,448 @@
+/*
+ * PngWriter.cpp
+ *
+ * Реалізація запису PNG з паралельним стисненням блоків рядків.
+ * Блоки стискаються незалежно в "сирі" потоки deflate і з'єднуються
+ * в один потік zlib (схема pigz).
+ */
+
+#include "PngWriter.h"
+#include <QDebug>
+#include <QSaveFile>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QtEndian>
+#include <cstring>
+#include <zlib.h>
+
+/// Сигнатура файлу PNG.
+static const char PNG_SIGNATURE[8] = {'\x89', 'P', 'N', 'G', '\r', '\n', '\x1a', '\n'};
+
+/// Бажаний розмір відфільтрованих даних блока.
+static const qsizetype BLOCK_BYTES = 256 * 1024;
+
+/// Розмір вікна deflate (словник блока).
+static const qsizetype DICTIONARY_SIZE = 32 * 1024;
+
+/// Кількість блоків на потік в одній хвилі.
+static const int BLOCKS_PER_THREAD = 4;
+
+/* ============================================================================
+ *                          ФІЛЬТРИ РЯДКІВ
+ * ============================================================================
+ */
+
+/**
+ * @brief Застосування одного фільтра PNG до рядка.
+ *
+ * Окремий цикл для кожного фільтра (без розгалуження на байт),
+ * тому прості фільтри компілятор векторизує.
+ *
+ * @param filter Номер фільтра (0-4).
+ * @param row Рядок.
+ * @param previous Попередній рядок.
+ * @param out Вихідний буфер (байт фільтра + дані).
+ * @param rowBytes Довжина рядка.
+ * @param bpp Байтів на піксель.
+ */
+static void applyFilter(int filter, const uchar* row, const uchar* previous, uchar* out,
+                        qsizetype rowBytes, int bpp) {
+    out[0] = uchar(filter);
+    uchar* data = out + 1;
+    const qsizetype head = qMin<qsizetype>(bpp, rowBytes);
+
+    switch (filter) {
+    case 0:
+        std::memcpy(data, row, size_t(rowBytes));
+        break;
+    case 1:
+        std::memcpy(data, row, size_t(head));
+        for (qsizetype i = bpp; i < rowBytes; ++i) {
+            data[i] = uchar(row[i] - row[i - bpp]);
+        }
+        break;
+    case 2:
+        for (qsizetype i = 0; i < rowBytes; ++i) {
+            data[i] = uchar(row[i] - previous[i]);
+        }
+        break;
+    case 3:
+        for (qsizetype i = 0; i < head; ++i) {
+            data[i] = uchar(row[i] - (previous[i] >> 1));
+        }
+        for (qsizetype i = bpp; i < rowBytes; ++i) {
+            data[i] = uchar(row[i] - ((row[i - bpp] + previous[i]) >> 1));
+        }
+        break;
+    default:
+        // Paeth: для першого пікселя a = c = 0, тобто предиктор - b.
+        for (qsizetype i = 0; i < head; ++i) {
+            data[i] = uchar(row[i] - previous[i]);
+        }
+        for (qsizetype i = bpp; i < rowBytes; ++i) {
+            const int a = row[i - bpp];
+            const int b = previous[i];
+            const int c = previous[i - bpp];
+            const int pa = qAbs(b - c);
+            const int pb = qAbs(a - c);
+            const int pc = qAbs(a + b - 2 * c);
+            const int predictor = (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+            data[i] = uchar(row[i] - predictor);
+        }
+        break;
+    }
+}
+
+/**
+ * @brief Оцінка відфільтрованого рядка: сума модулів байтів як знакових чисел.
+ */
+static qint64 filterCost(const uchar* data, qsizetype rowBytes) {
+    qint64 sum = 0;
+    for (qsizetype i = 0; i < rowBytes; ++i) {
+        sum += qAbs(int(qint8(data[i])));
+    }
+    return sum;
+}
+
+/**
+ * @brief Фільтрація рядка.
+ *
+ * @param row Рядок (pixelBytes байтів на піксель).
+ * @param previous Попередній рядок (нулі для першого рядка).
+ * @param out Вихідний буфер (байт фільтра + rowBytes байтів).
+ * @param scratch Робочий буфер того ж розміру (для адаптивного фільтра).
+ * @param rowBytes Довжина рядка в байтах.
+ * @param pixelBytes Байтів на піксель.
+ * @param filter Фільтр.
+ */
+void PngWriter::filterRow(const uchar* row, const uchar* previous, uchar* out, uchar* scratch,
+                          qsizetype rowBytes, int pixelBytes, PngFilter filter) {
+    if (filter != PngFilter::Adaptive) {
+        applyFilter(int(filter), row, previous, out, rowBytes, pixelBytes);
+        return;
+    }
+
+    // Найкращий варіант - у best, пробний - у trial (буфери міняються місцями).
+    uchar* best = out;
+    uchar* trial = scratch;
+    qint64 bestCost = -1;
+
+    for (int f = 0; f < 5; ++f) {
+        applyFilter(f, row, previous, trial, rowBytes, pixelBytes);
+        const qint64 cost = filterCost(trial + 1, rowBytes);
+        if (bestCost < 0 || cost < bestCost) {
+            bestCost = cost;
+            qSwap(best, trial);
+        }
+    }
+
+    if (best != out) {
+        std::memcpy(out, best, size_t(rowBytes + 1));
+    }
+}
+
+/* ============================================================================
+ *                          НАЛАШТУВАННЯ
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор.
+ * @param fileName Шлях до вихідного файлу.
+ */
+PngWriter::PngWriter(const QString& fileName)
+    : fileName(fileName) {
+}
+
+/**
+ * @brief Вибір фільтра рядків.
+ * @param filter Фільтр.
+ */
+void PngWriter::setFilter(PngFilter filter) {
+    rowFilter = filter;
+}
+
+/**
+ * @brief Рівень стиснення zlib.
+ * @param level 0 (без стиснення) - 9 (найкраще).
+ */
+void PngWriter::setCompressionLevel(int level) {
+    this->level = qBound(0, level, 9);
+}
+
+/**
+ * @brief Кількість потоків стиснення.
+ * @param threads Кількість потоків (0 - усі ядра).
+ */
+void PngWriter::setThreadCount(int threads) {
+    threadCount = qMax(0, threads);
+}
+
+/**
+ * @brief Опис останньої помилки.
+ * @return Текст помилки.
+ */
+QString PngWriter::errorString() const {
+    return error;
+}
+
+/* ============================================================================
+ *                              ЗАПИС ФАЙЛУ
+ * ============================================================================
+ */
+
+/**
+ * @brief Запис зображення.
+ *
+ * Алгоритм:
+ * 1. Сигнатура та IHDR (8 бітів на канал, RGB або RGBA, без інтерлейсу).
+ * 2. Заголовок zlib (2 байти) - на початку першого блока.
+ * 3. Хвилями по (потоки × 4) блоків: блоки стискаються паралельно,
+ *    потім записуються по порядку окремими блоками IDAT.
+ * 4. Adler-32 усіх даних - у кінці останнього блока, потім IEND.
+ *
+ * @param image Зображення.
+ * @return true у разі успіху.
+ */
+bool PngWriter::write(const QImage& image) {
+    if (image.isNull()) {
+        error = "Empty image";
+        return false;
+    }
+
+    const bool alpha = image.hasAlphaChannel();
+    const QImage source = image.convertToFormat(alpha ? QImage::Format_ARGB32
+                                                      : QImage::Format_RGB32);
+    const int width = source.width();
+    const int height = source.height();
+    pixelBytes = alpha ? 4 : 3;
+    rowBytes = qsizetype(width) * pixelBytes;
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        error = file.errorString();
+        return false;
+    }
+
+    // ========== КРОК 1: Сигнатура та IHDR ==========
+    QByteArray ihdr(13, 0);
+    qToBigEndian<quint32>(quint32(width), ihdr.data());
+    qToBigEndian<quint32>(quint32(height), ihdr.data() + 4);
+    ihdr[8] = 8;                 // Біт на канал.
+    ihdr[9] = alpha ? 6 : 2;     // Тип кольору: RGBA або RGB.
+    ihdr[10] = 0;                // Стиснення: deflate.
+    ihdr[11] = 0;                // Фільтрація: адаптивна.
+    ihdr[12] = 0;                // Без інтерлейсу.
+
+    if (file.write(PNG_SIGNATURE, 8) != 8 || !writeChunk(file, "IHDR", ihdr)) {
+        return false;
+    }
+
+    // ========== КРОК 2: Заголовок zlib ==========
+    // CMF: deflate, вікно 32 KB; FLEVEL - лише підказка декодеру.
+    const int flevel = level < 2 ? 0 : (level < 6 ? 1 : (level == 6 ? 2 : 3));
+    const int cmf = 0x78;
+    int flg = flevel << 6;
+    flg += 31 - (cmf * 256 + flg) % 31;
+    const QByteArray zlibHeader = QByteArray(1, char(cmf)) + char(flg);
+
+    // ========== КРОК 3: Паралельне стиснення хвилями ==========
+    const int rowsPerBlock = int(qMax<qsizetype>(1, BLOCK_BYTES / (rowBytes + 1)));
+    const int blockCount = (height + rowsPerBlock - 1) / rowsPerBlock;
+    const int threads = qMax(1, threadCount > 0 ? threadCount : QThread::idealThreadCount());
+    const int wave = threads * BLOCKS_PER_THREAD;
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+
+    quint32 adler = quint32(adler32(0L, Z_NULL, 0));
+    QVector<Block> blocks(qMin(wave, blockCount));
+
+    for (int first = 0; first < blockCount; first += wave) {
+        const int count = qMin(wave, blockCount - first);
+        Block* results = blocks.data();
+
+        for (int i = 0; i < count; ++i) {
+            const int firstRow = (first + i) * rowsPerBlock;
+            const int lastRow = qMin(height, firstRow + rowsPerBlock);
+            results[i] = Block();
+            if (threads == 1) {
+                compressBlock(source, firstRow, lastRow, results[i]);
+            } else {
+                pool.start([this, &source, firstRow, lastRow, results, i]() {
+                    compressBlock(source, firstRow, lastRow, results[i]);
+                });
+            }
+        }
+        pool.waitForDone();
+
+        // ========== Запис блоків по порядку ==========
+        for (int i = 0; i < count; ++i) {
+            Block& block = blocks[i];
+            if (!block.ok) {
+                error = "zlib compression error";
+                return false;
+            }
+
+            adler = quint32(adler32_combine(adler, block.adler, z_off_t(block.size)));
+            if (first + i == 0) {
+                block.data.prepend(zlibHeader);
+            }
+            if (first + i == blockCount - 1) {
+                QByteArray checksum(4, 0);
+                qToBigEndian<quint32>(adler, checksum.data());
+                block.data.append(checksum);
+            }
+
+            if (!writeChunk(file, "IDAT", block.data)) {
+                return false;
+            }
+            block.data.clear();
+        }
+    }
+
+    // ========== КРОК 4: IEND ==========
+    if (!writeChunk(file, "IEND", QByteArray())) {
+        return false;
+    }
+
+    if (!file.commit()) {
+        error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Фільтрація та стиснення блока рядків.
+ *
+ * Алгоритм:
+ * 1. Фільтруємо рядки словника - до 32 KB наприкінці попереднього блока
+ *    (ті самі байти, що запише задача попереднього блока).
+ * 2. Фільтруємо рядки блока.
+ * 3. Стискаємо блок у сирий потік deflate зі словником; останній
+ *    блок завершується Z_FINISH, решта - Z_SYNC_FLUSH.
+ *
+ * @param image Зображення RGB32 або ARGB32.
+ * @param firstRow Перший рядок блока.
+ * @param lastRow Рядок після останнього.
+ * @param block Результат (вихідний параметр).
+ */
+void PngWriter::compressBlock(const QImage& image, int firstRow, int lastRow, Block& block) const {
+    const qsizetype lineBytes = rowBytes + 1;
+    const int dictionaryRows = int(qMin<qsizetype>(firstRow,
+                                                   (DICTIONARY_SIZE + lineBytes - 1) / lineBytes));
+    const int startRow = firstRow - dictionaryRows;
+
+    // ========== КРОКИ 1-2: Фільтрація ==========
+    QByteArray filtered(qsizetype(lastRow - startRow) * lineBytes, '\0');
+    QByteArray current(rowBytes, '\0');
+    QByteArray previous(rowBytes, '\0');
+    QByteArray scratch(lineBytes, '\0');
+
+    if (startRow > 0) {
+        convertRow(image, startRow - 1, reinterpret_cast<uchar*>(previous.data()));
+    }
+    for (int y = startRow; y < lastRow; ++y) {
+        convertRow(image, y, reinterpret_cast<uchar*>(current.data()));
+        filterRow(reinterpret_cast<const uchar*>(current.constData()),
+                  reinterpret_cast<const uchar*>(previous.constData()),
+                  reinterpret_cast<uchar*>(filtered.data()) + qsizetype(y - startRow) * lineBytes,
+                  reinterpret_cast<uchar*>(scratch.data()), rowBytes, pixelBytes, rowFilter);
+        current.swap(previous);
+    }
+
+    const qsizetype dictionaryBytes = qsizetype(dictionaryRows) * lineBytes;
+    const Bytef* input = reinterpret_cast<const Bytef*>(filtered.constData()) + dictionaryBytes;
+    const qsizetype inputBytes = filtered.size() - dictionaryBytes;
+
+    // ========== КРОК 3: Стиснення ==========
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    // Як у libpng: для відфільтрованих рядків - стратегія Z_FILTERED.
+    const int strategy = rowFilter == PngFilter::None ? Z_DEFAULT_STRATEGY : Z_FILTERED;
+    if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, strategy) != Z_OK) {
+        return;
+    }
+
+    if (dictionaryBytes > 0) {
+        const qsizetype size = qMin(DICTIONARY_SIZE, dictionaryBytes);
+        deflateSetDictionary(&stream, input - size, uInt(size));
+    }
+
+    // Z_SYNC_FLUSH додає порожній збережений блок (5 байтів).
+    block.data.resize(qsizetype(deflateBound(&stream, uLong(inputBytes))) + 16);
+    stream.next_in = const_cast<Bytef*>(input);
+    stream.avail_in = uInt(inputBytes);
+    stream.next_out = reinterpret_cast<Bytef*>(block.data.data());
+    stream.avail_out = uInt(block.data.size());
+
+    const bool last = lastRow == image.height();
+    const int status = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    const bool complete = last ? status == Z_STREAM_END
+                               : status == Z_OK && stream.avail_in == 0 && stream.avail_out > 0;
+
+    block.data.resize(qsizetype(stream.total_out));
+    deflateEnd(&stream);
+
+    block.adler = quint32(adler32(adler32(0L, Z_NULL, 0), input, uInt(inputBytes)));
+    block.size = inputBytes;
+    block.ok = complete;
+}
+
+/**
+ * @brief Перетворення рядка зображення в байти PNG.
+ *
+ * @param image Зображення RGB32 або ARGB32.
+ * @param y Номер рядка.
+ * @param out Вихідний рядок (RGB або RGBA).
+ */
+void PngWriter::convertRow(const QImage& image, int y, uchar* out) const {
+    const QRgb* line = reinterpret_cast<const QRgb*>(image.constScanLine(y));
+    const int width = image.width();
+
+    if (pixelBytes == 4) {
+        for (int x = 0; x < width; ++x) {
+            out[4 * x] = uchar(qRed(line[x]));
+            out[4 * x + 1] = uchar(qGreen(line[x]));
+            out[4 * x + 2] = uchar(qBlue(line[x]));
+            out[4 * x + 3] = uchar(qAlpha(line[x]));
+        }
+    } else {
+        for (int x = 0; x < width; ++x) {
+            out[3 * x] = uchar(qRed(line[x]));
+            out[3 * x + 1] = uchar(qGreen(line[x]));
+            out[3 * x + 2] = uchar(qBlue(line[x]));
+        }
+    }
+}
+
+/**
+ * @brief Запис блока PNG (довжина, тип, дані, CRC).
+ *
+ * @param file Вихідний файл.
+ * @param type Тип блока (4 символи).
+ * @param data Дані блока.
+ * @return true у разі успіху.
+ */
+bool PngWriter::writeChunk(QSaveFile& file, const char* type, const QByteArray& data) {
+    QByteArray chunk(8, 0);
+    qToBigEndian<quint32>(quint32(data.size()), chunk.data());
+    std::memcpy(chunk.data() + 4, type, 4);
+
+    // CRC обчислюється по типу та даних.
+    uLong crc = crc32(0L, reinterpret_cast<const Bytef*>(type), 4);
+    crc = crc32(crc, reinterpret_cast<const Bytef*>(data.constData()), uInt(data.size()));
+
+    QByteArray crcBytes(4, 0);
+    qToBigEndian<quint32>(quint32(crc), crcBytes.data());
+
+    if (file.write(chunk) != chunk.size() || file.write(data) != data.size() ||
+        file.write(crcBytes) != 4) {
+        error = file.errorString();
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,163 @@
+/*
+ * PngWriter.h
+ *
+ * Заголовочний файл швидкого запису PNG для результатів приховування.
+ * Замінює QImage::save, що стискає файл в одному потоці.
+ *
+ * Основні можливості:
+ * - Запис 8-бітного RGB або RGBA PNG (молодші біти зберігаються без втрат).
+ * - Вибір фільтра рядків (фіксований або адаптивний) та рівня zlib.
+ * - Паралельне стиснення незалежних блоків рядків (як pigz): потоки
+ *   deflate блоків з'єднуються в один потік zlib без перекодування.
+ */
+
+#ifndef PNGWRITER_H
+#define PNGWRITER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QImage>
+
+class QSaveFile;
+
+/**
+ * @enum PngFilter
+ * @brief Фільтр рядків PNG.
+ */
+enum class PngFilter {
+    None,       ///< Без фільтра (найшвидше).
+    Sub,        ///< Різниця з лівим пікселем.
+    Up,         ///< Різниця з верхнім пікселем.
+    Average,    ///< Різниця із середнім лівого та верхнього.
+    Paeth,      ///< Предиктор Паета.
+    Adaptive    ///< Найкращий з п'яти для кожного рядка (евристика libpng).
+};
+
+/**
+ * @class PngWriter
+ * @brief Запис зображення у PNG з паралельним стисненням.
+ *
+ * Рядки діляться на блоки (~256 KB), кожен блок фільтрується та
+ * стискається окремою задачею пулу потоків у "сирий" потік deflate.
+ * Усі блоки, крім останнього, завершуються Z_SYNC_FLUSH (вирівнювання
+ * на байт без ознаки останнього блока), тому їх конкатенація - коректний
+ * потік deflate. Словником блока слугують останні 32 KB попереднього
+ * блока (їх задача фільтрує сама), тож стиснення майже не гірше за
+ * послідовне. Контрольна сума Adler-32 збирається з сум блоків
+ * (adler32_combine). Результат не залежить від кількості потоків.
+ *
+ * Блоки обробляються хвилями, тому в пам'яті одночасно знаходяться
+ * стиснуті дані лише кількох блоків на потік.
+ */
+class PngWriter {
+public:
+    /**
+     * @brief Конструктор.
+     * @param fileName Шлях до вихідного файлу.
+     */
+    explicit PngWriter(const QString& fileName);
+
+    /**
+     * @brief Вибір фільтра рядків.
+     * @param filter Фільтр (за замовчуванням - адаптивний).
+     */
+    void setFilter(PngFilter filter);
+
+    /**
+     * @brief Рівень стиснення zlib.
+     * @param level 0 (без стиснення) - 9 (найкраще), за замовчуванням 6.
+     */
+    void setCompressionLevel(int level);
+
+    /**
+     * @brief Кількість потоків стиснення.
+     * @param threads Кількість потоків (0 - усі ядра).
+     */
+    void setThreadCount(int threads);
+
+    /**
+     * @brief Запис зображення.
+     *
+     * Зображення з альфа-каналом записується як RGBA, інші - як RGB.
+     * Файл замінюється лише після успішного запису.
+     *
+     * @param image Зображення.
+     * @return true у разі успіху.
+     */
+    bool write(const QImage& image);
+
+    /**
+     * @brief Опис останньої помилки.
+     * @return Текст помилки.
+     */
+    QString errorString() const;
+
+    /**
+     * @brief Фільтрація рядка.
+     *
+     * Для адаптивного фільтра пробує всі 5 і обирає той, що дає
+     * найменшу суму модулів байтів як знакових чисел.
+     *
+     * @param row Рядок (pixelBytes байтів на піксель).
+     * @param previous Попередній рядок (нулі для першого рядка).
+     * @param out Вихідний буфер (байт фільтра + rowBytes байтів).
+     * @param scratch Робочий буфер того ж розміру (для адаптивного фільтра).
+     * @param rowBytes Довжина рядка в байтах.
+     * @param pixelBytes Байтів на піксель.
+     * @param filter Фільтр.
+     */
+    static void filterRow(const uchar* row, const uchar* previous, uchar* out, uchar* scratch,
+                          qsizetype rowBytes, int pixelBytes, PngFilter filter);
+
+private:
+    /**
+     * @struct Block
+     * @brief Результат стиснення блока рядків.
+     */
+    struct Block {
+        QByteArray data;        ///< Стиснуті дані (потік deflate без обгортки).
+        quint32 adler = 1;      ///< Adler-32 відфільтрованих даних блока.
+        qint64 size = 0;        ///< Розмір відфільтрованих даних блока.
+        bool ok = false;        ///< Чи стиснуто без помилок.
+    };
+
+    /**
+     * @brief Фільтрація та стиснення блока рядків.
+     *
+     * @param image Зображення RGB32 або ARGB32.
+     * @param firstRow Перший рядок блока.
+     * @param lastRow Рядок після останнього.
+     * @param block Результат (вихідний параметр).
+     */
+    void compressBlock(const QImage& image, int firstRow, int lastRow, Block& block) const;
+
+    /**
+     * @brief Перетворення рядка зображення в байти PNG.
+     *
+     * @param image Зображення RGB32 або ARGB32.
+     * @param y Номер рядка.
+     * @param out Вихідний рядок (RGB або RGBA).
+     */
+    void convertRow(const QImage& image, int y, uchar* out) const;
+
+    /**
+     * @brief Запис блока PNG (довжина, тип, дані, CRC).
+     *
+     * @param file Вихідний файл.
+     * @param type Тип блока (4 символи).
+     * @param data Дані блока.
+     * @return true у разі успіху.
+     */
+    bool writeChunk(QSaveFile& file, const char* type, const QByteArray& data);
+
+    // ========== Дані ==========
+    QString fileName;                       ///< Шлях до вихідного файлу.
+    QString error;                          ///< Опис останньої помилки.
+    PngFilter rowFilter = PngFilter::Adaptive;  ///< Фільтр рядків.
+    int level = 6;                          ///< Рівень стиснення zlib.
+    int threadCount = 0;                    ///< Потоки стиснення (0 - усі ядра).
+    int pixelBytes = 3;                     ///< Байтів на піксель (3 або 4).
+    qsizetype rowBytes = 0;                 ///< Байтів у рядку без байта фільтра.
+};
+
+#endif // PNGWRITER_H
@@ -0,0 +1,735 @@
+/*
+ * ReedSolomon.cpp
+ *
+ * Реалізація коду Ріда-Соломона зі стиранням над GF(256)
+ * (систематична матриця Коші, табличне множення) та коду, що
+ * виправляє помилки (кодові слова з чергуванням байтів).
+ */
+
+#include "ReedSolomon.h"
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define REEDSOLOMON_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define REEDSOLOMON_HAS_SSE2 0
+#endif
+
+/// Примітивний поліном поля GF(2^8): x^8 + x^4 + x^3 + x^2 + 1.
+static const int GF_POLYNOMIAL = 0x11D;
+
+/// Кодових слів за ітерацію векторного ядра парності.
+static const qsizetype SIMD_LANES = 16;
+
+/* ============================================================================
+ *                          ТАБЛИЦІ ПОЛЯ GF(256)
+ * ============================================================================
+ */
+
+/**
+ * @struct GaloisTables
+ * @brief Таблиці логарифмів, степенів і добутків поля GF(256).
+ *
+ * Таблиця степенів подвоєна (512 елементів), щоб сума двох логарифмів
+ * не потребувала зведення за модулем 255.
+ */
+struct GaloisTables {
+    uchar exp[512];            ///< α^i.
+    uchar log[256];            ///< log_α(x), log[0] не визначений.
+    uchar product[256][256];   ///< product[a][b] = a × b.
+
+    GaloisTables() {
+        int x = 1;
+        for (int i = 0; i < 255; ++i) {
+            exp[i] = uchar(x);
+            exp[i + 255] = uchar(x);
+            log[x] = uchar(i);
+            x <<= 1;
+            if (x & 0x100) {
+                x ^= GF_POLYNOMIAL;
+            }
+        }
+        exp[510] = exp[0];
+        exp[511] = exp[1];
+        log[0] = 0;
+
+        for (int a = 0; a < 256; ++a) {
+            product[0][a] = 0;
+            product[a][0] = 0;
+        }
+        for (int a = 1; a < 256; ++a) {
+            for (int b = 1; b < 256; ++b) {
+                product[a][b] = exp[log[a] + log[b]];
+            }
+        }
+    }
+};
+
+/**
+ * @brief Таблиці поля (будуються один раз, потокобезпечно).
+ */
+static const GaloisTables& galois() {
+    static const GaloisTables tables;
+    return tables;
+}
+
+/* ============================================================================
+ *                          АРИФМЕТИКА ПОЛЯ
+ * ============================================================================
+ */
+
+/**
+ * @brief Добуток у полі GF(256).
+ */
+uchar ReedSolomon::multiply(uchar a, uchar b) {
+    return galois().product[a][b];
+}
+
+/**
+ * @brief Обернений елемент у полі GF(256): α^(255 - log a).
+ * @param a Ненульовий елемент.
+ */
+uchar ReedSolomon::inverse(uchar a) {
+    const GaloisTables& gf = galois();
+    return gf.exp[255 - gf.log[a]];
+}
+
+/**
+ * @brief Рядок таблиці добутків: row[x] = c × x.
+ * @param c Множник.
+ * @return 256 добутків.
+ */
+const uchar* ReedSolomon::productRow(uchar c) {
+    return galois().product[c];
+}
+
+/**
+ * @brief Додавання фрагмента, помноженого на константу: out ^= c × in.
+ *
+ * Рядок таблиці добутків (256 байтів) залишається в кеші L1,
+ * тож на байт фрагмента припадає одне зчитування таблиці.
+ *
+ * @param out Фрагмент-накопичувач.
+ * @param in Вхідний фрагмент.
+ * @param size Розмір фрагментів.
+ * @param c Множник.
+ */
+void ReedSolomon::multiplyAdd(uchar* out, const uchar* in, qsizetype size, uchar c) {
+    if (c == 0) {
+        return;
+    }
+    if (c == 1) {
+        for (qsizetype i = 0; i < size; ++i) {
+            out[i] ^= in[i];
+        }
+        return;
+    }
+
+    const uchar* row = productRow(c);
+    for (qsizetype i = 0; i < size; ++i) {
+        out[i] ^= row[in[i]];
+    }
+}
+
+/* ============================================================================
+ *                          КОДУВАННЯ ТА ВІДНОВЛЕННЯ
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор.
+ *
+ * @param dataShards Кількість фрагментів даних k (щонайменше 1).
+ * @param parityShards Кількість фрагментів парності m (k + m <= MAX_SHARDS).
+ */
+ReedSolomon::ReedSolomon(int dataShards, int parityShards)
+    : dataCount(qBound(1, dataShards, MAX_SHARDS)),
+    parityCount(qBound(0, parityShards, MAX_SHARDS - dataCount)) {
+}
+
+/**
+ * @brief Кількість фрагментів даних.
+ * @return k.
+ */
+int ReedSolomon::dataShards() const {
+    return dataCount;
+}
+
+/**
+ * @brief Кількість фрагментів парності.
+ * @return m.
+ */
+int ReedSolomon::parityShards() const {
+    return parityCount;
+}
+
+/**
+ * @brief Рядок твірної матриці [I; C] для фрагмента.
+ *
+ * Фрагмент даних j - одиничний рядок, фрагмент парності i -
+ * рядок матриці Коші 1 / ((k + i) ^ j). Елементи x_i та y_j різні,
+ * тому знаменник ніколи не дорівнює нулю.
+ *
+ * @param shard Номер фрагмента (0..k+m-1).
+ * @return k коефіцієнтів.
+ */
+QVector<uchar> ReedSolomon::generatorRow(int shard) const {
+    QVector<uchar> row(dataCount, 0);
+    if (shard < dataCount) {
+        row[shard] = 1;
+        return row;
+    }
+
+    for (int j = 0; j < dataCount; ++j) {
+        row[j] = inverse(uchar(shard ^ j));
+    }
+    return row;
+}
+
+/**
+ * @brief Обчислення фрагментів парності.
+ *
+ * @param data k фрагментів даних однакового розміру.
+ * @return m фрагментів парності того ж розміру.
+ */
+QVector<QByteArray> ReedSolomon::encode(const QVector<QByteArray>& data) const {
+    QVector<QByteArray> parity;
+    if (data.size() != dataCount) {
+        return parity;
+    }
+
+    const qsizetype size = data.first().size();
+    for (int i = 0; i < parityCount; ++i) {
+        QByteArray shard(size, '\0');
+        uchar* out = reinterpret_cast<uchar*>(shard.data());
+        const QVector<uchar> row = generatorRow(dataCount + i);
+
+        for (int j = 0; j < dataCount; ++j) {
+            multiplyAdd(out, reinterpret_cast<const uchar*>(data[j].constData()), size, row[j]);
+        }
+        parity.append(shard);
+    }
+    return parity;
+}
+
+/**
+ * @brief Відновлення втрачених фрагментів даних.
+ *
+ * Алгоритм:
+ * 1. Беремо перші k збережених фрагментів і відповідні рядки [I; C].
+ * 2. Обертаємо утворену k × k матрицю A: збережені = A × дані.
+ * 3. Кожен втрачений фрагмент даних j = Σ A⁻¹[j][t] × збережений_t.
+ *
+ * Фрагменти парності не відновлюються - для даних вони не потрібні.
+ *
+ * @param shards k + m фрагментів; втрачені - порожні масиви.
+ * @return false якщо збережено менше k фрагментів або їх розміри різні.
+ */
+bool ReedSolomon::reconstruct(QVector<QByteArray>& shards) const {
+    if (shards.size() != dataCount + parityCount) {
+        return false;
+    }
+
+    // ========== КРОК 1: Збережені фрагменти ==========
+    QVector<int> present;
+    qsizetype size = -1;
+    for (int i = 0; i < shards.size() && present.size() < dataCount; ++i) {
+        if (shards[i].isEmpty()) {
+            continue;
+        }
+        if (size >= 0 && shards[i].size() != size) {
+            return false;
+        }
+        size = shards[i].size();
+        present.append(i);
+    }
+    if (present.size() < dataCount) {
+        return false;
+    }
+
+    QVector<int> missing;
+    for (int j = 0; j < dataCount; ++j) {
+        if (shards[j].isEmpty()) {
+            missing.append(j);
+        }
+    }
+    if (missing.isEmpty()) {
+        return true;
+    }
+
+    // ========== КРОК 2: Обернена матриця ==========
+    QVector<uchar> matrix;
+    matrix.reserve(dataCount * dataCount);
+    for (int shard : present) {
+        matrix += generatorRow(shard);
+    }
+    if (!invert(matrix)) {
+        return false;
+    }
+
+    // ========== КРОК 3: Втрачені фрагменти даних ==========
+    for (int j : missing) {
+        QByteArray shard(size, '\0');
+        uchar* out = reinterpret_cast<uchar*>(shard.data());
+        for (int t = 0; t < dataCount; ++t) {
+            multiplyAdd(out, reinterpret_cast<const uchar*>(shards[present[t]].constData()),
+                        size, matrix[j * dataCount + t]);
+        }
+        shards[j] = shard;
+    }
+    return true;
+}
+
+/**
+ * @brief Обертання k × k матриці методом Гаусса-Жордана.
+ *
+ * Віднімання в GF(2^8) - XOR, тому рядки виключаються додаванням.
+ *
+ * @param matrix Матриця за рядками (замінюється оберненою).
+ * @return false якщо матриця вироджена.
+ */
+bool ReedSolomon::invert(QVector<uchar>& matrix) const {
+    const int n = dataCount;
+    QVector<uchar> result(n * n, 0);
+    for (int i = 0; i < n; ++i) {
+        result[i * n + i] = 1;
+    }
+
+    for (int column = 0; column < n; ++column) {
+        // Опорний рядок з ненульовим елементом.
+        int pivot = column;
+        while (pivot < n && matrix[pivot * n + column] == 0) {
+            ++pivot;
+        }
+        if (pivot == n) {
+            return false;
+        }
+        if (pivot != column) {
+            for (int c = 0; c < n; ++c) {
+                qSwap(matrix[pivot * n + c], matrix[column * n + c]);
+                qSwap(result[pivot * n + c], result[column * n + c]);
+            }
+        }
+
+        // Нормуємо опорний рядок.
+        const uchar scale = inverse(matrix[column * n + column]);
+        for (int c = 0; c < n; ++c) {
+            matrix[column * n + c] = multiply(matrix[column * n + c], scale);
+            result[column * n + c] = multiply(result[column * n + c], scale);
+        }
+
+        // Виключаємо стовпець з інших рядків.
+        for (int r = 0; r < n; ++r) {
+            const uchar factor = matrix[r * n + column];
+            if (r == column || factor == 0) {
+                continue;
+            }
+            multiplyAdd(matrix.data() + r * n, matrix.constData() + column * n, n, factor);
+            multiplyAdd(result.data() + r * n, result.constData() + column * n, n, factor);
+        }
+    }
+
+    matrix = result;
+    return true;
+}
+
+/* ============================================================================
+ *                  ВИПРАВЛЕННЯ ПОМИЛОК (КОДОВІ СЛОВА З ЧЕРГУВАННЯМ)
+ * ============================================================================
+ */
+
+/**
+ * @brief Чи підтримується кількість символів парності.
+ *
+ * @param paritySymbols Кількість символів парності (2t).
+ * @return true для парних значень від 2 до MAX_PARITY_SYMBOLS.
+ */
+static bool validParity(int paritySymbols) {
+    return paritySymbols >= 2 && paritySymbols <= ReedSolomon::MAX_PARITY_SYMBOLS &&
+           paritySymbols % 2 == 0;
+}
+
+/**
+ * @brief Кількість кодових слів для блоку даних.
+ *
+ * @param dataSize Розмір даних у байтах.
+ * @param paritySymbols Кількість символів парності на слово (2t).
+ * @return Найменша кількість слів довжиною не більше MAX_CODEWORD.
+ */
+qsizetype ReedSolomon::codewordCount(qsizetype dataSize, int paritySymbols) {
+    if (dataSize <= 0 || !validParity(paritySymbols)) {
+        return 0;
+    }
+    const qsizetype dataSymbols = MAX_CODEWORD - paritySymbols;
+    return (dataSize + dataSymbols - 1) / dataSymbols;
+}
+
+/**
+ * @brief Розмір закодованого блоку.
+ *
+ * Дані діляться між C словами порівну: ⌈N / C⌉ символів даних на слово
+ * (останні слова доповнюються нулями), до кожного додається 2t символів.
+ *
+ * @param dataSize Розмір даних у байтах.
+ * @param paritySymbols Кількість символів парності на слово (2t).
+ * @return Розмір даних з доповненням і парністю.
+ */
+qsizetype ReedSolomon::encodedSize(qsizetype dataSize, int paritySymbols) {
+    const qsizetype lanes = codewordCount(dataSize, paritySymbols);
+    if (lanes == 0) {
+        return 0;
+    }
+    const qsizetype dataSymbols = (dataSize + lanes - 1) / lanes;
+    return lanes * (dataSymbols + paritySymbols);
+}
+
+/**
+ * @brief Кодування блоку даних з чергуванням.
+ *
+ * Блок складається з рядків по C байтів: рядок r містить r-й символ
+ * кожного слова. Рядки даних - це самі дані (байт i - символ i / C
+ * слова i mod C), за ними йдуть 2t рядків парності.
+ *
+ * @param data Дані.
+ * @param paritySymbols Кількість символів парності на слово (2t, парне).
+ * @return Дані, доповнення нулями та рядки парності (порожній масив,
+ *         якщо даних немає або 2t непідтримуване).
+ */
+QByteArray ReedSolomon::encodeInterleaved(const QByteArray& data, int paritySymbols) {
+    const qsizetype lanes = codewordCount(data.size(), paritySymbols);
+    if (lanes == 0) {
+        return QByteArray();
+    }
+
+    const int dataSymbols = int((data.size() + lanes - 1) / lanes);
+    QByteArray block(lanes * (dataSymbols + paritySymbols), '\0');
+    memcpy(block.data(), data.constData(), size_t(data.size()));
+
+    uchar* rows = reinterpret_cast<uchar*>(block.data());
+    parityRows(rows, lanes, dataSymbols, generatorPolynomial(paritySymbols),
+               rows + lanes * dataSymbols);
+    return block;
+}
+
+/**
+ * @brief Виправлення помилок у закодованому блоці на місці.
+ *
+ * Алгоритм:
+ * 1. Перераховуємо парність з рядків даних (те ж векторне ядро, що
+ *    й під час кодування) і порівнюємо з записаною.
+ * 2. Блок без розбіжностей повертаємо одразу - це звичайний випадок.
+ * 3. Слова з розбіжністю декодуємо окремо (синдроми, локатор, значення).
+ *
+ * @param block Закодований блок (encodedSize() байтів).
+ * @param dataSize Розмір даних у байтах.
+ * @param paritySymbols Кількість символів парності на слово (2t).
+ * @return Кількість виправлених байтів (-1 - якесь слово має більше t помилок).
+ */
+int ReedSolomon::decodeInterleaved(QByteArray& block, qsizetype dataSize, int paritySymbols) {
+    const qsizetype lanes = codewordCount(dataSize, paritySymbols);
+    if (lanes == 0 || block.size() != encodedSize(dataSize, paritySymbols)) {
+        return -1;
+    }
+
+    // ========== КРОК 1: Перерахунок парності ==========
+    const int dataSymbols = int((dataSize + lanes - 1) / lanes);
+    uchar* rows = reinterpret_cast<uchar*>(block.data());
+    const uchar* stored = rows + lanes * dataSymbols;
+
+    QByteArray expected(lanes * paritySymbols, '\0');
+    const uchar* computed = reinterpret_cast<const uchar*>(expected.constData());
+    parityRows(rows, lanes, dataSymbols, generatorPolynomial(paritySymbols),
+               reinterpret_cast<uchar*>(expected.data()));
+
+    // ========== КРОК 2: Слова з розбіжністю ==========
+    if (memcmp(stored, computed, size_t(expected.size())) == 0) {
+        return 0;
+    }
+
+    QVector<bool> damaged(lanes, false);
+    for (qsizetype i = 0; i < expected.size(); ++i) {
+        if (stored[i] != computed[i]) {
+            damaged[i % lanes] = true;
+        }
+    }
+
+    // ========== КРОК 3: Виправлення слів ==========
+    int corrected = 0;
+    for (qsizetype lane = 0; lane < lanes; ++lane) {
+        if (!damaged[lane]) {
+            continue;
+        }
+        const int errors = correctCodeword(rows, lanes, lane, dataSymbols + paritySymbols,
+                                           paritySymbols);
+        if (errors < 0) {
+            return -1;
+        }
+        corrected += errors;
+    }
+    return corrected;
+}
+
+/**
+ * @brief Коефіцієнти твірного полінома g(x) = Π (x + α^j), j < 2t.
+ *
+ * @param paritySymbols Кількість символів парності (2t).
+ * @return g_0..g_{2t-1} (старший коефіцієнт 1 не зберігається).
+ */
+QVector<uchar> ReedSolomon::generatorPolynomial(int paritySymbols) {
+    const GaloisTables& gf = galois();
+
+    // coefficients[k] - коефіцієнт при x^k; множимо на (x + α^j) на місці.
+    QVector<uchar> coefficients(paritySymbols + 1, 0);
+    coefficients[0] = 1;
+    for (int j = 0; j < paritySymbols; ++j) {
+        const uchar root = gf.exp[j];
+        for (int k = j + 1; k > 0; --k) {
+            coefficients[k] = coefficients[k - 1] ^ multiply(root, coefficients[k]);
+        }
+        coefficients[0] = multiply(root, coefficients[0]);
+    }
+
+    coefficients.resize(paritySymbols);
+    return coefficients;
+}
+
+/**
+ * @brief Рядки парності для всіх слів блоку (ділення на g(x) регістром зсуву).
+ *
+ * Для кожного символу даних: f = d ^ P[0], P[i] = P[i + 1] ^ g_(2t-1-i) × f,
+ * P[2t-1] = g_0 × f. Після всіх символів P - остача від ділення
+ * d(x) × x^2t на g(x), тобто символи парності (P[0] - старший).
+ *
+ * Векторний шлях (SSE2, 16 слів): добуток f на константу g збирається
+ * з f × α^b для встановлених бітів b числа g, а множення на α - це зсув
+ * на 1 біт і XOR з 0x1D для байтів зі старшим бітом. Таблиці не потрібні,
+ * тому 16 слів обробляються за ті ж кілька інструкцій, що й одне.
+ * Решта слів - табличний шлях (рядок таблиці добутків на коефіцієнт).
+ *
+ * @param data Рядки даних (рядок - по байту кожного слова).
+ * @param lanes Кількість слів C.
+ * @param dataSymbols Кількість рядків даних.
+ * @param generator Коефіцієнти твірного полінома.
+ * @param parity Вихідні рядки парності (2t × C байтів).
+ */
+void ReedSolomon::parityRows(const uchar* data, qsizetype lanes, int dataSymbols,
+                             const QVector<uchar>& generator, uchar* parity) {
+    const int paritySymbols = int(generator.size());
+    qsizetype lane = 0;
+
+#if REEDSOLOMON_HAS_SSE2
+    // Встановлені біти коефіцієнта для кожного кроку регістра.
+    int bitCount[MAX_PARITY_SYMBOLS];
+    int bitIndex[MAX_PARITY_SYMBOLS][8];
+    for (int i = 0; i < paritySymbols; ++i) {
+        const uchar g = generator[paritySymbols - 1 - i];
+        bitCount[i] = 0;
+        for (int b = 0; b < 8; ++b) {
+            if ((g >> b) & 1) {
+                bitIndex[i][bitCount[i]++] = b;
+            }
+        }
+    }
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i reduce = _mm_set1_epi8(char(GF_POLYNOMIAL & 0xFF));
+    __m128i registers[MAX_PARITY_SYMBOLS];
+
+    for (; lane + SIMD_LANES <= lanes; lane += SIMD_LANES) {
+        for (int i = 0; i < paritySymbols; ++i) {
+            registers[i] = zero;
+        }
+
+        for (int r = 0; r < dataSymbols; ++r) {
+            const __m128i symbol = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(data + r * lanes + lane));
+
+            // powers[b] = f × α^b.
+            __m128i powers[8];
+            powers[0] = _mm_xor_si128(symbol, registers[0]);
+            for (int b = 1; b < 8; ++b) {
+                const __m128i high = _mm_cmplt_epi8(powers[b - 1], zero);
+                powers[b] = _mm_xor_si128(_mm_add_epi8(powers[b - 1], powers[b - 1]),
+                                          _mm_and_si128(high, reduce));
+            }
+
+            for (int i = 0; i < paritySymbols; ++i) {
+                __m128i value = i + 1 < paritySymbols ? registers[i + 1] : zero;
+                for (int k = 0; k < bitCount[i]; ++k) {
+                    value = _mm_xor_si128(value, powers[bitIndex[i][k]]);
+                }
+                registers[i] = value;
+            }
+        }
+
+        for (int i = 0; i < paritySymbols; ++i) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(parity + i * lanes + lane), registers[i]);
+        }
+    }
+#endif
+
+    // Табличний шлях (або залишок).
+    const uchar* products[MAX_PARITY_SYMBOLS];
+    for (int i = 0; i < paritySymbols; ++i) {
+        products[i] = productRow(generator[paritySymbols - 1 - i]);
+    }
+
+    uchar state[MAX_PARITY_SYMBOLS];
+    for (; lane < lanes; ++lane) {
+        memset(state, 0, sizeof(state));
+
+        for (int r = 0; r < dataSymbols; ++r) {
+            const uchar feedback = data[r * lanes + lane] ^ state[0];
+            for (int i = 0; i + 1 < paritySymbols; ++i) {
+                state[i] = state[i + 1] ^ products[i][feedback];
+            }
+            state[paritySymbols - 1] = products[paritySymbols - 1][feedback];
+        }
+
+        for (int i = 0; i < paritySymbols; ++i) {
+            parity[i * lanes + lane] = state[i];
+        }
+    }
+}
+
+/**
+ * @brief Виправлення одного кодового слова блоку.
+ *
+ * Символ на позиції pos слова довжиною n - коефіцієнт при x^(n-1-pos).
+ *
+ * Алгоритм:
+ * 1. Синдроми S_j = r(α^j), j < 2t - схемою Горнера (рядок таблиці
+ *    добутків на α^j).
+ * 2. Локатор помилок Λ(x) алгоритмом Берлекемпа-Мессі; степінь
+ *    більше t означає, що слово не виправити.
+ * 3. Пошук Чена: позиції з Λ(α^-e) = 0, e = n-1-pos. Кількість коренів
+ *    має дорівнювати степеню Λ.
+ * 4. Формула Форні: значення помилки X × Ω(X⁻¹) / Λ'(X⁻¹), X = α^e,
+ *    Ω(x) = S(x) × Λ(x) mod x^2t.
+ *
+ * @param block Рядки блоку.
+ * @param lanes Кількість слів C.
+ * @param lane Номер слова.
+ * @param length Довжина слова n.
+ * @param paritySymbols Кількість символів парності (2t).
+ * @return Кількість виправлених символів (-1 - забагато помилок).
+ */
+int ReedSolomon::correctCodeword(uchar* block, qsizetype lanes, qsizetype lane, int length,
+                                 int paritySymbols) {
+    const GaloisTables& gf = galois();
+
+    uchar word[MAX_CODEWORD];
+    for (int pos = 0; pos < length; ++pos) {
+        word[pos] = block[pos * lanes + lane];
+    }
+
+    // ========== КРОК 1: Синдроми ==========
+    uchar syndromes[MAX_PARITY_SYMBOLS];
+    bool clean = true;
+    for (int j = 0; j < paritySymbols; ++j) {
+        const uchar* row = productRow(gf.exp[j]);
+        uchar value = 0;
+        for (int pos = 0; pos < length; ++pos) {
+            value = row[value] ^ word[pos];
+        }
+        syndromes[j] = value;
+        clean = clean && value == 0;
+    }
+    if (clean) {
+        return 0;
+    }
+
+    // ========== КРОК 2: Берлекемп-Мессі ==========
+    uchar locator[MAX_PARITY_SYMBOLS + 1] = {1};
+    uchar previous[MAX_PARITY_SYMBOLS + 1] = {1};
+    int degree = 0;
+    int shift = 1;
+    uchar lastDiscrepancy = 1;
+
+    for (int r = 0; r < paritySymbols; ++r) {
+        uchar discrepancy = syndromes[r];
+        for (int i = 1; i <= degree; ++i) {
+            discrepancy ^= multiply(locator[i], syndromes[r - i]);
+        }
+        if (discrepancy == 0) {
+            ++shift;
+            continue;
+        }
+
+        const uchar scale = multiply(discrepancy, inverse(lastDiscrepancy));
+        uchar saved[MAX_PARITY_SYMBOLS + 1];
+        const bool lengthen = 2 * degree <= r;
+        if (lengthen) {
+            memcpy(saved, locator, sizeof(saved));
+        }
+        for (int i = 0; i + shift <= paritySymbols; ++i) {
+            locator[i + shift] ^= multiply(scale, previous[i]);
+        }
+
+        if (lengthen) {
+            degree = r + 1 - degree;
+            memcpy(previous, saved, sizeof(saved));
+            lastDiscrepancy = discrepancy;
+            shift = 1;
+        } else {
+            ++shift;
+        }
+    }
+
+    if (degree == 0 || degree > paritySymbols / 2) {
+        return -1;
+    }
+
+    // ========== КРОК 3: Пошук Чена ==========
+    int positions[MAX_PARITY_SYMBOLS / 2];
+    int found = 0;
+    for (int pos = 0; pos < length; ++pos) {
+        const int inverseLog = (MAX_CODEWORD - (length - 1 - pos)) % MAX_CODEWORD;
+        uchar value = 0;
+        for (int i = 0; i <= degree; ++i) {
+            value ^= multiply(locator[i], gf.exp[(inverseLog * i) % MAX_CODEWORD]);
+        }
+        if (value == 0) {
+            if (found == degree) {
+                return -1;
+            }
+            positions[found++] = pos;
+        }
+    }
+    if (found != degree) {
+        return -1;
+    }
+
+    // ========== КРОК 4: Форні ==========
+    uchar evaluator[MAX_PARITY_SYMBOLS] = {0};
+    for (int i = 0; i < paritySymbols; ++i) {
+        for (int k = 0; k <= qMin(i, degree); ++k) {
+            evaluator[i] ^= multiply(locator[k], syndromes[i - k]);
+        }
+    }
+
+    for (int e = 0; e < found; ++e) {
+        const int pos = positions[e];
+        const int power = length - 1 - pos;
+        const int inverseLog = (MAX_CODEWORD - power) % MAX_CODEWORD;
+
+        uchar omega = 0;
+        for (int i = 0; i < paritySymbols; ++i) {
+            omega ^= multiply(evaluator[i], gf.exp[(inverseLog * i) % MAX_CODEWORD]);
+        }
+        // Похідна в полі характеристики 2 - лише непарні степені.
+        uchar derivative = 0;
+        for (int i = 1; i <= degree; i += 2) {
+            derivative ^= multiply(locator[i], gf.exp[(inverseLog * (i - 1)) % MAX_CODEWORD]);
+        }
+        if (derivative == 0) {
+            return -1;
+        }
+
+        const uchar magnitude = multiply(gf.exp[power], multiply(omega, inverse(derivative)));
+        block[pos * lanes + lane] = word[pos] ^ magnitude;
+    }
+
+    return found;
+}
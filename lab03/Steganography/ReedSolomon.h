@@ -0,0 +1,215 @@
+/*
+ * ReedSolomon.h
+ *
+ * Заголовочний файл коду Ріда-Соломона над полем GF(256).
+ * Використовується для розподілу навантаження між кількома
+ * контейнерами: k фрагментів даних доповнюються m фрагментами
+ * парності, і дані відновлюються з будь-яких k фрагментів.
+ *
+ * Основні можливості:
+ * - Систематичний код зі стиранням на матриці Коші (k + m <= 256).
+ * - Арифметика GF(2^8) з поліномом 0x11D через таблиці log/exp
+ *   і таблиці добутків (один прохід таблиці на байт фрагмента).
+ * - Відновлення втрачених фрагментів даних обертанням k × k матриці.
+ * - Виправлення помилок у блоці даних: кодові слова RS(n, n - 2t) з
+ *   чергуванням байтів, парність - регістром зсуву (SSE2 по 16 словах),
+ *   декодування - Берлекемп-Мессі, пошук Чена та формула Форні.
+ */
+
+#ifndef REEDSOLOMON_H
+#define REEDSOLOMON_H
+
+#include <QByteArray>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @class ReedSolomon
+ * @brief Код Ріда-Соломона зі стиранням для фрагментів однакового розміру.
+ *
+ * Фрагмент парності i - лінійна комбінація фрагментів даних з
+ * коефіцієнтами матриці Коші C[i][j] = 1 / (x_i + y_j), x_i = k + i,
+ * y_j = j. Будь-яка квадратна підматриця матриці [I; C] невироджена,
+ * тому будь-які k збережених фрагментів однозначно визначають дані.
+ *
+ * Кожен байт фрагментів кодується незалежно (кодове слово - байти
+ * з однаковим зміщенням у всіх фрагментах). Об'єкт незмінний після
+ * створення, тому методи можна викликати з кількох потоків одночасно.
+ *
+ * Статичні методи *Interleaved() - класичний код RS(n, n - 2t) з коренями
+ * α^0..α^(2t-1): виправляє до t помилкових байтів у кожному слові, коли
+ * їх положення невідомі (пошкоджені біти навантаження, а не втрачені
+ * контейнери).
+ */
+class ReedSolomon {
+public:
+    /**
+     * @brief Конструктор.
+     * @param dataShards Кількість фрагментів даних k (щонайменше 1).
+     * @param parityShards Кількість фрагментів парності m (k + m <= MAX_SHARDS).
+     */
+    ReedSolomon(int dataShards, int parityShards);
+
+    /**
+     * @brief Кількість фрагментів даних.
+     * @return k.
+     */
+    int dataShards() const;
+
+    /**
+     * @brief Кількість фрагментів парності.
+     * @return m.
+     */
+    int parityShards() const;
+
+    /**
+     * @brief Обчислення фрагментів парності.
+     *
+     * @param data k фрагментів даних однакового розміру.
+     * @return m фрагментів парності того ж розміру.
+     */
+    QVector<QByteArray> encode(const QVector<QByteArray>& data) const;
+
+    /**
+     * @brief Відновлення втрачених фрагментів даних.
+     *
+     * @param shards k + m фрагментів; втрачені - порожні масиви.
+     *               Відновлені фрагменти даних записуються на свої місця.
+     * @return false якщо збережено менше k фрагментів або їх розміри різні.
+     */
+    bool reconstruct(QVector<QByteArray>& shards) const;
+
+    // ========== Виправлення помилок (кодові слова з чергуванням) ==========
+
+    /**
+     * @brief Кількість кодових слів для блоку даних.
+     *
+     * @param dataSize Розмір даних у байтах.
+     * @param paritySymbols Кількість символів парності на слово (2t).
+     * @return Найменша кількість слів довжиною не більше MAX_CODEWORD.
+     */
+    static qsizetype codewordCount(qsizetype dataSize, int paritySymbols);
+
+    /**
+     * @brief Розмір закодованого блоку.
+     *
+     * @param dataSize Розмір даних у байтах.
+     * @param paritySymbols Кількість символів парності на слово (2t).
+     * @return Розмір даних з доповненням і парністю.
+     */
+    static qsizetype encodedSize(qsizetype dataSize, int paritySymbols);
+
+    /**
+     * @brief Кодування блоку даних з чергуванням.
+     *
+     * Байт i даних належить слову i mod C, тому блок починається з
+     * незмінених даних (систематичний код), а пакет помилок довжиною
+     * до C × t байтів виправляється.
+     *
+     * @param data Дані.
+     * @param paritySymbols Кількість символів парності на слово (2t, парне).
+     * @return Дані, доповнення нулями та рядки парності.
+     */
+    static QByteArray encodeInterleaved(const QByteArray& data, int paritySymbols);
+
+    /**
+     * @brief Виправлення помилок у закодованому блоці на місці.
+     *
+     * @param block Закодований блок (encodedSize() байтів).
+     * @param dataSize Розмір даних у байтах.
+     * @param paritySymbols Кількість символів парності на слово (2t).
+     * @return Кількість виправлених байтів (-1 - якесь слово має більше t помилок).
+     */
+    static int decodeInterleaved(QByteArray& block, qsizetype dataSize, int paritySymbols);
+
+    /// Максимальна кількість фрагментів (розмір поля без нуля + 1).
+    static constexpr int MAX_SHARDS = 256;
+
+    /// Максимальна довжина кодового слова (розмір поля без нуля).
+    static constexpr int MAX_CODEWORD = 255;
+
+    /// Максимальна кількість символів парності на слово.
+    static constexpr int MAX_PARITY_SYMBOLS = 64;
+
+private:
+    /**
+     * @brief Добуток у полі GF(256).
+     */
+    static uchar multiply(uchar a, uchar b);
+
+    /**
+     * @brief Обернений елемент у полі GF(256).
+     * @param a Ненульовий елемент.
+     */
+    static uchar inverse(uchar a);
+
+    /**
+     * @brief Рядок таблиці добутків: row[x] = c × x.
+     * @param c Множник.
+     * @return 256 добутків.
+     */
+    static const uchar* productRow(uchar c);
+
+    /**
+     * @brief Додавання фрагмента, помноженого на константу: out ^= c × in.
+     *
+     * @param out Фрагмент-накопичувач.
+     * @param in Вхідний фрагмент.
+     * @param size Розмір фрагментів.
+     * @param c Множник.
+     */
+    static void multiplyAdd(uchar* out, const uchar* in, qsizetype size, uchar c);
+
+    /**
+     * @brief Рядок твірної матриці [I; C] для фрагмента.
+     * @param shard Номер фрагмента (0..k+m-1).
+     * @return k коефіцієнтів.
+     */
+    QVector<uchar> generatorRow(int shard) const;
+
+    /**
+     * @brief Обертання k × k матриці методом Гаусса-Жордана.
+     *
+     * @param matrix Матриця за рядками (замінюється оберненою).
+     * @return false якщо матриця вироджена.
+     */
+    bool invert(QVector<uchar>& matrix) const;
+
+    /**
+     * @brief Коефіцієнти твірного полінома g(x) = Π (x + α^j), j < 2t.
+     *
+     * @param paritySymbols Кількість символів парності (2t).
+     * @return g_0..g_{2t-1} (старший коефіцієнт 1 не зберігається).
+     */
+    static QVector<uchar> generatorPolynomial(int paritySymbols);
+
+    /**
+     * @brief Рядки парності для всіх слів блоку (ділення на g(x) регістром зсуву).
+     *
+     * @param data Рядки даних (рядок - по байту кожного слова).
+     * @param lanes Кількість слів C.
+     * @param dataSymbols Кількість рядків даних.
+     * @param generator Коефіцієнти твірного полінома.
+     * @param parity Вихідні рядки парності (2t × C байтів).
+     */
+    static void parityRows(const uchar* data, qsizetype lanes, int dataSymbols,
+                           const QVector<uchar>& generator, uchar* parity);
+
+    /**
+     * @brief Виправлення одного кодового слова блоку.
+     *
+     * @param block Рядки блоку.
+     * @param lanes Кількість слів C.
+     * @param lane Номер слова.
+     * @param length Довжина слова n.
+     * @param paritySymbols Кількість символів парності (2t).
+     * @return Кількість виправлених символів (-1 - забагато помилок).
+     */
+    static int correctCodeword(uchar* block, qsizetype lanes, qsizetype lane, int length,
+                               int paritySymbols);
+
+    int dataCount;     ///< Кількість фрагментів даних k.
+    int parityCount;   ///< Кількість фрагментів парності m.
+};
+
+#endif // REEDSOLOMON_H
@@ -0,0 +1,334 @@
+/*
+ * Scrypt.cpp
+ *
+ * Реалізація функції виведення ключа scrypt (RFC 7914):
+ * PBKDF2-HMAC-SHA256 → ROMix (BlockMix на ядрі Salsa20/8) → PBKDF2-HMAC-SHA256.
+ */
+
+#include "Scrypt.h"
+#include <QMessageAuthenticationCode>
+#include <QElapsedTimer>
+#include <QtEndian>
+#include <cmath>
+#include <cstring>
+
+/// Слів у підблоці Salsa20 (64 байти).
+static const int SALSA_WORDS = 16;
+
+/// Розмір ключа, що виводиться під час калібрування.
+static const int CALIBRATION_KEY_SIZE = 32;
+
+/* ============================================================================
+ *                          ДОПОМІЖНІ ФУНКЦІЇ
+ * ============================================================================
+ */
+
+/**
+ * @brief Циклічний зсув 32-бітового слова вліво.
+ */
+static inline quint32 rotl32(quint32 value, int shift) {
+    return (value << shift) | (value >> (32 - shift));
+}
+
+/**
+ * @brief Ядро Salsa20/8 на місці: B = B + Salsa20/8(B).
+ * @param b Підблок (16 слів).
+ */
+static void salsa208(quint32 b[SALSA_WORDS]) {
+    quint32 x[SALSA_WORDS];
+    std::memcpy(x, b, sizeof(x));
+
+    for (int round = 0; round < 8; round += 2) {
+        // Стовпці.
+        x[ 4] ^= rotl32(x[ 0] + x[12],  7); x[ 8] ^= rotl32(x[ 4] + x[ 0],  9);
+        x[12] ^= rotl32(x[ 8] + x[ 4], 13); x[ 0] ^= rotl32(x[12] + x[ 8], 18);
+        x[ 9] ^= rotl32(x[ 5] + x[ 1],  7); x[13] ^= rotl32(x[ 9] + x[ 5],  9);
+        x[ 1] ^= rotl32(x[13] + x[ 9], 13); x[ 5] ^= rotl32(x[ 1] + x[13], 18);
+        x[14] ^= rotl32(x[10] + x[ 6],  7); x[ 2] ^= rotl32(x[14] + x[10],  9);
+        x[ 6] ^= rotl32(x[ 2] + x[14], 13); x[10] ^= rotl32(x[ 6] + x[ 2], 18);
+        x[ 3] ^= rotl32(x[15] + x[11],  7); x[ 7] ^= rotl32(x[ 3] + x[15],  9);
+        x[11] ^= rotl32(x[ 7] + x[ 3], 13); x[15] ^= rotl32(x[11] + x[ 7], 18);
+
+        // Рядки.
+        x[ 1] ^= rotl32(x[ 0] + x[ 3],  7); x[ 2] ^= rotl32(x[ 1] + x[ 0],  9);
+        x[ 3] ^= rotl32(x[ 2] + x[ 1], 13); x[ 0] ^= rotl32(x[ 3] + x[ 2], 18);
+        x[ 6] ^= rotl32(x[ 5] + x[ 4],  7); x[ 7] ^= rotl32(x[ 6] + x[ 5],  9);
+        x[ 4] ^= rotl32(x[ 7] + x[ 6], 13); x[ 5] ^= rotl32(x[ 4] + x[ 7], 18);
+        x[11] ^= rotl32(x[10] + x[ 9],  7); x[ 8] ^= rotl32(x[11] + x[10],  9);
+        x[ 9] ^= rotl32(x[ 8] + x[11], 13); x[10] ^= rotl32(x[ 9] + x[ 8], 18);
+        x[12] ^= rotl32(x[15] + x[14],  7); x[13] ^= rotl32(x[12] + x[15],  9);
+        x[14] ^= rotl32(x[13] + x[12], 13); x[15] ^= rotl32(x[14] + x[13], 18);
+    }
+
+    for (int i = 0; i < SALSA_WORDS; ++i) {
+        b[i] += x[i];
+    }
+}
+
+/* ============================================================================
+ *                          КОНСТРУКТОР ТА ПАРАМЕТРИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор.
+ * @param logN Двійковий логарифм параметра вартості N.
+ * @param blockSize Параметр розміру блока r.
+ * @param parallelism Кількість незалежних проходів p.
+ */
+Scrypt::Scrypt(int logN, int blockSize, int parallelism)
+    : log2N(logN), r(blockSize), p(parallelism) {
+}
+
+/**
+ * @brief Двійковий логарифм параметра вартості.
+ * @return logN.
+ */
+int Scrypt::logN() const {
+    return log2N;
+}
+
+/**
+ * @brief Параметр розміру блока.
+ * @return r.
+ */
+int Scrypt::blockSize() const {
+    return r;
+}
+
+/**
+ * @brief Кількість незалежних проходів.
+ * @return p.
+ */
+int Scrypt::parallelism() const {
+    return p;
+}
+
+/**
+ * @brief Пам'ять таблиці ROMix.
+ * @return N × 128 × r байтів.
+ */
+qint64 Scrypt::memoryBytes() const {
+    return (qint64(1) << log2N) * 128 * r;
+}
+
+/**
+ * @brief Перевірка параметрів.
+ *
+ * Параметри з заголовка навантаження недовірені: без обмежень
+ * підроблений заголовок змусив би виділити довільний обсяг пам'яті
+ * або виконувати виведення годинами.
+ *
+ * @param logN Двійковий логарифм N.
+ * @param blockSize Параметр r.
+ * @param parallelism Параметр p.
+ * @return true якщо параметри в допустимих межах.
+ */
+bool Scrypt::isValid(int logN, int blockSize, int parallelism) {
+    if (logN < 1 || logN > MAX_LOG_N || blockSize < 1 || blockSize > MAX_BLOCK_SIZE ||
+        parallelism < 1 || parallelism > MAX_PARALLELISM) {
+        return false;
+    }
+    const qint64 memory = Scrypt(logN, blockSize, parallelism).memoryBytes();
+    return memory <= MAX_MEMORY && memory * parallelism <= MAX_WORK;
+}
+
+/**
+ * @brief Параметри, за яких виведення триває приблизно targetMs.
+ *
+ * Час scrypt лінійний за N, тому досить одного пробного виведення
+ * з N = 2^CALIBRATION_LOG_N: logN = CALIBRATION_LOG_N + log2(target / час),
+ * округлений до найближчого цілого і обмежений знизу рекомендованим
+ * мінімумом (на повільному комп'ютері виведення буде довшим за target).
+ *
+ * @param targetMs Бажаний час виведення в мілісекундах.
+ * @return scrypt з підібраним N.
+ */
+Scrypt Scrypt::calibrate(int targetMs) {
+    const Scrypt probe(CALIBRATION_LOG_N, DEFAULT_BLOCK_SIZE, 1);
+
+    QElapsedTimer timer;
+    timer.start();
+    probe.derive(QByteArray("calibration"), QByteArray(16, '\0'), CALIBRATION_KEY_SIZE);
+    const double elapsedMs = qMax<qint64>(timer.nsecsElapsed(), 1) / 1e6;
+
+    const int logN = CALIBRATION_LOG_N + int(std::lround(std::log2(targetMs / elapsedMs)));
+    return Scrypt(qBound(MIN_CALIBRATED_LOG_N, logN, MAX_LOG_N), DEFAULT_BLOCK_SIZE, 1);
+}
+
+/* ============================================================================
+ *                          ВИВЕДЕННЯ КЛЮЧА
+ * ============================================================================
+ */
+
+/**
+ * @brief Виведення ключа.
+ *
+ * Алгоритм (RFC 7914, розділ 6):
+ * 1. B = PBKDF2-HMAC-SHA256(пароль, сіль, 1, p × 128 × r).
+ * 2. Кожен з p блоків B_i перетворюється ROMix (таблиця спільна).
+ * 3. Ключ = PBKDF2-HMAC-SHA256(пароль, B, 1, length).
+ *
+ * @param password Пароль.
+ * @param salt Сіль.
+ * @param length Довжина ключа в байтах.
+ * @return Похідний ключ (порожній, якщо параметри неприпустимі).
+ */
+QByteArray Scrypt::derive(const QByteArray& password, const QByteArray& salt, int length) const {
+    if (!isValid(log2N, r, p) || length <= 0) {
+        return QByteArray();
+    }
+
+    // ========== КРОК 1: Початкові блоки ==========
+    const int blockBytes = 128 * r;
+    QByteArray blocks = pbkdf2(password, salt, p * blockBytes);
+
+    // ========== КРОК 2: ROMix ==========
+    QVector<quint32> table(qsizetype(memoryBytes() / 4));
+    uchar* data = reinterpret_cast<uchar*>(blocks.data());
+    for (int i = 0; i < p; ++i) {
+        roMix(data + i * blockBytes, table);
+    }
+
+    // ========== КРОК 3: Ключ ==========
+    return pbkdf2(password, blocks, length);
+}
+
+/**
+ * @brief Перевірка на тестових векторах RFC 7914 (розділ 12).
+ * @return true якщо всі похідні ключі збіглися.
+ */
+bool Scrypt::selfTest() {
+    struct TestVector {
+        const char* password;
+        const char* salt;
+        int logN;
+        int blockSize;
+        int parallelism;
+        const char* key;
+    };
+
+    static const TestVector vectors[] = {
+        {"", "", 4, 1, 1,
+         "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442"
+         "fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906"},
+        {"password", "NaCl", 10, 8, 16,
+         "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b373162"
+         "2eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640"},
+        {"pleaseletmein", "SodiumChloride", 14, 8, 1,
+         "7023bdcb3afd7348461c06cd81fd38ebfda8fbba904f8e3ea9b543f6545da1f2"
+         "d5432955613f0fcf62d49705242a9af9e61e85dc0d651e40dfcf017b45575887"},
+    };
+
+    for (const TestVector& test : vectors) {
+        const QByteArray expected = QByteArray::fromHex(test.key);
+        const Scrypt kdf(test.logN, test.blockSize, test.parallelism);
+        if (kdf.derive(test.password, test.salt, int(expected.size())) != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief PBKDF2-HMAC-SHA256 з одною ітерацією.
+ *
+ * Блок i результату - HMAC(пароль, сіль || i), i = 1, 2, ... (big-endian).
+ *
+ * @param password Пароль.
+ * @param salt Сіль.
+ * @param length Довжина результату в байтах.
+ * @return Похідні байти.
+ */
+QByteArray Scrypt::pbkdf2(const QByteArray& password, const QByteArray& salt, int length) {
+    QMessageAuthenticationCode mac(QCryptographicHash::Sha256, password);
+    QByteArray result;
+    result.reserve(length);
+
+    for (quint32 index = 1; result.size() < length; ++index) {
+        uchar counter[4];
+        qToBigEndian<quint32>(index, counter);
+
+        mac.reset();
+        mac.addData(salt);
+        mac.addData(reinterpret_cast<const char*>(counter), 4);
+        result += mac.result();
+    }
+
+    result.truncate(length);
+    return result;
+}
+
+/**
+ * @brief BlockMix: 2r викликів Salsa20/8 над блоком 128 × r байтів.
+ *
+ * X = B[2r-1]; для кожного i: X = Salsa20/8(X ^ B[i]), Y[i] = X.
+ * Результат - Y[0], Y[2], ..., Y[2r-2], Y[1], Y[3], ..., Y[2r-1].
+ *
+ * @param in Вхідний блок (32 × r слів).
+ * @param out Вихідний блок.
+ */
+void Scrypt::blockMix(const quint32* in, quint32* out) const {
+    quint32 x[SALSA_WORDS];
+    std::memcpy(x, in + (2 * r - 1) * SALSA_WORDS, sizeof(x));
+
+    for (int i = 0; i < 2 * r; ++i) {
+        const quint32* b = in + i * SALSA_WORDS;
+        for (int k = 0; k < SALSA_WORDS; ++k) {
+            x[k] ^= b[k];
+        }
+        salsa208(x);
+
+        // Парні підблоки - в першу половину, непарні - в другу.
+        std::memcpy(out + ((i & 1) * r + i / 2) * SALSA_WORDS, x, sizeof(x));
+    }
+}
+
+/**
+ * @brief ROMix одного блока на місці.
+ *
+ * Алгоритм:
+ * 1. X = B; N разів: V[i] = X, X = BlockMix(X).
+ * 2. N разів: j = Integerify(X) mod N, X = BlockMix(X ^ V[j]).
+ * 3. B = X.
+ *
+ * Integerify - перше слово останнього підблока (little-endian).
+ *
+ * @param block Блок 128 × r байтів.
+ * @param table Таблиця N блоків.
+ */
+void Scrypt::roMix(uchar* block, QVector<quint32>& table) const {
+    const int words = 32 * r;
+    const quint32 mask = (quint32(1) << log2N) - 1;
+    const qint64 n = qint64(1) << log2N;
+
+    QVector<quint32> x(words);
+    QVector<quint32> y(words);
+    for (int k = 0; k < words; ++k) {
+        x[k] = qFromLittleEndian<quint32>(block + 4 * k);
+    }
+
+    // ========== КРОК 1: Заповнення таблиці ==========
+    quint32* v = table.data();
+    for (qint64 i = 0; i < n; ++i) {
+        std::memcpy(v + i * words, x.constData(), size_t(words) * 4);
+        blockMix(x.constData(), y.data());
+        x.swap(y);
+    }
+
+    // ========== КРОК 2: Читання в залежному від даних порядку ==========
+    for (qint64 i = 0; i < n; ++i) {
+        const quint32 j = x[(2 * r - 1) * SALSA_WORDS] & mask;
+        const quint32* row = v + qint64(j) * words;
+        for (int k = 0; k < words; ++k) {
+            x[k] ^= row[k];
+        }
+        blockMix(x.constData(), y.data());
+        x.swap(y);
+    }
+
+    // ========== КРОК 3: Результат ==========
+    for (int k = 0; k < words; ++k) {
+        qToLittleEndian<quint32>(x[k], block + 4 * k);
+    }
+}
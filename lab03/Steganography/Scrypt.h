@@ -0,0 +1,161 @@
+/*
+ * Scrypt.h
+ *
+ * Заголовочний файл функції виведення ключа scrypt (RFC 7914).
+ * Використовується для перетворення ключа користувача на ключ шифру:
+ * кожна спроба перебору коштує стільки ж часу та пам'яті, скільки
+ * й легітимне виведення.
+ *
+ * Основні можливості:
+ * - scrypt з параметрами N = 2^logN, r, p (PBKDF2-HMAC-SHA256, Salsa20/8).
+ * - Перевірка параметрів, прочитаних з недовіреного заголовка
+ *   (обмеження пам'яті та часу).
+ * - Калібрування N під заданий час виведення на поточному комп'ютері.
+ * - Самоперевірка на тестових векторах RFC 7914.
+ */
+
+#ifndef SCRYPT_H
+#define SCRYPT_H
+
+#include <QByteArray>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @class Scrypt
+ * @brief Функція виведення ключа scrypt, що вимагає багато пам'яті.
+ *
+ * ROMix заповнює таблицю з N блоків по 128 × r байтів і читає її
+ * в залежному від даних порядку, тому обчислення з меншою пам'яттю
+ * пропорційно повільніше. Час і пам'ять лінійні за N; p незалежних
+ * проходів множать лише час. Об'єкт незмінний після створення.
+ */
+class Scrypt {
+public:
+    /**
+     * @brief Конструктор.
+     * @param logN Двійковий логарифм параметра вартості N.
+     * @param blockSize Параметр розміру блока r.
+     * @param parallelism Кількість незалежних проходів p.
+     */
+    Scrypt(int logN, int blockSize, int parallelism);
+
+    /**
+     * @brief Двійковий логарифм параметра вартості.
+     * @return logN.
+     */
+    int logN() const;
+
+    /**
+     * @brief Параметр розміру блока.
+     * @return r.
+     */
+    int blockSize() const;
+
+    /**
+     * @brief Кількість незалежних проходів.
+     * @return p.
+     */
+    int parallelism() const;
+
+    /**
+     * @brief Пам'ять таблиці ROMix.
+     * @return N × 128 × r байтів.
+     */
+    qint64 memoryBytes() const;
+
+    /**
+     * @brief Виведення ключа.
+     *
+     * @param password Пароль (ключ користувача).
+     * @param salt Сіль.
+     * @param length Довжина ключа в байтах.
+     * @return Похідний ключ.
+     */
+    QByteArray derive(const QByteArray& password, const QByteArray& salt, int length) const;
+
+    /**
+     * @brief Перевірка параметрів (наприклад, прочитаних із заголовка).
+     *
+     * @param logN Двійковий логарифм N.
+     * @param blockSize Параметр r.
+     * @param parallelism Параметр p.
+     * @return true якщо параметри в допустимих межах пам'яті та часу.
+     */
+    static bool isValid(int logN, int blockSize, int parallelism);
+
+    /**
+     * @brief Параметри, за яких виведення триває приблизно targetMs.
+     *
+     * @param targetMs Бажаний час виведення в мілісекундах.
+     * @return scrypt з r = DEFAULT_BLOCK_SIZE, p = 1 і підібраним N.
+     */
+    static Scrypt calibrate(int targetMs);
+
+    /**
+     * @brief Перевірка на тестових векторах RFC 7914 (розділ 12).
+     *
+     * Перевіряються перші три вектори (N до 16384, пам'ять до 16 MB);
+     * четвертий (N = 2^20, 1 GB) для самоперевірки надто важкий.
+     *
+     * @return true якщо всі похідні ключі збіглися.
+     */
+    static bool selfTest();
+
+    /// Параметр r за замовчуванням (блок 1 KB, як рекомендує RFC 7914).
+    static constexpr int DEFAULT_BLOCK_SIZE = 8;
+
+    /// Найбільший допустимий logN.
+    static constexpr int MAX_LOG_N = 20;
+
+    /// Найбільший допустимий параметр r.
+    static constexpr int MAX_BLOCK_SIZE = 32;
+
+    /// Найбільший допустимий параметр p.
+    static constexpr int MAX_PARALLELISM = 16;
+
+    /// Найбільша допустима пам'ять таблиці ROMix (1 GB).
+    static constexpr qint64 MAX_MEMORY = qint64(1) << 30;
+
+    /// Найбільший допустимий обсяг роботи: пам'ять таблиці × p (4 GB).
+    static constexpr qint64 MAX_WORK = qint64(4) << 30;
+
+    /// logN пробного виведення під час калібрування (16 MB при r = 8).
+    static constexpr int CALIBRATION_LOG_N = 14;
+
+    /// Найменший logN після калібрування (рекомендований мінімум для інтерактивних ключів).
+    static constexpr int MIN_CALIBRATED_LOG_N = 14;
+
+private:
+    /**
+     * @brief PBKDF2-HMAC-SHA256 з одною ітерацією.
+     *
+     * @param password Пароль.
+     * @param salt Сіль.
+     * @param length Довжина результату в байтах.
+     * @return Похідні байти.
+     */
+    static QByteArray pbkdf2(const QByteArray& password, const QByteArray& salt, int length);
+
+    /**
+     * @brief BlockMix: 2r викликів Salsa20/8 над блоком 128 × r байтів.
+     *
+     * @param in Вхідний блок (32 × r слів).
+     * @param out Вихідний блок (парні підблоки, потім непарні).
+     */
+    void blockMix(const quint32* in, quint32* out) const;
+
+    /**
+     * @brief ROMix одного блока на місці.
+     *
+     * @param block Блок 128 × r байтів.
+     * @param table Таблиця N блоків (перевикористовується між проходами).
+     */
+    void roMix(uchar* block, QVector<quint32>& table) const;
+
+    int log2N;   ///< Двійковий логарифм N.
+    int r;       ///< Параметр розміру блока.
+    int p;       ///< Кількість незалежних проходів.
+};
+
+#endif // SCRYPT_H
@@ -7,10 +7,83 @@
  */
 
 #include "SteganographyEngine.h"
+#include "KeyedPermutation.h"
 #include <QColor>
 #include <QDebug>
 #include <QtMath>
+#include <QtEndian>
+#include <QThread>
+#include <QSemaphore>
+#include <QMutex>
+#include <QVector>
 #include <QCryptographicHash>
+#include <optional>
+
+/*
+ * ============================================================================
+ * ДОПОМІЖНІ СТРУКТУРИ
+ * ============================================================================
+ */
+
+/**
+ * @struct MarkerStream
+ * @brief Потік декодованих символів з інкрементальним пошуком маркера.
+ *
+ * Використовує алгоритм Кнута-Морріса-Пратта: кожен символ обробляється
+ * рівно один раз, тому пошук маркера займає лінійний час.
+ */
+struct SteganographyEngine::MarkerStream {
+    QString text;           ///< Накопичений текст потоку.
+    QString pattern;        ///< Маркер, що шукається.
+    QVector<int> failure;   ///< Префікс-функція маркера.
+    int matched = 0;        ///< Кількість символів маркера, що збіглися.
+    bool alive = true;      ///< Чи потік ще може містити повідомлення.
+
+    explicit MarkerStream(const QString& marker)
+        : pattern(marker), failure(marker.length(), 0) {
+        // Обчислюємо префікс-функцію маркера.
+        for (int i = 1, k = 0; i < pattern.length(); ++i) {
+            while (k > 0 && pattern[i] != pattern[k]) {
+                k = failure[k - 1];
+            }
+            if (pattern[i] == pattern[k]) {
+                ++k;
+            }
+            failure[i] = k;
+        }
+    }
+
+    /**
+     * @brief Додавання символу до потоку.
+     *
+     * @param ch Наступний символ.
+     * @param checkStart Чи символ належить до позиції START_MARKER.
+     * @param expected Очікуваний символ START_MARKER.
+     * @return true якщо маркер щойно знайдено.
+     */
+    bool feed(QChar ch, bool checkStart, QChar expected) {
+        if (!alive) {
+            return false;
+        }
+
+        // Повідомлення завжди починається з START_MARKER.
+        if (checkStart && ch != expected) {
+            alive = false;
+            return false;
+        }
+
+        text += ch;
+
+        while (matched > 0 && ch != pattern[matched]) {
+            matched = failure[matched - 1];
+        }
+        if (ch == pattern[matched]) {
+            ++matched;
+        }
+
+        return matched == pattern.length();
+    }
+};
 
 /*
  * ============================================================================
@@ -38,11 +111,11 @@ SteganographyEngine::SteganographyEngine() {
  * @brief Приховування текстового повідомлення в зображенні.
  *
  * Алгоритм:
- * 1. Додаємо маркери початку та кінця до повідомлення.
- * 2. (Опціонально) Шифруємо повідомлення.
- * 3. Конвертуємо текст у двійковий формат.
+ * 1. Кодуємо повідомлення в UTF-8.
+ * 2. Формуємо заголовок (сигнатура, версія, прапорці, довжина, CRC-32).
+ * 3. (Опціонально) Шифруємо дані.
  * 4. Перевіряємо чи достатньо місця в зображенні.
- * 5. Ховаємо біти в молодших бітах RGB-каналів пікселів.
+ * 5. Копіюємо біти навантаження в молодші біти RGB-каналів пікселів.
  *
  * @param image Вхідне зображення (оригінал).
  * @param message Текстове повідомлення.
@@ -58,75 +131,81 @@ QImage SteganographyEngine::hideMessage(const QImage& image,
         return QImage();
     }
 
-    // Конвертуємо зображення в формат RGB32 для роботи з кольорами.
-    QImage resultImage = image.convertToFormat(QImage::Format_RGB32);
+    // Конвертуємо зображення в формат RGB32 для роботи з кольорами
+    // (ARGB32, якщо дані записуються і в альфа-канал).
+    QImage resultImage = image.convertToFormat(alphaPlane ? QImage::Format_ARGB32
+                                                          : QImage::Format_RGB32);
 
-    // ========== КРОК 1: Додаємо маркери ==========
-    QString fullMessage = START_MARKER + message + END_MARKER;
-    qDebug() << "Original message length:" << message.length();
-    qDebug() << "Full message with markers length:" << fullMessage.length();
-
-    // ========== КРОК 2: Шифруємо (якщо потрібно) ==========
-    if (encrypt && !currentKey.isEmpty()) {
-        fullMessage = xorCipher(fullMessage, currentKey);
-        qDebug() << "Message encrypted, key:" << currentKey;
+    // Навантаження з кодом Ріда-Соломона має власний формат.
+    if (eccParity > 0) {
+        return hideProtectedMessage(resultImage, message, encrypt);
     }
 
-    // ========== КРОК 3: Конвертуємо в двійковий формат ==========
-    QString binary = textToBinary(fullMessage);
-    qDebug() << "Binary length:" << binary.length() << "bits";
+    // ========== КРОКИ 1-3: Формуємо навантаження ==========
+    QByteArray payload = buildPayload(message, encrypt);
+    const PayloadHeader header = parseHeader(payload);
+    const bool keyed = header.flags & FLAG_KEYED_ORDER;
+    const bool matrix = matrixLayout(header);
 
     // ========== КРОК 4: Перевіряємо ємність зображення ==========
-    // Кожен піксель має 3 канали (R, G, B), отже 3 біти на піксель.
-    int maxBits = resultImage.width() * resultImage.height() * 3;
-    qDebug() << "Available bits:" << maxBits;
-
-    if (binary.length() > maxBits) {
+    // 3 × k (або 4 × k з альфа-каналом) бітів на піксель.
+    const qint64 totalPixels = qint64(resultImage.width()) * resultImage.height();
+    const qint64 dataBytes = header.length;
+    const qint64 capacity = dataCapacity(header, totalPixels);
+    qDebug() << "Payload:" << dataBytes << "bytes, available:" << capacity
+             << "bits per channel:" << planeBits << "alpha:" << alphaPlane
+             << "keyed order:" << keyed << "matrix:" << matrix;
+
+    if (dataBytes > capacity) {
         qWarning() << "Message too long for this image!";
-        qWarning() << "Required:" << binary.length() << "Available:" << maxBits;
+        qWarning() << "Required:" << dataBytes << "Available:" << capacity;
         return QImage();
     }
 
     // ========== КРОК 5: Приховуємо біти в пікселях ==========
-    int bitIndex = 0;  // Поточна позиція в бітовій послідовності.
-    bool finished = false;
-
-    // Проходимо по всіх пікселях зображення.
-    for (int y = 0; y < resultImage.height() && !finished; ++y) {
-        for (int x = 0; x < resultImage.width() && !finished; ++x) {
-            // Отримуємо колір поточного піксела.
-            QColor pixel = resultImage.pixelColor(x, y);
-
-            // Модифікуємо червоний канал.
-            if (bitIndex < binary.length()) {
-                int r = setBit(pixel.red(), binary[bitIndex].digitValue());
-                pixel.setRed(r);
-                bitIndex++;
-            }
-
-            // Модифікуємо зелений канал.
-            if (bitIndex < binary.length()) {
-                int g = setBit(pixel.green(), binary[bitIndex].digitValue());
-                pixel.setGreen(g);
-                bitIndex++;
-            }
-
-            // Модифікуємо синій канал.
-            if (bitIndex < binary.length()) {
-                int b = setBit(pixel.blue(), binary[bitIndex].digitValue());
-                pixel.setBlue(b);
-                bitIndex++;
-            } else {
-                // Всі біти приховані.
-                finished = true;
-            }
-
-            // Зберігаємо модифікований піксель.
-            resultImage.setPixelColor(x, y, pixel);
+    int bits = 1;
+    int channels = 3;
+    if (!planeLayout(header, bits, channels)) {
+        beginProgress(qint64(payload.size()) * 8);
+        embedBytes(resultImage, payload);
+    } else {
+        // Заголовок і розширення - 1 біт на канал RGB, дані - k бітів на канал
+        // (у ключовому порядку - в пікселях first + π(j)).
+        const qint64 firstPixel = dataStartPixel(header);
+        const qint64 headerBytes = qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize;
+
+        std::optional<KeyedPermutation> order;
+        if (keyed) {
+            order.emplace(currentKey, quint64(totalPixels - firstPixel));
+        }
+        const KeyedPermutation* pixelOrder = order ? &*order : nullptr;
+
+        if (matrix) {
+            // Параметр коду залежить від розміру контейнера - записуємо його в розширення.
+            const qint64 coverBits = (totalPixels - firstPixel) * channels / 8 * 8;
+            const int p = chooseHammingParameter(header.length, coverBits);
+            payload[headerBytes - 1] = char(p);
+
+            // Робота: заголовок, зчитування і запис контейнера, блоки.
+            beginProgress(headerBytes * 8 + 2 * hammingCoverBits(header.length, p) +
+                          hammingBlocks(header.length, p));
+            embedBytes(resultImage, payload.left(headerBytes));
+            embedMatrix(resultImage, firstPixel, payload.mid(headerBytes), p, channels, pixelOrder);
+        } else {
+            beginProgress(qint64(payload.size()) * 8);
+            embedBytes(resultImage, payload.left(headerBytes));
+            embedPlanes(resultImage, firstPixel, payload.mid(headerBytes), bits, channels, pixelOrder);
         }
     }
 
-    qDebug() << "Total bits hidden:" << bitIndex;
+    const bool cancelled = isCancelled();
+    endProgress();
+    if (cancelled) {
+        qWarning() << "Hiding cancelled";
+        return QImage();
+    }
+
+    qDebug() << "Total bytes hidden:" << payload.size();
     qDebug() << "Hiding completed successfully";
 
     return resultImage;
@@ -137,10 +216,13 @@ QImage SteganographyEngine::hideMessage(const QImage& image,
  *
  * Алгоритм:
  * 1. Конвертуємо зображення в потрібний формат.
- * 2. Витягуємо молодші біти з RGB-каналів пікселів.
- * 3. Конвертуємо біти назад у текст.
- * 4. (Опціонально) Дешифруємо повідомлення.
- * 5. Шукаємо маркери та витягуємо повідомлення.
+ * 2. Зчитуємо та перевіряємо 16-байтовий заголовок і його розширення.
+ * 3. Зчитуємо рівно header.length байтів даних.
+ * 4. (Опціонально) Перевіряємо тег і дешифруємо дані.
+ * 5. Перевіряємо CRC-32 та декодуємо UTF-8.
+ *
+ * Спершу перевіряється заголовок навантаження з кодом Ріда-Соломона;
+ * якщо заголовок не знайдено, пробуємо старий формат з маркерами.
  *
  * @param image Зображення з повідомленням.
  * @param decrypt Чи потрібно дешифрувати.
@@ -153,96 +235,302 @@ QString SteganographyEngine::extractMessage(const QImage& image, bool decrypt) {
         return QString();
     }
 
-    // Конвертуємо зображення в формат RGB32.
-    QImage workImage = image.convertToFormat(QImage::Format_RGB32);
-    QString binary;
+    // Конвертуємо зображення в формат RGB32 (ARGB32 зберігає альфа-канал).
+    QImage workImage = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32
+                                                                     : QImage::Format_RGB32);
+
+    // ========== КРОК 1: Зчитуємо заголовок ==========
+    PayloadHeader header;
+    int paritySymbols = 0;
+    qint64 payloadSize = 0;
+    if (readProtectedHeader(workImage, header, paritySymbols, payloadSize)) {
+        qDebug() << "Protected payload header found, parity symbols:" << paritySymbols;
+        return extractProtectedMessage(workImage, header, paritySymbols, payloadSize, decrypt);
+    }
 
-    // ========== ОПТИМІЗАЦІЯ: Обмежуємо пошук ==========
-    // Щоб уникнути зависання на зображеннях без повідомлення.
-    const int MAX_CHARS_TO_SEARCH = 50000;  // Шукаємо максимум 50000 символів.
-    const int BITS_PER_CHAR = 16;           // UTF-16: 16 біт на символ.
-    const int MAX_BITS = MAX_CHARS_TO_SEARCH * BITS_PER_CHAR;
-
-    int bitsExtracted = 0;
-    bool endMarkerFound = false;
-
-    // ========== КРОК 1: Витягуємо біти з пікселів ==========
-    for (int y = 0; y < workImage.height() && !endMarkerFound; ++y) {
-        for (int x = 0; x < workImage.width() && !endMarkerFound; ++x) {
-            QColor pixel = workImage.pixelColor(x, y);
-
-            // Витягуємо молодший біт з червоного каналу.
-            binary += QString::number(getBit(pixel.red()));
-            bitsExtracted++;
-            if (bitsExtracted >= MAX_BITS) break;
-
-            // Витягуємо молодший біт з зеленого каналу.
-            binary += QString::number(getBit(pixel.green()));
-            bitsExtracted++;
-            if (bitsExtracted >= MAX_BITS) break;
-
-            // Витягуємо молодший біт з синього каналу.
-            binary += QString::number(getBit(pixel.blue()));
-            bitsExtracted++;
-            if (bitsExtracted >= MAX_BITS) break;
-
-            // ========== ОПТИМІЗАЦІЯ: Перевіряємо наявність END_MARKER ==========
-            // Перевіряємо кожні 320 біт (20 символів).
-            if (bitsExtracted % 320 == 0 && bitsExtracted >= 320) {
-                QString currentText = binaryToText(binary);
-
-                // Перевіряємо незашифрований текст.
-                if (currentText.contains(END_MARKER)) {
-                    endMarkerFound = true;
-                    qDebug() << "END marker found at" << bitsExtracted
-                             << "bits (unencrypted)";
-                    break;
-                }
+    if (!readPayloadHeader(workImage, header)) {
+        qDebug() << "Payload header not found, trying legacy marker format";
+        return extractLegacyMessage(workImage, decrypt);
+    }
 
-                // Якщо потрібно дешифрування, перевіряємо зашифрований текст.
-                if (decrypt && !currentKey.isEmpty()) {
-                    QString decryptedText = xorCipher(currentText, currentKey);
-                    if (decryptedText.contains(END_MARKER)) {
-                        endMarkerFound = true;
-                        qDebug() << "END marker found at" << bitsExtracted
-                                 << "bits (encrypted)";
-                        break;
-                    }
-                }
+    qDebug() << "Payload header found, length:" << header.length
+             << "bytes, flags:" << header.flags;
+
+    // ========== КРОК 2: Зчитуємо розширення та дані ==========
+    // Розширення завжди записане по 1 біту на канал одразу після заголовка.
+    const QByteArray extension = extractBytes(workImage, PAYLOAD_HEADER_SIZE, header.extensionSize);
+
+    int bits = 1;
+    int channels = 3;
+    QByteArray data;
+
+    if (!planeLayout(header, bits, channels)) {
+        beginProgress(qint64(header.length) * 8);
+        data = extractBytes(workImage, PAYLOAD_HEADER_SIZE + header.extensionSize, header.length);
+    } else {
+        const qint64 firstPixel = dataStartPixel(header);
+        const qint64 totalPixels = qint64(workImage.width()) * workImage.height();
+
+        // Порядок пікселів визначається ключем - без нього дані не знайти.
+        std::optional<KeyedPermutation> order;
+        if (header.flags & FLAG_KEYED_ORDER) {
+            if (currentKey.isEmpty()) {
+                qWarning() << "Payload uses keyed pixel order, but no key was provided!";
+                return NOT_FOUND_MESSAGE;
             }
+            order.emplace(currentKey, quint64(totalPixels - firstPixel));
         }
+        const KeyedPermutation* pixelOrder = order ? &*order : nullptr;
+
+        if (matrixLayout(header)) {
+            const int p = storedHammingParameter(header, extension);
+            if (p == 0) {
+                qWarning() << "Invalid Hamming code parameter in the payload header!";
+                return NOT_FOUND_MESSAGE;
+            }
+            beginProgress(hammingCoverBits(header.length, p) + hammingBlocks(header.length, p));
+            data = extractMatrix(workImage, firstPixel, header.length, p, channels, pixelOrder);
+        } else {
+            beginProgress(qint64(header.length) * 8);
+            data = extractPlanes(workImage, firstPixel, header.length, bits, channels, pixelOrder);
+        }
+    }
+
+    const bool cancelled = isCancelled();
+    endProgress();
+    if (cancelled) {
+        qWarning() << "Extraction cancelled";
+        return NOT_FOUND_MESSAGE;
     }
 
-    qDebug() << "Total bits extracted:" << bitsExtracted;
+    // ========== КРОКИ 3-4: Дешифруємо та перевіряємо ==========
+    return decodePayload(header, extension, data, decrypt);
+}
 
-    // ========== КРОК 2: Конвертуємо біти в текст ==========
-    QString extractedText = binaryToText(binary);
-    qDebug() << "Text length before decryption:" << extractedText.length();
+/**
+ * @brief Формування навантаження: заголовок + дані.
+ *
+ * Заголовок режиму - для поточних налаштувань пікселів (layoutHeader()).
+ *
+ * @param message Повідомлення.
+ * @param encrypt Чи потрібно шифрувати.
+ * @return Серіалізований заголовок, розширення і дані.
+ */
+QByteArray SteganographyEngine::buildPayload(const QString& message, bool encrypt) {
+    return buildPayload(message, layoutHeader(encrypt));
+}
 
-    // ========== КРОК 3: Дешифруємо (якщо потрібно) ==========
-    if (decrypt && !currentKey.isEmpty()) {
-        extractedText = xorCipher(extractedText, currentKey);
-        qDebug() << "Text decrypted, length:" << extractedText.length();
+/**
+ * @brief Формування навантаження із заданим заголовком режиму.
+ *
+ * 1. Кодуємо повідомлення в UTF-8.
+ * 2. Заповнюємо заголовок (CRC-32 відкритого тексту).
+ * 3. (Опціонально) Стискаємо дані deflate; довжина - після стиснення.
+ * 4. (Опціонально) Шифруємо дані ChaCha20-Poly1305 ключем scrypt; nonce, тег
+ *    і запис KDF записуються в розширення заголовка, сам заголовок автентифікується.
+ *
+ * @param message Повідомлення.
+ * @param header Заголовок без довжини та CRC (див. layoutHeader(), jpegHeader()).
+ * @return Серіалізований заголовок, розширення і дані.
+ */
+QByteArray SteganographyEngine::buildPayload(const QString& message, PayloadHeader header) {
+    // ========== КРОК 1: Кодуємо повідомлення в UTF-8 ==========
+    QByteArray data = message.toUtf8();
+    qDebug() << "Original message length:" << message.length()
+             << "chars," << data.size() << "bytes (UTF-8)";
+
+    // ========== КРОК 2: Заповнюємо заголовок ==========
+    header.crc = calculateCRC32(data);
+
+    // ========== КРОК 3: Стискаємо (якщо потрібно) ==========
+    const int codec = compressData(data);
+    header.flags |= quint8(codec << FLAG_CODEC_SHIFT);
+    header.length = static_cast<quint32>(data.size());
+
+    // ========== КРОК 4: Шифруємо (якщо потрібно) ==========
+    const QByteArray headerBytes = serializeHeader(header);
+    QByteArray extension;
+    if (header.flags & FLAG_ENCRYPTED) {
+        extension = encryptPayload(data, headerBytes);
+        qDebug() << "Message encrypted (ChaCha20-Poly1305)";
     }
 
-    // ========== КРОК 4: Шукаємо маркери ==========
-    int startPos = extractedText.indexOf(START_MARKER);
-    int endPos = extractedText.indexOf(END_MARKER);
+    // Параметр коду Геммінга залежить від зображення - його записує hideMessage().
+    if (matrixLayout(header)) {
+        extension.append('\0');
+    }
 
-    qDebug() << "START marker position:" << startPos;
-    qDebug() << "END marker position:" << endPos;
+    return headerBytes + extension + data;
+}
 
-    // Перевіряємо чи знайдені маркери.
-    if (startPos == -1 || endPos == -1) {
+/**
+ * @brief Заголовок без довжини та CRC для поточних налаштувань.
+ *
+ * Шифрування та ключовий порядок пікселів вмикаються лише за наявності ключа.
+ *
+ * @param encrypt Чи буде навантаження зашифроване.
+ * @return Заголовок.
+ */
+PayloadHeader SteganographyEngine::layoutHeader(bool encrypt) const {
+    // Матричне вбудовування використовує лише молодший біт каналу.
+    const int bits = matrixEmbedding ? 1 : planeBits;
+
+    PayloadHeader header;
+    header.magic = PAYLOAD_MAGIC;
+    header.version = PAYLOAD_VERSION;
+    header.flags = quint8((bits - 1) << FLAG_BITS_SHIFT);
+    if (alphaPlane) {
+        header.flags |= FLAG_ALPHA;
+    }
+    if (keyedOrder && !currentKey.isEmpty()) {
+        header.flags |= FLAG_KEYED_ORDER;
+    }
+    if (encrypt && !currentKey.isEmpty()) {
+        addCipherLayout(header);
+    }
+    if (matrixEmbedding) {
+        header.extensionSize += MATRIX_EXTENSION_SIZE;
+    }
+    return header;
+}
+
+/**
+ * @brief Розбір даних навантаження після зчитування.
+ *
+ * Дешифрує дані (якщо встановлено прапорець), розпаковує їх (якщо
+ * в заголовку вказано кодек), перевіряє CRC-32 відкритого тексту
+ * та декодує UTF-8. Для ChaCha20-Poly1305 спершу
+ * перевіряється тег: неправильний ключ відкидається без дешифрування.
+ *
+ * @param header Заголовок навантаження.
+ * @param extension Розширення заголовка (header.extensionSize байтів).
+ * @param data Зчитані дані (header.length байтів).
+ * @param decrypt Чи дозволено дешифрування.
+ * @return Повідомлення або NOT_FOUND_MESSAGE.
+ */
+QString SteganographyEngine::decodePayload(const PayloadHeader& header, const QByteArray& extension,
+                                           QByteArray data, bool decrypt) {
+    // ========== Дешифруємо (якщо потрібно) ==========
+    if (header.flags & FLAG_ENCRYPTED) {
+        if (!decrypt || currentKey.isEmpty()) {
+            qWarning() << "Payload is encrypted, but no key was provided!";
+            return NOT_FOUND_MESSAGE;
+        }
+
+        if (!(header.flags & FLAG_AEAD)) {
+            // Старі навантаження з XOR-шифруванням.
+            xorBytes(data, currentKey);
+        } else if (!decryptPayload(data, header, extension)) {
+            qWarning() << "Authentication failed: wrong key or corrupted payload!";
+            return NOT_FOUND_MESSAGE;
+        }
+    }
+
+    // ========== Розпаковуємо (якщо потрібно) ==========
+    const int codec = (header.flags & FLAG_CODEC_MASK) >> FLAG_CODEC_SHIFT;
+    if (!decompressData(data, codec)) {
+        return NOT_FOUND_MESSAGE;
+    }
+
+    // ========== Перевіряємо контрольну суму ==========
+    if (calculateCRC32(data) != header.crc) {
+        qWarning() << "CRC mismatch: wrong key or corrupted payload!";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    QString message = QString::fromUtf8(data);
+    qDebug() << "Message extracted successfully, length:" << message.length();
+
+    return message;
+}
+
+/**
+ * @brief Витягування повідомлення старого формату (з маркерами).
+ *
+ * Потоковий алгоритм за один прохід (лінійний час):
+ * 1. Зчитуємо молодші біти з RGB-каналів рядок за рядком.
+ * 2. Кожні 16 бітів один раз перетворюємо на символ UTF-16.
+ * 3. Паралельно ведемо два потоки символів: відкритий та розшифрований
+ *    (XOR з ключем застосовується до одного символу, а не до всього префікса).
+ * 4. Для кожного потоку інкрементально шукаємо END_MARKER (KMP).
+ * 5. Потік відкидається, щойно його початок не збігся з START_MARKER.
+ *
+ * @param workImage Зображення у форматі RGB32.
+ * @param decrypt Чи потрібно дешифрувати.
+ * @return Витягнуте повідомлення або повідомлення про помилку.
+ */
+QString SteganographyEngine::extractLegacyMessage(const QImage& workImage, bool decrypt) {
+    static const int CHANNEL_SHIFTS[3] = {16, 8, 0};
+
+    // Потоки символів: відкритий текст та розшифрований текст.
+    MarkerStream plainStream(END_MARKER);
+    MarkerStream decryptedStream(END_MARKER);
+    decryptedStream.alive = decrypt && !currentKey.isEmpty();
+
+    const int startLength = START_MARKER.length();
+    const int keyLength = currentKey.length();
+    const int width = workImage.width();
+
+    ushort unit = 0;        // Поточний символ, що збирається з бітів.
+    int unitBits = 0;       // Кількість зібраних бітів символу.
+    qint64 charIndex = 0;   // Номер поточного символу.
+    const MarkerStream* found = nullptr;
+    bool finished = false;
+
+    // ========== КРОК 1: Потокове декодування бітів ==========
+    for (int y = 0; y < workImage.height() && !finished; ++y) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(workImage.constScanLine(y));
+
+        for (int x = 0; x < width && !finished; ++x) {
+            for (int c = 0; c < 3 && !finished; ++c) {
+                unit = ushort((unit << 1) | ((line[x] >> CHANNEL_SHIFTS[c]) & 1u));
+                if (++unitBits < 16) {
+                    continue;
+                }
+
+                // ========== КРОК 2: Символ зібрано, передаємо в потоки ==========
+                QChar plainChar(unit);
+                QChar startChar = charIndex < startLength ? START_MARKER[charIndex] : QChar();
+
+                if (plainStream.feed(plainChar, charIndex < startLength, startChar)) {
+                    found = &plainStream;
+                }
+
+                if (decryptedStream.alive) {
+                    ushort keyCode = currentKey[charIndex % keyLength].unicode();
+                    QChar decryptedChar(ushort(unit ^ keyCode));
+                    if (decryptedStream.feed(decryptedChar, charIndex < startLength, startChar)
+                        && found == nullptr) {
+                        found = &decryptedStream;
+                    }
+                }
+
+                unit = 0;
+                unitBits = 0;
+                ++charIndex;
+
+                // Зупиняємося коли маркер знайдено або обидва потоки відкинуто.
+                finished = found != nullptr ||
+                           (!plainStream.alive && !decryptedStream.alive);
+            }
+        }
+    }
+
+    qDebug() << "Total chars decoded:" << charIndex;
+
+    // ========== КРОК 3: Перевіряємо результат ==========
+    if (found == nullptr) {
         qWarning() << "Markers not found!";
-        qDebug() << "First 200 chars of extracted text:"
-                 << extractedText.left(200);
-        return "Повідомлення не знайдено";
+        return NOT_FOUND_MESSAGE;
     }
 
-    // ========== КРОК 5: Витягуємо повідомлення між маркерами ==========
-    QString message = extractedText.mid(startPos + START_MARKER.length(),
-                                        endPos - startPos - START_MARKER.length());
+    qDebug() << "END marker found at" << charIndex * 16 << "bits"
+             << (found == &plainStream ? "(unencrypted)" : "(encrypted)");
+
+    // ========== КРОК 4: Витягуємо повідомлення між маркерами ==========
+    // Потік починається з START_MARKER і закінчується END_MARKER.
+    QString message = found->text.mid(startLength,
+                                      found->text.length() - startLength - END_MARKER.length());
 
     qDebug() << "Message extracted successfully, length:" << message.length();
 
@@ -262,8 +550,9 @@ QString SteganographyEngine::extractMessage(const QImage& image, bool decrypt) {
  * - Розміри зображень.
  * - Статистику повідомлення.
  * - PSNR (Peak Signal-to-Noise Ratio).
- * - MSE (Mean Squared Error).
- * - Кількість змінених пікселів.
+ * - MSE (Mean Squared Error), загальну та по каналах.
+ * - SSIM (Structural Similarity Index).
+ * - Кількість та бітову карту змінених пікселів.
  *
  * @param original Оригінальне зображення.
  * @param modified Модифіковане зображення.
@@ -292,36 +581,54 @@ ImageAnalysisResult SteganographyEngine::analyzeChanges(
     // ========== Інформація про повідомлення ==========
     result.message = message;
     result.messageLength = message.length();
+    result.messageBytes = message.toUtf8().size();
     result.hasMessage = !message.isEmpty();
 
+    result.storedBytes = storedMessageSize(message);
+    result.compressed = result.storedBytes < result.messageBytes;
+
     // ========== Обчислюємо використані біти ==========
-    QString fullMessage = START_MARKER + message + END_MARKER;
-    QString binary = textToBinary(fullMessage);
-    result.bitsUsed = binary.length();
+    // Заголовок навантаження з розширенням (шифр, код Геммінга) + дані
+    // (після стиснення). Шифрування вибирається для кожного повідомлення,
+    // тому розмір розширення читаємо із записаного заголовка.
+    PayloadHeader header;
+    const QImage stego = modified.convertToFormat(modified.hasAlphaChannel() ? QImage::Format_ARGB32
+                                                                             : QImage::Format_RGB32);
+    const bool headerFound = readPayloadHeader(stego, header);
+    const int extensionSize = headerFound ? header.extensionSize : layoutHeader(false).extensionSize;
+    result.bitsUsed = (PAYLOAD_HEADER_SIZE + extensionSize + result.storedBytes) * 8;
 
     // ========== Обчислюємо ємність ==========
     result.maxCapacity = calculateMaxCapacity(original);
-    result.capacityUsed = (result.messageLength / result.maxCapacity) * 100.0;
+    result.bitsPerChannel = matrixEmbedding ? 1 : planeBits;
+    result.alphaUsed = alphaPlane;
+    result.keyedOrder = keyedOrder && !currentKey.isEmpty();
+    result.effectiveCapacity = result.maxCapacity;
+    if (result.storedBytes > 0) {
+        result.effectiveCapacity = result.maxCapacity * result.messageBytes / result.storedBytes;
+    }
+    if (result.maxCapacity > 0) {
+        result.capacityUsed = (result.storedBytes / result.maxCapacity) * 100.0;
+    }
 
     // ========== Обчислюємо якісні метрики ==========
-    result.mse = calculateMSE(original, modified);
-    result.psnr = calculatePSNR(original, modified);
-
-    // ========== Підраховуємо змінені пікселі ==========
-    result.modifiedPixels = 0;
-    for (int y = 0; y < original.height(); ++y) {
-        for (int x = 0; x < original.width(); ++x) {
-            QColor origColor = original.pixelColor(x, y);
-            QColor modColor = modified.pixelColor(x, y);
-
-            // Перевіряємо чи змінився хоча б один канал.
-            if (origColor.red() != modColor.red() ||
-                origColor.green() != modColor.green() ||
-                origColor.blue() != modColor.blue()) {
-                result.modifiedPixels++;
-            }
-        }
+    // MSE, PSNR, змінені пікселі та SSIM за один злитий прохід.
+    calculateQualityMetrics(original, modified, result);
+
+    // ========== Ефективність вбудовування ==========
+    // Бітів навантаження на одну зміну каналу: для LSB в середньому 2,
+    // для коду Геммінга - p / (1 - 2^-p). Параметр коду читаємо з заголовка.
+    if (result.changedChannels > 0) {
+        result.embeddingEfficiency = double(result.bitsUsed) / result.changedChannels;
     }
+    if (headerFound && matrixLayout(header)) {
+        result.hammingP = storedHammingParameter(
+            header, extractBytes(stego, PAYLOAD_HEADER_SIZE, header.extensionSize));
+    }
+
+    // ========== Статистичний стегоаналіз ==========
+    result.originalSteganalysis = analyzeStatistics(original);
+    result.modifiedSteganalysis = analyzeStatistics(modified);
 
     return result;
 }
@@ -329,27 +636,34 @@ ImageAnalysisResult SteganographyEngine::analyzeChanges(
 /**
  * @brief Обчислення максимальної ємності зображення.
  *
- * Формула: (кількість_пікселів × 3 біти - біти_маркерів) / 16 біт_на_символ.
+ * Формула для 1 біта на канал: (кількість_пікселів × 3 біти) / 8 - розмір_заголовка.
+ * Для k бітів на канал див. dataCapacity().
  *
  * @param image Зображення для аналізу.
- * @return Максимальна кількість символів.
+ * @param encrypt Чи буде повідомлення зашифроване.
+ * @return Максимальна кількість байтів UTF-8.
  */
-int SteganographyEngine::calculateMaxCapacity(const QImage& image) {
+qint64 SteganographyEngine::calculateMaxCapacity(const QImage& image, bool encrypt) {
     if (image.isNull()) return 0;
 
-    // Загальна кількість бітів, які можна приховати.
-    // 3 біти на піксель (по одному біту на канал R, G, B).
-    int totalBits = image.width() * image.height() * 3;
+    return calculateMaxCapacity(image.size(), encrypt);
+}
 
-    // Віднімаємо біти для маркерів START та END.
-    QString markers = START_MARKER + END_MARKER;
-    int markerBits = textToBinary(markers).length();
+/**
+ * @brief Обчислення максимальної ємності за розміром зображення.
+ *
+ * @param size Розмір зображення.
+ * @param encrypt Чи буде повідомлення зашифроване.
+ * @return Максимальна кількість байтів UTF-8.
+ */
+qint64 SteganographyEngine::calculateMaxCapacity(const QSize& size, bool encrypt) {
+    if (size.isEmpty()) return 0;
 
-    // Обчислюємо кількість символів.
-    // 16 біт на символ (UTF-16).
-    int maxChars = (totalBits - markerBits) / 16;
+    const qint64 pixels = qint64(size.width()) * size.height();
+    qint64 maxBytes = eccParity > 0 ? protectedCapacity(pixels, encrypt)
+                                    : dataCapacity(layoutHeader(encrypt), pixels);
 
-    return maxChars;
+    return qMax<qint64>(0, maxBytes);
 }
 
 /**
@@ -359,8 +673,7 @@ int SteganographyEngine::calculateMaxCapacity(const QImage& image) {
  * @return true якщо повідомлення знайдено.
  */
 bool SteganographyEngine::hasHiddenMessage(const QImage& image) {
-    QString extracted = extractMessage(image, false);
-    return !extracted.isEmpty() && extracted != "Повідомлення не знайдено";
+    return probeMessage(image) != ProbeResult::None;
 }
 
 /*
@@ -448,26 +761,44 @@ QString SteganographyEngine::xorCipher(const QString& text, const QString& key)
     // Якщо ключ порожній, повертаємо текст без змін.
     if (key.isEmpty()) return text;
 
-    QString result;
-    int keyIndex = 0;
-
-    // Проходимо по кожному символу тексту.
-    for (QChar ch : text) {
-        // Отримуємо коди символів.
-        ushort charCode = ch.unicode();
-        ushort keyCode = key[keyIndex % key.length()].unicode();
-
-        // Виконуємо XOR операцію.
-        ushort encrypted = charCode ^ keyCode;
-
-        // Додаємо зашифрований символ.
-        result += QChar(encrypted);
-        keyIndex++;
+    // Результат формується в копії на місці, без поступового дописування символів.
+    QString result = text;
+    QChar* chars = result.data();
+    const QChar* keyChars = key.constData();
+    const qsizetype length = result.size();
+    const qsizetype keyLength = key.size();
+
+    for (qsizetype i = 0, keyIndex = 0; i < length; ++i) {
+        // XOR коду символу з кодом символу ключа.
+        chars[i] = QChar(ushort(chars[i].unicode() ^ keyChars[keyIndex].unicode()));
+        if (++keyIndex == keyLength) {
+            keyIndex = 0;
+        }
     }
 
     return result;
 }
 
+/**
+ * @brief XOR-шифрування байтів на місці.
+ *
+ * Байти даних XOR-яться з байтами ключа в UTF-8 (ключ повторюється).
+ * Той самий метод використовується для шифрування та дешифрування.
+ *
+ * @param data Байти для шифрування/дешифрування.
+ * @param key Ключ шифрування.
+ */
+void SteganographyEngine::xorBytes(QByteArray& data, const QString& key) {
+    const QByteArray keyBytes = key.toUtf8();
+    if (keyBytes.isEmpty()) return;
+
+    char* bytes = data.data();
+    const qsizetype keyLength = keyBytes.size();
+    for (qsizetype i = 0; i < data.size(); ++i) {
+        bytes[i] ^= keyBytes[i % keyLength];
+    }
+}
+
 /**
  * @brief Генерація ключа шифрування з персональних даних.
  *
@@ -499,7 +830,7 @@ QString SteganographyEngine::generateKey(const QString& firstName,
     // Зберігаємо ключ.
     currentKey = key;
 
-    qDebug() << "Generated key:" << key;
+    qDebug() << "Key generated";
 
     return key;
 }
@@ -511,7 +842,7 @@ QString SteganographyEngine::generateKey(const QString& firstName,
  */
 void SteganographyEngine::setKey(const QString& key) {
     currentKey = key;
-    qDebug() << "Encryption key set to:" << key;
+    qDebug() << "Encryption key set," << key.length() << "characters";
 }
 
 /*
@@ -555,92 +886,674 @@ int SteganographyEngine::getBit(int pixel) {
     return pixel & 1;
 }
 
+/**
+ * @brief Запис байтів у молодші біти RGB-каналів.
+ *
+ * Працює безпосередньо з рядками пікселів замість pixelColor/setPixelColor.
+ * Біт з номером i потрапляє в піксель i / 3, канал i % 3 (0 - R, 1 - G, 2 - B),
+ * тому зображення можна розбити на смуги та обробляти їх паралельно.
+ *
+ * @param image Зображення у форматі RGB32.
+ * @param data Байти для запису.
+ */
+void SteganographyEngine::embedBytes(QImage& image, const QByteArray& data) {
+    // bits() від'єднує зображення один раз у поточному потоці,
+    // після чого смуги записуються через сирий вказівник.
+    uchar* pixels = image.bits();
+    const qsizetype bytesPerLine = image.bytesPerLine();
+    const int width = image.width();
+    const uchar* bytes = reinterpret_cast<const uchar*>(data.constData());
+
+    runBands(qint64(data.size()) * 8, BAND_ALIGN_BITS, PARALLEL_MIN_BITS,
+             [=](qint64 bitBegin, qint64 bitEnd) {
+        embedBitRange(pixels, bytesPerLine, width, 0, bytes, bitBegin, bitEnd);
+    });
+}
+
+/**
+ * @brief Зчитування байтів з молодших бітів RGB-каналів.
+ *
+ * Починає з біта byteOffset × 8 і зупиняється рівно після
+ * byteCount байтів, не переглядаючи решту зображення.
+ *
+ * @param image Зображення у форматі RGB32.
+ * @param byteOffset Зміщення першого байта.
+ * @param byteCount Кількість байтів.
+ * @return Зчитані байти.
+ */
+QByteArray SteganographyEngine::extractBytes(const QImage& image,
+                                             qint64 byteOffset,
+                                             qint64 byteCount) {
+    QByteArray data(byteCount, '\0');
+
+    // Не виходимо за межі зображення.
+    const qint64 carrierBits = qint64(image.width()) * image.height() * 3;
+    const qint64 totalBits = qMax<qint64>(0, qMin(byteCount * 8, carrierBits - byteOffset * 8));
+
+    const uchar* pixels = image.constBits();
+    const qsizetype bytesPerLine = image.bytesPerLine();
+    const int width = image.width();
+    const qint64 carrierOffset = byteOffset * 8;
+    uchar* bytes = reinterpret_cast<uchar*>(data.data());
+
+    runBands(totalBits, BAND_ALIGN_BITS, PARALLEL_MIN_BITS,
+             [=](qint64 bitBegin, qint64 bitEnd) {
+        extractBitRange(pixels, bytesPerLine, width, carrierOffset, bytes, bitBegin, bitEnd);
+    });
+
+    return data;
+}
+
+/**
+ * @brief Запис діапазону бітів навантаження в пікселі (ядро однієї смуги).
+ *
+ * Біт навантаження i записується в біт носія carrierOffset + i
+ * (піксель / 3, канал % 3). Старший біт байта записується першим.
+ * Від'ємне зміщення дозволяє писати в смугу, що починається не з першого рядка.
+ *
+ * @param pixels Початок даних зображення (або смуги) RGB32.
+ * @param bytesPerLine Довжина рядка в байтах.
+ * @param width Ширина зображення.
+ * @param carrierOffset Зміщення навантаження в бітах носія.
+ * @param bytes Байти навантаження.
+ * @param bitBegin Перший біт діапазону.
+ * @param bitEnd Біт після останнього.
+ */
+void SteganographyEngine::embedBitRange(uchar* pixels, qsizetype bytesPerLine, int width,
+                                        qint64 carrierOffset, const uchar* bytes,
+                                        qint64 bitBegin, qint64 bitEnd) {
+    // Зсуви каналів R, G, B у значенні QRgb (0xAARRGGBB).
+    static const int CHANNEL_SHIFTS[3] = {16, 8, 0};
+
+    // Позиція першого біта: піксель та канал.
+    const qint64 carrierBit = carrierOffset + bitBegin;
+    qint64 pixelIndex = carrierBit / 3;
+    int channel = static_cast<int>(carrierBit % 3);
+    qint64 y = pixelIndex / width;
+    int x = static_cast<int>(pixelIndex % width);
+    qint64 bitIndex = bitBegin;
+
+    for (; bitIndex < bitEnd; ++y, x = 0) {
+        QRgb* line = reinterpret_cast<QRgb*>(pixels + y * bytesPerLine);
+
+        for (; x < width && bitIndex < bitEnd; ++x, channel = 0) {
+            QRgb pixel = line[x];
+
+            for (; channel < 3 && bitIndex < bitEnd; ++channel, ++bitIndex) {
+                uint bit = (bytes[bitIndex >> 3] >> (7 - (bitIndex & 7))) & 1u;
+                pixel = (pixel & ~(1u << CHANNEL_SHIFTS[channel])) | (bit << CHANNEL_SHIFTS[channel]);
+            }
+
+            line[x] = pixel;
+        }
+    }
+}
+
+/**
+ * @brief Зчитування діапазону бітів навантаження з пікселів (ядро однієї смуги).
+ *
+ * Біт навантаження i зчитується з біта носія carrierOffset + i.
+ * Вихідний буфер має бути заповнений нулями.
+ *
+ * @param pixels Початок даних зображення RGB32.
+ * @param bytesPerLine Довжина рядка в байтах.
+ * @param width Ширина зображення.
+ * @param carrierOffset Зміщення навантаження в бітах носія.
+ * @param bytes Вихідні байти.
+ * @param bitBegin Перший біт діапазону.
+ * @param bitEnd Біт після останнього.
+ */
+void SteganographyEngine::extractBitRange(const uchar* pixels, qsizetype bytesPerLine, int width,
+                                          qint64 carrierOffset, uchar* bytes,
+                                          qint64 bitBegin, qint64 bitEnd) {
+    static const int CHANNEL_SHIFTS[3] = {16, 8, 0};
+
+    const qint64 carrierBit = carrierOffset + bitBegin;
+    qint64 pixelIndex = carrierBit / 3;
+    int channel = static_cast<int>(carrierBit % 3);
+    qint64 y = pixelIndex / width;
+    int x = static_cast<int>(pixelIndex % width);
+    qint64 bitIndex = bitBegin;
+
+    for (; bitIndex < bitEnd; ++y, x = 0) {
+        const QRgb* line = reinterpret_cast<const QRgb*>(pixels + y * bytesPerLine);
+
+        for (; x < width && bitIndex < bitEnd; ++x, channel = 0) {
+            const QRgb pixel = line[x];
+
+            for (; channel < 3 && bitIndex < bitEnd; ++channel, ++bitIndex) {
+                uint bit = (pixel >> CHANNEL_SHIFTS[channel]) & 1u;
+                bytes[bitIndex >> 3] |= uchar(bit << (7 - (bitIndex & 7)));
+            }
+        }
+    }
+}
+
 /*
  * ============================================================================
- * МЕТОДИ ОБЧИСЛЕННЯ ЯКОСТІ
+ * ПАРАЛЕЛЬНА ОБРОБКА
  * ============================================================================
  */
 
 /**
- * @brief Обчислення PSNR між двома зображеннями.
+ * @brief Увімкнення паралельного режиму.
  *
- * PSNR (Peak Signal-to-Noise Ratio) - міра якості зображення.
- * Формула: PSNR = 10 × log10(MAX² / MSE)
- * де MAX = 255 (максимальне значення піксела).
+ * @param enabled Чи використовувати пул потоків.
+ * @param threads Кількість потоків (0 - за кількістю ядер процесора).
+ */
+void SteganographyEngine::setParallelMode(bool enabled, int threads) {
+    parallelMode = enabled;
+    threadPool.setMaxThreadCount(threads > 0 ? threads : QThread::idealThreadCount());
+    qDebug() << "Parallel mode:" << enabled << "threads:" << threadPool.maxThreadCount();
+}
+
+/**
+ * @brief Чи увімкнено паралельний режим.
  *
- * Інтерпретація:
- * - PSNR > 40 дБ: Відмінна якість (зміни непомітні).
- * - PSNR 30-40 дБ: Добра якість (мінімальні зміни).
- * - PSNR < 30 дБ: Низька якість (помітні зміни).
+ * @return true якщо обробка виконується пулом потоків.
+ */
+bool SteganographyEngine::isParallelMode() const {
+    return parallelMode;
+}
+
+/**
+ * @brief Кількість потоків, що використовуються для обробки.
  *
- * @param original Оригінальне зображення.
- * @param modified Модифіковане зображення.
- * @return Значення PSNR в децибелах.
+ * @return 1 у послідовному режимі, інакше розмір пулу.
+ */
+int SteganographyEngine::threadCount() const {
+    return parallelMode ? threadPool.maxThreadCount() : 1;
+}
+
+/**
+ * @brief Встановлення обробника прогресу.
+ * @param handler Обробник (порожній - без звітів).
+ */
+void SteganographyEngine::setProgressHandler(const ProgressHandler& handler) {
+    progressHandler = handler;
+}
+
+/**
+ * @brief Запит на скасування поточної (або наступної) операції.
+ */
+void SteganographyEngine::cancel() {
+    cancelRequested.storeRelaxed(1);
+}
+
+/**
+ * @brief Чи надійшов запит на скасування.
+ * @return true якщо операцію скасовано.
  */
-double SteganographyEngine::calculatePSNR(const QImage& original,
-                                          const QImage& modified) {
-    // Обчислюємо MSE.
-    double mse = calculateMSE(original, modified);
+bool SteganographyEngine::isCancelled() const {
+    return cancelRequested.loadRelaxed() != 0;
+}
 
-    // Якщо MSE = 0, зображення ідентичні.
-    if (mse == 0) {
-        return 100.0;  // Максимальна якість.
+/**
+ * @brief Початок відстеження прогресу операції.
+ * @param total Загальна кількість одиниць роботи.
+ */
+void SteganographyEngine::beginProgress(qint64 total) {
+    progressDone.storeRelaxed(0);
+    progressTotal = qMax<qint64>(1, total);
+    if (progressHandler) {
+        progressHandler(0, progressTotal);
     }
+}
 
-    // Максимальне значення піксела.
-    double maxPixelValue = 255.0;
+/**
+ * @brief Завершення відстеження прогресу та скидання запиту на скасування.
+ */
+void SteganographyEngine::endProgress() {
+    progressTotal = 0;
+    cancelRequested.storeRelaxed(0);
+}
 
-    // Обчислюємо PSNR за формулою.
-    double psnr = 10.0 * log10((maxPixelValue * maxPixelValue) / mse);
+/**
+ * @brief Додавання виконаної роботи та виклик обробника прогресу.
+ * @param units Кількість одиниць роботи.
+ */
+void SteganographyEngine::advanceProgress(qint64 units) {
+    const qint64 done = progressDone.fetchAndAddRelaxed(units) + units;
+    if (progressHandler) {
+        progressHandler(done, progressTotal);
+    }
+}
 
-    return psnr;
+/**
+ * @brief Розбиття діапазону на смуги та їх обробка.
+ *
+ * Діапазоном можуть бути біти навантаження або рядки зображення.
+ * Для бітів межі смуг вирівнюються на BAND_ALIGN_BITS (24 біти = 8 пікселів
+ * = 3 байти), тому жодні дві смуги не пишуть в один піксель або в один байт
+ * навантаження. Результат ідентичний послідовній обробці. Невеликі обсяги
+ * обробляються в поточному потоці, щоб не платити за синхронізацію.
+ *
+ * Під час відстеження прогресу (beginProgress) діапазон ділиться щонайменше
+ * на PROGRESS_STEPS смуг і в послідовному режимі: після кожної смуги
+ * звітується прогрес, а перед нею перевіряється запит на скасування.
+ *
+ * @param total Розмір діапазону.
+ * @param alignment Кратність меж смуг.
+ * @param minParallel Мінімальний розмір діапазону для паралельної обробки.
+ * @param kernel Обробник смуги [begin, end).
+ */
+void SteganographyEngine::runBands(qint64 total, qint64 alignment, qint64 minParallel,
+                                   const std::function<void(qint64, qint64)>& kernel) {
+    const int threads = threadCount();
+    const bool parallel = threads > 1 && total >= minParallel;
+    const bool tracked = progressTotal > 0;
+    if (!parallel && !tracked) {
+        kernel(0, total);
+        return;
+    }
+
+    // Кілька смуг на потік для рівномірного навантаження.
+    qint64 bandCount = parallel ? qint64(threads) * 4 : 1;
+    if (tracked) {
+        bandCount = qMax(bandCount, PROGRESS_STEPS);
+    }
+    qint64 bandSize = (total + bandCount - 1) / bandCount;
+    bandSize = qMax<qint64>(alignment, (bandSize + alignment - 1) / alignment * alignment);
+
+    const auto band = [this, &kernel, tracked](qint64 begin, qint64 end) {
+        if (tracked) {
+            if (isCancelled()) {
+                return;
+            }
+            kernel(begin, end);
+            advanceProgress(end - begin);
+        } else {
+            kernel(begin, end);
+        }
+    };
+
+    if (!parallel) {
+        for (qint64 begin = 0; begin < total; begin += bandSize) {
+            band(begin, qMin(total, begin + bandSize));
+        }
+        return;
+    }
+
+    QSemaphore finished;
+    int started = 0;
+
+    for (qint64 begin = 0; begin < total; begin += bandSize) {
+        const qint64 end = qMin(total, begin + bandSize);
+        threadPool.start([&band, &finished, begin, end] {
+            band(begin, end);
+            finished.release();
+        });
+        ++started;
+    }
+
+    // Чекаємо завершення всіх смуг цього виклику.
+    finished.acquire(started);
 }
 
+/*
+ * ============================================================================
+ * МЕТОДИ РОБОТИ З ЗАГОЛОВКОМ НАВАНТАЖЕННЯ
+ * ============================================================================
+ */
+
 /**
- * @brief Обчислення MSE між двома зображеннями.
+ * @brief Зчитування та перевірка заголовка навантаження.
  *
- * MSE (Mean Squared Error) - середньоквадратична помилка.
- * Формула: MSE = (1/N) × Σ(Original - Modified)²
- * де N - загальна кількість пікселів.
+ * Зчитує лише перші 128 бітів (43 пікселі) і перевіряє:
+ * - сигнатуру та версію формату;
+ * - що заявлена довжина вміщується в зображення.
  *
- * Інтерпретація:
- * - MSE ≈ 0: Зображення практично ідентичні.
- * - MSE < 1: Дуже малі відмінності.
- * - MSE > 10: Значні відмінності.
+ * @param image Зображення у форматі RGB32.
+ * @param header Структура для заповнення.
+ * @return true якщо заголовок коректний.
+ */
+bool SteganographyEngine::readPayloadHeader(const QImage& image,
+                                            PayloadHeader& header) {
+    qint64 availableBytes = qint64(image.width()) * image.height() * 3 / 8;
+    if (availableBytes < PAYLOAD_HEADER_SIZE) {
+        return false;
+    }
+
+    header = parseHeader(extractBytes(image, 0, PAYLOAD_HEADER_SIZE));
+
+    if (header.magic != PAYLOAD_MAGIC || !knownVersion(header.version)) {
+        return false;
+    }
+
+    return payloadFits(header, qint64(image.width()) * image.height());
+}
+
+/**
+ * @brief Перевірка, що навантаження вміщується в зображення.
+ *
+ * Враховує розширення заголовка та режим бітових площин.
+ *
+ * @param header Заголовок навантаження.
+ * @param pixels Кількість пікселів зображення.
+ * @return true якщо заголовок, розширення і дані вміщуються.
+ */
+bool SteganographyEngine::payloadFits(const PayloadHeader& header, qint64 pixels) const {
+    return qint64(header.length) <= dataCapacity(header, pixels);
+}
+
+/**
+ * @brief Серіалізація заголовка у 16 байтів (big-endian).
+ *
+ * @param header Заголовок навантаження.
+ * @return Байтове представлення заголовка.
+ */
+QByteArray SteganographyEngine::serializeHeader(const PayloadHeader& header) {
+    QByteArray bytes(PAYLOAD_HEADER_SIZE, '\0');
+    uchar* p = reinterpret_cast<uchar*>(bytes.data());
+
+    qToBigEndian<quint32>(header.magic, p);
+    p[4] = header.version;
+    p[5] = header.flags;
+    qToBigEndian<quint16>(header.extensionSize, p + 6);
+    qToBigEndian<quint32>(header.length, p + 8);
+    qToBigEndian<quint32>(header.crc, p + 12);
+
+    return bytes;
+}
+
+/**
+ * @brief Розбір заголовка з 16 байтів.
+ *
+ * @param bytes Байтове представлення заголовка.
+ * @return Заголовок навантаження.
+ */
+PayloadHeader SteganographyEngine::parseHeader(const QByteArray& bytes) {
+    PayloadHeader header;
+    if (bytes.size() < PAYLOAD_HEADER_SIZE) {
+        return header;
+    }
+
+    const uchar* p = reinterpret_cast<const uchar*>(bytes.constData());
+
+    header.magic = qFromBigEndian<quint32>(p);
+    header.version = p[4];
+    header.flags = p[5];
+    header.extensionSize = qFromBigEndian<quint16>(p + 6);
+    header.length = qFromBigEndian<quint32>(p + 8);
+    header.crc = qFromBigEndian<quint32>(p + 12);
+
+    return header;
+}
+
+/**
+ * @brief Обчислення контрольної суми CRC-32 (IEEE 802.3).
+ *
+ * Табличний алгоритм з поліномом 0xEDB88320 (як у zlib та PNG).
+ *
+ * @param data Дані для обчислення.
+ * @return Контрольна сума.
+ */
+quint32 SteganographyEngine::calculateCRC32(const QByteArray& data) {
+    // Таблиця обчислюється один раз при першому виклику.
+    static const QVector<quint32> table = [] {
+        QVector<quint32> t(256);
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 c = i;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+
+    quint32 crc = 0xFFFFFFFFu;
+    for (char byte : data) {
+        crc = table[(crc ^ uchar(byte)) & 0xFF] ^ (crc >> 8);
+    }
+
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/*
+ * ============================================================================
+ * МЕТОДИ ОБЧИСЛЕННЯ ЯКОСТІ
+ * ============================================================================
+ */
+
+/**
+ * @brief Обчислення метрик якості за один злитий прохід.
+ *
+ * Один прохід по рядках (scanLine) обох зображень обчислює одночасно:
+ * - суму квадратів різниць по кожному каналу (MSE загальна та по каналах);
+ * - кількість змінених пікселів;
+ * - бітову карту змінених пікселів (Format_Mono).
+ *
+ * Формули:
+ * - MSE = (1/N) × Σ(Original - Modified)², усереднено по каналах R, G, B.
+ * - PSNR = 10 × log10(255² / MSE).
+ *
+ * Інтерпретація PSNR:
+ * - PSNR > 40 дБ: Відмінна якість (зміни непомітні).
+ * - PSNR 30-40 дБ: Добра якість (мінімальні зміни).
+ * - PSNR < 30 дБ: Низька якість (помітні зміни).
+ *
+ * Внутрішній цикл не містить розгалужень і працює з цілими числами,
+ * тому компілятор векторизує його. Рядки обробляються смугами паралельно.
  *
  * @param original Оригінальне зображення.
  * @param modified Модифіковане зображення.
- * @return Значення MSE.
+ * @param result Структура для заповнення метрик.
  */
-double SteganographyEngine::calculateMSE(const QImage& original,
-                                         const QImage& modified) {
+void SteganographyEngine::calculateQualityMetrics(const QImage& original,
+                                                  const QImage& modified,
+                                                  ImageAnalysisResult& result) {
     // Перевіряємо чи розміри однакові.
     if (original.size() != modified.size()) {
         qWarning() << "Images have different sizes!";
-        return -1.0;
+        return;
     }
 
-    double sum = 0.0;
-    int totalPixels = original.width() * original.height();
+    // ARGB32 зберігає альфа-канал, якщо дані записувались і в нього.
+    const QImage::Format format = (original.hasAlphaChannel() || modified.hasAlphaChannel())
+                                      ? QImage::Format_ARGB32
+                                      : QImage::Format_RGB32;
+    const QImage first = original.convertToFormat(format);
+    const QImage second = modified.convertToFormat(format);
+    const int width = first.width();
+    const int height = first.height();
+
+    // Бітова карта: 1 - піксель змінено, 0 - без змін.
+    QImage mask(width, height, QImage::Format_Mono);
+    mask.setColor(0, qRgb(0, 0, 0));
+    mask.setColor(1, qRgb(255, 255, 255));
+    uchar* maskBits = mask.bits();
+    const qsizetype maskBytesPerLine = mask.bytesPerLine();
+
+    quint64 sse[3] = {0, 0, 0};
+    qint64 changed = 0;
+    qint64 changedChannels = 0;
+    QMutex mutex;
+
+    runBands(height, 1, PARALLEL_MIN_ROWS, [&](qint64 rowBegin, qint64 rowEnd) {
+        quint64 bandSse[3] = {0, 0, 0};
+        qint64 bandChanged = 0;
+        qint64 bandChannels = 0;
+
+        for (qint64 y = rowBegin; y < rowEnd; ++y) {
+            const QRgb* a = reinterpret_cast<const QRgb*>(first.constScanLine(int(y)));
+            const QRgb* b = reinterpret_cast<const QRgb*>(second.constScanLine(int(y)));
+            uchar* maskLine = maskBits + y * maskBytesPerLine;
+
+            // Суми блоку з 8 пікселів вміщуються в 32 біти без переповнення.
+            quint64 rowSse[3] = {0, 0, 0};
+
+            for (int x0 = 0; x0 < width; x0 += 8) {
+                const int x1 = qMin(width, x0 + 8);
+                uint maskByte = 0;
+                uint sumR = 0, sumG = 0, sumB = 0;
+
+                for (int x = x0; x < x1; ++x) {
+                    const int dr = qRed(a[x]) - qRed(b[x]);
+                    const int dg = qGreen(a[x]) - qGreen(b[x]);
+                    const int db = qBlue(a[x]) - qBlue(b[x]);
+                    sumR += uint(dr * dr);
+                    sumG += uint(dg * dg);
+                    sumB += uint(db * db);
+
+                    // У RGB32 альфа завжди 0xFF, тому порівнюємо всі 4 канали.
+                    const QRgb diff = a[x] ^ b[x];
+                    const uint isChanged = diff != 0;
+                    maskByte |= isChanged << (7 - (x - x0));
+                    bandChanged += isChanged;
+                    bandChannels += ((diff & 0xFFu) != 0) + ((diff & 0xFF00u) != 0) +
+                                    ((diff & 0xFF0000u) != 0) + ((diff & 0xFF000000u) != 0);
+                }
 
-    // Проходимо по всіх пікселях.
-    for (int y = 0; y < original.height(); ++y) {
-        for (int x = 0; x < original.width(); ++x) {
-            // Отримуємо кольори пікселів.
-            QColor origColor = original.pixelColor(x, y);
-            QColor modColor = modified.pixelColor(x, y);
+                rowSse[0] += sumR;
+                rowSse[1] += sumG;
+                rowSse[2] += sumB;
+                maskLine[x0 >> 3] = uchar(maskByte);
+            }
 
-            // Обчислюємо різницю для кожного каналу.
-            double dr = origColor.red() - modColor.red();
-            double dg = origColor.green() - modColor.green();
-            double db = origColor.blue() - modColor.blue();
+            for (int c = 0; c < 3; ++c) {
+                bandSse[c] += rowSse[c];
+            }
+        }
 
-            // Додаємо квадрати різниць.
-            // Ділимо на 3 бо усереднюємо по каналах.
-            sum += (dr * dr + dg * dg + db * db) / 3.0;
+        QMutexLocker locker(&mutex);
+        for (int c = 0; c < 3; ++c) {
+            sse[c] += bandSse[c];
         }
+        changed += bandChanged;
+        changedChannels += bandChannels;
+    });
+
+    // ========== MSE загальна та по каналах ==========
+    const double totalPixels = double(width) * height;
+    result.mseRed = sse[0] / totalPixels;
+    result.mseGreen = sse[1] / totalPixels;
+    result.mseBlue = sse[2] / totalPixels;
+    result.mse = (result.mseRed + result.mseGreen + result.mseBlue) / 3.0;
+
+    // ========== PSNR ==========
+    // Якщо MSE = 0, зображення ідентичні (максимальна якість).
+    const double maxPixelValue = 255.0;
+    result.psnr = result.mse == 0
+                      ? 100.0
+                      : 10.0 * log10((maxPixelValue * maxPixelValue) / result.mse);
+
+    result.modifiedPixels = static_cast<int>(changed);
+    result.changedChannels = changedChannels;
+    result.changedPixelsMask = mask;
+
+    // ========== SSIM ==========
+    result.ssim = calculateSSIM(first, second);
+}
+
+/**
+ * @brief Обчислення SSIM (Structural Similarity Index) ковзним вікном.
+ *
+ * SSIM порівнює локальні середні, дисперсії та коваріацію яскравості
+ * у вікні 8×8, що ковзає з кроком 1 піксель:
+ * SSIM = ((2μxμy + C1)(2σxy + C2)) / ((μx² + μy² + C1)(σx² + σy² + C2)),
+ * де C1 = (0.01 × 255)², C2 = (0.03 × 255)².
+ *
+ * Суми у вікні підтримуються інкрементально: стовпцеві суми оновлюються
+ * при зсуві вікна вниз, горизонтальні - при зсуві вправо. Тому кожне
+ * вікно обчислюється за O(1), а пам'ять пропорційна лише ширині.
+ *
+ * Інтерпретація:
+ * - SSIM = 1: Зображення структурно ідентичні.
+ * - SSIM > 0.99: Зміни непомітні.
+ *
+ * @param first Перше зображення (RGB32).
+ * @param second Друге зображення (RGB32).
+ * @return Середнє значення SSIM по всіх вікнах.
+ */
+double SteganographyEngine::calculateSSIM(const QImage& first, const QImage& second) {
+    const int width = first.width();
+    const int height = first.height();
+    const int window = qMin(SSIM_WINDOW, qMin(width, height));
+    if (window < 1) {
+        return 1.0;
     }
 
-    // Обчислюємо середнє значення.
-    return sum / totalPixels;
+    const int windowsX = width - window + 1;
+    const int windowsY = height - window + 1;
+    const double n = double(window) * window;
+    const double c1 = (0.01 * 255) * (0.01 * 255);
+    const double c2 = (0.03 * 255) * (0.03 * 255);
+
+    // Яскравість піксела (ITU-R BT.601, цілочисельна апроксимація).
+    auto luma = [](QRgb pixel) {
+        return (77 * qRed(pixel) + 150 * qGreen(pixel) + 29 * qBlue(pixel) + 128) >> 8;
+    };
+
+    double ssimSum = 0.0;
+    QMutex mutex;
+
+    runBands(windowsY, 1, PARALLEL_MIN_ROWS, [&](qint64 rowBegin, qint64 rowEnd) {
+        // Стовпцеві суми по рядках [r, r + window).
+        QVector<qint64> sumX(width, 0), sumY(width, 0);
+        QVector<qint64> sumXX(width, 0), sumYY(width, 0), sumXY(width, 0);
+
+        auto addRow = [&](int y, int sign) {
+            const QRgb* a = reinterpret_cast<const QRgb*>(first.constScanLine(y));
+            const QRgb* b = reinterpret_cast<const QRgb*>(second.constScanLine(y));
+            for (int x = 0; x < width; ++x) {
+                const int lx = luma(a[x]);
+                const int ly = luma(b[x]);
+                sumX[x] += sign * lx;
+                sumY[x] += sign * ly;
+                sumXX[x] += sign * lx * lx;
+                sumYY[x] += sign * ly * ly;
+                sumXY[x] += sign * lx * ly;
+            }
+        };
+
+        for (int y = int(rowBegin); y < int(rowBegin) + window; ++y) {
+            addRow(y, 1);
+        }
+
+        double bandSum = 0.0;
+
+        for (int r = int(rowBegin); r < int(rowEnd); ++r) {
+            // Суми першого вікна в рядку.
+            qint64 sx = 0, sy = 0, sxx = 0, syy = 0, sxy = 0;
+            for (int x = 0; x < window; ++x) {
+                sx += sumX[x];
+                sy += sumY[x];
+                sxx += sumXX[x];
+                syy += sumYY[x];
+                sxy += sumXY[x];
+            }
+
+            for (int wx = 0; wx < windowsX; ++wx) {
+                const double muX = sx / n;
+                const double muY = sy / n;
+                const double varX = sxx / n - muX * muX;
+                const double varY = syy / n - muY * muY;
+                const double covXY = sxy / n - muX * muY;
+
+                bandSum += ((2 * muX * muY + c1) * (2 * covXY + c2)) /
+                           ((muX * muX + muY * muY + c1) * (varX + varY + c2));
+
+                // Зсуваємо вікно на один стовпець вправо.
+                if (wx + window < width) {
+                    sx += sumX[wx + window] - sumX[wx];
+                    sy += sumY[wx + window] - sumY[wx];
+                    sxx += sumXX[wx + window] - sumXX[wx];
+                    syy += sumYY[wx + window] - sumYY[wx];
+                    sxy += sumXY[wx + window] - sumXY[wx];
+                }
+            }
+
+            // Зсуваємо вікно на один рядок вниз.
+            if (r + 1 < rowEnd) {
+                addRow(r + window, 1);
+                addRow(r, -1);
+            }
+        }
+
+        QMutexLocker locker(&mutex);
+        ssimSum += bandSum;
+    });
+
+    return ssimSum / (double(windowsX) * windowsY);
 }
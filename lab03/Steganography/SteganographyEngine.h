@@ -8,8 +8,24 @@
  * Основні можливості:
  * - Приховування тексту в зображеннях.
  * - Витягування прихованого тексту.
- * - XOR шифрування/дешифрування.
- * - Аналіз якості стеганографії (PSNR, MSE).
+ * - Приховування довільних файлів з потоковим читанням і записом.
+ * - Розподіл повідомлення між кількома зображеннями (фрагменти парності
+ *   Ріда-Соломона, паралельна обробка зображень).
+ * - Упакований двійковий формат навантаження із заголовком.
+ * - Опціональне стиснення даних (deflate) перед вбудовуванням.
+ * - Матричне вбудовування кодами Геммінга (менше змінених пікселів).
+ * - Опціональний код Ріда-Соломона: навантаження витримує поодинокі
+ *   змінені молодші біти.
+ * - Вбудовування в 1-4 молодші біти каналу (опціонально з альфа-каналом).
+ * - Ключовий псевдовипадковий порядок пікселів (без таблиці індексів).
+ * - Паралельна обробка зображення смугами (пул потоків).
+ * - Поблокова обробка дуже великих файлів з обмеженою пам'яттю.
+ * - Приховування в коефіцієнтах DCT файлів JPEG (F4/F5, без перекодування).
+ * - Приховування в 16/24-бітному PCM файлів WAV (відображення в пам'ять).
+ * - Приховування в площині яскравості відео Y4M (паралельно по кадрах).
+ * - Автентифіковане шифрування ChaCha20-Poly1305 (XOR - для старих даних).
+ * - Аналіз якості стеганографії (PSNR, MSE, SSIM) за один прохід.
+ * - Статистичний стегоаналіз (хі-квадрат, RS, аналіз пар пікселів).
  * - Генерація ключів з персональних даних.
  */
 
@@ -18,8 +34,89 @@
 
 #include <QImage>
 #include <QString>
+#include <QByteArray>
 #include <QMap>
 #include <QVector>
+#include <QThreadPool>
+#include <QAtomicInteger>
+#include <functional>
+
+class KeyedPermutation;
+class Y4mFile;
+
+/**
+ * @struct PayloadHeader
+ * @brief Двійковий заголовок упакованого навантаження.
+ *
+ * Записується в перші 16 байтів (128 бітів) прихованих даних.
+ * Всі багатобайтові поля зберігаються у форматі big-endian.
+ *
+ * Структура (16 байтів):
+ * - magic (4 байти): сигнатура "STEG".
+ * - version (1 байт): версія формату.
+ * - flags (1 байт): прапорці (шифрування, альфа-канал, біти 2-3: бітів на канал - 1,
+ *   ключовий порядок пікселів, тип шифру, біти 6-7: кодек стиснення).
+ * - extensionSize (2 байти): розмір розширення заголовка.
+ * - length (4 байти): довжина даних у байтах (після стиснення).
+ * - crc (4 байти): CRC-32 відкритого тексту (UTF-8 до стиснення).
+ *
+ * За заголовком іде розширення (extensionSize байтів). Для шифрування
+ * ChaCha20-Poly1305 воно містить nonce (12 байтів) і тег (16 байтів),
+ * у версії 2 за ними - параметри scrypt (logN, r, p по 1 байту) і сіль
+ * (16 байтів), з яких виводиться ключ шифру; для матричного вбудовування
+ * далі йде 1 байт параметра коду Геммінга.
+ *
+ * Навантаження з файлом має сигнатуру "STEF", а за даними шифру в
+ * розширенні йде запис файлу: розмір (8 байтів), довжина імені (2 байти)
+ * та ім'я в UTF-8. Кодек deflate для файлу - суцільний потік zlib.
+ *
+ * Фрагмент навантаження, розподіленого між кількома зображеннями, має
+ * сигнатуру "STES": розширення - запис фрагмента (набір, номер, кількість
+ * фрагментів даних і парності, розмір навантаження), дані - фрагмент
+ * звичайного навантаження "STEG", а CRC-32 охоплює запис і фрагмент.
+ *
+ * Навантаження з кодом Ріда-Соломона має сигнатуру "STER": розширення -
+ * символи парності на слово (1 байт), розмір навантаження "STEG" (4 байти)
+ * та 16 символів парності заголовка і запису; дані - навантаження "STEG",
+ * закодоване словами з чергуванням, а CRC-32 охоплює навантаження "STEG".
+ */
+struct PayloadHeader {
+    quint32 magic = 0;          ///< Сигнатура формату.
+    quint8 version = 0;         ///< Версія формату.
+    quint8 flags = 0;           ///< Прапорці навантаження.
+    quint16 extensionSize = 0;  ///< Розмір розширення заголовка в байтах.
+    quint32 length = 0;         ///< Довжина даних у байтах.
+    quint32 crc = 0;            ///< CRC-32 відкритого тексту.
+};
+
+/**
+ * @enum ProbeResult
+ * @brief Результат швидкої перевірки заголовка навантаження.
+ */
+enum class ProbeResult {
+    None,       ///< Навантаження не знайдено.
+    Plain,      ///< Відкрите навантаження.
+    Encrypted   ///< Зашифроване навантаження (для витягування потрібен ключ).
+};
+
+/**
+ * @struct SteganalysisResult
+ * @brief Результати статистичного стегоаналізу зображення.
+ *
+ * Оцінки частки вбудовування (0..1) для довільного LSB-вбудовування,
+ * незалежно від формату навантаження:
+ * - Хі-квадрат атака на пари значень (Westfeld-Pfitzmann).
+ * - RS-аналіз (Fridrich, регулярні та сингулярні групи).
+ * - Аналіз пар пікселів (Sample Pair Analysis, Dumitrescu).
+ */
+struct SteganalysisResult {
+    double chiSquareProbability = 0.0;  ///< Ймовірність вбудовування за хі-квадрат (0..1).
+    double chiSquareRate = 0.0;    ///< Частка зображення з початку, де хі-квадрат виявляє вбудовування.
+    double rsRate = 0.0;           ///< Оцінка частки вбудовування RS-аналізом.
+    double samplePairRate = 0.0;   ///< Оцінка частки вбудовування аналізом пар пікселів.
+    double estimatedRate = 0.0;    ///< Підсумкова оцінка частки вбудовування.
+    bool suspicious = false;       ///< Чи перевищує оцінка поріг виявлення.
+};
 
 /**
  * @struct ImageAnalysisResult
@@ -41,29 +138,165 @@ struct ImageAnalysisResult {
 
     // ========== Статистика повідомлення ==========
     int messageLength = 0;      ///< Довжина прихованого повідомлення в символах.
+    int messageBytes = 0;       ///< Розмір повідомлення в байтах UTF-8.
     int bitsUsed = 0;          ///< Кількість використаних бітів.
     double capacityUsed = 0.0; ///< Відсоток використаної ємності.
-    double maxCapacity = 0.0;  ///< Максимальна ємність в символах.
+    double maxCapacity = 0.0;  ///< Максимальна ємність в байтах UTF-8.
+    int storedBytes = 0;       ///< Байтів даних у зображенні (після стиснення).
+    bool compressed = false;   ///< Чи стиснуте повідомлення.
+    double effectiveCapacity = 0.0;  ///< Ємність з урахуванням стиснення (байтів UTF-8).
+    int bitsPerChannel = 1;    ///< Кількість молодших бітів на канал.
+    bool alphaUsed = false;    ///< Чи використовується альфа-канал.
+    bool keyedOrder = false;   ///< Чи розміщуються дані в ключовому порядку пікселів.
+    int hammingP = 0;          ///< Параметр p коду Геммінга (0 - без матричного вбудовування).
 
     // ========== Метрики якості ==========
     double psnr = 0.0;  ///< Peak Signal-to-Noise Ratio (дБ).
     double mse = 0.0;   ///< Mean Squared Error.
-    int modifiedPixels = 0;  ///< Кількість змінених пікселів.
+    double mseRed = 0.0;    ///< MSE червоного каналу.
+    double mseGreen = 0.0;  ///< MSE зеленого каналу.
+    double mseBlue = 0.0;   ///< MSE синього каналу.
+    double ssim = 0.0;  ///< Structural Similarity Index (0..1).
+    int modifiedPixels = 0;  ///< Кількість змінених пікселів (з урахуванням альфа-каналу).
+    qint64 changedChannels = 0;  ///< Кількість змінених значень каналів.
+    double embeddingEfficiency = 0.0;  ///< Бітів навантаження на одну зміну каналу.
+    QImage changedPixelsMask;  ///< Бітова карта змінених пікселів (Format_Mono).
+
+    // ========== Статистичний стегоаналіз ==========
+    SteganalysisResult originalSteganalysis;  ///< Стегоаналіз оригіналу.
+    SteganalysisResult modifiedSteganalysis;  ///< Стегоаналіз модифікованого зображення.
 
     // ========== Інформація про повідомлення ==========
     QString message;        ///< Приховане повідомлення.
     bool hasMessage = false;  ///< Чи містить зображення повідомлення.
 };
 
+/**
+ * @struct AudioAnalysisResult
+ * @brief Результати порівняння оригінального та модифікованого файлу WAV.
+ *
+ * Аналог ImageAnalysisResult для аудіо: замість PSNR/SSIM зображення -
+ * відношення сигнал/шум (SNR) та PSNR відносно повної шкали відліку.
+ */
+struct AudioAnalysisResult {
+    // ========== Формат ==========
+    int channels = 0;           ///< Кількість каналів.
+    int sampleRate = 0;         ///< Частота дискретизації (Гц).
+    int bitsPerSample = 0;      ///< Розрядність відліку (16 або 24).
+    qint64 sampleCount = 0;     ///< Кількість відліків усіх каналів.
+    double duration = 0.0;      ///< Тривалість (секунди).
+
+    // ========== Розміри файлів ==========
+    qint64 originalFileSize = 0;  ///< Розмір оригінального файлу в байтах.
+    qint64 modifiedFileSize = 0;  ///< Розмір модифікованого файлу в байтах.
+
+    // ========== Статистика повідомлення ==========
+    int messageLength = 0;      ///< Довжина прихованого повідомлення в символах.
+    int messageBytes = 0;       ///< Розмір повідомлення в байтах UTF-8.
+    qint64 bitsUsed = 0;        ///< Кількість використаних бітів.
+    double capacityUsed = 0.0;  ///< Відсоток використаної ємності.
+    double maxCapacity = 0.0;   ///< Максимальна ємність в байтах.
+    int storedBytes = 0;        ///< Байтів даних у файлі (після стиснення).
+    bool compressed = false;    ///< Чи стиснуте повідомлення.
+    int lsbBits = 1;            ///< Кількість молодших бітів на відлік.
+    bool keyedOrder = false;    ///< Чи розміщуються дані в ключовому порядку відліків.
+
+    // ========== Метрики якості ==========
+    double snr = 0.0;           ///< Signal-to-Noise Ratio (дБ).
+    double psnr = 0.0;          ///< PSNR відносно повної шкали відліку (дБ).
+    double mse = 0.0;           ///< Mean Squared Error (в одиницях відліку).
+    int maxDifference = 0;      ///< Найбільша зміна відліку.
+    qint64 modifiedSamples = 0; ///< Кількість змінених відліків.
+    double embeddingEfficiency = 0.0;  ///< Бітів навантаження на одну зміну відліку.
+
+    // ========== Інформація про повідомлення ==========
+    QString message;            ///< Приховане повідомлення.
+    bool hasMessage = false;    ///< Чи містить файл повідомлення.
+};
+
+/**
+ * @struct VideoFrameQuality
+ * @brief Метрики якості одного кадру відео (площина яскравості).
+ */
+struct VideoFrameQuality {
+    int frame = 0;              ///< Номер кадру.
+    double psnr = 0.0;          ///< PSNR кадру (дБ).
+    double mse = 0.0;           ///< MSE кадру.
+    double ssim = 0.0;          ///< SSIM кадру (0..1).
+    int modifiedPixels = 0;     ///< Кількість змінених пікселів кадру.
+};
+
+/**
+ * @struct VideoAnalysisResult
+ * @brief Результати порівняння оригінального та модифікованого відео Y4M.
+ *
+ * Метрики кожного кадру обчислюються так само, як в analyzeChanges()
+ * (площина яскравості як зображення у відтінках сірого); підсумкові
+ * значення - по всіх порівняних кадрах.
+ */
+struct VideoAnalysisResult {
+    // ========== Формат ==========
+    int width = 0;              ///< Ширина кадру.
+    int height = 0;             ///< Висота кадру.
+    int frameCount = 0;         ///< Кількість кадрів.
+    double frameRate = 0.0;     ///< Кадрів за секунду.
+    double duration = 0.0;      ///< Тривалість (секунди).
+
+    // ========== Розміри файлів ==========
+    qint64 originalFileSize = 0;  ///< Розмір оригінального файлу в байтах.
+    qint64 modifiedFileSize = 0;  ///< Розмір модифікованого файлу в байтах.
+
+    // ========== Статистика повідомлення ==========
+    int messageLength = 0;      ///< Довжина прихованого повідомлення в символах.
+    int messageBytes = 0;       ///< Розмір повідомлення в байтах UTF-8.
+    qint64 bitsUsed = 0;        ///< Кількість використаних бітів.
+    double capacityUsed = 0.0;  ///< Відсоток використаної ємності.
+    double maxCapacity = 0.0;   ///< Максимальна ємність в байтах.
+    int storedBytes = 0;        ///< Байтів даних у файлі (після стиснення).
+    bool compressed = false;    ///< Чи стиснуте повідомлення.
+    int lsbBits = 1;            ///< Кількість молодших бітів на піксель яскравості.
+    bool keyedOrder = false;    ///< Чи розміщуються дані в ключовому порядку пікселів.
+
+    // ========== Розміщення ==========
+    int firstFrame = 0;         ///< Перший кадр з даними (із заголовка навантаження).
+    int framesUsed = 0;         ///< Кількість кадрів з даними.
+
+    // ========== Метрики якості ==========
+    double psnr = 0.0;          ///< PSNR за сумарним MSE порівняних кадрів (дБ).
+    double minPsnr = 0.0;       ///< Найменший PSNR кадру (дБ).
+    double mse = 0.0;           ///< Середнє MSE порівняних кадрів.
+    double ssim = 0.0;          ///< Середній SSIM порівняних кадрів.
+    qint64 modifiedPixels = 0;  ///< Кількість змінених пікселів усіх кадрів.
+    double embeddingEfficiency = 0.0;  ///< Бітів навантаження на одну зміну пікселя.
+    QVector<VideoFrameQuality> frames;  ///< Метрики кожного порівняного кадру.
+
+    // ========== Інформація про повідомлення ==========
+    QString message;            ///< Приховане повідомлення.
+    bool hasMessage = false;    ///< Чи містить файл повідомлення.
+};
+
 /**
  * @class SteganographyEngine
  * @brief Основний клас для роботи зі стеганографією.
  *
  * Реалізує алгоритм LSB (Least Significant Bit) для приховування
  * текстової інформації в зображеннях.
+ *
+ * Движок зберігає стан поточної операції (прогрес, скасування), тому
+ * одночасні операції з різних потоків потребують окремих об'єктів.
  */
 class SteganographyEngine {
 public:
+    /**
+     * @brief Обробник прогресу: виконано done з total одиниць роботи (бітів).
+     *
+     * Викликається з потоків пулу, тому має бути потокобезпечним.
+     */
+    using ProgressHandler = std::function<void(qint64 done, qint64 total)>;
+
+    /// Повідомлення, що повертається коли дані не знайдено.
+    static inline const QString NOT_FOUND_MESSAGE = "Повідомлення не знайдено";
+
     // ========== Конструктор ==========
 
     /**
@@ -79,7 +312,8 @@ public:
      * @brief Приховування текстового повідомлення в зображенні.
      *
      * Використовує метод LSB для приховування тексту в молодших бітах
-     * RGB-каналів зображення.
+     * RGB-каналів зображення. Текст кодується в UTF-8 і пакується
+     * разом з двійковим заголовком (див. PayloadHeader).
      *
      * @param image Вхідне зображення (оригінал).
      * @param message Текстове повідомлення для приховування.
@@ -91,7 +325,9 @@ public:
     /**
      * @brief Витягування прихованого повідомлення з зображення.
      *
-     * Зчитує молодші біти пікселів та конвертує їх назад у текст.
+     * Зчитує заголовок навантаження та рівно задану в ньому кількість
+     * байтів. Для зображень старого формату (з текстовими маркерами)
+     * використовується пошук маркерів.
      *
      * @param image Зображення з прихованим повідомленням.
      * @param decrypt Чи потрібно розшифрувати повідомлення після витягування.
@@ -99,14 +335,291 @@ public:
      */
     QString extractMessage(const QImage& image, bool decrypt = false);
 
+    // ========== Потокова (поблокова) обробка файлів ==========
+
+    /**
+     * @brief Приховування повідомлення з обробкою файлу смугами.
+     *
+     * Для дуже великих зображень: зображення читається смугами рядків,
+     * навантаження записується в смуги, що його містять, а результат
+     * одразу дописується у вихідний PNG. Пікова пам'ять обмежена
+     * розміром смуги (TILE_BYTES) і не залежить від розміру зображення.
+     * Вхідний файл - PNG без інтерлейсу або базовий JPEG (ImageStripReader).
+     *
+     * @param inputPath Шлях до вхідного зображення.
+     * @param outputPath Шлях до вихідного PNG.
+     * @param message Текстове повідомлення для приховування.
+     * @param encrypt Чи потрібно шифрувати повідомлення.
+     * @return true у разі успіху.
+     */
+    bool hideMessageTiled(const QString& inputPath, const QString& outputPath,
+                          const QString& message, bool encrypt = false);
+
+    /**
+     * @brief Витягування повідомлення з обробкою файлу смугами.
+     *
+     * Зчитує лише смуги, що містять заголовок і дані навантаження,
+     * решта зображення не декодується.
+     *
+     * @param inputPath Шлях до зображення.
+     * @param decrypt Чи потрібно розшифрувати повідомлення.
+     * @return Витягнуте повідомлення або повідомлення про помилку.
+     */
+    QString extractMessageTiled(const QString& inputPath, bool decrypt = false);
+
+    // ========== Приховування файлів ==========
+
+    /**
+     * @brief Приховування довільного файлу в зображенні.
+     *
+     * Файл читається фрагментами і кожен фрагмент проходить стиснення
+     * (якщо увімкнене), шифрування (якщо потрібне) та одразу записується
+     * в пікселі, тож пам'ять не залежить від розміру файлу. Ім'я та розмір
+     * оригінального файлу зберігаються в розширенні заголовка.
+     *
+     * @param image Вхідне зображення (оригінал).
+     * @param inputPath Шлях до файлу для приховування.
+     * @param encrypt Чи потрібно шифрувати файл.
+     * @return Модифіковане зображення або пусте зображення у разі помилки.
+     */
+    QImage hideFile(const QImage& image, const QString& inputPath, bool encrypt = false);
+
+    /**
+     * @brief Витягування прихованого файлу в каталог.
+     *
+     * Дані зчитуються фрагментами та одразу записуються у файл з
+     * оригінальним ім'ям. Файл з'являється лише після успішної перевірки
+     * тегу, CRC-32 та розміру.
+     *
+     * @param image Зображення з прихованим файлом.
+     * @param outputDirectory Каталог для запису файлу.
+     * @param decrypt Чи потрібно розшифрувати файл.
+     * @return Шлях до записаного файлу або порожній рядок у разі помилки.
+     */
+    QString extractFile(const QImage& image, const QString& outputDirectory, bool decrypt = false);
+
+    /**
+     * @brief Ім'я та розмір прихованого файлу без витягування даних.
+     *
+     * @param image Зображення для перевірки.
+     * @param fileName Оригінальне ім'я файлу (вихідний параметр, необов'язковий).
+     * @param fileSize Оригінальний розмір файлу (вихідний параметр, необов'язковий).
+     * @return true якщо зображення містить прихований файл.
+     */
+    bool hiddenFileInfo(const QImage& image, QString* fileName = nullptr,
+                        qint64* fileSize = nullptr);
+
+    // ========== Кілька контейнерів ==========
+
+    /**
+     * @brief Розподіл повідомлення між кількома зображеннями.
+     *
+     * Навантаження ділиться на фрагменти однакового розміру (по одному
+     * на зображення), останні parityShards з них - парність Ріда-Соломона.
+     * Повідомлення відновлюється з будь-яких (кількість - parityShards)
+     * неушкоджених зображень. Зображення обробляються паралельно.
+     *
+     * @param images Зображення-контейнери (оригінали).
+     * @param message Текстове повідомлення для приховування.
+     * @param parityShards Кількість фрагментів парності (0 - без відновлення).
+     * @param encrypt Чи потрібно шифрувати повідомлення.
+     * @return Модифіковані зображення в тому ж порядку або порожній список у разі помилки.
+     */
+    QVector<QImage> hideMessageShards(const QVector<QImage>& images, const QString& message,
+                                      int parityShards = 0, bool encrypt = false);
+
+    /**
+     * @brief Відновлення повідомлення з набору зображень.
+     *
+     * Зображення можуть бути в будь-якому порядку; відсутні та пошкоджені
+     * (наприклад, перекодовані з втратами) фрагменти відновлюються
+     * з фрагментів парності.
+     *
+     * @param images Зображення набору.
+     * @param decrypt Чи потрібно розшифрувати повідомлення.
+     * @return Витягнуте повідомлення або повідомлення про помилку.
+     */
+    QString extractMessageShards(const QVector<QImage>& images, bool decrypt = false);
+
+    /**
+     * @brief Максимальна ємність набору зображень.
+     *
+     * @param sizes Розміри зображень набору.
+     * @param parityShards Кількість фрагментів парності.
+     * @param encrypt Чи буде повідомлення зашифроване.
+     * @return Максимальна кількість байтів UTF-8 (0 - набір непридатний).
+     */
+    qint64 calculateShardedCapacity(const QVector<QSize>& sizes, int parityShards,
+                                    bool encrypt = false);
+
+    // ========== JPEG (коефіцієнти DCT) ==========
+
+    /**
+     * @brief Приховування повідомлення в коефіцієнтах DCT файлу JPEG.
+     *
+     * Квантовані коефіцієнти зчитуються без декодування в пікселі,
+     * біти записуються в ненульові AC-коефіцієнти (F4: зменшення модуля,
+     * усадка ±1 до нуля), і коефіцієнти записуються назад без повторного
+     * квантування. На відміну від збереження результату hideMessage()
+     * у JPEG, повідомлення не руйнується.
+     *
+     * @param inputPath Шлях до вхідного JPEG.
+     * @param outputPath Шлях до вихідного JPEG.
+     * @param message Текстове повідомлення для приховування.
+     * @param encrypt Чи потрібно шифрувати повідомлення.
+     * @return true у разі успіху.
+     */
+    bool hideMessageJpeg(const QString& inputPath, const QString& outputPath,
+                         const QString& message, bool encrypt = false);
+
+    /**
+     * @brief Витягування повідомлення з коефіцієнтів DCT файлу JPEG.
+     *
+     * @param inputPath Шлях до JPEG.
+     * @param decrypt Чи потрібно розшифрувати повідомлення.
+     * @return Витягнуте повідомлення або повідомлення про помилку
+     *         (порожній рядок, якщо файл не вдалося прочитати).
+     */
+    QString extractMessageJpeg(const QString& inputPath, bool decrypt = false);
+
+    /**
+     * @brief Оцінка ємності файлу JPEG.
+     *
+     * Залежить від кількості ненульових AC-коефіцієнтів, тобто від
+     * вмісту зображення та якості стиснення, а не лише від розміру.
+     *
+     * @param inputPath Шлях до JPEG.
+     * @param encrypt Чи буде повідомлення зашифроване.
+     * @return Оцінка максимальної кількості байтів даних (-1, якщо файл не прочитано).
+     */
+    qint64 calculateJpegCapacity(const QString& inputPath, bool encrypt = false);
+
+    // ========== Аудіо WAV (PCM) ==========
+
+    /**
+     * @brief Приховування повідомлення в молодших бітах відліків файлу WAV.
+     *
+     * Відліки 16- або 24-бітного PCM відображаються в пам'ять (QFile::map)
+     * і змінюються на місці: пам'ять не залежить від розміру файлу.
+     * Якщо outputPath відрізняється від inputPath, спершу створюється
+     * копія файлу, інакше змінюється сам вхідний файл. Кількість бітів
+     * на відлік - bitsPerChannel(), ключовий порядок і шифрування - як для
+     * зображень; альфа-канал і матричне вбудовування не діють.
+     *
+     * @param inputPath Шлях до вхідного WAV.
+     * @param outputPath Шлях до вихідного WAV (може збігатися з вхідним).
+     * @param message Текстове повідомлення для приховування.
+     * @param encrypt Чи потрібно шифрувати повідомлення.
+     * @return true у разі успіху.
+     */
+    bool hideMessageWav(const QString& inputPath, const QString& outputPath,
+                        const QString& message, bool encrypt = false);
+
+    /**
+     * @brief Витягування повідомлення з молодших бітів відліків файлу WAV.
+     *
+     * @param inputPath Шлях до WAV.
+     * @param decrypt Чи потрібно розшифрувати повідомлення.
+     * @return Витягнуте повідомлення або повідомлення про помилку
+     *         (порожній рядок, якщо файл не вдалося прочитати).
+     */
+    QString extractMessageWav(const QString& inputPath, bool decrypt = false);
+
+    /**
+     * @brief Ємність файлу WAV у поточному режимі.
+     *
+     * @param inputPath Шлях до WAV.
+     * @param encrypt Чи буде повідомлення зашифроване.
+     * @return Максимальна кількість байтів даних (-1, якщо файл не прочитано).
+     */
+    qint64 calculateWavCapacity(const QString& inputPath, bool encrypt = false);
+
+    /**
+     * @brief Аналіз змін між оригінальним і модифікованим файлом WAV.
+     *
+     * Аналог analyzeChanges() для аудіо: SNR, PSNR, MSE, кількість
+     * змінених відліків і використання ємності. Відліки обох файлів
+     * читаються через відображення в пам'ять смугами (паралельно).
+     *
+     * @param originalPath Шлях до оригінального WAV.
+     * @param modifiedPath Шлях до модифікованого WAV.
+     * @param message Приховане повідомлення.
+     * @return Структура з результатами аналізу.
+     */
+    AudioAnalysisResult analyzeAudioChanges(const QString& originalPath,
+                                            const QString& modifiedPath,
+                                            const QString& message);
+
+    // ========== Відео YUV4MPEG2 ==========
+
+    /**
+     * @brief Приховування повідомлення в площині яскравості кадрів Y4M.
+     *
+     * Файл відображається в пам'ять (QFile::map) і змінюється на місці;
+     * якщо outputPath відрізняється від inputPath, спершу створюється
+     * копія. Заголовок завжди записується в кадр 0, дані - в найменшу
+     * кількість кадрів починаючи з firstFrame, порівну в кожен кадр;
+     * кадри обробляються паралельно. Діапазон кадрів зберігається в
+     * розширенні заголовка, тому витягування читає лише ці кадри.
+     * Кількість бітів на піксель - bitsPerChannel(), ключовий порядок
+     * і шифрування - як для зображень.
+     *
+     * @param inputPath Шлях до вхідного Y4M.
+     * @param outputPath Шлях до вихідного Y4M (може збігатися з вхідним).
+     * @param message Текстове повідомлення для приховування.
+     * @param encrypt Чи потрібно шифрувати повідомлення.
+     * @param firstFrame Перший кадр для даних.
+     * @return true у разі успіху.
+     */
+    bool hideMessageY4m(const QString& inputPath, const QString& outputPath,
+                        const QString& message, bool encrypt = false, int firstFrame = 0);
+
+    /**
+     * @brief Витягування повідомлення з площини яскравості кадрів Y4M.
+     *
+     * @param inputPath Шлях до Y4M.
+     * @param decrypt Чи потрібно розшифрувати повідомлення.
+     * @return Витягнуте повідомлення або повідомлення про помилку
+     *         (порожній рядок, якщо файл не вдалося прочитати).
+     */
+    QString extractMessageY4m(const QString& inputPath, bool decrypt = false);
+
+    /**
+     * @brief Ємність файлу Y4M у поточному режимі.
+     *
+     * @param inputPath Шлях до Y4M.
+     * @param encrypt Чи буде повідомлення зашифроване.
+     * @param firstFrame Перший кадр для даних.
+     * @return Максимальна кількість байтів даних (-1, якщо файл не прочитано).
+     */
+    qint64 calculateY4mCapacity(const QString& inputPath, bool encrypt = false, int firstFrame = 0);
+
+    /**
+     * @brief Аналіз змін між оригінальним і модифікованим відео Y4M.
+     *
+     * Порівнюються кадр 0 і кадри з даними (діапазон із заголовка
+     * модифікованого файлу; без заголовка - усі кадри). Метрики кадру -
+     * ті ж, що в analyzeChanges(), для площини яскравості.
+     *
+     * @param originalPath Шлях до оригінального Y4M.
+     * @param modifiedPath Шлях до модифікованого Y4M.
+     * @param message Приховане повідомлення.
+     * @return Структура з результатами аналізу.
+     */
+    VideoAnalysisResult analyzeVideoChanges(const QString& originalPath,
+                                            const QString& modifiedPath,
+                                            const QString& message);
+
     /**
      * @brief Аналіз змін між оригінальним і модифікованим зображенням.
      *
      * Обчислює різні метрики якості стеганографії:
      * - PSNR (Peak Signal-to-Noise Ratio).
      * - MSE (Mean Squared Error).
+     * - SSIM (Structural Similarity Index).
      * - Кількість змінених пікселів.
      * - Використання ємності.
+     * - Статистичний стегоаналіз обох зображень.
      *
      * @param original Оригінальне зображення.
      * @param modified Модифіковане зображення.
@@ -118,143 +631,1319 @@ public:
                                        const QString& message);
 
     /**
-     * @brief Обчислення максимальної ємності зображення.
+     * @brief Статистичний стегоаналіз зображення.
      *
-     * Визначає скільки символів можна приховати в даному зображенні
-     * з урахуванням маркерів початку/кінця.
+     * Виявляє довільне LSB-вбудовування (не лише власний формат)
+     * та оцінює частку використаних молодших бітів. Гістограми каналів,
+     * статистика RS-груп і пар пікселів збираються за один прохід.
      *
      * @param image Зображення для аналізу.
-     * @return Максимальна кількість символів, які можна приховати.
+     * @return Оцінки частки вбудовування трьома методами.
      */
-    int calculateMaxCapacity(const QImage& image);
+    SteganalysisResult analyzeStatistics(const QImage& image);
 
     /**
-     * @brief Встановлення користувацького ключа шифрування.
+     * @brief Обчислення максимальної ємності зображення.
      *
-     * Дозволяє встановити ключ вручну (наприклад, отриманий раніше).
+     * Визначає скільки байтів UTF-8 можна приховати в даному зображенні
+     * з урахуванням заголовка навантаження та поточної кількості
+     * бітів на канал (setBitsPerChannel).
      *
-     * @param key Ключ шифрування (hex рядок).
+     * @param image Зображення для аналізу.
+     * @param encrypt Чи буде повідомлення зашифроване (nonce і тег займають місце).
+     * @return Максимальна кількість байтів, які можна приховати.
      */
-    void setKey(const QString& key);
+    qint64 calculateMaxCapacity(const QImage& image, bool encrypt = false);
 
     /**
-     * @brief Перевірка наявності прихованого повідомлення.
+     * @brief Обчислення максимальної ємності за розміром зображення.
      *
-     * @param image Зображення для перевірки.
-     * @return true якщо зображення містить приховане повідомлення.
+     * Ємність залежить лише від кількості пікселів, тому її можна
+     * обчислити за розміром із заголовка файлу, не декодуючи піксели.
+     *
+     * @param size Розмір зображення.
+     * @param encrypt Чи буде повідомлення зашифроване.
+     * @return Максимальна кількість байтів, які можна приховати.
      */
-    bool hasHiddenMessage(const QImage& image);
+    qint64 calculateMaxCapacity(const QSize& size, bool encrypt = false);
 
-    // ========== Допоміжні методи ==========
+    /**
+     * @brief Ефективна ємність з урахуванням стиснення.
+     *
+     * Сира ємність (calculateMaxCapacity), помножена на коефіцієнт
+     * стиснення зразка тексту. Без стиснення дорівнює сирій ємності.
+     *
+     * @param image Зображення для аналізу.
+     * @param sample Зразок тексту (наприклад, повідомлення).
+     * @param encrypt Чи буде повідомлення зашифроване.
+     * @return Орієнтовна кількість байтів UTF-8, які можна приховати.
+     */
+    qint64 calculateEffectiveCapacity(const QImage& image, const QString& sample,
+                                      bool encrypt = false);
 
     /**
-     * @brief Конвертація тексту в двійковий формат.
+     * @brief Розмір повідомлення в зображенні (після стиснення, якщо воно увімкнене).
      *
-     * Перетворює кожен символ Unicode у 16-бітну двійкову послідовність.
+     * Саме це значення порівнюється з calculateMaxCapacity().
      *
-     * @param text Текст для конвертації.
-     * @return Двійкове представлення (рядок з '0' та '1').
+     * @param message Повідомлення.
+     * @return Кількість байтів даних.
      */
-    QString textToBinary(const QString& text);
+    qint64 storedMessageSize(const QString& message) const;
 
     /**
-     * @brief Конвертація двійкового формату в текст.
+     * @brief Увімкнення стиснення повідомлення перед вбудовуванням.
      *
-     * Перетворює послідовність бітів назад у текст.
+     * Дані стискаються deflate (qCompress); кодек записується в заголовок,
+     * тому при витягуванні режим визначається автоматично. Якщо стиснення
+     * не зменшує дані, вони записуються без нього.
      *
-     * @param binary Двійкове представлення.
-     * @return Відновлений текст.
+     * @param enabled true - стискати повідомлення.
      */
-    QString binaryToText(const QString& binary);
+    void setCompressionEnabled(bool enabled);
 
     /**
-     * @brief XOR-шифрування/дешифрування.
+     * @brief Чи увімкнено стиснення повідомлення.
+     * @return true якщо повідомлення стискаються.
+     */
+    bool isCompressionEnabled() const;
+
+    /**
+     * @brief Встановлення користувацького ключа шифрування.
      *
-     * Простий симетричний шифр для базового захисту даних.
+     * Дозволяє встановити ключ вручну (наприклад, отриманий раніше).
      *
-     * @param text Текст для шифрування/дешифрування.
-     * @param key Ключ шифрування.
-     * @return Шифрований/дешифрований текст.
+     * @param key Ключ шифрування (hex рядок).
      */
-    QString xorCipher(const QString& text, const QString& key);
+    void setKey(const QString& key);
 
     /**
-     * @brief Генерація ключа шифрування з персональних даних.
+     * @brief Увімкнення паралельного режиму обробки.
      *
-     * Використовує SHA-256 для створення унікального ключа
-     * на основі особистої інформації користувача.
+     * Зображення розбивається на горизонтальні смуги, які обробляються
+     * пулом потоків. Результат ідентичний послідовному режиму.
      *
-     * @param firstName Ім'я.
-     * @param lastName Прізвище.
-     * @param birthDate Дата народження (формат: ddMMyyyy).
-     * @param phone Номер телефону.
-     * @return Згенерований ключ (16 символів hex).
+     * @param enabled Чи використовувати пул потоків.
+     * @param threads Кількість потоків (0 - за кількістю ядер процесора).
      */
-    QString generateKey(const QString& firstName,
-                        const QString& lastName,
-                        const QString& birthDate,
-                        const QString& phone);
+    void setParallelMode(bool enabled, int threads = 0);
 
-private:
-    // ========== Приватні методи ==========
+    /**
+     * @brief Чи увімкнено паралельний режим.
+     * @return true якщо обробка виконується пулом потоків.
+     */
+    bool isParallelMode() const;
 
     /**
-     * @brief Встановлення молодшого біту в значенні піксела.
+     * @brief Кількість потоків обробки.
+     * @return 1 у послідовному режимі, інакше розмір пулу.
+     */
+    int threadCount() const;
+
+    /**
+     * @brief Встановлення обробника прогресу для hideMessage() та extractMessage().
      *
-     * Замінює останній біт значення кольору на потрібний біт.
+     * Прогрес - кількість оброблених бітів навантаження (для матричного
+     * вбудовування також бітів контейнера та блоків) із загальної кількості.
+     * Обробник викликається після кожної смуги, тому навіть у
+     * послідовному режимі робота ділиться на PROGRESS_STEPS частин.
      *
-     * @param pixel Значення кольору (0-255).
-     * @param bit Біт для встановлення (0 або 1).
-     * @return Модифіковане значення кольору.
+     * @param handler Обробник (порожній - без звітів).
      */
-    int setBit(int pixel, int bit);
+    void setProgressHandler(const ProgressHandler& handler);
 
     /**
-     * @brief Отримання молодшого біту з значення піксела.
-     *
-     * Витягує останній біт значення кольору.
+     * @brief Запит на скасування поточної (або наступної) операції.
      *
-     * @param pixel Значення кольору (0-255).
-     * @return Молодший біт (0 або 1).
+     * Потокобезпечний. Смуги, що ще не почались, пропускаються, і
+     * hideMessage() повертає пусте зображення, а extractMessage() -
+     * NOT_FOUND_MESSAGE. Після завершення операції запит скидається.
      */
-    int getBit(int pixel);
+    void cancel();
 
     /**
-     * @brief Обчислення PSNR між двома зображеннями.
+     * @brief Чи надійшов запит на скасування.
+     * @return true якщо операцію скасовано.
+     */
+    bool isCancelled() const;
+
+    /**
+     * @brief Налаштування кількості молодших бітів на канал.
      *
-     * PSNR (Peak Signal-to-Noise Ratio) - метрика якості зображення.
-     * Чим вище значення, тим менша різниця між зображеннями.
+     * При bits > 1 або useAlpha дані записуються у k молодших бітів
+     * кожного каналу (R, G, B та опціонально A): 3k або 4k бітів на піксель.
+     * Ємність зростає в k (або 4k/3) разів, але зміни помітніші.
+     * Заголовок завжди записується в 1 біт на канал RGB, тому режим
+     * визначається при витягуванні автоматично.
      *
-     * @param original Оригінальне зображення.
-     * @param modified Модифіковане зображення.
-     * @return Значення PSNR в децибелах (дБ).
+     * @param bits Кількість бітів на канал (1-4).
+     * @param useAlpha Чи використовувати альфа-канал.
+     */
+    void setBitsPerChannel(int bits, bool useAlpha = false);
+
+    /**
+     * @brief Кількість молодших бітів на канал.
+     * @return Значення від 1 до 4.
      */
-    double calculatePSNR(const QImage& original, const QImage& modified);
+    int bitsPerChannel() const;
 
     /**
-     * @brief Обчислення MSE між двома зображеннями.
+     * @brief Чи використовується альфа-канал.
+     * @return true якщо дані записуються і в канал A.
+     */
+    bool usesAlpha() const;
+
+    /**
+     * @brief Увімкнення ключового порядку пікселів.
      *
-     * MSE (Mean Squared Error) - середньоквадратична помилка.
-     * Чим менше значення, тим менша різниця між зображеннями.
+     * Дані (після заголовка) розміщуються не підряд, а в пікселях
+     * π_K(0), π_K(1), ..., де π_K - бієкція на множині пікселів даних,
+     * що визначається поточним ключем (setKey/generateKey). Без ключа
+     * неможливо дізнатися, які пікселі несуть дані, а зміни розподіляються
+     * по всьому зображенню рівномірно. Заголовок лишається на своєму місці,
+     * тому режим визначається при витягуванні автоматично.
      *
-     * @param original Оригінальне зображення.
-     * @param modified Модифіковане зображення.
-     * @return Значення MSE.
+     * @param enabled true - ключовий порядок, false - послідовний.
      */
-    double calculateMSE(const QImage& original, const QImage& modified);
+    void setKeyedOrdering(bool enabled);
 
-    // ========== Константи ==========
+    /**
+     * @brief Чи увімкнено ключовий порядок пікселів.
+     * @return true якщо дані розміщуються в ключовому порядку.
+     */
+    bool isKeyedOrdering() const;
 
-    /// Маркер початку повідомлення (для визначення початку даних).
+    /**
+     * @brief Увімкнення матричного вбудовування (коди Геммінга).
+     *
+     * Молодші біти каналів пікселів даних діляться на блоки з n = 2^p - 1
+     * бітів; кожен блок несе p бітів даних як синдром коду Геммінга і
+     * змінюється не більше ніж в одному біті. p обирається найбільшим,
+     * за якого дані вміщуються, тому при малому навантаженні змін значно
+     * менше, ніж при звичайному LSB (у середньому p / (1 - 2^-p) бітів
+     * на зміну замість 2). Використовується лише 1 біт на канал;
+     * альфа-канал і ключовий порядок пікселів підтримуються.
+     *
+     * @param enabled true - матричне вбудовування.
+     */
+    void setMatrixEmbedding(bool enabled);
+
+    /**
+     * @brief Чи увімкнено матричне вбудовування.
+     * @return true якщо дані вбудовуються кодами Геммінга.
+     */
+    bool isMatrixEmbedding() const;
+
+    /**
+     * @brief Увімкнення коду Ріда-Соломона для повідомлень у зображеннях.
+     *
+     * Навантаження кодується словами RS(n, n - 2t) над GF(256) з
+     * чергуванням байтів: кожне слово виправляє до t пошкоджених байтів,
+     * а пакет помилок розподіляється між словами. Заголовок також
+     * захищений, тому extractMessage() знаходить навантаження навіть
+     * з пошкодженими бітами заголовка. Режим визначається при витягуванні
+     * автоматично; з матричним вбудовуванням не поєднується.
+     *
+     * @param paritySymbols Символів парності на слово 2t (0 - вимкнено, до 64;
+     *                      непарне значення округлюється вгору).
+     */
+    void setErrorCorrection(int paritySymbols);
+
+    /**
+     * @brief Кількість символів парності коду Ріда-Соломона.
+     * @return 2t або 0, якщо код вимкнено.
+     */
+    int errorCorrection() const;
+
+    /**
+     * @brief Перевірка наявності прихованого повідомлення.
+     *
+     * Зчитує лише заголовок (див. probeMessage()), тому знаходить
+     * і зашифровані повідомлення.
+     *
+     * @param image Зображення для перевірки.
+     * @return true якщо зображення містить приховане повідомлення.
+     */
+    bool hasHiddenMessage(const QImage& image);
+
+    /**
+     * @brief Швидка перевірка заголовка навантаження.
+     *
+     * Зчитує молодші біти лише перших PROBE_PIXELS пікселів: заголовок
+     * (сигнатура, версія, прапорці, довжина) або маркер початку старого
+     * формату. Дані та CRC не перевіряються, тому час не залежить від
+     * розміру зображення і повідомлення.
+     *
+     * @param image Зображення для перевірки.
+     * @return Наявність і тип навантаження.
+     */
+    ProbeResult probeMessage(const QImage& image);
+
+    /**
+     * @brief Швидка перевірка заголовка навантаження у файлі.
+     *
+     * Декодує лише перші рядки, що містять PROBE_PIXELS пікселів:
+     * PNG та базовий JPEG - потоковими декодерами ImageStripReader,
+     * інші формати - через QImageReader з обмежувальним прямокутником
+     * (якщо обробник формату його не підтримує, Qt декодує все зображення).
+     *
+     * @param path Шлях до файлу зображення.
+     * @param ok Якщо задано - false, коли файл не вдалося прочитати.
+     * @return Наявність і тип навантаження (None, якщо файл не читається).
+     */
+    ProbeResult probeFile(const QString& path, bool* ok = nullptr);
+
+    // ========== Допоміжні методи ==========
+
+    /**
+     * @brief Конвертація тексту в двійковий формат.
+     *
+     * Перетворює кожен символ Unicode у 16-бітну двійкову послідовність.
+     * Використовується лише старим форматом з текстовими маркерами.
+     *
+     * @param text Текст для конвертації.
+     * @return Двійкове представлення (рядок з '0' та '1').
+     */
+    QString textToBinary(const QString& text);
+
+    /**
+     * @brief Конвертація двійкового формату в текст.
+     *
+     * Перетворює послідовність бітів назад у текст.
+     *
+     * @param binary Двійкове представлення.
+     * @return Відновлений текст.
+     */
+    QString binaryToText(const QString& binary);
+
+    /**
+     * @brief XOR-шифрування/дешифрування.
+     *
+     * Простий симетричний шифр для базового захисту даних.
+     *
+     * @param text Текст для шифрування/дешифрування.
+     * @param key Ключ шифрування.
+     * @return Шифрований/дешифрований текст.
+     */
+    QString xorCipher(const QString& text, const QString& key);
+
+    /**
+     * @brief Генерація ключа шифрування з персональних даних.
+     *
+     * Використовує SHA-256 для створення унікального ключа
+     * на основі особистої інформації користувача. Ключ шифру з нього
+     * виводиться scrypt із сіллю навантаження (див. derivedKey()), тож
+     * перебір персональних даних коштує стільки ж, скільки виведення.
+     *
+     * @param firstName Ім'я.
+     * @param lastName Прізвище.
+     * @param birthDate Дата народження (формат: ddMMyyyy).
+     * @param phone Номер телефону.
+     * @return Згенерований ключ (16 символів hex).
+     */
+    QString generateKey(const QString& firstName,
+                        const QString& lastName,
+                        const QString& birthDate,
+                        const QString& phone);
+
+private:
+    // ========== Допоміжні структури ==========
+
+    /// Потік символів з пошуком маркера (для старого формату).
+    struct MarkerStream;
+
+    /**
+     * @struct ShardRecord
+     * @brief Запис фрагмента в розширенні заголовка "STES".
+     */
+    struct ShardRecord {
+        quint32 setId = 0;         ///< Випадковий ідентифікатор набору зображень.
+        int index = 0;             ///< Номер фрагмента (0..k+m-1).
+        int dataShards = 0;        ///< Кількість фрагментів даних k.
+        int parityShards = 0;      ///< Кількість фрагментів парності m.
+        quint32 payloadSize = 0;   ///< Розмір навантаження без доповнення.
+    };
+
+    /**
+     * @struct VideoRecord
+     * @brief Діапазон кадрів з даними в розширенні заголовка відео.
+     */
+    struct VideoRecord {
+        int firstFrame = 0;        ///< Перший кадр з даними.
+        int frameCount = 0;        ///< Кількість кадрів з даними.
+        quint32 frameBytes = 0;    ///< Байтів даних у кожному кадрі (в останньому - решта).
+    };
+
+    // ========== Приватні методи ==========
+
+    /**
+     * @brief Встановлення молодшого біту в значенні піксела.
+     *
+     * Замінює останній біт значення кольору на потрібний біт.
+     *
+     * @param pixel Значення кольору (0-255).
+     * @param bit Біт для встановлення (0 або 1).
+     * @return Модифіковане значення кольору.
+     */
+    int setBit(int pixel, int bit);
+
+    /**
+     * @brief Отримання молодшого біту з значення піксела.
+     *
+     * Витягує останній біт значення кольору.
+     *
+     * @param pixel Значення кольору (0-255).
+     * @return Молодший біт (0 або 1).
+     */
+    int getBit(int pixel);
+
+    /**
+     * @brief Запис байтів у молодші біти RGB-каналів.
+     *
+     * Біти записуються послідовно (старший біт байта першим) у канали
+     * R, G, B кожного піксела, рядок за рядком.
+     *
+     * @param image Зображення у форматі RGB32 (модифікується).
+     * @param data Байти для запису.
+     */
+    void embedBytes(QImage& image, const QByteArray& data);
+
+    /**
+     * @brief Зчитування байтів з молодших бітів RGB-каналів.
+     *
+     * @param image Зображення у форматі RGB32.
+     * @param byteOffset Зміщення першого байта від початку даних.
+     * @param byteCount Кількість байтів для зчитування.
+     * @return Зчитані байти.
+     */
+    QByteArray extractBytes(const QImage& image, qint64 byteOffset, qint64 byteCount);
+
+    // ========== Вбудовування в кілька бітових площин ==========
+
+    /**
+     * @brief Запис даних у k молодших бітів каналів, починаючи з піксела.
+     *
+     * @param image Зображення RGB32 або ARGB32 (модифікується).
+     * @param firstPixel Номер першого піксела даних.
+     * @param data Байти для запису.
+     * @param bits Кількість бітів на канал.
+     * @param channels Кількість каналів (3 - RGB, 4 - RGBA).
+     * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+     */
+    void embedPlanes(QImage& image, qint64 firstPixel, const QByteArray& data,
+                     int bits, int channels, const KeyedPermutation* order = nullptr);
+
+    /**
+     * @brief Зчитування даних з k молодших бітів каналів.
+     *
+     * @param image Зображення RGB32 або ARGB32.
+     * @param firstPixel Номер першого піксела даних.
+     * @param byteCount Кількість байтів.
+     * @param bits Кількість бітів на канал.
+     * @param channels Кількість каналів (3 - RGB, 4 - RGBA).
+     * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+     * @return Зчитані байти.
+     */
+    QByteArray extractPlanes(const QImage& image, qint64 firstPixel, qint64 byteCount,
+                             int bits, int channels, const KeyedPermutation* order = nullptr);
+
+    /**
+     * @brief Запис діапазону бітів у бітові площини (ядро смуги).
+     *
+     * Біт даних i потрапляє в піксель pixelOffset + j, де j = i / (bits × channels),
+     * або pixelOffset + π(j) з ключовою перестановкою. Біти піксела збираються в одне бітове поле і розкладаються по
+     * каналах масками та зсувами (без циклу по окремих бітах).
+     *
+     * @param pixels Початок даних зображення (або смуги).
+     * @param bytesPerLine Довжина рядка в байтах.
+     * @param width Ширина зображення.
+     * @param pixelOffset Номер першого піксела даних відносно pixels.
+     * @param bytes Байти даних.
+     * @param bitBegin Перший біт діапазону (кратний bits × channels).
+     * @param bitEnd Біт після останнього.
+     * @param bits Кількість бітів на канал.
+     * @param channels Кількість каналів.
+     * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+     * @param byteOffset Номер байта даних, з якого починається буфер bytes
+     *                   (для запису даних фрагментами).
+     */
+    void embedPlaneRange(uchar* pixels, qsizetype bytesPerLine, int width,
+                         qint64 pixelOffset, const uchar* bytes,
+                         qint64 bitBegin, qint64 bitEnd, int bits, int channels,
+                         const KeyedPermutation* order = nullptr, qint64 byteOffset = 0);
+
+    /**
+     * @brief Зчитування діапазону бітів з бітових площин (ядро смуги).
+     *
+     * @param pixels Початок даних зображення (або смуги).
+     * @param bytesPerLine Довжина рядка в байтах.
+     * @param width Ширина зображення.
+     * @param pixelOffset Номер першого піксела даних відносно pixels.
+     * @param bytes Вихідні байти (заповнені нулями).
+     * @param bitBegin Перший біт діапазону (кратний bits × channels).
+     * @param bitEnd Біт після останнього.
+     * @param bits Кількість бітів на канал.
+     * @param channels Кількість каналів.
+     * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+     * @param byteOffset Номер байта даних, з якого починається буфер bytes
+     *                   (для зчитування даних фрагментами).
+     */
+    void extractPlaneRange(const uchar* pixels, qsizetype bytesPerLine, int width,
+                           qint64 pixelOffset, uchar* bytes,
+                           qint64 bitBegin, qint64 bitEnd, int bits, int channels,
+                           const KeyedPermutation* order = nullptr, qint64 byteOffset = 0);
+
+    /**
+     * @brief Номер першого піксела даних у багатобітовому режимі.
+     *
+     * Заголовок та розширення займають перші пікселі (1 біт на канал RGB).
+     *
+     * @param header Заголовок навантаження.
+     * @return Номер піксела.
+     */
+    qint64 dataStartPixel(const PayloadHeader& header) const;
+
+    // ========== Матричне вбудовування ==========
+
+    /**
+     * @brief Чи записані дані кодом Геммінга.
+     *
+     * Параметр коду - останній байт розширення заголовка (після nonce і
+     * тегу шифру), тому його наявність визначається розміром розширення.
+     *
+     * @param header Заголовок навантаження.
+     * @return true для матричного вбудовування.
+     */
+    bool matrixLayout(const PayloadHeader& header) const;
+
+    /**
+     * @brief Параметр p коду Геммінга з розширення заголовка.
+     *
+     * @param header Заголовок навантаження.
+     * @param extension Розширення заголовка.
+     * @return p (1..MAX_HAMMING_P) або 0, якщо значення неправильне.
+     */
+    int storedHammingParameter(const PayloadHeader& header, const QByteArray& extension) const;
+
+    /**
+     * @brief Вибір найбільшого p, за якого дані вміщуються в контейнер.
+     *
+     * @param dataBytes Розмір даних у байтах.
+     * @param coverBits Кількість доступних молодших бітів (кратна 8).
+     * @return p (1..MAX_HAMMING_P) або 0, якщо дані не вміщуються.
+     */
+    static int chooseHammingParameter(qint64 dataBytes, qint64 coverBits);
+
+    /**
+     * @brief Кількість блоків коду Геммінга для даних.
+     * @param dataBytes Розмір даних у байтах.
+     * @param p Параметр коду Геммінга.
+     * @return Кількість блоків.
+     */
+    static qint64 hammingBlocks(qint64 dataBytes, int p);
+
+    /**
+     * @brief Кількість бітів контейнера для даних (кратна 8).
+     * @param dataBytes Розмір даних у байтах.
+     * @param p Параметр коду Геммінга.
+     * @return Кількість бітів.
+     */
+    static qint64 hammingCoverBits(qint64 dataBytes, int p);
+
+    /**
+     * @brief Матричне вбудовування даних у молодші біти каналів.
+     *
+     * Молодші біти пікселів даних зчитуються як контейнер (extractPlanes),
+     * у кожному блоці змінюється не більше одного біта, і контейнер
+     * записується назад (embedPlanes).
+     *
+     * @param image Зображення RGB32 або ARGB32 (модифікується).
+     * @param firstPixel Номер першого піксела даних.
+     * @param data Байти для запису.
+     * @param p Параметр коду Геммінга.
+     * @param channels Кількість каналів (3 - RGB, 4 - RGBA).
+     * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+     */
+    void embedMatrix(QImage& image, qint64 firstPixel, const QByteArray& data,
+                     int p, int channels, const KeyedPermutation* order = nullptr);
+
+    /**
+     * @brief Зчитування даних, записаних кодом Геммінга.
+     *
+     * @param image Зображення RGB32 або ARGB32.
+     * @param firstPixel Номер першого піксела даних.
+     * @param byteCount Кількість байтів.
+     * @param p Параметр коду Геммінга.
+     * @param channels Кількість каналів (3 - RGB, 4 - RGBA).
+     * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+     * @return Зчитані байти.
+     */
+    QByteArray extractMatrix(const QImage& image, qint64 firstPixel, qint64 byteCount,
+                             int p, int channels, const KeyedPermutation* order = nullptr);
+
+    /**
+     * @brief Синдром блока коду Геммінга.
+     *
+     * Синдром - XOR номерів (1..n) одиничних бітів блока. Біти обробляються
+     * по 8 через таблицю: для байта з позиціями 8m..8m+7 внесок дорівнює
+     * XOR молодших трьох бітів позицій (з таблиці) та 8m, якщо одиниць
+     * непарна кількість.
+     *
+     * @param cover Біти контейнера (старший біт байта - перший).
+     * @param start Номер першого біта блока.
+     * @param n Довжина блока (2^p - 1).
+     * @return Синдром (p бітів).
+     */
+    static quint32 hammingSyndrome(const uchar* cover, qint64 start, int n);
+
+    /**
+     * @brief Вбудовування діапазону блоків (ядро смуги).
+     *
+     * @param cover Біти контейнера (модифікуються).
+     * @param message Біти даних.
+     * @param messageBits Кількість бітів даних.
+     * @param blockBegin Перший блок (кратний 8, тож межі смуг припадають на цілі байти).
+     * @param blockEnd Блок після останнього.
+     * @param p Параметр коду Геммінга.
+     */
+    static void embedHammingRange(uchar* cover, const uchar* message, qint64 messageBits,
+                                  qint64 blockBegin, qint64 blockEnd, int p);
+
+    /**
+     * @brief Зчитування діапазону блоків (ядро смуги).
+     *
+     * @param cover Біти контейнера.
+     * @param message Вихідні біти даних (заповнені нулями, із запасом до цілого блока).
+     * @param blockBegin Перший блок (кратний 8).
+     * @param blockEnd Блок після останнього.
+     * @param p Параметр коду Геммінга.
+     */
+    static void extractHammingRange(const uchar* cover, uchar* message,
+                                    qint64 blockBegin, qint64 blockEnd, int p);
+
+    /**
+     * @brief Розбір режиму розміщення даних з прапорців заголовка.
+     *
+     * @param header Заголовок навантаження.
+     * @param bits Кількість бітів на канал (вихідний параметр).
+     * @param channels Кількість каналів: 3 або 4 (вихідний параметр).
+     * @return true якщо дані записані по пікселях (embedPlanes),
+     *         false - суцільним потоком бітів (embedBytes).
+     */
+    bool planeLayout(const PayloadHeader& header, int& bits, int& channels) const;
+
+    /**
+     * @brief Ємність для даних (без заголовка) в заданому режимі.
+     *
+     * @param layout Заголовок з прапорцями режиму та розміром розширення.
+     * @param pixels Кількість пікселів зображення.
+     * @return Кількість байтів (може бути від'ємною, якщо не вміщується заголовок).
+     */
+    qint64 dataCapacity(const PayloadHeader& layout, qint64 pixels) const;
+
+    /**
+     * @brief Заголовок без довжини та CRC для поточних налаштувань.
+     *
+     * Містить прапорці режиму (біти на канал, альфа-канал, ключовий
+     * порядок, шифрування) та розмір розширення.
+     *
+     * @param encrypt Чи буде навантаження зашифроване.
+     * @return Заголовок.
+     */
+    PayloadHeader layoutHeader(bool encrypt) const;
+
+    /**
+     * @brief Стиснення даних навантаження (якщо увімкнене і вигідне).
+     *
+     * @param data Дані (замінюються стиснутими).
+     * @return Кодек, яким стиснуто дані (CODEC_NONE - без змін).
+     */
+    int compressData(QByteArray& data) const;
+
+    /**
+     * @brief Розпакування даних навантаження.
+     *
+     * @param data Стиснуті дані (замінюються розпакованими).
+     * @param codec Кодек із заголовка.
+     * @return true у разі успіху.
+     */
+    bool decompressData(QByteArray& data, int codec) const;
+
+    /**
+     * @brief Запис діапазону бітів навантаження в пікселі (ядро смуги).
+     *
+     * @param pixels Початок даних зображення (або смуги) RGB32.
+     * @param bytesPerLine Довжина рядка в байтах.
+     * @param width Ширина зображення.
+     * @param carrierOffset Зміщення навантаження в бітах носія.
+     * @param bytes Байти навантаження.
+     * @param bitBegin Перший біт діапазону.
+     * @param bitEnd Біт після останнього.
+     */
+    void embedBitRange(uchar* pixels, qsizetype bytesPerLine, int width,
+                       qint64 carrierOffset, const uchar* bytes,
+                       qint64 bitBegin, qint64 bitEnd);
+
+    /**
+     * @brief Зчитування діапазону бітів навантаження з пікселів (ядро смуги).
+     *
+     * @param pixels Початок даних зображення RGB32.
+     * @param bytesPerLine Довжина рядка в байтах.
+     * @param width Ширина зображення.
+     * @param carrierOffset Зміщення навантаження в бітах носія.
+     * @param bytes Вихідні байти (заповнені нулями).
+     * @param bitBegin Перший біт діапазону.
+     * @param bitEnd Біт після останнього.
+     */
+    void extractBitRange(const uchar* pixels, qsizetype bytesPerLine, int width,
+                         qint64 carrierOffset, uchar* bytes,
+                         qint64 bitBegin, qint64 bitEnd);
+
+    /**
+     * @brief Розбиття діапазону (бітів або рядків) на смуги та їх обробка.
+     *
+     * У паралельному режимі смуги виконуються пулом потоків,
+     * інакше весь діапазон обробляється в поточному потоці.
+     *
+     * @param total Розмір діапазону.
+     * @param alignment Кратність меж смуг.
+     * @param minParallel Мінімальний розмір для паралельної обробки.
+     * @param kernel Обробник смуги [begin, end).
+     */
+    void runBands(qint64 total, qint64 alignment, qint64 minParallel,
+                  const std::function<void(qint64, qint64)>& kernel);
+
+    /**
+     * @brief Початок відстеження прогресу операції.
+     *
+     * Поки прогрес відстежується, кожна смуга runBands() додає свій
+     * розмір до виконаної роботи і перевіряє запит на скасування.
+     *
+     * @param total Загальна кількість одиниць роботи.
+     */
+    void beginProgress(qint64 total);
+
+    /**
+     * @brief Завершення відстеження прогресу та скидання запиту на скасування.
+     */
+    void endProgress();
+
+    /**
+     * @brief Додавання виконаної роботи та виклик обробника прогресу.
+     * @param units Кількість одиниць роботи.
+     */
+    void advanceProgress(qint64 units);
+
+    /**
+     * @brief Формування навантаження: заголовок + (зашифровані) дані UTF-8.
+     *
+     * @param message Повідомлення.
+     * @param encrypt Чи потрібно шифрувати.
+     * @return Серіалізований заголовок і дані.
+     */
+    QByteArray buildPayload(const QString& message, bool encrypt);
+
+    /**
+     * @brief Формування навантаження із заданим заголовком режиму.
+     *
+     * @param message Повідомлення.
+     * @param header Заголовок без довжини та CRC (див. layoutHeader(), jpegHeader()).
+     * @return Серіалізований заголовок і дані.
+     */
+    QByteArray buildPayload(const QString& message, PayloadHeader header);
+
+    /**
+     * @brief Дешифрування, перевірка CRC-32 та декодування даних.
+     *
+     * @param header Заголовок навантаження.
+     * @param extension Розширення заголовка.
+     * @param data Зчитані дані.
+     * @param decrypt Чи дозволено дешифрування.
+     * @return Повідомлення або NOT_FOUND_MESSAGE.
+     */
+    QString decodePayload(const PayloadHeader& header, const QByteArray& extension,
+                          QByteArray data, bool decrypt);
+
+    /**
+     * @brief Зчитування та перевірка заголовка прихованого файлу.
+     *
+     * @param image Зображення RGB32 або ARGB32.
+     * @param header Заголовок навантаження (вихідний параметр).
+     * @param extension Розширення заголовка (вихідний параметр).
+     * @param fileName Оригінальне ім'я файлу (вихідний параметр).
+     * @param fileSize Оригінальний розмір файлу (вихідний параметр).
+     * @return true якщо заголовок файлу коректний і дані вміщуються в зображення.
+     */
+    bool readFileHeader(const QImage& image, PayloadHeader& header, QByteArray& extension,
+                        QString& fileName, qint64& fileSize);
+
+    /**
+     * @brief Запис фрагмента даних файлу в пікселі.
+     *
+     * @param image Зображення RGB32 або ARGB32 (модифікується).
+     * @param header Заголовок навантаження (режим розміщення).
+     * @param chunk Байти фрагмента.
+     * @param offset Номер першого байта фрагмента в даних.
+     * @param size Розмір фрагмента.
+     * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+     */
+    void embedFileChunk(QImage& image, const PayloadHeader& header, const uchar* chunk,
+                        qint64 offset, qint64 size, const KeyedPermutation* order);
+
+    /**
+     * @brief Зчитування фрагмента даних файлу з пікселів.
+     *
+     * @param image Зображення RGB32 або ARGB32.
+     * @param header Заголовок навантаження (режим розміщення).
+     * @param chunk Вихідні байти (заповнені нулями).
+     * @param offset Номер першого байта фрагмента в даних.
+     * @param size Розмір фрагмента.
+     * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+     */
+    void extractFileChunk(const QImage& image, const PayloadHeader& header, uchar* chunk,
+                          qint64 offset, qint64 size, const KeyedPermutation* order);
+
+    /**
+     * @brief Заголовок фрагмента без довжини та CRC для поточних налаштувань.
+     *
+     * @param encrypt Чи буде навантаження зашифроване.
+     * @return Заголовок.
+     */
+    PayloadHeader shardHeader(bool encrypt) const;
+
+    /**
+     * @brief Зчитування та перевірка заголовка фрагмента.
+     *
+     * @param image Зображення RGB32 або ARGB32.
+     * @param header Заголовок фрагмента (вихідний параметр).
+     * @param record Запис фрагмента (вихідний параметр).
+     * @return true якщо заголовок коректний і фрагмент вміщується в зображення.
+     */
+    bool readShardHeader(const QImage& image, PayloadHeader& header, ShardRecord& record);
+
+    /**
+     * @brief Заголовок навантаження JPEG без довжини та CRC.
+     *
+     * @param encrypt Чи буде навантаження зашифроване.
+     * @return Заголовок.
+     */
+    PayloadHeader jpegHeader(bool encrypt) const;
+
+    /**
+     * @brief Очікувана кількість байтів, що вміщується в коефіцієнти DCT.
+     *
+     * @param coefficients Коефіцієнти всіх блоків (по 64).
+     * @param blocks Кількість блоків.
+     * @return Кількість байтів (включно із заголовком).
+     */
+    qint64 jpegCapacity(const qint16* coefficients, qint64 blocks) const;
+
+    /**
+     * @brief Заголовок навантаження WAV без довжини та CRC.
+     *
+     * @param encrypt Чи буде навантаження зашифроване.
+     * @return Заголовок.
+     */
+    PayloadHeader audioHeader(bool encrypt) const;
+
+    /**
+     * @brief Ємність відліків для даних (без заголовка).
+     *
+     * @param layout Заголовок з прапорцями режиму та розміром розширення.
+     * @param samples Кількість відліків.
+     * @return Кількість байтів (від'ємна, якщо не вміщується заголовок).
+     */
+    qint64 audioCapacity(const PayloadHeader& layout, qint64 samples) const;
+
+    /**
+     * @brief Заголовок навантаження Y4M без довжини та CRC.
+     *
+     * @param encrypt Чи буде навантаження зашифроване.
+     * @return Заголовок.
+     */
+    PayloadHeader videoHeader(bool encrypt) const;
+
+    /**
+     * @brief Ємність одного кадру для даних.
+     *
+     * @param layout Заголовок з прапорцями режиму та розміром розширення.
+     * @param pixels Кількість пікселів площини яскравості.
+     * @param frame Номер кадру (кадр 0 містить і заголовок).
+     * @return Кількість байтів (від'ємна, якщо не вміщується заголовок).
+     */
+    qint64 videoFrameCapacity(const PayloadHeader& layout, qint64 pixels, int frame) const;
+
+    /**
+     * @brief Зчитування та перевірка заголовка навантаження з кадру 0.
+     *
+     * @param video Відкритий файл Y4M.
+     * @param header Заголовок навантаження (вихідний параметр).
+     * @param extension Розширення заголовка (вихідний параметр).
+     * @param record Діапазон кадрів з даними (вихідний параметр).
+     * @return true якщо заголовок коректний і дані вміщуються в кадри.
+     */
+    bool readVideoHeader(const Y4mFile& video, PayloadHeader& header,
+                         QByteArray& extension, VideoRecord& record);
+
+    /**
+     * @brief Серіалізація запису фрагмента (big-endian).
+     *
+     * @param record Запис фрагмента.
+     * @return Байтове представлення запису.
+     */
+    static QByteArray serializeShardRecord(const ShardRecord& record);
+
+    /**
+     * @brief Обробка кількох зображень паралельно (в окремому пулі).
+     *
+     * @param count Кількість зображень.
+     * @param task Обробник зображення з номером i.
+     */
+    void runCarriers(int count, const std::function<void(int)>& task);
+
+    /**
+     * @brief Кількість рядків у смузі для поблокової обробки.
+     *
+     * @param width Ширина зображення.
+     * @return Кількість рядків (щонайменше 1).
+     */
+    int tileRows(int width) const;
+
+    /**
+     * @brief Зчитування та перевірка заголовка навантаження.
+     *
+     * @param image Зображення у форматі RGB32.
+     * @param header Структура для заповнення.
+     * @return true якщо заголовок коректний і дані вміщуються в зображення.
+     */
+    bool readPayloadHeader(const QImage& image, PayloadHeader& header);
+
+    // ========== Код Ріда-Соломона ==========
+
+    /**
+     * @brief Зовнішній заголовок захищеного навантаження без довжини та CRC.
+     *
+     * @param encrypt Чи буде внутрішнє навантаження зашифроване.
+     * @return Заголовок "STER" з прапорцями режиму пікселів.
+     */
+    PayloadHeader protectedLayout(bool encrypt) const;
+
+    /**
+     * @brief Ємність захищеного навантаження для повідомлення.
+     *
+     * @param pixels Кількість пікселів зображення.
+     * @param encrypt Чи буде повідомлення зашифроване.
+     * @return Кількість байтів даних повідомлення (може бути від'ємною).
+     */
+    qint64 protectedCapacity(qint64 pixels, bool encrypt) const;
+
+    /**
+     * @brief Приховування повідомлення із захистом кодом Ріда-Соломона.
+     *
+     * @param image Зображення RGB32 або ARGB32 (модифікується).
+     * @param message Повідомлення.
+     * @param encrypt Чи потрібно шифрувати.
+     * @return Модифіковане зображення або пусте зображення у разі помилки.
+     */
+    QImage hideProtectedMessage(QImage& image, const QString& message, bool encrypt);
+
+    /**
+     * @brief Зчитування та виправлення захищеного заголовка.
+     *
+     * @param image Зображення RGB32 або ARGB32.
+     * @param header Зовнішній заголовок (вихідний параметр).
+     * @param paritySymbols Символів парності на слово (вихідний параметр).
+     * @param payloadSize Розмір внутрішнього навантаження (вихідний параметр).
+     * @return true якщо зображення містить захищене навантаження.
+     */
+    bool readProtectedHeader(const QImage& image, PayloadHeader& header,
+                             int& paritySymbols, qint64& payloadSize);
+
+    /**
+     * @brief Витягування повідомлення із захищеного навантаження.
+     *
+     * @param image Зображення RGB32 або ARGB32.
+     * @param header Зовнішній заголовок.
+     * @param paritySymbols Символів парності на слово.
+     * @param payloadSize Розмір внутрішнього навантаження.
+     * @param decrypt Чи дозволено дешифрування.
+     * @return Повідомлення або NOT_FOUND_MESSAGE.
+     */
+    QString extractProtectedMessage(const QImage& image, const PayloadHeader& header,
+                                    int paritySymbols, qint64 payloadSize, bool decrypt);
+
+    /**
+     * @brief Перевірка, що навантаження вміщується в зображення.
+     *
+     * @param header Заголовок навантаження.
+     * @param pixels Кількість пікселів зображення.
+     * @return true якщо заголовок, розширення і дані вміщуються.
+     */
+    bool payloadFits(const PayloadHeader& header, qint64 pixels) const;
+
+    /**
+     * @brief Серіалізація заголовка у 16 байтів (big-endian).
+     *
+     * @param header Заголовок навантаження.
+     * @return Байтове представлення заголовка.
+     */
+    QByteArray serializeHeader(const PayloadHeader& header);
+
+    /**
+     * @brief Розбір заголовка з 16 байтів.
+     *
+     * @param bytes Байтове представлення заголовка.
+     * @return Заголовок навантаження.
+     */
+    PayloadHeader parseHeader(const QByteArray& bytes);
+
+    /**
+     * @brief Обчислення контрольної суми CRC-32 (IEEE 802.3).
+     *
+     * @param data Дані для обчислення.
+     * @return Контрольна сума.
+     */
+    quint32 calculateCRC32(const QByteArray& data);
+
+    /**
+     * @brief XOR-шифрування байтів на місці.
+     *
+     * @param data Байти для шифрування/дешифрування (модифікуються).
+     * @param key Ключ шифрування.
+     */
+    void xorBytes(QByteArray& data, const QString& key);
+
+    // ========== Автентифіковане шифрування ==========
+
+    /**
+     * @brief Чи підтримується версія формату навантаження.
+     * @param version Версія з заголовка.
+     * @return true для PAYLOAD_VERSION і PAYLOAD_KDF_VERSION.
+     */
+    static bool knownVersion(quint8 version);
+
+    /**
+     * @brief Розмір даних шифру в розширенні заголовка.
+     * @param header Заголовок навантаження.
+     * @return Nonce і тег (та запис KDF у версії 2) або 0 без FLAG_AEAD.
+     */
+    static int cipherExtensionSize(const PayloadHeader& header);
+
+    /**
+     * @brief Увімкнення шифрування в заголовку (версія, прапорці, розширення).
+     * @param header Заголовок навантаження.
+     */
+    static void addCipherLayout(PayloadHeader& header);
+
+    /**
+     * @brief 256-бітовий ключ шифру з поточного ключа.
+     *
+     * @param header Заголовок навантаження (версія визначає KDF).
+     * @param extension Розширення заголовка (запис KDF у версії 2).
+     * @return Ключ (32 байти) або порожній масив для неприпустимих параметрів KDF.
+     */
+    QByteArray cipherKey(const PayloadHeader& header, const QByteArray& extension);
+
+    /**
+     * @brief Запис KDF для нових навантажень поточного сеансу.
+     *
+     * @return logN, r, p і сіль (KDF_RECORD_SIZE байтів).
+     */
+    static QByteArray sessionKdfRecord();
+
+    /**
+     * @brief Ключ шифру scrypt з поточного ключа (з кешем сеансу).
+     *
+     * @param record Запис KDF: logN, r, p і сіль.
+     * @return Ключ (32 байти) або порожній масив для неприпустимих параметрів.
+     */
+    QByteArray derivedKey(const QByteArray& record) const;
+
+    /**
+     * @brief Випадкове одноразове значення шифру.
+     * @return Nonce (12 байтів).
+     */
+    static QByteArray cipherNonce();
+
+    /**
+     * @brief Шифрування даних ChaCha20-Poly1305 на місці.
+     *
+     * @param data Дані (замінюються шифротекстом).
+     * @param headerBytes Серіалізований заголовок (автентифікується).
+     * @return Розширення заголовка: nonce, тег і запис KDF.
+     */
+    QByteArray encryptPayload(QByteArray& data, const QByteArray& headerBytes);
+
+    /**
+     * @brief Перевірка тегу та дешифрування даних на місці.
+     *
+     * @param data Шифротекст (замінюється відкритим текстом).
+     * @param header Заголовок навантаження.
+     * @param extension Розширення заголовка (nonce, тег і запис KDF).
+     * @return true якщо тег правильний.
+     */
+    bool decryptPayload(QByteArray& data, const PayloadHeader& header,
+                        const QByteArray& extension);
+
+    /**
+     * @brief Перевірка заголовка в перших пікселях зображення.
+     *
+     * @param head Перші рядки зображення у форматі RGB32 або ARGB32
+     *             (щонайменше PROBE_PIXELS пікселів, якщо зображення не менше).
+     * @param pixels Кількість пікселів усього зображення.
+     * @return Наявність і тип навантаження.
+     */
+    ProbeResult probeHead(const QImage& head, qint64 pixels);
+
+    /**
+     * @brief Витягування повідомлення старого формату (з маркерами).
+     *
+     * Декодує біти потоково за один прохід (лінійний час).
+     *
+     * @param image Зображення у форматі RGB32.
+     * @param decrypt Чи потрібно розшифрувати повідомлення.
+     * @return Витягнуте повідомлення або повідомлення про помилку.
+     */
+    QString extractLegacyMessage(const QImage& image, bool decrypt);
+
+    /**
+     * @brief Обчислення метрик якості за один злитий прохід.
+     *
+     * Заповнює MSE (загальну та по каналах), PSNR, кількість
+     * та бітову карту змінених пікселів, SSIM.
+     *
+     * @param original Оригінальне зображення.
+     * @param modified Модифіковане зображення.
+     * @param result Структура для заповнення метрик.
+     */
+    void calculateQualityMetrics(const QImage& original,
+                                 const QImage& modified,
+                                 ImageAnalysisResult& result);
+
+    /**
+     * @brief Обчислення SSIM ковзним вікном 8×8.
+     *
+     * SSIM (Structural Similarity Index) - метрика структурної схожості.
+     * Чим ближче до 1, тим менша різниця між зображеннями.
+     *
+     * @param first Перше зображення (RGB32).
+     * @param second Друге зображення (RGB32).
+     * @return Середнє значення SSIM.
+     */
+    double calculateSSIM(const QImage& first, const QImage& second);
+
+    /**
+     * @brief Ймовірність вбудовування за статистикою хі-квадрат.
+     *
+     * @param chiSquare Значення статистики хі-квадрат.
+     * @param degrees Кількість ступенів свободи.
+     * @return Ймовірність (0..1), що пари значень вирівняні вбудовуванням.
+     */
+    double chiSquareProbability(double chiSquare, int degrees);
+
+    /**
+     * @brief Оцінка частки вбудовування за статистикою RS-груп.
+     *
+     * @param counts Лічильники груп: R_M, S_M, R_-M, S_-M для зображення
+     *               та для зображення з інвертованими молодшими бітами.
+     * @return Оцінка частки вбудовування (0..1).
+     */
+    double estimateRsRate(const qint64 counts[8]);
+
+    /**
+     * @brief Оцінка частки вбудовування за статистикою пар пікселів.
+     *
+     * @param x Кількість пар множини X.
+     * @param y Кількість пар множини Y.
+     * @param k Кількість пар з однаковими значеннями без молодшого біта.
+     * @param pairs Загальна кількість пар.
+     * @return Оцінка частки вбудовування (0..1).
+     */
+    double estimateSamplePairRate(qint64 x, qint64 y, qint64 k, qint64 pairs);
+
+    // ========== Константи ==========
+
+    /// Сигнатура заголовка навантаження ("STEG").
+    static constexpr quint32 PAYLOAD_MAGIC = 0x53544547;
+
+    /// Версія формату навантаження без KDF (ключ шифру - SHA-256 ключа).
+    static constexpr quint8 PAYLOAD_VERSION = 1;
+
+    /// Версія формату з записом scrypt у розширенні шифру.
+    static constexpr quint8 PAYLOAD_KDF_VERSION = 2;
+
+    /// Розмір заголовка навантаження в байтах.
+    static constexpr int PAYLOAD_HEADER_SIZE = 16;
+
+    /// Прапорець: дані зашифровані.
+    static constexpr quint8 FLAG_ENCRYPTED = 0x01;
+
+    /// Прапорець: дані записані також в альфа-канал.
+    static constexpr quint8 FLAG_ALPHA = 0x02;
+
+    /// Зсув поля "бітів на канал - 1" у прапорцях.
+    static constexpr int FLAG_BITS_SHIFT = 2;
+
+    /// Маска поля "бітів на канал - 1" у прапорцях.
+    static constexpr quint8 FLAG_BITS_MASK = 0x0C;
+
+    /// Прапорець: дані розміщені в ключовому порядку пікселів.
+    static constexpr quint8 FLAG_KEYED_ORDER = 0x10;
+
+    /// Прапорець: дані зашифровані ChaCha20-Poly1305 (інакше - XOR).
+    static constexpr quint8 FLAG_AEAD = 0x20;
+
+    /// Розмір розширення заголовка для шифру: nonce (12) + тег (16).
+    static constexpr int CIPHER_EXTENSION_SIZE = 28;
+
+    /// Розмір запису KDF: logN, r, p (по 1 байту) + сіль.
+    static constexpr int KDF_RECORD_SIZE = 19;
+
+    /// Розмір солі scrypt у байтах.
+    static constexpr int KDF_SALT_SIZE = 16;
+
+    /// Бажаний час виведення ключа на поточному комп'ютері (мс).
+    static constexpr int KDF_TARGET_MS = 250;
+
+    /// Максимальна кількість ключів у кеші сеансу.
+    static constexpr int KDF_CACHE_LIMIT = 64;
+
+    /// Зсув поля "кодек стиснення" у прапорцях.
+    static constexpr int FLAG_CODEC_SHIFT = 6;
+
+    /// Маска поля "кодек стиснення" у прапорцях.
+    static constexpr quint8 FLAG_CODEC_MASK = 0xC0;
+
+    /// Кодек: без стиснення.
+    static constexpr int CODEC_NONE = 0;
+
+    /// Кодек: deflate (формат qCompress: 4 байти розміру + потік zlib).
+    static constexpr int CODEC_DEFLATE = 1;
+
+    /// Максимальний коефіцієнт стиснення deflate (захист від завеликого розміру).
+    static constexpr qint64 DEFLATE_MAX_RATIO = 1032;
+
+    /// Максимальна кількість молодших бітів на канал.
+    static constexpr int MAX_BITS_PER_CHANNEL = 4;
+
+    /// Розмір розширення заголовка для матричного вбудовування: параметр p.
+    static constexpr int MATRIX_EXTENSION_SIZE = 1;
+
+    /// Максимальний параметр коду Геммінга (блок з 1023 бітів).
+    static constexpr int MAX_HAMMING_P = 10;
+
+    /// Вирівнювання меж смуг: 24 біти = 8 пікселів = 3 байти.
+    static constexpr qint64 BAND_ALIGN_BITS = 24;
+
+    /// Мінімальний обсяг бітів, з якого вмикається паралельна обробка.
+    static constexpr qint64 PARALLEL_MIN_BITS = 1 << 16;
+
+    /// Мінімальна кількість рядків, з якої вмикається паралельна обробка.
+    static constexpr qint64 PARALLEL_MIN_ROWS = 64;
+
+    /// Мінімальна кількість смуг при відстеженні прогресу.
+    static constexpr qint64 PROGRESS_STEPS = 64;
+
+    /// Розмір ковзного вікна SSIM.
+    static constexpr int SSIM_WINDOW = 8;
+
+    /// Розмір смуги (в байтах RGB32) для поблокової обробки файлів.
+    static constexpr qint64 TILE_BYTES = 16 * 1024 * 1024;
+
+    /// Кількість послідовних сегментів для хі-квадрат атаки.
+    static constexpr int CHI_SQUARE_SEGMENTS = 32;
+
+    /// Поріг оцінки частки вбудовування для позначення підозрілих зображень.
+    static constexpr double STEGANALYSIS_THRESHOLD = 0.05;
+
+    /// Пікселів для швидкої перевірки: маркер старого формату (9 символів × 16 бітів / 3).
+    static constexpr int PROBE_PIXELS = 48;
+
+    /// Сигнатура заголовка навантаження з файлом ("STEF").
+    static constexpr quint32 PAYLOAD_FILE_MAGIC = 0x53544546;
+
+    /// Фіксована частина запису файлу в розширенні: розмір (8) + довжина імені (2).
+    static constexpr int FILE_RECORD_SIZE = 10;
+
+    /// Максимальна довжина імені файлу в байтах UTF-8.
+    static constexpr int MAX_FILE_NAME_BYTES = 255;
+
+    /// Фрагмент файлу - стільки байтів на кожен біт піксела (кратно блоку ChaCha20).
+    static constexpr qint64 FILE_CHUNK_UNIT = 64 * 1024;
+
+    /// Рівень стиснення deflate для файлів (баланс швидкості та розміру).
+    static constexpr int FILE_DEFLATE_LEVEL = 6;
+
+    /// Сигнатура заголовка фрагмента навантаження ("STES").
+    static constexpr quint32 PAYLOAD_SHARD_MAGIC = 0x53544553;
+
+    /// Розмір запису фрагмента: набір (4) + номер (1) + k (1) + m (1) + розмір (4).
+    static constexpr int SHARD_RECORD_SIZE = 11;
+
+    /// Максимальна кількість зображень у наборі (номер фрагмента - 1 байт).
+    static constexpr int MAX_CARRIERS = 255;
+
+    /// Розмір запису відео: перший кадр (4) + кількість кадрів (4) + байтів на кадр (4).
+    static constexpr int VIDEO_RECORD_SIZE = 12;
+
+    /// Сигнатура заголовка навантаження з кодом Ріда-Соломона ("STER").
+    static constexpr quint32 PAYLOAD_ECC_MAGIC = 0x53544552;
+
+    /// Розмір запису коду: символів парності (1) + розмір навантаження (4).
+    static constexpr int ECC_RECORD_SIZE = 5;
+
+    /// Символів парності заголовка та запису коду (виправляє 8 байтів).
+    static constexpr int ECC_HEADER_PARITY = 16;
+
+    /// Ім'я витягнутого файлу, якщо збережене ім'я непридатне.
+    const QString DEFAULT_FILE_NAME = "extracted.bin";
+
+    /// Маркер початку повідомлення (старий формат).
     const QString START_MARKER = "<<START>>";
 
-    /// Маркер кінця повідомлення (для визначення кінця даних).
+    /// Маркер кінця повідомлення (старий формат).
     const QString END_MARKER = "<<END>>";
 
     // ========== Змінні стану ==========
 
     /// Поточний ключ шифрування.
     QString currentKey;
+
+    /// Чи увімкнено паралельний режим.
+    bool parallelMode = false;
+
+    /// Кількість молодших бітів на канал (1-4).
+    int planeBits = 1;
+
+    /// Чи записуються дані в альфа-канал.
+    bool alphaPlane = false;
+
+    /// Чи розміщуються дані в ключовому порядку пікселів.
+    bool keyedOrder = false;
+
+    /// Чи стискається повідомлення перед вбудовуванням.
+    bool compression = false;
+
+    /// Чи вбудовуються дані кодами Геммінга.
+    bool matrixEmbedding = false;
+
+    /// Символів парності коду Ріда-Соломона на слово (0 - без коду).
+    int eccParity = 0;
+
+    /// Обробник прогресу операції.
+    ProgressHandler progressHandler;
+
+    /// Виконана робота поточної операції.
+    QAtomicInteger<qint64> progressDone;
+
+    /// Загальна робота поточної операції (0 - прогрес не відстежується).
+    qint64 progressTotal = 0;
+
+    /// Запит на скасування (1 - скасувати).
+    QAtomicInt cancelRequested;
+
+    /// Пул потоків для паралельної обробки смуг.
+    QThreadPool threadPool;
 };
 
 #endif // STEGANOGRAPHYENGINE_H
@@ -0,0 +1,570 @@
+/*
+ * SteganographyEngine_Audio.cpp
+ *
+ * Реалізація приховування повідомлень у молодших бітах відліків
+ * нестисненого PCM файлів WAV (16 та 24 біти на відлік).
+ * Відліки відображаються в пам'ять (WavFile) і змінюються на місці,
+ * тому пам'ять не залежить від розміру файлу.
+ */
+
+#include "SteganographyEngine.h"
+#include "KeyedPermutation.h"
+#include "WavFile.h"
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QtEndian>
+#include <QtMath>
+#include <numeric>
+#include <optional>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define AUDIO_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define AUDIO_HAS_SSE2 0
+#endif
+
+/// Відліків за ітерацію векторного ядра (два регістри по 8 відліків).
+static const qint64 SIMD_SAMPLES = 16;
+
+/* ============================================================================
+ *                      ЯДРА ЗАПИСУ ТА ЗЧИТУВАННЯ ВІДЛІКІВ
+ * ============================================================================
+ */
+
+/**
+ * @brief Зчитування відліку зі знаком (little-endian).
+ *
+ * @param sample Перший байт відліку.
+ * @param sampleBytes Розмір відліку (2 або 3).
+ * @return Значення відліку.
+ */
+static inline int sampleValue(const uchar* sample, int sampleBytes) {
+    if (sampleBytes == WavFile::PCM16_BYTES) {
+        return qFromLittleEndian<qint16>(sample);
+    }
+    // 24 біти: розширення знака зсувом старшого байта.
+    return int(quint32(sample[0]) | (quint32(sample[1]) << 8) | (quint32(sample[2]) << 16)) << 8 >> 8;
+}
+
+/**
+ * @brief Запис діапазону бітів у молодші біти відліків (ядро смуги).
+ *
+ * j-й відлік даних отримує біти [j × bits, (j + 1) × bits) потоку, старший
+ * біт - першим; неповне поле в кінці даних займає старші з bits бітів.
+ * Молодші біти відліку - молодші біти його першого байта (little-endian),
+ * тому решта байтів відліку не змінюється.
+ *
+ * Векторний шлях (16-бітний PCM, 1 біт, послідовний порядок): байт даних
+ * розкладається на 8 відліків порівнянням з масками бітів (SSE2).
+ *
+ * @param samples Відліки (початок блока data).
+ * @param sampleBytes Розмір відліку (2 або 3).
+ * @param firstSample Номер першого відліку даних.
+ * @param bytes Байти даних.
+ * @param bitBegin Перший біт діапазону (кратний НСК(bits, 8)).
+ * @param bitEnd Біт після останнього.
+ * @param bits Кількість бітів на відлік (1-4).
+ * @param order Ключова перестановка відліків даних (nullptr - послідовно).
+ */
+static void embedSampleRange(uchar* samples, int sampleBytes, qint64 firstSample,
+                             const uchar* bytes, qint64 bitBegin, qint64 bitEnd, int bits,
+                             const KeyedPermutation* order) {
+    qint64 k = bitBegin;
+
+#if AUDIO_HAS_SSE2
+    if (bits == 1 && !order && sampleBytes == WavFile::PCM16_BYTES) {
+        // Відлік 0 отримує біт 7 байта, відлік 7 - біт 0.
+        const __m128i masks = _mm_set_epi16(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80);
+        const __m128i keep = _mm_set1_epi16(qint16(0xFFFE));
+
+        for (; k + SIMD_SAMPLES <= bitEnd; k += SIMD_SAMPLES) {
+            __m128i* out = reinterpret_cast<__m128i*>(samples + (firstSample + k) * 2);
+            for (int half = 0; half < 2; ++half) {
+                const __m128i value = _mm_set1_epi16(bytes[(k >> 3) + half]);
+                const __m128i bit = _mm_srli_epi16(
+                    _mm_cmpeq_epi16(_mm_and_si128(value, masks), masks), 15);
+                const __m128i sample = _mm_loadu_si128(out + half);
+                _mm_storeu_si128(out + half, _mm_or_si128(_mm_and_si128(sample, keep), bit));
+            }
+        }
+    }
+#endif
+
+    // Скалярний шлях (або залишок).
+    while (k < bitEnd) {
+        const qint64 j = k / bits;
+        const int fieldBits = int(qMin<qint64>(bits, bitEnd - k));
+
+        uint field = 0;
+        for (int b = 0; b < fieldBits; ++b, ++k) {
+            field = (field << 1) | ((bytes[k >> 3] >> (7 - (k & 7))) & 1);
+        }
+
+        const qint64 position = order ? qint64(order->map(quint64(j))) : j;
+        uchar* low = samples + (firstSample + position) * sampleBytes;
+        const int shift = bits - fieldBits;
+        const uint mask = ((1u << fieldBits) - 1) << shift;
+        *low = uchar((*low & ~mask) | (field << shift));
+    }
+}
+
+/**
+ * @brief Зчитування діапазону бітів з молодших бітів відліків (ядро смуги).
+ *
+ * Буфер bytes має бути обнулений: біти додаються через OR. Межі смуг
+ * кратні 8 бітам, тому смуги не пишуть в один байт.
+ *
+ * Векторний шлях (16-бітний PCM, 1 біт, послідовний порядок): молодші
+ * біти 16 відліків розвертаються в порядку (старший біт - перший відлік)
+ * і збираються в 2 байти через _mm_movemask_epi8.
+ *
+ * @param samples Відліки (початок блока data).
+ * @param sampleBytes Розмір відліку (2 або 3).
+ * @param firstSample Номер першого відліку даних.
+ * @param bytes Вихідні байти (обнулені).
+ * @param bitBegin Перший біт діапазону (кратний НСК(bits, 8)).
+ * @param bitEnd Біт після останнього.
+ * @param bits Кількість бітів на відлік (1-4).
+ * @param order Ключова перестановка відліків даних (nullptr - послідовно).
+ */
+static void extractSampleRange(const uchar* samples, int sampleBytes, qint64 firstSample,
+                               uchar* bytes, qint64 bitBegin, qint64 bitEnd, int bits,
+                               const KeyedPermutation* order) {
+    qint64 k = bitBegin;
+
+#if AUDIO_HAS_SSE2
+    if (bits == 1 && !order && sampleBytes == WavFile::PCM16_BYTES) {
+        const __m128i one = _mm_set1_epi16(1);
+
+        for (; k + SIMD_SAMPLES <= bitEnd; k += SIMD_SAMPLES) {
+            const __m128i* in = reinterpret_cast<const __m128i*>(samples + (firstSample + k) * 2);
+            __m128i lsb[2];
+            for (int half = 0; half < 2; ++half) {
+                // Розворот 8 відліків: обмін половин, потім розворот кожної половини.
+                __m128i v = _mm_and_si128(_mm_loadu_si128(in + half), one);
+                v = _mm_shuffle_epi32(v, 0x4E);
+                v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+                lsb[half] = _mm_slli_epi16(v, 7);
+            }
+            const int mask = _mm_movemask_epi8(_mm_packus_epi16(lsb[0], lsb[1]));
+            bytes[k >> 3] = uchar(mask);
+            bytes[(k >> 3) + 1] = uchar(mask >> 8);
+        }
+    }
+#endif
+
+    while (k < bitEnd) {
+        const qint64 j = k / bits;
+        const int fieldBits = int(qMin<qint64>(bits, bitEnd - k));
+        const qint64 position = order ? qint64(order->map(quint64(j))) : j;
+        const uint low = samples[(firstSample + position) * sampleBytes];
+
+        for (int b = 0; b < fieldBits; ++b, ++k) {
+            const uint bit = (low >> (bits - 1 - b)) & 1;
+            bytes[k >> 3] |= uchar(bit << (7 - (k & 7)));
+        }
+    }
+}
+
+/* ============================================================================
+ *                      МЕТОДИ ПРИХОВУВАННЯ В WAV
+ * ============================================================================
+ */
+
+/**
+ * @brief Приховування повідомлення в молодших бітах відліків файлу WAV.
+ *
+ * Алгоритм:
+ * 1. Відкриваємо вхідний файл і перевіряємо ємність.
+ * 2. Копіюємо файл (потоково), якщо результат - інший файл.
+ * 3. Відображаємо відліки результату в пам'ять для запису.
+ * 4. Записуємо дані (смугами, паралельно) по bits бітів у відліки
+ *    після заголовка, в послідовному або ключовому порядку.
+ * 5. Записуємо заголовок і розширення по 1 біту у перші відліки.
+ *    Заголовок - останнім: якщо операцію скасовано під час зміни
+ *    файлу на місці, повідомлення просто не знаходиться.
+ *
+ * @param inputPath Шлях до вхідного WAV.
+ * @param outputPath Шлях до вихідного WAV (може збігатися з вхідним).
+ * @param message Текстове повідомлення для приховування.
+ * @param encrypt Чи потрібно шифрувати повідомлення.
+ * @return true у разі успіху.
+ */
+bool SteganographyEngine::hideMessageWav(const QString& inputPath, const QString& outputPath,
+                                         const QString& message, bool encrypt) {
+    if (message.isEmpty()) {
+        qWarning() << "Empty message!";
+        return false;
+    }
+
+    // ========== КРОК 1: Вхідний файл і ємність ==========
+    const PayloadHeader layout = audioHeader(encrypt);
+    const QByteArray payload = buildPayload(message, layout);
+    const PayloadHeader header = parseHeader(payload);
+    const qint64 headerBytes = qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize;
+    const int bits = ((header.flags & FLAG_BITS_MASK) >> FLAG_BITS_SHIFT) + 1;
+
+    {
+        WavFile source(inputPath);
+        if (!source.open()) {
+            qWarning() << "Cannot read WAV:" << inputPath << source.errorString();
+            return false;
+        }
+
+        const qint64 capacity = audioCapacity(header, source.sampleCount());
+        qDebug() << "Payload:" << header.length << "bytes, WAV capacity:" << capacity
+                 << "bits per sample:" << bits << "keyed order:" << bool(header.flags & FLAG_KEYED_ORDER);
+
+        if (qint64(header.length) > capacity) {
+            qWarning() << "Message too long for this file!";
+            qWarning() << "Required:" << header.length << "Available:" << capacity;
+            return false;
+        }
+    }
+
+    // ========== КРОК 2: Копія файлу ==========
+    const bool inPlace = QFileInfo(inputPath).absoluteFilePath() ==
+                         QFileInfo(outputPath).absoluteFilePath();
+    if (!inPlace) {
+        QFile::remove(outputPath);
+        if (!QFile::copy(inputPath, outputPath)) {
+            qWarning() << "Cannot copy WAV to" << outputPath;
+            return false;
+        }
+    }
+
+    // ========== КРОК 3: Відображення для запису ==========
+    bool written = false;
+    {
+        WavFile target(outputPath);
+        if (!target.open(true)) {
+            qWarning() << "Cannot map WAV for writing:" << outputPath << target.errorString();
+        } else {
+            uchar* samples = target.samples();
+            const int sampleBytes = target.sampleBytes();
+            const qint64 firstSample = headerBytes * 8;
+            const uchar* bytes = reinterpret_cast<const uchar*>(payload.constData());
+
+            std::optional<KeyedPermutation> order;
+            if (header.flags & FLAG_KEYED_ORDER) {
+                order.emplace(currentKey, quint64(target.sampleCount() - firstSample));
+            }
+            const KeyedPermutation* permutation = order ? &*order : nullptr;
+
+            // ========== КРОК 4: Дані ==========
+            const qint64 dataBits = qint64(header.length) * 8;
+            beginProgress(dataBits);
+            runBands(dataBits, std::lcm(qint64(bits), qint64(8)), PARALLEL_MIN_BITS,
+                     [=](qint64 bitBegin, qint64 bitEnd) {
+                embedSampleRange(samples, sampleBytes, firstSample, bytes + headerBytes,
+                                 bitBegin, bitEnd, bits, permutation);
+            });
+
+            // ========== КРОК 5: Заголовок ==========
+            written = !isCancelled();
+            if (written) {
+                embedSampleRange(samples, sampleBytes, 0, bytes, 0, headerBytes * 8, 1, nullptr);
+            }
+            endProgress();
+        }
+    }
+
+    if (!written) {
+        if (!inPlace) {
+            QFile::remove(outputPath);
+        }
+        qWarning() << "WAV hiding failed or was cancelled";
+        return false;
+    }
+
+    qDebug() << "Total bytes hidden:" << payload.size();
+    qDebug() << "WAV hiding completed successfully";
+
+    return true;
+}
+
+/**
+ * @brief Витягування повідомлення з молодших бітів відліків файлу WAV.
+ *
+ * Алгоритм:
+ * 1. Відображаємо відліки для читання.
+ * 2. Зчитуємо та перевіряємо заголовок (сигнатура, версія, розмір).
+ * 3. Зчитуємо розширення і дані (в ключовому порядку, якщо він вказаний).
+ * 4. Дешифруємо, перевіряємо CRC-32 та декодуємо UTF-8.
+ *
+ * @param inputPath Шлях до WAV.
+ * @param decrypt Чи потрібно розшифрувати повідомлення.
+ * @return Витягнуте повідомлення або повідомлення про помилку
+ *         (порожній рядок, якщо файл не вдалося прочитати).
+ */
+QString SteganographyEngine::extractMessageWav(const QString& inputPath, bool decrypt) {
+    // ========== КРОК 1: Відліки ==========
+    WavFile wav(inputPath);
+    if (!wav.open()) {
+        qWarning() << "Cannot read WAV:" << inputPath << wav.errorString();
+        return QString();
+    }
+
+    const uchar* samples = wav.constSamples();
+    const int sampleBytes = wav.sampleBytes();
+    if (wav.sampleCount() < qint64(PAYLOAD_HEADER_SIZE) * 8) {
+        return NOT_FOUND_MESSAGE;
+    }
+
+    // ========== КРОК 2: Заголовок ==========
+    QByteArray headerBytes(PAYLOAD_HEADER_SIZE, '\0');
+    extractSampleRange(samples, sampleBytes, 0, reinterpret_cast<uchar*>(headerBytes.data()),
+                       0, qint64(PAYLOAD_HEADER_SIZE) * 8, 1, nullptr);
+
+    const PayloadHeader header = parseHeader(headerBytes);
+    if (header.magic != PAYLOAD_MAGIC || !knownVersion(header.version) ||
+        qint64(header.length) > audioCapacity(header, wav.sampleCount())) {
+        qDebug() << "WAV payload header not found";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    const int bits = ((header.flags & FLAG_BITS_MASK) >> FLAG_BITS_SHIFT) + 1;
+    qDebug() << "WAV payload header found, length:" << header.length
+             << "bytes, bits per sample:" << bits << "flags:" << header.flags;
+
+    // ========== КРОК 3: Розширення та дані ==========
+    QByteArray extension(header.extensionSize, '\0');
+    extractSampleRange(samples, sampleBytes, qint64(PAYLOAD_HEADER_SIZE) * 8,
+                       reinterpret_cast<uchar*>(extension.data()),
+                       0, qint64(header.extensionSize) * 8, 1, nullptr);
+
+    // Порядок відліків визначається ключем - без нього дані не знайти.
+    const qint64 firstSample = (qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize) * 8;
+    std::optional<KeyedPermutation> order;
+    if (header.flags & FLAG_KEYED_ORDER) {
+        if (currentKey.isEmpty()) {
+            qWarning() << "Payload uses keyed sample order, but no key was provided!";
+            return NOT_FOUND_MESSAGE;
+        }
+        order.emplace(currentKey, quint64(wav.sampleCount() - firstSample));
+    }
+    const KeyedPermutation* permutation = order ? &*order : nullptr;
+
+    QByteArray data(header.length, '\0');
+    uchar* bytes = reinterpret_cast<uchar*>(data.data());
+    const qint64 dataBits = qint64(header.length) * 8;
+
+    beginProgress(dataBits);
+    runBands(dataBits, std::lcm(qint64(bits), qint64(8)), PARALLEL_MIN_BITS,
+             [=](qint64 bitBegin, qint64 bitEnd) {
+        extractSampleRange(samples, sampleBytes, firstSample, bytes,
+                           bitBegin, bitEnd, bits, permutation);
+    });
+
+    const bool cancelled = isCancelled();
+    endProgress();
+    if (cancelled) {
+        qWarning() << "Extraction cancelled";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    // ========== КРОК 4: Дешифруємо та перевіряємо ==========
+    return decodePayload(header, extension, data, decrypt);
+}
+
+/**
+ * @brief Ємність файлу WAV у поточному режимі.
+ *
+ * @param inputPath Шлях до WAV.
+ * @param encrypt Чи буде повідомлення зашифроване.
+ * @return Максимальна кількість байтів даних (-1, якщо файл не прочитано).
+ */
+qint64 SteganographyEngine::calculateWavCapacity(const QString& inputPath, bool encrypt) {
+    WavFile wav(inputPath);
+    if (!wav.open()) {
+        qWarning() << "Cannot read WAV:" << inputPath << wav.errorString();
+        return -1;
+    }
+    return qMax<qint64>(0, audioCapacity(audioHeader(encrypt), wav.sampleCount()));
+}
+
+/* ============================================================================
+ *                          АНАЛІЗ ЗМІН
+ * ============================================================================
+ */
+
+/**
+ * @brief Аналіз змін між оригінальним і модифікованим файлом WAV.
+ *
+ * Метрики:
+ * - MSE = Σ(x - y)² / N в одиницях відліку.
+ * - SNR = 10 × log10(Σx² / Σ(x - y)²) - відношення енергії сигналу до шуму
+ *   вбудовування (для тиші не визначене і дорівнює 0).
+ * - PSNR = 10 × log10(MAX² / MSE), MAX - повна шкала відліку (32767 або 8388607).
+ * Для ідентичних файлів SNR і PSNR дорівнюють 100 дБ, як PSNR зображень.
+ *
+ * @param originalPath Шлях до оригінального WAV.
+ * @param modifiedPath Шлях до модифікованого WAV.
+ * @param message Приховане повідомлення.
+ * @return Структура з результатами аналізу.
+ */
+AudioAnalysisResult SteganographyEngine::analyzeAudioChanges(const QString& originalPath,
+                                                             const QString& modifiedPath,
+                                                             const QString& message) {
+    AudioAnalysisResult result;
+
+    WavFile original(originalPath);
+    WavFile modified(modifiedPath);
+    if (!original.open() || !modified.open()) {
+        qWarning() << "Cannot analyze WAV:" << original.errorString() << modified.errorString();
+        return result;
+    }
+
+    // ========== Формат ==========
+    result.channels = original.channels();
+    result.sampleRate = original.sampleRate();
+    result.bitsPerSample = original.bitsPerSample();
+    result.sampleCount = original.sampleCount();
+    if (result.sampleRate > 0) {
+        result.duration = double(result.sampleCount) / result.channels / result.sampleRate;
+    }
+    result.originalFileSize = QFileInfo(originalPath).size();
+    result.modifiedFileSize = QFileInfo(modifiedPath).size();
+
+    // ========== Інформація про повідомлення ==========
+    result.message = message;
+    result.messageLength = message.length();
+    result.messageBytes = message.toUtf8().size();
+    result.hasMessage = !message.isEmpty();
+    result.storedBytes = storedMessageSize(message);
+    result.compressed = result.storedBytes < result.messageBytes;
+
+    // Шифрування вибирається для кожного повідомлення, тому режим і розмір
+    // розширення беремо із записаного заголовка (без нього - без шифрування).
+    PayloadHeader layout = audioHeader(false);
+    if (modified.sampleCount() >= qint64(PAYLOAD_HEADER_SIZE) * 8) {
+        QByteArray headerBytes(PAYLOAD_HEADER_SIZE, '\0');
+        extractSampleRange(modified.constSamples(), modified.sampleBytes(), 0,
+                           reinterpret_cast<uchar*>(headerBytes.data()),
+                           0, qint64(PAYLOAD_HEADER_SIZE) * 8, 1, nullptr);
+        const PayloadHeader header = parseHeader(headerBytes);
+        if (header.magic == PAYLOAD_MAGIC && knownVersion(header.version) &&
+            header.extensionSize == cipherExtensionSize(header) &&
+            qint64(header.length) <= audioCapacity(header, modified.sampleCount())) {
+            layout = header;
+        }
+    }
+    result.lsbBits = ((layout.flags & FLAG_BITS_MASK) >> FLAG_BITS_SHIFT) + 1;
+    result.keyedOrder = (layout.flags & FLAG_KEYED_ORDER) != 0;
+    result.bitsUsed = (qint64(PAYLOAD_HEADER_SIZE) + layout.extensionSize + result.storedBytes) * 8;
+    result.maxCapacity = qMax<qint64>(0, audioCapacity(layout, result.sampleCount));
+    if (result.maxCapacity > 0) {
+        result.capacityUsed = (result.storedBytes / result.maxCapacity) * 100.0;
+    }
+
+    if (modified.sampleCount() != original.sampleCount() ||
+        modified.sampleBytes() != original.sampleBytes()) {
+        qWarning() << "Cannot compare WAV files with different formats!";
+        return result;
+    }
+
+    // ========== Метрики якості за один прохід ==========
+    const uchar* a = original.constSamples();
+    const uchar* b = modified.constSamples();
+    const int sampleBytes = original.sampleBytes();
+
+    double signal = 0.0;
+    double noise = 0.0;
+    qint64 changed = 0;
+    int maxDifference = 0;
+    QMutex mutex;
+
+    runBands(result.sampleCount, 1, PARALLEL_MIN_BITS, [&](qint64 begin, qint64 end) {
+        // Квадрати 24-бітних відліків (до 2^46) швидко переповнюють 64 біти.
+        double bandSignal = 0.0;
+        double bandNoise = 0.0;
+        qint64 bandChanged = 0;
+        int bandMax = 0;
+
+        for (qint64 i = begin; i < end; ++i) {
+            const int x = sampleValue(a + i * sampleBytes, sampleBytes);
+            const int d = x - sampleValue(b + i * sampleBytes, sampleBytes);
+            bandSignal += double(x) * x;
+            bandNoise += double(d) * d;
+            bandChanged += d != 0;
+            bandMax = qMax(bandMax, qAbs(d));
+        }
+
+        QMutexLocker locker(&mutex);
+        signal += bandSignal;
+        noise += bandNoise;
+        changed += bandChanged;
+        maxDifference = qMax(maxDifference, bandMax);
+    });
+
+    result.mse = noise / double(result.sampleCount);
+    result.modifiedSamples = changed;
+    result.maxDifference = maxDifference;
+
+    const double fullScale = double((1 << (original.bitsPerSample() - 1)) - 1);
+    result.psnr = result.mse == 0 ? 100.0 : 10.0 * log10(fullScale * fullScale / result.mse);
+    if (noise == 0) {
+        result.snr = 100.0;
+    } else if (signal > 0) {
+        result.snr = 10.0 * log10(signal / noise);
+    }
+
+    if (changed > 0) {
+        result.embeddingEfficiency = double(result.bitsUsed) / changed;
+    }
+
+    return result;
+}
+
+/* ============================================================================
+ *                          РОЗМІЩЕННЯ ДАНИХ
+ * ============================================================================
+ */
+
+/**
+ * @brief Заголовок навантаження WAV без довжини та CRC.
+ *
+ * Кількість бітів на відлік - bitsPerChannel(); альфа-каналу і матричного
+ * вбудовування для аудіо немає. Ключовий порядок і шифрування - як для
+ * зображень (лише за наявності ключа).
+ *
+ * @param encrypt Чи буде навантаження зашифроване.
+ * @return Заголовок.
+ */
+PayloadHeader SteganographyEngine::audioHeader(bool encrypt) const {
+    PayloadHeader header;
+    header.magic = PAYLOAD_MAGIC;
+    header.version = PAYLOAD_VERSION;
+    header.flags = quint8((planeBits - 1) << FLAG_BITS_SHIFT);
+    if (keyedOrder && !currentKey.isEmpty()) {
+        header.flags |= FLAG_KEYED_ORDER;
+    }
+    if (encrypt && !currentKey.isEmpty()) {
+        addCipherLayout(header);
+    }
+    return header;
+}
+
+/**
+ * @brief Ємність відліків для даних (без заголовка).
+ *
+ * Заголовок і розширення займають по 1 біту в перших (16 + розширення) × 8
+ * відліках, решта відліків несе по k бітів.
+ *
+ * @param layout Заголовок з прапорцями режиму та розміром розширення.
+ * @param samples Кількість відліків.
+ * @return Кількість байтів (від'ємна, якщо не вміщується заголовок).
+ */
+qint64 SteganographyEngine::audioCapacity(const PayloadHeader& layout, qint64 samples) const {
+    const qint64 headerBytes = qint64(PAYLOAD_HEADER_SIZE) + layout.extensionSize;
+    const qint64 dataSamples = samples - headerBytes * 8;
+    if (dataSamples <= 0) {
+        return -headerBytes;
+    }
+
+    const int bits = ((layout.flags & FLAG_BITS_MASK) >> FLAG_BITS_SHIFT) + 1;
+    return dataSamples * bits / 8;
+}
@@ -0,0 +1,382 @@
+/*
+ * SteganographyEngine_BitPlanes.cpp
+ *
+ * Реалізація вбудовування в кілька молодших бітових площин.
+ * Кожен піксель несе 3k (або 4k з альфа-каналом) бітів даних,
+ * де k - кількість молодших бітів на канал (1-4).
+ */
+
+#include "SteganographyEngine.h"
+#include "KeyedPermutation.h"
+#include <QDebug>
+#include <numeric>
+
+/// Зсуви каналів R, G, B, A у значенні QRgb (0xAARRGGBB).
+static const int PLANE_CHANNEL_SHIFTS[4] = {16, 8, 0, 24};
+
+/* ============================================================================
+ *                          НАЛАШТУВАННЯ РЕЖИМУ
+ * ============================================================================
+ */
+
+/**
+ * @brief Налаштування кількості молодших бітів на канал.
+ *
+ * @param bits Кількість бітів на канал (обмежується діапазоном 1-4).
+ * @param useAlpha Чи використовувати альфа-канал.
+ */
+void SteganographyEngine::setBitsPerChannel(int bits, bool useAlpha) {
+    planeBits = qBound(1, bits, MAX_BITS_PER_CHANNEL);
+    alphaPlane = useAlpha;
+    qDebug() << "Bits per channel:" << planeBits << "alpha:" << alphaPlane;
+}
+
+/**
+ * @brief Увімкнення ключового порядку пікселів.
+ *
+ * Діє лише за наявності ключа: без нього дані записуються послідовно.
+ *
+ * @param enabled true - ключовий порядок, false - послідовний.
+ */
+void SteganographyEngine::setKeyedOrdering(bool enabled) {
+    keyedOrder = enabled;
+    qDebug() << "Keyed pixel order:" << keyedOrder;
+}
+
+/**
+ * @brief Чи увімкнено ключовий порядок пікселів.
+ * @return true якщо дані розміщуються в ключовому порядку.
+ */
+bool SteganographyEngine::isKeyedOrdering() const {
+    return keyedOrder;
+}
+
+/**
+ * @brief Кількість молодших бітів на канал.
+ * @return Значення від 1 до 4.
+ */
+int SteganographyEngine::bitsPerChannel() const {
+    return planeBits;
+}
+
+/**
+ * @brief Чи використовується альфа-канал.
+ * @return true якщо дані записуються і в канал A.
+ */
+bool SteganographyEngine::usesAlpha() const {
+    return alphaPlane;
+}
+
+/* ============================================================================
+ *                          РОЗМІЩЕННЯ ДАНИХ
+ * ============================================================================
+ */
+
+/**
+ * @brief Номер першого піксела даних у багатобітовому режимі.
+ *
+ * Заголовок (і розширення) записуються по 1 біту в канали R, G, B,
+ * як у звичайному режимі, тому їх можна прочитати не знаючи режиму.
+ * Дані починаються з наступного цілого піксела:
+ * ⌈(16 + extensionSize) × 8 / 3⌉ (43 пікселі без розширення).
+ *
+ * @param header Заголовок навантаження.
+ * @return Номер піксела.
+ */
+qint64 SteganographyEngine::dataStartPixel(const PayloadHeader& header) const {
+    const qint64 headerBits = (qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize) * 8;
+    return (headerBits + 2) / 3;
+}
+
+/**
+ * @brief Розбір режиму розміщення даних з прапорців заголовка.
+ *
+ * Суцільний потік бітів використовується лише для 1 біта на канал RGB
+ * у послідовному порядку. Ключовий порядок переставляє цілі пікселі,
+ * тому завжди використовує розміщення по пікселях (навіть при k = 1),
+ * як і матричне вбудовування (блоки коду Геммінга починаються з цілого піксела).
+ *
+ * @param header Заголовок навантаження.
+ * @param bits Кількість бітів на канал (вихідний параметр).
+ * @param channels Кількість каналів: 3 або 4 (вихідний параметр).
+ * @return true якщо дані записані по пікселях.
+ */
+bool SteganographyEngine::planeLayout(const PayloadHeader& header, int& bits, int& channels) const {
+    bits = ((header.flags & FLAG_BITS_MASK) >> FLAG_BITS_SHIFT) + 1;
+    channels = (header.flags & FLAG_ALPHA) ? 4 : 3;
+    return bits > 1 || channels == 4 || (header.flags & FLAG_KEYED_ORDER) || matrixLayout(header);
+}
+
+/**
+ * @brief Ємність для даних (без заголовка) в заданому режимі.
+ *
+ * - Суцільний потік бітів: (пікселі × 3) / 8 - (16 + розширення).
+ * - По пікселях: (пікселі - перший_піксель_даних) × k × канали / 8,
+ *   де перший піксель даних - 43 без розширення заголовка.
+ *
+ * @param layout Заголовок з прапорцями режиму та розміром розширення.
+ * @param pixels Кількість пікселів зображення.
+ * @return Кількість байтів (від'ємна, якщо не вміщується заголовок).
+ */
+qint64 SteganographyEngine::dataCapacity(const PayloadHeader& layout, qint64 pixels) const {
+    const qint64 headerBytes = qint64(PAYLOAD_HEADER_SIZE) + layout.extensionSize;
+    int bits = 1;
+    int channels = 3;
+
+    if (!planeLayout(layout, bits, channels)) {
+        return pixels * 3 / 8 - headerBytes;
+    }
+
+    const qint64 dataPixels = pixels - dataStartPixel(layout);
+    if (dataPixels <= 0) {
+        return -headerBytes;
+    }
+    return dataPixels * bits * channels / 8;
+}
+
+/* ============================================================================
+ *                      ЗАПИС ТА ЗЧИТУВАННЯ ПЛОЩИН
+ * ============================================================================
+ */
+
+/**
+ * @brief Запис даних у k молодших бітів каналів.
+ *
+ * Межі смуг вирівнюються на НСК(біти_на_піксель, 8), тому кожна смуга
+ * починається з цілого піксела, а різні смуги не пишуть в один байт даних.
+ *
+ * @param image Зображення RGB32 або ARGB32 (модифікується).
+ * @param firstPixel Номер першого піксела даних.
+ * @param data Байти для запису.
+ * @param bits Кількість бітів на канал.
+ * @param channels Кількість каналів (3 або 4).
+ * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+ */
+void SteganographyEngine::embedPlanes(QImage& image, qint64 firstPixel, const QByteArray& data,
+                                      int bits, int channels, const KeyedPermutation* order) {
+    uchar* pixels = image.bits();
+    const qsizetype bytesPerLine = image.bytesPerLine();
+    const int width = image.width();
+    const uchar* bytes = reinterpret_cast<const uchar*>(data.constData());
+    const qint64 alignment = std::lcm(qint64(bits) * channels, qint64(8));
+
+    runBands(qint64(data.size()) * 8, alignment, PARALLEL_MIN_BITS,
+             [=](qint64 bitBegin, qint64 bitEnd) {
+        embedPlaneRange(pixels, bytesPerLine, width, firstPixel, bytes,
+                        bitBegin, bitEnd, bits, channels, order);
+    });
+}
+
+/**
+ * @brief Зчитування даних з k молодших бітів каналів.
+ *
+ * @param image Зображення RGB32 або ARGB32.
+ * @param firstPixel Номер першого піксела даних.
+ * @param byteCount Кількість байтів.
+ * @param bits Кількість бітів на канал.
+ * @param channels Кількість каналів (3 або 4).
+ * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+ * @return Зчитані байти.
+ */
+QByteArray SteganographyEngine::extractPlanes(const QImage& image, qint64 firstPixel,
+                                              qint64 byteCount, int bits, int channels,
+                                              const KeyedPermutation* order) {
+    QByteArray data(byteCount, '\0');
+
+    // Не виходимо за межі зображення.
+    const qint64 bitsPerPixel = qint64(bits) * channels;
+    const qint64 dataPixels = qMax<qint64>(0, qint64(image.width()) * image.height() - firstPixel);
+    const qint64 totalBits = qMin(byteCount * 8, dataPixels * bitsPerPixel);
+
+    const uchar* pixels = image.constBits();
+    const qsizetype bytesPerLine = image.bytesPerLine();
+    const int width = image.width();
+    uchar* bytes = reinterpret_cast<uchar*>(data.data());
+
+    runBands(totalBits, std::lcm(bitsPerPixel, qint64(8)), PARALLEL_MIN_BITS,
+             [=](qint64 bitBegin, qint64 bitEnd) {
+        extractPlaneRange(pixels, bytesPerLine, width, firstPixel, bytes,
+                          bitBegin, bitEnd, bits, channels, order);
+    });
+
+    return data;
+}
+
+/**
+ * @brief Запис діапазону бітів у бітові площини (ядро смуги).
+ *
+ * Для кожного піксела з потоку даних береться бітове поле довжиною
+ * bits × channels (до 16 бітів), старші біти - першими. Поле розкладається
+ * по каналах: канал R отримує старші k бітів поля, далі G, B, A.
+ * Біти подаються через 64-бітний акумулятор, що поповнюється цілими
+ * байтами, тому на піксель припадає кілька зсувів і масок незалежно від k.
+ *
+ * Неповне поле в кінці даних доповнюється поточними бітами піксела,
+ * тож зайві молодші біти не змінюються.
+ *
+ * З ключовою перестановкою j-й піксель даних записується у піксель
+ * pixelOffset + π(j). Перестановка - бієкція, тож смуги, що обробляються
+ * паралельно, так само не перетинаються.
+ *
+ * @param pixels Початок даних зображення (або смуги).
+ * @param bytesPerLine Довжина рядка в байтах.
+ * @param width Ширина зображення.
+ * @param pixelOffset Номер першого піксела даних відносно pixels.
+ * @param bytes Байти даних.
+ * @param bitBegin Перший біт діапазону (кратний bits × channels).
+ * @param bitEnd Біт після останнього.
+ * @param bits Кількість бітів на канал.
+ * @param channels Кількість каналів.
+ * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+ * @param byteOffset Номер байта даних, з якого починається буфер bytes.
+ */
+void SteganographyEngine::embedPlaneRange(uchar* pixels, qsizetype bytesPerLine, int width,
+                                          qint64 pixelOffset, const uchar* bytes,
+                                          qint64 bitBegin, qint64 bitEnd,
+                                          int bits, int channels,
+                                          const KeyedPermutation* order, qint64 byteOffset) {
+    if (bitBegin >= bitEnd) {
+        return;
+    }
+
+    const int bitsPerPixel = bits * channels;
+    const quint32 channelMask = (1u << bits) - 1;
+
+    // Маска молодших бітів усіх каналів у QRgb.
+    quint32 clearMask = 0;
+    for (int c = 0; c < channels; ++c) {
+        clearMask |= channelMask << PLANE_CHANNEL_SHIFTS[c];
+    }
+
+    // Акумулятор бітів: починаємо з байта, що містить bitBegin.
+    qint64 byteIndex = (bitBegin >> 3) - byteOffset;
+    quint64 accumulator = bytes[byteIndex] & (0xFFu >> (bitBegin & 7));
+    int accumulatorBits = 8 - int(bitBegin & 7);
+
+    qint64 dataPixel = bitBegin / bitsPerPixel;
+    qint64 y = (pixelOffset + dataPixel) / width;
+    int x = int((pixelOffset + dataPixel) % width);
+    qint64 bitIndex = bitBegin;
+
+    for (; bitIndex < bitEnd; ++dataPixel) {
+        const int count = int(qMin<qint64>(bitsPerPixel, bitEnd - bitIndex));
+        while (accumulatorBits < count) {
+            accumulator = (accumulator << 8) | bytes[++byteIndex];
+            accumulatorBits += 8;
+        }
+
+        accumulatorBits -= count;
+        quint32 field = quint32(accumulator >> accumulatorBits) & ((1u << count) - 1);
+        bitIndex += count;
+
+        // Цільовий піксель: наступний за порядком або π(j).
+        QRgb* target;
+        if (order) {
+            const qint64 p = pixelOffset + qint64(order->map(quint64(dataPixel)));
+            target = reinterpret_cast<QRgb*>(pixels + (p / width) * bytesPerLine) + p % width;
+        } else {
+            if (x == width) {
+                x = 0;
+                ++y;
+            }
+            target = reinterpret_cast<QRgb*>(pixels + y * bytesPerLine) + x++;
+        }
+
+        const QRgb pixel = *target;
+
+        // Неповне поле: молодші біти беремо з поточного піксела.
+        if (count < bitsPerPixel) {
+            quint32 current = 0;
+            for (int c = 0; c < channels; ++c) {
+                current = (current << bits) | ((pixel >> PLANE_CHANNEL_SHIFTS[c]) & channelMask);
+            }
+            const int pad = bitsPerPixel - count;
+            field = (field << pad) | (current & ((1u << pad) - 1));
+        }
+
+        // Розкладаємо поле по каналах.
+        quint32 spread = 0;
+        for (int c = 0; c < channels; ++c) {
+            const int fieldShift = (channels - 1 - c) * bits;
+            spread |= ((field >> fieldShift) & channelMask) << PLANE_CHANNEL_SHIFTS[c];
+        }
+
+        *target = (pixel & ~clearMask) | spread;
+    }
+}
+
+/**
+ * @brief Зчитування діапазону бітів з бітових площин (ядро смуги).
+ *
+ * Збирає бітове поле піксела з молодших бітів каналів і дописує його
+ * в 64-бітний акумулятор, з якого виводяться цілі байти. Байти
+ * об'єднуються через OR, тому діапазон може починатися всередині байта
+ * (наприклад, на межі смуги рядків при поблоковій обробці).
+ *
+ * @param pixels Початок даних зображення (або смуги).
+ * @param bytesPerLine Довжина рядка в байтах.
+ * @param width Ширина зображення.
+ * @param pixelOffset Номер першого піксела даних відносно pixels.
+ * @param bytes Вихідні байти (заповнені нулями).
+ * @param bitBegin Перший біт діапазону (кратний bits × channels).
+ * @param bitEnd Біт після останнього.
+ * @param bits Кількість бітів на канал.
+ * @param channels Кількість каналів.
+ * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+ * @param byteOffset Номер байта даних, з якого починається буфер bytes.
+ */
+void SteganographyEngine::extractPlaneRange(const uchar* pixels, qsizetype bytesPerLine, int width,
+                                            qint64 pixelOffset, uchar* bytes,
+                                            qint64 bitBegin, qint64 bitEnd,
+                                            int bits, int channels,
+                                            const KeyedPermutation* order, qint64 byteOffset) {
+    const int bitsPerPixel = bits * channels;
+    const quint32 channelMask = (1u << bits) - 1;
+
+    // Біти перед bitBegin у першому байті залишаються нулями в акумуляторі.
+    quint64 accumulator = 0;
+    int accumulatorBits = int(bitBegin & 7);
+    qint64 byteIndex = (bitBegin >> 3) - byteOffset;
+
+    qint64 dataPixel = bitBegin / bitsPerPixel;
+    qint64 y = (pixelOffset + dataPixel) / width;
+    int x = int((pixelOffset + dataPixel) % width);
+    qint64 bitIndex = bitBegin;
+
+    for (; bitIndex < bitEnd; ++dataPixel) {
+        // Джерельний піксель: наступний за порядком або π(j).
+        QRgb pixel;
+        if (order) {
+            const qint64 p = pixelOffset + qint64(order->map(quint64(dataPixel)));
+            pixel = reinterpret_cast<const QRgb*>(pixels + (p / width) * bytesPerLine)[p % width];
+        } else {
+            if (x == width) {
+                x = 0;
+                ++y;
+            }
+            pixel = reinterpret_cast<const QRgb*>(pixels + y * bytesPerLine)[x++];
+        }
+
+        // Збираємо поле з каналів.
+        quint32 field = 0;
+        for (int c = 0; c < channels; ++c) {
+            field = (field << bits) | ((pixel >> PLANE_CHANNEL_SHIFTS[c]) & channelMask);
+        }
+
+        // Останнє поле може бути неповним - беремо лише старші біти.
+        const int count = int(qMin<qint64>(bitsPerPixel, bitEnd - bitIndex));
+        accumulator = (accumulator << count) | (field >> (bitsPerPixel - count));
+        accumulatorBits += count;
+        bitIndex += count;
+
+        while (accumulatorBits >= 8) {
+            accumulatorBits -= 8;
+            bytes[byteIndex++] |= uchar(accumulator >> accumulatorBits);
+        }
+    }
+
+    // Залишок неповного останнього байта.
+    if (accumulatorBits > 0) {
+        bytes[byteIndex] |= uchar(accumulator << (8 - accumulatorBits));
+    }
+}
@@ -0,0 +1,256 @@
+/*
+ * SteganographyEngine_Cipher.cpp
+ *
+ * Реалізація автентифікованого шифрування навантаження.
+ * Дані шифруються ChaCha20-Poly1305 на місці; заголовок
+ * автентифікується як додаткові дані, тому підміна довжини
+ * чи прапорців також виявляється тегом. Ключ шифру виводиться
+ * з ключа користувача scrypt з каліброваними параметрами.
+ */
+
+#include "SteganographyEngine.h"
+#include "ChaCha20Poly1305.h"
+#include "Scrypt.h"
+#include <QCryptographicHash>
+#include <QRandomGenerator>
+#include <QMutex>
+#include <QDebug>
+#include <future>
+
+/**
+ * @struct KdfCache
+ * @brief Кеш виведених ключів, спільний для всіх рушіїв процесу.
+ *
+ * Ключі запам'ятовуються за (запис KDF, SHA-256 ключа): пакетне
+ * витягування з багатьох зображень з тим самим ключем виводить
+ * його лише один раз. Запис - результат, що може ще обчислюватися:
+ * одночасні запити того самого ключа чекають на одне виведення,
+ * а м'ютекс тримається лише під час пошуку та вставки.
+ */
+struct KdfCache {
+    QMutex mutex;                                          ///< Захист карти (пакетні потоки).
+    QMap<QByteArray, std::shared_future<QByteArray>> keys; ///< Виведені ключі шифру.
+};
+
+/**
+ * @brief Кеш KDF процесу.
+ */
+static KdfCache& kdfCache() {
+    static KdfCache cache;
+    return cache;
+}
+
+/* ============================================================================
+ *                          ВИВЕДЕННЯ КЛЮЧА
+ * ============================================================================
+ */
+
+/**
+ * @brief Чи підтримується версія формату навантаження.
+ *
+ * Версія 2 відрізняється лише записом KDF у розширенні шифру,
+ * тому обидві версії читаються тим самим кодом.
+ *
+ * @param version Версія з заголовка.
+ * @return true для PAYLOAD_VERSION і PAYLOAD_KDF_VERSION.
+ */
+bool SteganographyEngine::knownVersion(quint8 version) {
+    return version == PAYLOAD_VERSION || version == PAYLOAD_KDF_VERSION;
+}
+
+/**
+ * @brief Розмір даних шифру в розширенні заголовка.
+ *
+ * @param header Заголовок навантаження.
+ * @return Nonce і тег (та запис KDF у версії 2) або 0 без FLAG_AEAD.
+ */
+int SteganographyEngine::cipherExtensionSize(const PayloadHeader& header) {
+    if (!(header.flags & FLAG_AEAD)) {
+        return 0;
+    }
+    return CIPHER_EXTENSION_SIZE + (header.version == PAYLOAD_KDF_VERSION ? KDF_RECORD_SIZE : 0);
+}
+
+/**
+ * @brief Увімкнення шифрування в заголовку.
+ *
+ * Нові навантаження завжди записуються з KDF (версія 2); розширення
+ * шифру додається до вже врахованих розширень.
+ *
+ * @param header Заголовок навантаження.
+ */
+void SteganographyEngine::addCipherLayout(PayloadHeader& header) {
+    header.version = PAYLOAD_KDF_VERSION;
+    header.flags |= FLAG_ENCRYPTED | FLAG_AEAD;
+    header.extensionSize += quint16(cipherExtensionSize(header));
+}
+
+/**
+ * @brief 256-бітовий ключ шифру з поточного ключа.
+ *
+ * Версія 1: SHA-256 ключа користувача (старі навантаження).
+ * Версія 2: scrypt з параметрами та сіллю із запису KDF.
+ *
+ * @param header Заголовок навантаження.
+ * @param extension Розширення заголовка.
+ * @return Ключ (32 байти) або порожній масив для неприпустимих параметрів KDF.
+ */
+QByteArray SteganographyEngine::cipherKey(const PayloadHeader& header, const QByteArray& extension) {
+    if (header.version != PAYLOAD_KDF_VERSION) {
+        return QCryptographicHash::hash(currentKey.toUtf8(), QCryptographicHash::Sha256);
+    }
+    return derivedKey(extension.mid(CIPHER_EXTENSION_SIZE, KDF_RECORD_SIZE));
+}
+
+/**
+ * @brief Запис KDF для нових навантажень поточного сеансу.
+ *
+ * Перший виклик калібрує N під KDF_TARGET_MS на цьому комп'ютері та
+ * генерує випадкову сіль; далі запис не змінюється, тож ключ для
+ * приховування виводиться один раз за сеанс.
+ *
+ * @return logN, r, p і сіль (KDF_RECORD_SIZE байтів).
+ */
+QByteArray SteganographyEngine::sessionKdfRecord() {
+    // Ініціалізація локальної статичної змінної потокобезпечна.
+    static const QByteArray sessionRecord = [] {
+        const Scrypt kdf = Scrypt::calibrate(KDF_TARGET_MS);
+
+        quint32 saltWords[KDF_SALT_SIZE / 4];
+        QRandomGenerator::system()->fillRange(saltWords, KDF_SALT_SIZE / 4);
+
+        QByteArray record;
+        record.append(char(kdf.logN()));
+        record.append(char(kdf.blockSize()));
+        record.append(char(kdf.parallelism()));
+        record.append(reinterpret_cast<const char*>(saltWords), KDF_SALT_SIZE);
+
+        qDebug() << "Key derivation calibrated: scrypt N = 2 ^" << kdf.logN()
+                 << "r =" << kdf.blockSize() << "p =" << kdf.parallelism()
+                 << "memory:" << kdf.memoryBytes() / (1024 * 1024) << "MB";
+        return record;
+    }();
+
+    return sessionRecord;
+}
+
+/**
+ * @brief Ключ шифру scrypt з поточного ключа.
+ *
+ * Параметри з недовіреного заголовка перевіряються до виведення.
+ * Перший запит ключа вставляє в кеш незавершений результат і виводить
+ * ключ без блокування кешу; паралельні запити того самого ключа чекають
+ * на цей результат, а запити інших ключів виводять їх одночасно.
+ *
+ * @param record Запис KDF: logN, r, p і сіль.
+ * @return Ключ (32 байти) або порожній масив для неприпустимих параметрів.
+ */
+QByteArray SteganographyEngine::derivedKey(const QByteArray& record) const {
+    if (record.size() != KDF_RECORD_SIZE) {
+        return QByteArray();
+    }
+
+    const int logN = quint8(record.at(0));
+    const int blockSize = quint8(record.at(1));
+    const int parallelism = quint8(record.at(2));
+    if (!Scrypt::isValid(logN, blockSize, parallelism)) {
+        qWarning() << "Unsupported key derivation parameters: logN" << logN
+                   << "r" << blockSize << "p" << parallelism;
+        return QByteArray();
+    }
+
+    const QByteArray password = currentKey.toUtf8();
+    const QByteArray cacheKey = record + QCryptographicHash::hash(password, QCryptographicHash::Sha256);
+
+    // ========== КРОК 1: Пошук або резервування запису ==========
+    std::promise<QByteArray> derivation;
+    std::shared_future<QByteArray> result;
+    {
+        KdfCache& cache = kdfCache();
+        QMutexLocker locker(&cache.mutex);
+
+        const auto cached = cache.keys.constFind(cacheKey);
+        if (cached != cache.keys.constEnd()) {
+            result = cached.value();
+        } else {
+            if (cache.keys.size() >= KDF_CACHE_LIMIT) {
+                cache.keys.clear();
+            }
+            result = derivation.get_future().share();
+            cache.keys.insert(cacheKey, result);
+            locker.unlock();
+
+            // ========== КРОК 2: Виведення без блокування кешу ==========
+            derivation.set_value(Scrypt(logN, blockSize, parallelism)
+                                     .derive(password, record.mid(3), ChaCha20Poly1305::KEY_SIZE));
+        }
+    }
+
+    // ========== КРОК 3: Очікування результату ==========
+    return result.get();
+}
+
+/* ============================================================================
+ *                      АВТЕНТИФІКОВАНЕ ШИФРУВАННЯ
+ * ============================================================================
+ */
+
+/**
+ * @brief Випадкове одноразове значення шифру.
+ *
+ * Nonce - 12 випадкових байтів із системного генератора, тож повторне
+ * приховування з тим самим ключем не повторює ключовий потік.
+ *
+ * @return Nonce (12 байтів).
+ */
+QByteArray SteganographyEngine::cipherNonce() {
+    quint32 nonceWords[3];
+    QRandomGenerator::system()->fillRange(nonceWords, 3);
+    return QByteArray(reinterpret_cast<const char*>(nonceWords), ChaCha20Poly1305::NONCE_SIZE);
+}
+
+/**
+ * @brief Шифрування даних ChaCha20-Poly1305 на місці.
+ *
+ * @param data Дані (замінюються шифротекстом).
+ * @param headerBytes Серіалізований заголовок (автентифікується).
+ * @return Розширення заголовка: nonce, тег і запис KDF.
+ */
+QByteArray SteganographyEngine::encryptPayload(QByteArray& data, const QByteArray& headerBytes) {
+    const QByteArray record = sessionKdfRecord();
+    const QByteArray nonce = cipherNonce();
+    const ChaCha20Poly1305 cipher(derivedKey(record));
+    const QByteArray tag = cipher.encrypt(data, nonce, headerBytes);
+
+    return nonce + tag + record;
+}
+
+/**
+ * @brief Перевірка тегу та дешифрування даних на місці.
+ *
+ * Тег перевіряється до дешифрування, тому неправильний ключ
+ * відкидається без обробки даних.
+ *
+ * @param data Шифротекст (замінюється відкритим текстом).
+ * @param header Заголовок навантаження.
+ * @param extension Розширення заголовка (nonce, тег і запис KDF).
+ * @return true якщо тег правильний.
+ */
+bool SteganographyEngine::decryptPayload(QByteArray& data, const PayloadHeader& header,
+                                         const QByteArray& extension) {
+    if (extension.size() < cipherExtensionSize(header)) {
+        qWarning() << "Cipher header extension is too short:" << extension.size();
+        return false;
+    }
+
+    const QByteArray key = cipherKey(header, extension);
+    if (key.isEmpty()) {
+        return false;
+    }
+
+    const QByteArray nonce = extension.left(ChaCha20Poly1305::NONCE_SIZE);
+    const QByteArray tag = extension.mid(ChaCha20Poly1305::NONCE_SIZE, ChaCha20Poly1305::TAG_SIZE);
+
+    const ChaCha20Poly1305 cipher(key);
+    return cipher.decrypt(data, nonce, serializeHeader(header), tag);
+}
@@ -0,0 +1,147 @@
+/*
+ * SteganographyEngine_Compression.cpp
+ *
+ * Реалізація стиснення навантаження перед вбудовуванням.
+ * Текст стискається deflate (qCompress); кодек записується в
+ * прапорці заголовка, а довжина в заголовку - це розмір стиснутих
+ * даних, тому ефективна ємність зростає пропорційно коефіцієнту стиснення.
+ */
+
+#include "SteganographyEngine.h"
+#include <QtEndian>
+#include <QDebug>
+
+/* ============================================================================
+ *                          НАЛАШТУВАННЯ РЕЖИМУ
+ * ============================================================================
+ */
+
+/**
+ * @brief Увімкнення стиснення повідомлення перед вбудовуванням.
+ * @param enabled true - стискати повідомлення.
+ */
+void SteganographyEngine::setCompressionEnabled(bool enabled) {
+    compression = enabled;
+    qDebug() << "Payload compression:" << compression;
+}
+
+/**
+ * @brief Чи увімкнено стиснення повідомлення.
+ * @return true якщо повідомлення стискаються.
+ */
+bool SteganographyEngine::isCompressionEnabled() const {
+    return compression;
+}
+
+/* ============================================================================
+ *                          СТИСНЕННЯ ДАНИХ
+ * ============================================================================
+ */
+
+/**
+ * @brief Стиснення даних навантаження (якщо увімкнене і вигідне).
+ *
+ * Короткі або вже стиснуті дані deflate може збільшити, тому стиснутий
+ * варіант використовується лише тоді, коли він менший за оригінал.
+ *
+ * @param data Дані (замінюються стиснутими).
+ * @return Кодек, яким стиснуто дані (CODEC_NONE - без змін).
+ */
+int SteganographyEngine::compressData(QByteArray& data) const {
+    if (!compression || data.isEmpty()) {
+        return CODEC_NONE;
+    }
+
+    QByteArray packed = qCompress(data, 9);
+    if (packed.size() >= data.size()) {
+        qDebug() << "Compression skipped: no gain for" << data.size() << "bytes";
+        return CODEC_NONE;
+    }
+
+    qDebug() << "Payload compressed (deflate):" << data.size() << "->" << packed.size() << "bytes";
+    data = std::move(packed);
+    return CODEC_DEFLATE;
+}
+
+/**
+ * @brief Розпакування даних навантаження.
+ *
+ * Формат qCompress починається з 4 байтів розміру (big-endian); перед
+ * розпакуванням розмір перевіряється на відповідність максимальному
+ * коефіцієнту deflate, щоб пошкоджений заголовок не спричинив
+ * виділення завеликого буфера.
+ *
+ * @param data Стиснуті дані (замінюються розпакованими).
+ * @param codec Кодек із заголовка.
+ * @return true у разі успіху.
+ */
+bool SteganographyEngine::decompressData(QByteArray& data, int codec) const {
+    if (codec == CODEC_NONE) {
+        return true;
+    }
+    if (codec != CODEC_DEFLATE) {
+        qWarning() << "Unknown payload codec:" << codec;
+        return false;
+    }
+
+    if (data.size() < 4) {
+        qWarning() << "Compressed payload is too short:" << data.size();
+        return false;
+    }
+
+    const quint32 expected = qFromBigEndian<quint32>(data.constData());
+    if (qint64(expected) > qint64(data.size()) * DEFLATE_MAX_RATIO) {
+        qWarning() << "Compressed payload declares impossible size:" << expected;
+        return false;
+    }
+
+    QByteArray unpacked = qUncompress(data);
+    if (unpacked.size() != qsizetype(expected)) {
+        qWarning() << "Failed to decompress payload!";
+        return false;
+    }
+
+    data = std::move(unpacked);
+    return true;
+}
+
+/* ============================================================================
+ *                          ЕФЕКТИВНА ЄМНІСТЬ
+ * ============================================================================
+ */
+
+/**
+ * @brief Розмір повідомлення в зображенні (після стиснення, якщо воно увімкнене).
+ *
+ * @param message Повідомлення.
+ * @return Кількість байтів даних.
+ */
+qint64 SteganographyEngine::storedMessageSize(const QString& message) const {
+    QByteArray data = message.toUtf8();
+    compressData(data);
+    return data.size();
+}
+
+/**
+ * @brief Ефективна ємність з урахуванням стиснення.
+ *
+ * Коефіцієнт стиснення залежить від тексту, тому оцінюється за зразком:
+ * для типового тексту deflate дає 2-3 рази, для короткого чи
+ * випадкового - стиснення не застосовується.
+ *
+ * @param image Зображення для аналізу.
+ * @param sample Зразок тексту.
+ * @param encrypt Чи буде повідомлення зашифроване.
+ * @return Орієнтовна кількість байтів UTF-8, які можна приховати.
+ */
+qint64 SteganographyEngine::calculateEffectiveCapacity(const QImage& image, const QString& sample,
+                                                      bool encrypt) {
+    const qint64 rawCapacity = calculateMaxCapacity(image, encrypt);
+    const qint64 sampleBytes = sample.toUtf8().size();
+    const qint64 storedBytes = storedMessageSize(sample);
+    if (storedBytes <= 0 || storedBytes >= sampleBytes) {
+        return rawCapacity;
+    }
+
+    return qint64(double(rawCapacity) * sampleBytes / storedBytes);
+}
@@ -0,0 +1,323 @@
+/*
+ * SteganographyEngine_Ecc.cpp
+ *
+ * Реалізація захищеного формату навантаження з кодом Ріда-Соломона.
+ * Звичайне навантаження "STEG" (заголовок, розширення, дані) кодується
+ * кодовими словами RS(n, n - 2t) з чергуванням байтів і записується
+ * після власного заголовка "STER", захищеного тим самим кодом. Поодинокі
+ * змінені молодші біти (редагування з збереженням палітри, шум каналу)
+ * виправляються при витягуванні, а не ламають весь формат.
+ */
+
+#include "SteganographyEngine.h"
+#include "KeyedPermutation.h"
+#include "ReedSolomon.h"
+#include <QtEndian>
+#include <QDebug>
+#include <optional>
+
+/* ============================================================================
+ *                          НАЛАШТУВАННЯ РЕЖИМУ
+ * ============================================================================
+ */
+
+/**
+ * @brief Увімкнення коду Ріда-Соломона для навантаження.
+ *
+ * Непарна кількість округлюється вгору до парної.
+ *
+ * @param paritySymbols Символів парності на кодове слово (0 - вимкнено).
+ */
+void SteganographyEngine::setErrorCorrection(int paritySymbols) {
+    if (paritySymbols <= 0) {
+        eccParity = 0;
+    } else {
+        eccParity = qBound(2, paritySymbols + (paritySymbols & 1), ReedSolomon::MAX_PARITY_SYMBOLS);
+    }
+    qDebug() << "Error correction parity symbols:" << eccParity;
+}
+
+/**
+ * @brief Кількість символів парності на кодове слово.
+ * @return 0, якщо код вимкнено.
+ */
+int SteganographyEngine::errorCorrection() const {
+    return eccParity;
+}
+
+/* ============================================================================
+ *                          ЗАГОЛОВОК ТА ЄМНІСТЬ
+ * ============================================================================
+ */
+
+/**
+ * @brief Зовнішній заголовок захищеного навантаження без довжини та CRC.
+ *
+ * Прапорці режиму (біти на канал, альфа-канал, ключовий порядок) - як у
+ * layoutHeader(); FLAG_ENCRYPTED лише повідомляє probeMessage(), що
+ * внутрішнє навантаження зашифроване. Розширення - запис коду та
+ * символи парності заголовка.
+ *
+ * @param encrypt Чи буде внутрішнє навантаження зашифроване.
+ * @return Заголовок.
+ */
+PayloadHeader SteganographyEngine::protectedLayout(bool encrypt) const {
+    const PayloadHeader inner = layoutHeader(encrypt);
+
+    PayloadHeader header;
+    header.magic = PAYLOAD_ECC_MAGIC;
+    header.version = PAYLOAD_VERSION;
+    header.flags = inner.flags & (FLAG_BITS_MASK | FLAG_ALPHA | FLAG_KEYED_ORDER | FLAG_ENCRYPTED);
+    header.extensionSize = ECC_RECORD_SIZE + ECC_HEADER_PARITY;
+    return header;
+}
+
+/**
+ * @brief Ємність захищеного навантаження для повідомлення.
+ *
+ * Найбільший розмір внутрішнього навантаження, закодований блок якого
+ * вміщується в зображення (розмір блоку монотонно зростає з розміром
+ * даних), мінус заголовок і розширення внутрішнього навантаження.
+ *
+ * @param pixels Кількість пікселів зображення.
+ * @param encrypt Чи буде повідомлення зашифроване.
+ * @return Кількість байтів даних повідомлення (може бути від'ємною).
+ */
+qint64 SteganographyEngine::protectedCapacity(qint64 pixels, bool encrypt) const {
+    const qint64 available = dataCapacity(protectedLayout(encrypt), pixels);
+    const qint64 overhead = qint64(PAYLOAD_HEADER_SIZE) + layoutHeader(encrypt).extensionSize;
+    if (available <= 0) {
+        return -overhead;
+    }
+
+    // Оцінка знизу частки даних у слові, далі - уточнення по байту.
+    qint64 inner = available * (ReedSolomon::MAX_CODEWORD - eccParity) / ReedSolomon::MAX_CODEWORD;
+    while (inner > 0 && ReedSolomon::encodedSize(inner, eccParity) > available) {
+        --inner;
+    }
+    return qMin<qint64>(inner, UINT32_MAX) - overhead;
+}
+
+/* ============================================================================
+ *                          ПРИХОВУВАННЯ
+ * ============================================================================
+ */
+
+/**
+ * @brief Приховування повідомлення із захистом кодом Ріда-Соломона.
+ *
+ * Алгоритм:
+ * 1. Формуємо звичайне навантаження (заголовок, розширення, дані).
+ * 2. Кодуємо його з чергуванням (eccParity символів на слово).
+ * 3. Заголовок "STER" і запис коду (2t, розмір навантаження) кодуємо
+ *    одним словом з ECC_HEADER_PARITY символами парності.
+ * 4. Записуємо заголовок по 1 біту на канал RGB, закодований блок -
+ *    як дані звичайного навантаження (суцільно або по пікселях).
+ *
+ * @param image Зображення RGB32 або ARGB32 (модифікується).
+ * @param message Повідомлення.
+ * @param encrypt Чи потрібно шифрувати.
+ * @return Модифіковане зображення або пусте зображення у разі помилки.
+ */
+QImage SteganographyEngine::hideProtectedMessage(QImage& image, const QString& message,
+                                                 bool encrypt) {
+    if (matrixEmbedding) {
+        qWarning() << "Error correction is not supported with matrix embedding!";
+        return QImage();
+    }
+
+    // ========== КРОКИ 1-2: Навантаження та кодування ==========
+    const QByteArray payload = buildPayload(message, encrypt);
+    const QByteArray encoded = ReedSolomon::encodeInterleaved(payload, eccParity);
+
+    PayloadHeader header = protectedLayout(encrypt);
+    header.length = quint32(encoded.size());
+    header.crc = calculateCRC32(payload);
+
+    const qint64 totalPixels = qint64(image.width()) * image.height();
+    const qint64 capacity = dataCapacity(header, totalPixels);
+    qDebug() << "Protected payload:" << payload.size() << "->" << encoded.size()
+             << "bytes, parity symbols:" << eccParity << "available:" << capacity;
+
+    if (encoded.size() > capacity) {
+        qWarning() << "Message too long for this image!";
+        qWarning() << "Required:" << encoded.size() << "Available:" << capacity;
+        return QImage();
+    }
+
+    // ========== КРОК 3: Захищений заголовок ==========
+    QByteArray record(ECC_RECORD_SIZE, '\0');
+    uchar* r = reinterpret_cast<uchar*>(record.data());
+    r[0] = uchar(eccParity);
+    qToBigEndian<quint32>(quint32(payload.size()), r + 1);
+
+    const QByteArray headerBlock =
+        ReedSolomon::encodeInterleaved(serializeHeader(header) + record, ECC_HEADER_PARITY);
+
+    // ========== КРОК 4: Запис ==========
+    int bits = 1;
+    int channels = 3;
+    beginProgress(qint64(headerBlock.size() + encoded.size()) * 8);
+
+    if (!planeLayout(header, bits, channels)) {
+        embedBytes(image, headerBlock + encoded);
+    } else {
+        const qint64 firstPixel = dataStartPixel(header);
+
+        std::optional<KeyedPermutation> order;
+        if (header.flags & FLAG_KEYED_ORDER) {
+            order.emplace(currentKey, quint64(totalPixels - firstPixel));
+        }
+
+        embedBytes(image, headerBlock);
+        embedPlanes(image, firstPixel, encoded, bits, channels, order ? &*order : nullptr);
+    }
+
+    const bool cancelled = isCancelled();
+    endProgress();
+    if (cancelled) {
+        qWarning() << "Hiding cancelled";
+        return QImage();
+    }
+
+    qDebug() << "Total bytes hidden:" << headerBlock.size() + encoded.size();
+    qDebug() << "Hiding completed successfully";
+
+    return image;
+}
+
+/* ============================================================================
+ *                          ВИТЯГУВАННЯ
+ * ============================================================================
+ */
+
+/**
+ * @brief Зчитування та виправлення захищеного заголовка.
+ *
+ * Заголовок і запис коду зчитуються разом із символами парності
+ * (ECC_HEADER_PARITY / 2 помилкових байтів виправляються), після чого
+ * перевіряються сигнатура, версія, параметри коду та що закодований
+ * блок вміщується в зображення.
+ *
+ * @param image Зображення RGB32 або ARGB32.
+ * @param header Зовнішній заголовок (вихідний параметр).
+ * @param paritySymbols Символів парності на слово (вихідний параметр).
+ * @param payloadSize Розмір внутрішнього навантаження (вихідний параметр).
+ * @return true якщо зображення містить захищене навантаження.
+ */
+bool SteganographyEngine::readProtectedHeader(const QImage& image, PayloadHeader& header,
+                                              int& paritySymbols, qint64& payloadSize) {
+    const qint64 totalPixels = qint64(image.width()) * image.height();
+    const qint64 blockSize = ReedSolomon::encodedSize(PAYLOAD_HEADER_SIZE + ECC_RECORD_SIZE,
+                                                      ECC_HEADER_PARITY);
+    if (totalPixels * 3 / 8 < blockSize) {
+        return false;
+    }
+
+    QByteArray block = extractBytes(image, 0, blockSize);
+    const int corrected = ReedSolomon::decodeInterleaved(block, PAYLOAD_HEADER_SIZE + ECC_RECORD_SIZE,
+                                                         ECC_HEADER_PARITY);
+    if (corrected < 0) {
+        return false;
+    }
+
+    header = parseHeader(block);
+    if (header.magic != PAYLOAD_ECC_MAGIC || !knownVersion(header.version) ||
+        header.extensionSize != ECC_RECORD_SIZE + ECC_HEADER_PARITY) {
+        return false;
+    }
+
+    const uchar* r = reinterpret_cast<const uchar*>(block.constData()) + PAYLOAD_HEADER_SIZE;
+    paritySymbols = r[0];
+    payloadSize = qFromBigEndian<quint32>(r + 1);
+
+    const qsizetype encodedSize = ReedSolomon::encodedSize(payloadSize, paritySymbols);
+    if (payloadSize < PAYLOAD_HEADER_SIZE || encodedSize == 0 || encodedSize != header.length) {
+        return false;
+    }
+
+    if (corrected > 0) {
+        qDebug() << "Protected header: corrected" << corrected << "bytes";
+    }
+    return payloadFits(header, totalPixels);
+}
+
+/**
+ * @brief Витягування повідомлення із захищеного навантаження.
+ *
+ * Алгоритм:
+ * 1. Зчитуємо закодований блок (суцільно або по пікселях).
+ * 2. Виправляємо помилки кодом Ріда-Соломона.
+ * 3. Перевіряємо CRC-32 навантаження та розбираємо його заголовок.
+ * 4. Дешифруємо та декодуємо дані (decodePayload()).
+ *
+ * @param image Зображення RGB32 або ARGB32.
+ * @param header Зовнішній заголовок.
+ * @param paritySymbols Символів парності на слово.
+ * @param payloadSize Розмір внутрішнього навантаження.
+ * @param decrypt Чи дозволено дешифрування.
+ * @return Повідомлення або NOT_FOUND_MESSAGE.
+ */
+QString SteganographyEngine::extractProtectedMessage(const QImage& image, const PayloadHeader& header,
+                                                     int paritySymbols, qint64 payloadSize,
+                                                     bool decrypt) {
+    // ========== КРОК 1: Закодований блок ==========
+    int bits = 1;
+    int channels = 3;
+    QByteArray block;
+    beginProgress(qint64(header.length) * 8);
+
+    if (!planeLayout(header, bits, channels)) {
+        block = extractBytes(image, PAYLOAD_HEADER_SIZE + header.extensionSize, header.length);
+    } else {
+        const qint64 firstPixel = dataStartPixel(header);
+        const qint64 totalPixels = qint64(image.width()) * image.height();
+
+        std::optional<KeyedPermutation> order;
+        if (header.flags & FLAG_KEYED_ORDER) {
+            if (currentKey.isEmpty()) {
+                endProgress();
+                qWarning() << "Payload uses keyed pixel order, but no key was provided!";
+                return NOT_FOUND_MESSAGE;
+            }
+            order.emplace(currentKey, quint64(totalPixels - firstPixel));
+        }
+
+        block = extractPlanes(image, firstPixel, header.length, bits, channels,
+                              order ? &*order : nullptr);
+    }
+
+    const bool cancelled = isCancelled();
+    endProgress();
+    if (cancelled) {
+        qWarning() << "Extraction cancelled";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    // ========== КРОК 2: Виправлення помилок ==========
+    const int corrected = ReedSolomon::decodeInterleaved(block, payloadSize, paritySymbols);
+    if (corrected < 0) {
+        qWarning() << "Too many errors: payload cannot be corrected!";
+        return NOT_FOUND_MESSAGE;
+    }
+    qDebug() << "Reed-Solomon: corrected" << corrected << "bytes";
+
+    // ========== КРОК 3: Навантаження ==========
+    block.truncate(payloadSize);
+    if (calculateCRC32(block) != header.crc) {
+        qWarning() << "CRC mismatch: payload corrupted beyond correction!";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    const PayloadHeader inner = parseHeader(block);
+    if (inner.magic != PAYLOAD_MAGIC || !knownVersion(inner.version) ||
+        qint64(PAYLOAD_HEADER_SIZE) + inner.extensionSize + inner.length != payloadSize) {
+        qWarning() << "Invalid protected payload header!";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    // ========== КРОК 4: Дешифруємо та декодуємо ==========
+    const QByteArray extension = block.mid(PAYLOAD_HEADER_SIZE, inner.extensionSize);
+    return decodePayload(inner, extension, block.mid(PAYLOAD_HEADER_SIZE + inner.extensionSize),
+                         decrypt);
+}
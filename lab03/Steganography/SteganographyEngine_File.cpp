@@ -0,0 +1,687 @@
+/*
+ * SteganographyEngine_File.cpp
+ *
+ * Реалізація приховування довільних файлів.
+ * Файл проходить фрагментами через стиснення, шифрування та ядро
+ * вбудовування, а при витягуванні - у зворотному порядку одразу
+ * у вихідний файл. Пам'ять обмежена кількома фрагментами і не
+ * залежить від розміру файлу.
+ */
+
+#include "SteganographyEngine.h"
+#include "ChaCha20Poly1305.h"
+#include "KeyedPermutation.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QtEndian>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <zlib.h>
+
+/* ============================================================================
+ *                      МЕТОДИ ПРИХОВУВАННЯ ФАЙЛІВ
+ * ============================================================================
+ */
+
+/**
+ * @brief Приховування довільного файлу в зображенні.
+ *
+ * Алгоритм:
+ * 1. Формуємо запис файлу (розмір, ім'я) та заголовок без довжини і CRC.
+ * 2. Стискаємо пробно перший фрагмент: якщо deflate не зменшує його,
+ *    файл записується без стиснення.
+ * 3. Для кожного фрагмента файлу:
+ *    - оновлюємо CRC-32 відкритих даних;
+ *    - (опціонально) стискаємо потоком zlib у буфер фрагмента;
+ *    - заповнений буфер шифруємо ChaCha20 і одразу записуємо в пікселі.
+ * 4. Записуємо заголовок (довжина, CRC) і розширення (nonce, тег, запис файлу).
+ *
+ * Довжина і CRC відомі лише в кінці, тому Poly1305 автентифікує заголовок
+ * без них: довжину шифротексту Poly1305 включає сам, а CRC перевіряється
+ * після дешифрування. Матричне вбудовування не підтримується: параметр
+ * коду залежить від розміру даних, що до кінця стиснення невідомий.
+ *
+ * @param image Вхідне зображення (оригінал).
+ * @param inputPath Шлях до файлу для приховування.
+ * @param encrypt Чи потрібно шифрувати файл.
+ * @return Модифіковане зображення або пусте зображення у разі помилки.
+ */
+QImage SteganographyEngine::hideFile(const QImage& image, const QString& inputPath, bool encrypt) {
+    if (image.isNull()) {
+        qWarning() << "Empty image!";
+        return QImage();
+    }
+
+    if (matrixEmbedding) {
+        qWarning() << "Matrix embedding is not supported for file payloads!";
+        return QImage();
+    }
+
+    QFile input(inputPath);
+    if (!input.open(QIODevice::ReadOnly)) {
+        qWarning() << "Cannot open file:" << inputPath << input.errorString();
+        return QImage();
+    }
+    const qint64 fileSize = input.size();
+
+    QImage resultImage = image.convertToFormat(alphaPlane ? QImage::Format_ARGB32
+                                                          : QImage::Format_RGB32);
+    const qint64 totalPixels = qint64(resultImage.width()) * resultImage.height();
+
+    // ========== КРОК 1: Запис файлу та заголовок ==========
+    QString fileName = QFileInfo(inputPath).fileName();
+    QByteArray name = fileName.toUtf8();
+    while (name.size() > MAX_FILE_NAME_BYTES) {
+        fileName.chop(1);
+        name = fileName.toUtf8();
+    }
+
+    QByteArray record(FILE_RECORD_SIZE, '\0');
+    qToBigEndian<quint64>(quint64(fileSize), record.data());
+    qToBigEndian<quint16>(quint16(name.size()), record.data() + 8);
+    record += name;
+
+    PayloadHeader header = layoutHeader(encrypt);
+    header.magic = PAYLOAD_FILE_MAGIC;
+    header.extensionSize += quint16(record.size());
+
+    // Довжина даних у заголовку - 32-бітова.
+    const qint64 capacity = qMin<qint64>(dataCapacity(header, totalPixels), 0xFFFFFFFFll);
+    qDebug() << "File:" << inputPath << fileSize << "bytes, available:" << capacity
+             << "bits per channel:" << planeBits << "alpha:" << alphaPlane;
+
+    if (capacity <= 0 || (!compression && fileSize > capacity)) {
+        qWarning() << "File too large for this image!";
+        qWarning() << "Required:" << fileSize << "Available:" << capacity;
+        return QImage();
+    }
+
+    // ========== КРОК 2: Пробне стиснення першого фрагмента ==========
+    // Фрагмент - ціле число пікселів даних і блоків ChaCha20.
+    int bits = 1;
+    int channels = 3;
+    planeLayout(header, bits, channels);
+    const qint64 chunkBytes = qint64(bits) * channels * FILE_CHUNK_UNIT;
+
+    QByteArray block(chunkBytes, Qt::Uninitialized);
+    qint64 blockSize = input.read(block.data(), chunkBytes);
+
+    bool deflating = false;
+    if (compression && blockSize > 0) {
+        uLongf packedSize = compressBound(uLong(blockSize));
+        QByteArray packed(qsizetype(packedSize), Qt::Uninitialized);
+        deflating = compress2(reinterpret_cast<Bytef*>(packed.data()), &packedSize,
+                              reinterpret_cast<const Bytef*>(block.constData()), uLong(blockSize),
+                              FILE_DEFLATE_LEVEL) == Z_OK &&
+                    qint64(packedSize) < blockSize;
+        if (!deflating) {
+            qDebug() << "Compression skipped: no gain on the first" << blockSize << "bytes";
+        }
+    }
+
+    if (deflating) {
+        header.flags |= quint8(CODEC_DEFLATE << FLAG_CODEC_SHIFT);
+    } else if (fileSize > capacity) {
+        qWarning() << "File too large for this image!";
+        qWarning() << "Required:" << fileSize << "Available:" << capacity;
+        return QImage();
+    }
+
+    // ========== КРОК 3: Шифр і порядок пікселів ==========
+    std::optional<ChaCha20Poly1305::Stream> cipherStream;
+    QByteArray nonce;
+    QByteArray kdfRecord;
+    if (header.flags & FLAG_ENCRYPTED) {
+        nonce = cipherNonce();
+        kdfRecord = sessionKdfRecord();
+        cipherStream.emplace(ChaCha20Poly1305(derivedKey(kdfRecord)), nonce,
+                             serializeHeader(header) + record);
+        qDebug() << "File encrypted (ChaCha20-Poly1305)";
+    }
+
+    std::optional<KeyedPermutation> order;
+    if (header.flags & FLAG_KEYED_ORDER) {
+        order.emplace(currentKey, quint64(totalPixels - dataStartPixel(header)));
+    }
+    const KeyedPermutation* pixelOrder = order ? &*order : nullptr;
+
+    z_stream deflater;
+    std::memset(&deflater, 0, sizeof(deflater));
+    if (deflating && deflateInit(&deflater, FILE_DEFLATE_LEVEL) != Z_OK) {
+        qWarning() << "Cannot initialize zlib";
+        return QImage();
+    }
+
+    // ========== КРОК 4: Фрагменти файлу ==========
+    QByteArray staging(chunkBytes, Qt::Uninitialized);
+    uchar* stagingData = reinterpret_cast<uchar*>(staging.data());
+    qint64 stagingSize = 0;
+    qint64 stored = 0;
+    qint64 processed = 0;
+    uLong crc = crc32(0L, Z_NULL, 0);
+    bool ok = true;
+
+    // Заповнений буфер шифруємо та записуємо в пікселі.
+    const auto flush = [&]() {
+        if (stored + stagingSize > capacity) {
+            qWarning() << "File too large for this image!";
+            qWarning() << "Stored:" << stored + stagingSize << "Available:" << capacity;
+            return false;
+        }
+        if (cipherStream) {
+            cipherStream->encrypt(stagingData, stagingSize);
+        }
+        embedFileChunk(resultImage, header, stagingData, stored, stagingSize, pixelOrder);
+        stored += stagingSize;
+        stagingSize = 0;
+        return true;
+    };
+
+    // Стиснення просто в буфер фрагмента (без проміжного буфера).
+    const auto deflateBlock = [&](const char* data, qint64 size, int mode) {
+        deflater.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+        deflater.avail_in = uInt(size);
+        for (;;) {
+            deflater.next_out = stagingData + stagingSize;
+            deflater.avail_out = uInt(chunkBytes - stagingSize);
+            const int status = deflate(&deflater, mode);
+            stagingSize = chunkBytes - deflater.avail_out;
+
+            if (status == Z_STREAM_ERROR) {
+                qWarning() << "Compression failed";
+                return false;
+            }
+            if (stagingSize == chunkBytes) {
+                if (!flush()) {
+                    return false;
+                }
+                continue;
+            }
+            if (mode != Z_FINISH || status == Z_STREAM_END) {
+                return true;
+            }
+        }
+    };
+
+    while (ok && blockSize > 0) {
+        if (isCancelled()) {
+            qWarning() << "Hiding cancelled";
+            ok = false;
+            break;
+        }
+
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(block.constData()), uInt(blockSize));
+        processed += blockSize;
+
+        if (deflating) {
+            ok = deflateBlock(block.constData(), blockSize, Z_NO_FLUSH);
+        } else {
+            for (qint64 copied = 0; ok && copied < blockSize;) {
+                const qint64 count = qMin(blockSize - copied, chunkBytes - stagingSize);
+                std::memcpy(stagingData + stagingSize, block.constData() + copied, size_t(count));
+                stagingSize += count;
+                copied += count;
+                if (stagingSize == chunkBytes) {
+                    ok = flush();
+                }
+            }
+        }
+
+        if (progressHandler) {
+            progressHandler(processed, fileSize);
+        }
+        blockSize = input.read(block.data(), chunkBytes);
+    }
+
+    if (ok && blockSize < 0) {
+        qWarning() << "Cannot read file:" << inputPath << input.errorString();
+        ok = false;
+    }
+    if (ok && processed != fileSize) {
+        qWarning() << "File changed while reading:" << inputPath;
+        ok = false;
+    }
+    if (ok && deflating) {
+        ok = deflateBlock(nullptr, 0, Z_FINISH);
+    }
+    if (ok && stagingSize > 0) {
+        ok = flush();
+    }
+    if (deflating) {
+        deflateEnd(&deflater);
+    }
+
+    endProgress();
+    if (!ok) {
+        return QImage();
+    }
+
+    // ========== КРОК 5: Заголовок і розширення ==========
+    header.length = quint32(stored);
+    header.crc = quint32(crc);
+
+    QByteArray extension;
+    if (cipherStream) {
+        extension = nonce + cipherStream->finish() + kdfRecord;
+    }
+    extension += record;
+    embedBytes(resultImage, serializeHeader(header) + extension);
+
+    qDebug() << "File hidden:" << fileName << fileSize << "bytes, stored:" << stored << "bytes";
+    qDebug() << "Hiding completed successfully";
+
+    return resultImage;
+}
+
+/**
+ * @brief Витягування прихованого файлу в каталог.
+ *
+ * Алгоритм:
+ * 1. Зчитуємо заголовок і запис файлу (ім'я, розмір).
+ * 2. Відкриваємо тимчасовий вихідний файл (QSaveFile).
+ * 3. Для кожного фрагмента даних:
+ *    - зчитуємо фрагмент з пікселів;
+ *    - (опціонально) автентифікуємо та дешифруємо його;
+ *    - (опціонально) розпаковуємо і дописуємо у файл.
+ * 4. Перевіряємо тег, CRC-32 і розмір; лише тоді файл з'являється
+ *    під своїм ім'ям, інакше тимчасовий файл видаляється.
+ *
+ * З імені файлу береться лише остання складова шляху, тож записане
+ * ім'я не може вказувати за межі каталогу.
+ *
+ * @param image Зображення з прихованим файлом.
+ * @param outputDirectory Каталог для запису файлу.
+ * @param decrypt Чи потрібно розшифрувати файл.
+ * @return Шлях до записаного файлу або порожній рядок у разі помилки.
+ */
+QString SteganographyEngine::extractFile(const QImage& image, const QString& outputDirectory,
+                                         bool decrypt) {
+    if (image.isNull()) {
+        qWarning() << "Empty image!";
+        return QString();
+    }
+
+    QImage workImage = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32
+                                                                     : QImage::Format_RGB32);
+
+    // ========== КРОК 1: Заголовок і запис файлу ==========
+    PayloadHeader header;
+    QByteArray extension;
+    QString fileName;
+    qint64 fileSize = 0;
+    if (!readFileHeader(workImage, header, extension, fileName, fileSize)) {
+        qWarning() << "Hidden file not found";
+        return QString();
+    }
+
+    qDebug() << "Hidden file found:" << fileName << fileSize << "bytes, stored:"
+             << header.length << "bytes, flags:" << header.flags;
+
+    const bool encrypted = header.flags & FLAG_ENCRYPTED;
+    if (encrypted && (!decrypt || currentKey.isEmpty())) {
+        qWarning() << "Payload is encrypted, but no key was provided!";
+        return QString();
+    }
+    if (encrypted && !(header.flags & FLAG_AEAD)) {
+        qWarning() << "Unsupported cipher in the file payload header!";
+        return QString();
+    }
+
+    const int codec = (header.flags & FLAG_CODEC_MASK) >> FLAG_CODEC_SHIFT;
+    if (codec != CODEC_NONE && codec != CODEC_DEFLATE) {
+        qWarning() << "Unsupported compression codec:" << codec;
+        return QString();
+    }
+
+    if ((header.flags & FLAG_KEYED_ORDER) && currentKey.isEmpty()) {
+        qWarning() << "Payload uses keyed pixel order, but no key was provided!";
+        return QString();
+    }
+
+    // ========== КРОК 2: Вихідний файл ==========
+    QString safeName = QFileInfo(QString(fileName).replace('\\', '/')).fileName();
+    if (safeName.isEmpty() || safeName == "." || safeName == "..") {
+        safeName = DEFAULT_FILE_NAME;
+    }
+    const QString outputPath = QDir(outputDirectory).filePath(safeName);
+
+    QSaveFile output(outputPath);
+    if (!output.open(QIODevice::WriteOnly)) {
+        qWarning() << "Cannot create file:" << outputPath << output.errorString();
+        return QString();
+    }
+
+    std::optional<ChaCha20Poly1305::Stream> cipherStream;
+    if (encrypted) {
+        const QByteArray key = cipherKey(header, extension);
+        if (key.isEmpty()) {
+            return QString();
+        }
+
+        // Та сама автентифікована частина, що й при приховуванні: без довжини та CRC.
+        PayloadHeader aadHeader = header;
+        aadHeader.length = 0;
+        aadHeader.crc = 0;
+        cipherStream.emplace(ChaCha20Poly1305(key),
+                             extension.left(ChaCha20Poly1305::NONCE_SIZE),
+                             serializeHeader(aadHeader) + extension.mid(cipherExtensionSize(header)));
+    }
+
+    const qint64 totalPixels = qint64(workImage.width()) * workImage.height();
+    std::optional<KeyedPermutation> order;
+    if (header.flags & FLAG_KEYED_ORDER) {
+        order.emplace(currentKey, quint64(totalPixels - dataStartPixel(header)));
+    }
+    const KeyedPermutation* pixelOrder = order ? &*order : nullptr;
+
+    const bool deflating = codec == CODEC_DEFLATE;
+    z_stream inflater;
+    std::memset(&inflater, 0, sizeof(inflater));
+    if (deflating && inflateInit(&inflater) != Z_OK) {
+        qWarning() << "Cannot initialize zlib";
+        return QString();
+    }
+
+    // ========== КРОК 3: Фрагменти даних ==========
+    int bits = 1;
+    int channels = 3;
+    planeLayout(header, bits, channels);
+    const qint64 chunkBytes = qint64(bits) * channels * FILE_CHUNK_UNIT;
+
+    QByteArray staging(chunkBytes, Qt::Uninitialized);
+    uchar* stagingData = reinterpret_cast<uchar*>(staging.data());
+    QByteArray inflated(deflating ? chunkBytes : 0, Qt::Uninitialized);
+    uchar* inflatedData = reinterpret_cast<uchar*>(inflated.data());
+
+    qint64 written = 0;
+    uLong crc = crc32(0L, Z_NULL, 0);
+    bool streamEnd = !deflating;
+    bool ok = true;
+
+    // Розмір із запису файлу обмежує вихід (захист від завеликого розпакування).
+    const auto writeOut = [&](const uchar* data, qint64 size) {
+        if (written + size > fileSize) {
+            qWarning() << "Hidden file is larger than its recorded size!";
+            return false;
+        }
+        crc = crc32(crc, data, uInt(size));
+        written += size;
+        if (output.write(reinterpret_cast<const char*>(data), size) != size) {
+            qWarning() << "Cannot write file:" << outputPath << output.errorString();
+            return false;
+        }
+        return true;
+    };
+
+    for (qint64 offset = 0; ok && offset < qint64(header.length); offset += chunkBytes) {
+        if (isCancelled()) {
+            qWarning() << "Extraction cancelled";
+            ok = false;
+            break;
+        }
+
+        const qint64 size = qMin<qint64>(chunkBytes, qint64(header.length) - offset);
+        std::memset(stagingData, 0, size_t(size));
+        extractFileChunk(workImage, header, stagingData, offset, size, pixelOrder);
+
+        if (cipherStream) {
+            cipherStream->decrypt(stagingData, size);
+        }
+
+        if (!deflating) {
+            ok = writeOut(stagingData, size);
+        } else if (streamEnd) {
+            qWarning() << "Unexpected data after the compressed stream!";
+            ok = false;
+        } else {
+            inflater.next_in = stagingData;
+            inflater.avail_in = uInt(size);
+            do {
+                inflater.next_out = inflatedData;
+                inflater.avail_out = uInt(chunkBytes);
+                const int status = inflate(&inflater, Z_NO_FLUSH);
+                if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+                    qWarning() << "Corrupted compressed data: wrong key or corrupted payload!";
+                    ok = false;
+                    break;
+                }
+
+                const qint64 produced = chunkBytes - inflater.avail_out;
+                ok = writeOut(inflatedData, produced);
+                if (status == Z_STREAM_END) {
+                    streamEnd = true;
+                    if (inflater.avail_in > 0) {
+                        qWarning() << "Unexpected data after the compressed stream!";
+                        ok = false;
+                    }
+                    break;
+                }
+                if (status == Z_BUF_ERROR && produced == 0) {
+                    break;
+                }
+            } while (ok && (inflater.avail_in > 0 || inflater.avail_out == 0));
+        }
+
+        if (progressHandler) {
+            progressHandler(offset + size, header.length);
+        }
+    }
+
+    if (deflating) {
+        inflateEnd(&inflater);
+    }
+
+    // ========== КРОК 4: Перевірка та збереження ==========
+    if (ok && cipherStream &&
+        !cipherStream->verify(extension.mid(ChaCha20Poly1305::NONCE_SIZE,
+                                            ChaCha20Poly1305::TAG_SIZE))) {
+        qWarning() << "Authentication failed: wrong key or corrupted payload!";
+        ok = false;
+    }
+    if (ok && !streamEnd) {
+        qWarning() << "Compressed stream is truncated!";
+        ok = false;
+    }
+    if (ok && (written != fileSize || quint32(crc) != header.crc)) {
+        qWarning() << "CRC mismatch: wrong key or corrupted payload!";
+        ok = false;
+    }
+
+    endProgress();
+    if (!ok) {
+        output.cancelWriting();
+        return QString();
+    }
+
+    if (!output.commit()) {
+        qWarning() << "Cannot save file:" << outputPath << output.errorString();
+        return QString();
+    }
+
+    qDebug() << "File extracted successfully:" << outputPath << written << "bytes";
+
+    return outputPath;
+}
+
+/**
+ * @brief Ім'я та розмір прихованого файлу без витягування даних.
+ *
+ * Зчитуються лише заголовок і розширення.
+ *
+ * @param image Зображення для перевірки.
+ * @param fileName Оригінальне ім'я файлу (вихідний параметр, необов'язковий).
+ * @param fileSize Оригінальний розмір файлу (вихідний параметр, необов'язковий).
+ * @return true якщо зображення містить прихований файл.
+ */
+bool SteganographyEngine::hiddenFileInfo(const QImage& image, QString* fileName, qint64* fileSize) {
+    if (image.isNull()) {
+        return false;
+    }
+
+    const QImage workImage = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32
+                                                                           : QImage::Format_RGB32);
+
+    PayloadHeader header;
+    QByteArray extension;
+    QString name;
+    qint64 size = 0;
+    if (!readFileHeader(workImage, header, extension, name, size)) {
+        return false;
+    }
+
+    if (fileName) {
+        *fileName = name;
+    }
+    if (fileSize) {
+        *fileSize = size;
+    }
+    return true;
+}
+
+/* ============================================================================
+ *                      ЗАГОЛОВОК І ФРАГМЕНТИ ДАНИХ
+ * ============================================================================
+ */
+
+/**
+ * @brief Зчитування та перевірка заголовка прихованого файлу.
+ *
+ * Розширення: [дані шифру, якщо дані зашифровані] + запис файлу
+ * (розмір u64, довжина імені u16, ім'я UTF-8). Розмір розширення має
+ * точно збігатися з довжиною запису.
+ *
+ * @param image Зображення RGB32 або ARGB32.
+ * @param header Заголовок навантаження (вихідний параметр).
+ * @param extension Розширення заголовка (вихідний параметр).
+ * @param fileName Оригінальне ім'я файлу (вихідний параметр).
+ * @param fileSize Оригінальний розмір файлу (вихідний параметр).
+ * @return true якщо заголовок файлу коректний.
+ */
+bool SteganographyEngine::readFileHeader(const QImage& image, PayloadHeader& header,
+                                         QByteArray& extension, QString& fileName,
+                                         qint64& fileSize) {
+    const qint64 pixels = qint64(image.width()) * image.height();
+    if (pixels * 3 / 8 < PAYLOAD_HEADER_SIZE) {
+        return false;
+    }
+
+    header = parseHeader(extractBytes(image, 0, PAYLOAD_HEADER_SIZE));
+    if (header.magic != PAYLOAD_FILE_MAGIC || !knownVersion(header.version) ||
+        !payloadFits(header, pixels)) {
+        return false;
+    }
+
+    const int cipherSize = cipherExtensionSize(header);
+    if (header.extensionSize < cipherSize + FILE_RECORD_SIZE) {
+        return false;
+    }
+
+    extension = extractBytes(image, PAYLOAD_HEADER_SIZE, header.extensionSize);
+    const uchar* record = reinterpret_cast<const uchar*>(extension.constData()) + cipherSize;
+    const quint64 size = qFromBigEndian<quint64>(record);
+    const int nameLength = qFromBigEndian<quint16>(record + 8);
+
+    if (cipherSize + FILE_RECORD_SIZE + nameLength != header.extensionSize ||
+        size > quint64(std::numeric_limits<qint64>::max())) {
+        return false;
+    }
+
+    fileName = QString::fromUtf8(extension.mid(cipherSize + FILE_RECORD_SIZE, nameLength));
+    fileSize = qint64(size);
+    return true;
+}
+
+/**
+ * @brief Запис фрагмента даних файлу в пікселі.
+ *
+ * Байт i фрагмента - байт offset + i даних навантаження, тож розміщення
+ * те саме, що й при записі всіх даних одразу:
+ * - суцільний потік бітів: біти носія з (16 + розширення + offset) × 8;
+ * - бітові площини: ядро з глобальними номерами бітів (і ключова
+ *   перестановка - з глобальними номерами пікселів).
+ *
+ * У потоці бітів фрагмент може починатися всередині піксела. Перші біти
+ * до межі піксела записуються в поточному потоці, а решта ділиться
+ * на смуги з цілих пікселів, щоб паралельні смуги не писали в один піксель.
+ *
+ * @param image Зображення RGB32 або ARGB32 (модифікується).
+ * @param header Заголовок навантаження (режим розміщення).
+ * @param chunk Байти фрагмента.
+ * @param offset Номер першого байта фрагмента в даних.
+ * @param size Розмір фрагмента.
+ * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+ */
+void SteganographyEngine::embedFileChunk(QImage& image, const PayloadHeader& header,
+                                         const uchar* chunk, qint64 offset, qint64 size,
+                                         const KeyedPermutation* order) {
+    uchar* pixels = image.bits();
+    const qsizetype bytesPerLine = image.bytesPerLine();
+    const int width = image.width();
+
+    int bits = 1;
+    int channels = 3;
+    if (!planeLayout(header, bits, channels)) {
+        const qint64 carrierOffset = (qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize + offset) * 8;
+        const qint64 lead = qMin(size * 8, (3 - carrierOffset % 3) % 3);
+        embedBitRange(pixels, bytesPerLine, width, carrierOffset, chunk, 0, lead);
+
+        runBands(size * 8 - lead, BAND_ALIGN_BITS, PARALLEL_MIN_BITS,
+                 [=](qint64 begin, qint64 end) {
+            embedBitRange(pixels, bytesPerLine, width, carrierOffset, chunk, lead + begin, lead + end);
+        });
+        return;
+    }
+
+    const qint64 firstPixel = dataStartPixel(header);
+    const qint64 bitBase = offset * 8;
+    runBands(size * 8, std::lcm(qint64(bits) * channels, qint64(8)), PARALLEL_MIN_BITS,
+             [=](qint64 begin, qint64 end) {
+        embedPlaneRange(pixels, bytesPerLine, width, firstPixel, chunk,
+                        bitBase + begin, bitBase + end, bits, channels, order, offset);
+    });
+}
+
+/**
+ * @brief Зчитування фрагмента даних файлу з пікселів.
+ *
+ * Смуги потоку бітів вирівняні на цілі байти фрагмента, тому
+ * паралельні смуги не об'єднують біти в один байт.
+ *
+ * @param image Зображення RGB32 або ARGB32.
+ * @param header Заголовок навантаження (режим розміщення).
+ * @param chunk Вихідні байти (заповнені нулями).
+ * @param offset Номер першого байта фрагмента в даних.
+ * @param size Розмір фрагмента.
+ * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+ */
+void SteganographyEngine::extractFileChunk(const QImage& image, const PayloadHeader& header,
+                                           uchar* chunk, qint64 offset, qint64 size,
+                                           const KeyedPermutation* order) {
+    const uchar* pixels = image.constBits();
+    const qsizetype bytesPerLine = image.bytesPerLine();
+    const int width = image.width();
+
+    int bits = 1;
+    int channels = 3;
+    if (!planeLayout(header, bits, channels)) {
+        const qint64 carrierOffset = (qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize + offset) * 8;
+        runBands(size * 8, BAND_ALIGN_BITS, PARALLEL_MIN_BITS,
+                 [=](qint64 begin, qint64 end) {
+            extractBitRange(pixels, bytesPerLine, width, carrierOffset, chunk, begin, end);
+        });
+        return;
+    }
+
+    const qint64 firstPixel = dataStartPixel(header);
+    const qint64 bitBase = offset * 8;
+    runBands(size * 8, std::lcm(qint64(bits) * channels, qint64(8)), PARALLEL_MIN_BITS,
+             [=](qint64 begin, qint64 end) {
+        extractPlaneRange(pixels, bytesPerLine, width, firstPixel, chunk,
+                          bitBase + begin, bitBase + end, bits, channels, order, offset);
+    });
+}
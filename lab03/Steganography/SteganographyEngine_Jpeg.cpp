@@ -0,0 +1,420 @@
+/*
+ * SteganographyEngine_Jpeg.cpp
+ *
+ * Реалізація приховування повідомлень у коефіцієнтах DCT файлів JPEG.
+ * Коефіцієнти зчитуються та записуються без декодування в пікселі
+ * і без повторного квантування, тому повідомлення не руйнується
+ * збереженням у JPEG (на відміну від молодших бітів пікселів).
+ */
+
+#include "SteganographyEngine.h"
+#include "JpegCoefficients.h"
+#include "KeyedPermutation.h"
+#include <QDebug>
+#include <optional>
+
+/// Кількість AC-коефіцієнтів у блоці 8×8 (усі, крім DC).
+static const int AC_PER_BLOCK = JpegCoefficients::BLOCK_COEFFICIENTS - 1;
+
+/// Кількість байтів навантаження між оновленнями прогресу.
+static const qint64 JPEG_CHUNK_BYTES = 4096;
+
+/* ============================================================================
+ *                      ПОТІК БІТІВ У КОЕФІЦІЄНТАХ DCT
+ * ============================================================================
+ */
+
+/**
+ * @class CoefficientStream
+ * @brief Послідовний запис і зчитування бітів у ненульових AC-коефіцієнтах (F4).
+ *
+ * Позиції потоку - усі AC-коефіцієнти файлу; нульові коефіцієнти
+ * пропускаються (їх зміна помітно спотворює зображення і гістограму).
+ * Біт коефіцієнта c: для c > 0 - молодший біт, для c < 0 - інвертований
+ * молодший біт. Якщо біт не збігається, модуль коефіцієнта зменшується
+ * на 1. Коефіцієнт ±1, що став нулем ("усадка"), біта не несе: той самий
+ * біт записується в наступний коефіцієнт. Читач теж пропускає нулі,
+ * тому бачить ту саму послідовність коефіцієнтів.
+ *
+ * Після заголовка можна ввімкнути ключову перестановку решти позицій
+ * (розкидання даних по всьому зображенню, як у F5).
+ */
+class CoefficientStream {
+public:
+    /**
+     * @brief Конструктор.
+     * @param coefficients Коефіцієнти всіх блоків.
+     * @param blocks Кількість блоків.
+     */
+    CoefficientStream(qint16* coefficients, qint64 blocks)
+        : coefficients(coefficients), positions(blocks * AC_PER_BLOCK) {
+    }
+
+    /**
+     * @brief Кількість ще не використаних позицій.
+     * @return Кількість AC-коефіцієнтів після поточної позиції.
+     */
+    qint64 remaining() const {
+        return positions - position;
+    }
+
+    /**
+     * @brief Ключовий порядок для решти позицій.
+     * @param permutation Перестановка розміру remaining().
+     */
+    void setOrder(const KeyedPermutation* permutation) {
+        order = permutation;
+        base = position;
+    }
+
+    /**
+     * @brief Кількість коефіцієнтів, що стали нулем.
+     * @return Лічильник усадки.
+     */
+    qint64 shrinkage() const {
+        return shrunk;
+    }
+
+    /**
+     * @brief Запис байтів (старший біт першим).
+     *
+     * @param bytes Байти.
+     * @param count Кількість байтів.
+     * @return false якщо коефіцієнти закінчилися.
+     */
+    bool embed(const uchar* bytes, qint64 count) {
+        for (qint64 i = 0; i < count; ++i) {
+            for (int bit = 7; bit >= 0; --bit) {
+                if (!embedBit((bytes[i] >> bit) & 1)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Зчитування байтів (старший біт першим).
+     *
+     * @param bytes Вихідні байти.
+     * @param count Кількість байтів.
+     * @return false якщо коефіцієнти закінчилися.
+     */
+    bool extract(uchar* bytes, qint64 count) {
+        for (qint64 i = 0; i < count; ++i) {
+            uchar value = 0;
+            for (int bit = 0; bit < 8; ++bit) {
+                qint16* c = next();
+                if (!c) {
+                    return false;
+                }
+                value = uchar((value << 1) | coefficientBit(*c));
+            }
+            bytes[i] = value;
+        }
+        return true;
+    }
+
+private:
+    /**
+     * @brief Біт ненульового коефіцієнта.
+     */
+    static int coefficientBit(qint16 c) {
+        return c > 0 ? (c & 1) : ((c & 1) ^ 1);
+    }
+
+    /**
+     * @brief Наступний ненульовий AC-коефіцієнт.
+     * @return Вказівник на коефіцієнт або nullptr, якщо позиції закінчилися.
+     */
+    qint16* next() {
+        while (position < positions) {
+            const qint64 p = order ? base + qint64(order->map(quint64(position - base))) : position;
+            ++position;
+
+            // Позиція p - AC-коефіцієнт (p mod 63) + 1 блока p / 63.
+            qint16* c = coefficients + p / AC_PER_BLOCK * JpegCoefficients::BLOCK_COEFFICIENTS +
+                        1 + p % AC_PER_BLOCK;
+            if (*c != 0) {
+                return c;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Запис одного біта з урахуванням усадки.
+     * @return false якщо коефіцієнти закінчилися.
+     */
+    bool embedBit(int bit) {
+        for (;;) {
+            qint16* c = next();
+            if (!c) {
+                return false;
+            }
+            if (coefficientBit(*c) == bit) {
+                return true;
+            }
+
+            *c += *c > 0 ? -1 : 1;
+            if (*c != 0) {
+                return true;
+            }
+            ++shrunk;
+        }
+    }
+
+    qint16* coefficients;                        ///< Коефіцієнти всіх блоків.
+    qint64 positions;                            ///< Кількість AC-позицій.
+    qint64 position = 0;                         ///< Наступна позиція.
+    qint64 base = 0;                             ///< Початок переставленої частини.
+    const KeyedPermutation* order = nullptr;     ///< Перестановка (nullptr - послідовно).
+    qint64 shrunk = 0;                           ///< Лічильник усадки.
+};
+
+/* ============================================================================
+ *                      МЕТОДИ ПРИХОВУВАННЯ В JPEG
+ * ============================================================================
+ */
+
+/**
+ * @brief Приховування повідомлення в коефіцієнтах DCT файлу JPEG.
+ *
+ * Алгоритм:
+ * 1. Зчитуємо квантовані коефіцієнти (лише декодування Хаффмана).
+ * 2. Формуємо навантаження та перевіряємо оцінку ємності.
+ * 3. Записуємо заголовок і розширення послідовно в ненульові
+ *    AC-коефіцієнти, дані - в тому ж або ключовому порядку (F4/F5).
+ * 4. Записуємо коефіцієнти у вихідний JPEG без повторного квантування.
+ *
+ * Налаштування бітових площин, альфа-каналу та матричного вбудовування
+ * стосуються пікселів і тут не діють: кожен коефіцієнт несе один біт.
+ *
+ * @param inputPath Шлях до вхідного JPEG.
+ * @param outputPath Шлях до вихідного JPEG.
+ * @param message Текстове повідомлення для приховування.
+ * @param encrypt Чи потрібно шифрувати повідомлення.
+ * @return true у разі успіху.
+ */
+bool SteganographyEngine::hideMessageJpeg(const QString& inputPath, const QString& outputPath,
+                                          const QString& message, bool encrypt) {
+    if (message.isEmpty()) {
+        qWarning() << "Empty message!";
+        return false;
+    }
+
+    // ========== КРОК 1: Зчитуємо коефіцієнти ==========
+    JpegCoefficients jpeg(inputPath);
+    if (!jpeg.read()) {
+        qWarning() << "Cannot read JPEG coefficients:" << inputPath << jpeg.errorString();
+        return false;
+    }
+
+    // ========== КРОК 2: Формуємо навантаження ==========
+    const QByteArray payload = buildPayload(message, jpegHeader(encrypt));
+    const PayloadHeader header = parseHeader(payload);
+    const qint64 headerBytes = qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize;
+    const qint64 capacity = jpegCapacity(jpeg.constCoefficients(), jpeg.blockCount()) - headerBytes;
+    qDebug() << "Payload:" << header.length << "bytes, estimated JPEG capacity:" << capacity
+             << "keyed order:" << bool(header.flags & FLAG_KEYED_ORDER);
+
+    if (header.length > capacity) {
+        qWarning() << "Message too long for this image!";
+        qWarning() << "Required:" << header.length << "Available:" << capacity;
+        return false;
+    }
+
+    // ========== КРОК 3: Записуємо біти в коефіцієнти ==========
+    CoefficientStream stream(jpeg.coefficients(), jpeg.blockCount());
+    const uchar* bytes = reinterpret_cast<const uchar*>(payload.constData());
+    beginProgress(qint64(payload.size()) * 8);
+
+    bool written = stream.embed(bytes, headerBytes);
+
+    std::optional<KeyedPermutation> order;
+    if (header.flags & FLAG_KEYED_ORDER) {
+        order.emplace(currentKey, quint64(stream.remaining()));
+        stream.setOrder(&*order);
+    }
+
+    for (qint64 offset = headerBytes; written && offset < payload.size() && !isCancelled();
+         offset += JPEG_CHUNK_BYTES) {
+        const qint64 size = qMin(JPEG_CHUNK_BYTES, qint64(payload.size()) - offset);
+        written = stream.embed(bytes + offset, size);
+        advanceProgress(size * 8);
+    }
+
+    const bool cancelled = isCancelled();
+    endProgress();
+    if (cancelled) {
+        qWarning() << "Hiding cancelled";
+        return false;
+    }
+
+    // Оцінка ємності не враховує точну кількість усадки.
+    if (!written) {
+        qWarning() << "Message too long for this image (shrinkage exhausted the coefficients)!";
+        return false;
+    }
+
+    // ========== КРОК 4: Записуємо файл ==========
+    if (!jpeg.write(outputPath)) {
+        qWarning() << "Cannot write JPEG:" << outputPath << jpeg.errorString();
+        return false;
+    }
+
+    qDebug() << "Total bytes hidden:" << payload.size() << "shrinkage:" << stream.shrinkage();
+    qDebug() << "JPEG hiding completed successfully";
+
+    return true;
+}
+
+/**
+ * @brief Витягування повідомлення з коефіцієнтів DCT файлу JPEG.
+ *
+ * Алгоритм:
+ * 1. Зчитуємо квантовані коефіцієнти.
+ * 2. Зчитуємо та перевіряємо заголовок (сигнатура, версія, розмір).
+ * 3. Зчитуємо розширення і дані (в ключовому порядку, якщо він вказаний).
+ * 4. Дешифруємо, перевіряємо CRC-32 та декодуємо UTF-8.
+ *
+ * @param inputPath Шлях до JPEG.
+ * @param decrypt Чи потрібно розшифрувати повідомлення.
+ * @return Витягнуте повідомлення або повідомлення про помилку
+ *         (порожній рядок, якщо файл не вдалося прочитати).
+ */
+QString SteganographyEngine::extractMessageJpeg(const QString& inputPath, bool decrypt) {
+    // ========== КРОК 1: Зчитуємо коефіцієнти ==========
+    JpegCoefficients jpeg(inputPath);
+    if (!jpeg.read()) {
+        qWarning() << "Cannot read JPEG coefficients:" << inputPath << jpeg.errorString();
+        return QString();
+    }
+
+    // ========== КРОК 2: Заголовок ==========
+    CoefficientStream stream(jpeg.coefficients(), jpeg.blockCount());
+    QByteArray headerBytes(PAYLOAD_HEADER_SIZE, '\0');
+    if (!stream.extract(reinterpret_cast<uchar*>(headerBytes.data()), PAYLOAD_HEADER_SIZE)) {
+        return NOT_FOUND_MESSAGE;
+    }
+
+    const PayloadHeader header = parseHeader(headerBytes);
+    const qint64 totalBits = (qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize + header.length) * 8;
+    if (header.magic != PAYLOAD_MAGIC || !knownVersion(header.version) ||
+        totalBits > stream.remaining() + qint64(PAYLOAD_HEADER_SIZE) * 8) {
+        qDebug() << "JPEG payload header not found";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    qDebug() << "JPEG payload header found, length:" << header.length
+             << "bytes, flags:" << header.flags;
+
+    // ========== КРОК 3: Розширення та дані ==========
+    QByteArray extension(header.extensionSize, '\0');
+    if (!stream.extract(reinterpret_cast<uchar*>(extension.data()), header.extensionSize)) {
+        return NOT_FOUND_MESSAGE;
+    }
+
+    // Порядок коефіцієнтів визначається ключем - без нього дані не знайти.
+    std::optional<KeyedPermutation> order;
+    if (header.flags & FLAG_KEYED_ORDER) {
+        if (currentKey.isEmpty()) {
+            qWarning() << "Payload uses keyed coefficient order, but no key was provided!";
+            return NOT_FOUND_MESSAGE;
+        }
+        order.emplace(currentKey, quint64(stream.remaining()));
+        stream.setOrder(&*order);
+    }
+
+    QByteArray data(header.length, '\0');
+    uchar* bytes = reinterpret_cast<uchar*>(data.data());
+    beginProgress(qint64(header.length) * 8);
+
+    bool complete = true;
+    for (qint64 offset = 0; complete && offset < data.size() && !isCancelled();
+         offset += JPEG_CHUNK_BYTES) {
+        const qint64 size = qMin(JPEG_CHUNK_BYTES, qint64(data.size()) - offset);
+        complete = stream.extract(bytes + offset, size);
+        advanceProgress(size * 8);
+    }
+
+    const bool cancelled = isCancelled();
+    endProgress();
+    if (cancelled) {
+        qWarning() << "Extraction cancelled";
+        return NOT_FOUND_MESSAGE;
+    }
+    if (!complete) {
+        return NOT_FOUND_MESSAGE;
+    }
+
+    // ========== КРОК 4: Дешифруємо та перевіряємо ==========
+    return decodePayload(header, extension, data, decrypt);
+}
+
+/**
+ * @brief Оцінка ємності файлу JPEG.
+ *
+ * @param inputPath Шлях до JPEG.
+ * @param encrypt Чи буде повідомлення зашифроване.
+ * @return Оцінка максимальної кількості байтів даних (-1, якщо файл не прочитано).
+ */
+qint64 SteganographyEngine::calculateJpegCapacity(const QString& inputPath, bool encrypt) {
+    JpegCoefficients jpeg(inputPath);
+    if (!jpeg.read()) {
+        qWarning() << "Cannot read JPEG coefficients:" << inputPath << jpeg.errorString();
+        return -1;
+    }
+
+    const PayloadHeader header = jpegHeader(encrypt);
+    const qint64 headerBytes = qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize;
+    return qMax<qint64>(0, jpegCapacity(jpeg.constCoefficients(), jpeg.blockCount()) - headerBytes);
+}
+
+/**
+ * @brief Заголовок навантаження JPEG без довжини та CRC.
+ *
+ * Один біт на коефіцієнт, без альфа-каналу і матричного вбудовування;
+ * ключовий порядок і шифрування - як для пікселів.
+ *
+ * @param encrypt Чи буде навантаження зашифроване.
+ * @return Заголовок.
+ */
+PayloadHeader SteganographyEngine::jpegHeader(bool encrypt) const {
+    PayloadHeader header;
+    header.magic = PAYLOAD_MAGIC;
+    header.version = PAYLOAD_VERSION;
+    if (keyedOrder && !currentKey.isEmpty()) {
+        header.flags |= FLAG_KEYED_ORDER;
+    }
+    if (encrypt && !currentKey.isEmpty()) {
+        addCipherLayout(header);
+    }
+    return header;
+}
+
+/**
+ * @brief Очікувана кількість байтів, що вміщується в коефіцієнти.
+ *
+ * Коефіцієнт з модулем > 1 завжди несе біт. Коефіцієнт ±1 у середньому
+ * в половині випадків стає нулем (усадка), тому враховується як пів біта.
+ *
+ * @param coefficients Коефіцієнти всіх блоків.
+ * @param blocks Кількість блоків.
+ * @return Кількість байтів (включно із заголовком).
+ */
+qint64 SteganographyEngine::jpegCapacity(const qint16* coefficients, qint64 blocks) const {
+    qint64 large = 0;
+    qint64 ones = 0;
+    for (qint64 b = 0; b < blocks; ++b) {
+        const qint16* block = coefficients + b * JpegCoefficients::BLOCK_COEFFICIENTS;
+        for (int i = 1; i < JpegCoefficients::BLOCK_COEFFICIENTS; ++i) {
+            if (block[i] == 1 || block[i] == -1) {
+                ++ones;
+            } else if (block[i] != 0) {
+                ++large;
+            }
+        }
+    }
+    return (large + ones / 2) / 8;
+}
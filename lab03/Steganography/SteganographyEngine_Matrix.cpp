@@ -0,0 +1,321 @@
+/*
+ * SteganographyEngine_Matrix.cpp
+ *
+ * Реалізація матричного вбудовування кодами Геммінга.
+ * Блок з n = 2^p - 1 молодших бітів несе p бітів даних як синдром
+ * коду Геммінга [n, n - p]; для запису достатньо змінити не більше
+ * одного біта блока. Контейнер (молодші біти пікселів даних)
+ * зчитується та записується ядрами бітових площин.
+ */
+
+#include "SteganographyEngine.h"
+#include "KeyedPermutation.h"
+#include <QDebug>
+#include <array>
+
+/**
+ * @brief Таблиця синдромів байта.
+ *
+ * Для байта з позиціями j = 0..7 (старший біт - j = 0): біти 0-2 - XOR
+ * номерів j одиничних бітів, біт 3 - парність кількості одиниць.
+ */
+static const std::array<quint8, 256> SYNDROME_TABLE = [] {
+    std::array<quint8, 256> table{};
+    for (int value = 0; value < 256; ++value) {
+        int positions = 0;
+        int parity = 0;
+        for (int j = 0; j < 8; ++j) {
+            if (value & (0x80 >> j)) {
+                positions ^= j;
+                parity ^= 1;
+            }
+        }
+        table[value] = quint8(positions | (parity << 3));
+    }
+    return table;
+}();
+
+/**
+ * @brief Зчитування до 16 бітів, починаючи з довільного біта.
+ *
+ * Зчитуються лише байти, що містять потрібні біти, тому смуги,
+ * вирівняні на цілі байти, не торкаються байтів сусідніх смуг.
+ *
+ * @param bytes Біти (старший біт байта - перший).
+ * @param index Номер першого біта.
+ * @param count Кількість бітів (1-16).
+ * @return Біти (перший - старший).
+ */
+static inline quint32 readBits(const uchar* bytes, qint64 index, int count) {
+    qint64 byteIndex = index >> 3;
+    const int skip = int(index & 7);
+    quint32 window = 0;
+    int windowBits = 0;
+    while (windowBits < skip + count) {
+        window = (window << 8) | bytes[byteIndex++];
+        windowBits += 8;
+    }
+    return (window >> (windowBits - skip - count)) & ((1u << count) - 1);
+}
+
+/* ============================================================================
+ *                          НАЛАШТУВАННЯ РЕЖИМУ
+ * ============================================================================
+ */
+
+/**
+ * @brief Увімкнення матричного вбудовування (коди Геммінга).
+ * @param enabled true - матричне вбудовування.
+ */
+void SteganographyEngine::setMatrixEmbedding(bool enabled) {
+    matrixEmbedding = enabled;
+    qDebug() << "Matrix embedding:" << matrixEmbedding;
+}
+
+/**
+ * @brief Чи увімкнено матричне вбудовування.
+ * @return true якщо дані вбудовуються кодами Геммінга.
+ */
+bool SteganographyEngine::isMatrixEmbedding() const {
+    return matrixEmbedding;
+}
+
+/* ============================================================================
+ *                          ПАРАМЕТР КОДУ
+ * ============================================================================
+ */
+
+/**
+ * @brief Чи записані дані кодом Геммінга.
+ *
+ * Розширення містить дані шифру (лише з FLAG_AEAD), за ними -
+ * байт параметра коду.
+ *
+ * @param header Заголовок навантаження.
+ * @return true для матричного вбудовування.
+ */
+bool SteganographyEngine::matrixLayout(const PayloadHeader& header) const {
+    const int cipherSize = cipherExtensionSize(header);
+    return header.extensionSize == cipherSize + MATRIX_EXTENSION_SIZE;
+}
+
+/**
+ * @brief Параметр p коду Геммінга з розширення заголовка.
+ *
+ * @param header Заголовок навантаження.
+ * @param extension Розширення заголовка.
+ * @return p (1..MAX_HAMMING_P) або 0, якщо значення неправильне.
+ */
+int SteganographyEngine::storedHammingParameter(const PayloadHeader& header,
+                                                const QByteArray& extension) const {
+    if (!matrixLayout(header) || extension.size() < header.extensionSize) {
+        return 0;
+    }
+
+    const int p = quint8(extension.at(header.extensionSize - 1));
+    return (p >= 1 && p <= MAX_HAMMING_P) ? p : 0;
+}
+
+/**
+ * @brief Вибір найбільшого p, за якого дані вміщуються в контейнер.
+ *
+ * Більше p - довші блоки і менше змін на біт даних, але й менше
+ * бітів даних на біт контейнера (p / n). p = 1 - звичайний LSB.
+ *
+ * @param dataBytes Розмір даних у байтах.
+ * @param coverBits Кількість доступних молодших бітів (кратна 8).
+ * @return p (1..MAX_HAMMING_P) або 0, якщо дані не вміщуються.
+ */
+int SteganographyEngine::chooseHammingParameter(qint64 dataBytes, qint64 coverBits) {
+    for (int p = MAX_HAMMING_P; p >= 1; --p) {
+        if (hammingBlocks(dataBytes, p) * ((1 << p) - 1) <= coverBits) {
+            return p;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Кількість блоків коду Геммінга для даних.
+ * @param dataBytes Розмір даних у байтах.
+ * @param p Параметр коду Геммінга.
+ * @return Кількість блоків.
+ */
+qint64 SteganographyEngine::hammingBlocks(qint64 dataBytes, int p) {
+    return (dataBytes * 8 + p - 1) / p;
+}
+
+/**
+ * @brief Кількість бітів контейнера для даних (кратна 8).
+ * @param dataBytes Розмір даних у байтах.
+ * @param p Параметр коду Геммінга.
+ * @return Кількість бітів.
+ */
+qint64 SteganographyEngine::hammingCoverBits(qint64 dataBytes, int p) {
+    return (hammingBlocks(dataBytes, p) * ((1 << p) - 1) + 7) / 8 * 8;
+}
+
+/* ============================================================================
+ *                      ЗАПИС ТА ЗЧИТУВАННЯ БЛОКІВ
+ * ============================================================================
+ */
+
+/**
+ * @brief Матричне вбудовування даних у молодші біти каналів.
+ *
+ * Алгоритм:
+ * 1. Зчитуємо молодші біти потрібної кількості блоків (контейнер).
+ * 2. У кожному блоці змінюємо не більше одного біта (смуги - паралельно).
+ * 3. Записуємо контейнер назад; незмінені біти записуються тими самими.
+ *
+ * @param image Зображення RGB32 або ARGB32 (модифікується).
+ * @param firstPixel Номер першого піксела даних.
+ * @param data Байти для запису.
+ * @param p Параметр коду Геммінга.
+ * @param channels Кількість каналів (3 або 4).
+ * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+ */
+void SteganographyEngine::embedMatrix(QImage& image, qint64 firstPixel, const QByteArray& data,
+                                      int p, int channels, const KeyedPermutation* order) {
+    const qint64 n = (1 << p) - 1;
+    const qint64 messageBits = qint64(data.size()) * 8;
+    const qint64 blocks = hammingBlocks(data.size(), p);
+
+    // ========== КРОК 1: Зчитуємо контейнер ==========
+    QByteArray cover = extractPlanes(image, firstPixel, hammingCoverBits(data.size(), p) / 8,
+                                     1, channels, order);
+
+    // ========== КРОК 2: Вбудовуємо блоки ==========
+    // Смуги по 8 блоків: межі припадають на цілі байти контейнера і даних.
+    uchar* coverBits = reinterpret_cast<uchar*>(cover.data());
+    const uchar* message = reinterpret_cast<const uchar*>(data.constData());
+    runBands(blocks, 8, PARALLEL_MIN_BITS / p, [=](qint64 blockBegin, qint64 blockEnd) {
+        embedHammingRange(coverBits, message, messageBits, blockBegin, blockEnd, p);
+    });
+
+    // ========== КРОК 3: Записуємо контейнер ==========
+    embedPlanes(image, firstPixel, cover, 1, channels, order);
+
+    qDebug() << "Matrix embedding: p =" << p << "n =" << n << "blocks:" << blocks;
+}
+
+/**
+ * @brief Зчитування даних, записаних кодом Геммінга.
+ *
+ * @param image Зображення RGB32 або ARGB32.
+ * @param firstPixel Номер першого піксела даних.
+ * @param byteCount Кількість байтів.
+ * @param p Параметр коду Геммінга.
+ * @param channels Кількість каналів (3 або 4).
+ * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+ * @return Зчитані байти.
+ */
+QByteArray SteganographyEngine::extractMatrix(const QImage& image, qint64 firstPixel,
+                                              qint64 byteCount, int p, int channels,
+                                              const KeyedPermutation* order) {
+    const qint64 blocks = hammingBlocks(byteCount, p);
+    const QByteArray cover = extractPlanes(image, firstPixel, hammingCoverBits(byteCount, p) / 8,
+                                           1, channels, order);
+
+    // Зайві біти останнього блока потрапляють у запасний байт і відкидаються.
+    QByteArray data((blocks * p + 7) / 8, '\0');
+    const uchar* coverBits = reinterpret_cast<const uchar*>(cover.constData());
+    uchar* message = reinterpret_cast<uchar*>(data.data());
+    runBands(blocks, 8, PARALLEL_MIN_BITS / p, [=](qint64 blockBegin, qint64 blockEnd) {
+        extractHammingRange(coverBits, message, blockBegin, blockEnd, p);
+    });
+
+    data.truncate(byteCount);
+    return data;
+}
+
+/**
+ * @brief Синдром блока коду Геммінга.
+ *
+ * Позиція 0 фіктивна (нульовий стовпець перевірочної матриці), позиції
+ * 1..n - біти блока. Тоді байт m охоплює позиції 8m..8m+7, і номер
+ * позиції 8m + j = 8m | j, тож внесок байта береться з таблиці.
+ *
+ * @param cover Біти контейнера (старший біт байта - перший).
+ * @param start Номер першого біта блока.
+ * @param n Довжина блока (2^p - 1).
+ * @return Синдром (p бітів).
+ */
+quint32 SteganographyEngine::hammingSyndrome(const uchar* cover, qint64 start, int n) {
+    quint32 syndrome = 0;
+
+    for (int base = 0; base <= n; base += 8) {
+        const int count = qMin(8, n + 1 - base);
+
+        // Вирівнюємо позиції base..base+count-1 на старші біти байта.
+        const quint32 chunk = base == 0
+                                  ? readBits(cover, start, count - 1)
+                                  : readBits(cover, start + base - 1, count);
+        const quint8 entry = SYNDROME_TABLE[(chunk << (8 - count)) & 0xFF];
+
+        syndrome ^= (entry & 7u) ^ ((entry & 8u) ? quint32(base) : 0u);
+    }
+
+    return syndrome;
+}
+
+/**
+ * @brief Вбудовування діапазону блоків (ядро смуги).
+ *
+ * Для блока b: m - p бітів даних, s - синдром блока. Якщо s ≠ m,
+ * інвертуємо біт на позиції s XOR m - після цього синдром дорівнює m.
+ * Неповна група бітів даних в останньому блоці доповнюється нулями.
+ *
+ * @param cover Біти контейнера (модифікуються).
+ * @param message Біти даних.
+ * @param messageBits Кількість бітів даних.
+ * @param blockBegin Перший блок.
+ * @param blockEnd Блок після останнього.
+ * @param p Параметр коду Геммінга.
+ */
+void SteganographyEngine::embedHammingRange(uchar* cover, const uchar* message, qint64 messageBits,
+                                            qint64 blockBegin, qint64 blockEnd, int p) {
+    const int n = (1 << p) - 1;
+
+    for (qint64 block = blockBegin; block < blockEnd; ++block) {
+        const qint64 messageIndex = block * p;
+        const int count = int(qMin<qint64>(p, messageBits - messageIndex));
+        const quint32 value = readBits(message, messageIndex, count) << (p - count);
+
+        const qint64 start = block * n;
+        const quint32 flip = hammingSyndrome(cover, start, n) ^ value;
+        if (flip != 0) {
+            const qint64 bit = start + flip - 1;
+            cover[bit >> 3] ^= uchar(0x80 >> (bit & 7));
+        }
+    }
+}
+
+/**
+ * @brief Зчитування діапазону блоків (ядро смуги).
+ *
+ * Синдром кожного блока - p бітів даних. Вихідний буфер має запасні
+ * біти для останнього блока, тому біти записуються без перевірки меж.
+ *
+ * @param cover Біти контейнера.
+ * @param message Вихідні біти даних (заповнені нулями).
+ * @param blockBegin Перший блок.
+ * @param blockEnd Блок після останнього.
+ * @param p Параметр коду Геммінга.
+ */
+void SteganographyEngine::extractHammingRange(const uchar* cover, uchar* message,
+                                              qint64 blockBegin, qint64 blockEnd, int p) {
+    const int n = (1 << p) - 1;
+
+    for (qint64 block = blockBegin; block < blockEnd; ++block) {
+        const quint32 syndrome = hammingSyndrome(cover, block * n, n);
+        const qint64 messageIndex = block * p;
+
+        for (int i = 0; i < p; ++i) {
+            if (syndrome & (1u << (p - 1 - i))) {
+                const qint64 bit = messageIndex + i;
+                message[bit >> 3] |= uchar(0x80 >> (bit & 7));
+            }
+        }
+    }
+}
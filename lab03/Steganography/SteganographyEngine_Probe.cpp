@@ -0,0 +1,157 @@
+/*
+ * SteganographyEngine_Probe.cpp
+ *
+ * Реалізація швидкої перевірки наявності навантаження.
+ * Зчитуються лише перші пікселі зображення з заголовком, тому
+ * перевірка великого архіву не потребує повного декодування файлів.
+ */
+
+#include "SteganographyEngine.h"
+#include "ImageStripReader.h"
+#include <QDebug>
+#include <QImageReader>
+#include <QRect>
+
+/* ============================================================================
+ *                      МЕТОДИ ШВИДКОЇ ПЕРЕВІРКИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Швидка перевірка заголовка навантаження.
+ *
+ * Зображення у форматі RGB32/ARGB32 читається без копіювання,
+ * інші формати - конвертуються лише перші рядки.
+ *
+ * @param image Зображення для перевірки.
+ * @return Наявність і тип навантаження.
+ */
+ProbeResult SteganographyEngine::probeMessage(const QImage& image) {
+    if (image.isNull()) {
+        return ProbeResult::None;
+    }
+
+    const int width = image.width();
+    const int rows = qMin(image.height(), (PROBE_PIXELS + width - 1) / width);
+
+    QImage head = image;
+    if (image.format() != QImage::Format_RGB32 && image.format() != QImage::Format_ARGB32) {
+        head = image.copy(0, 0, width, rows).convertToFormat(QImage::Format_RGB32);
+    }
+
+    return probeHead(head, qint64(width) * image.height());
+}
+
+/**
+ * @brief Швидка перевірка заголовка навантаження у файлі.
+ *
+ * @param path Шлях до файлу зображення.
+ * @param ok Результат читання файлу (необов'язковий).
+ * @return Наявність і тип навантаження.
+ */
+ProbeResult SteganographyEngine::probeFile(const QString& path, bool* ok) {
+    if (ok) {
+        *ok = false;
+    }
+
+    QSize size;
+    QImage head;
+
+    ImageStripReader reader(path);
+    if (reader.open()) {
+        // ========== PNG/JPEG: лише перші рядки, решта файлу не декодується ==========
+        size = reader.size();
+        if (size.isEmpty()) {
+            qWarning() << "Empty image:" << path;
+            return ProbeResult::None;
+        }
+        const int rows = qMin(size.height(), (PROBE_PIXELS + size.width() - 1) / size.width());
+        head = reader.readStrip(rows);
+        if (head.isNull()) {
+            qWarning() << "Cannot read image header:" << path << reader.errorString();
+            return ProbeResult::None;
+        }
+    } else {
+        // ========== Інші формати: обмежувальний прямокутник QImageReader ==========
+        QImageReader imageReader(path);
+        size = imageReader.size();
+        if (size.isEmpty()) {
+            qWarning() << "Cannot open image:" << path << imageReader.errorString();
+            return ProbeResult::None;
+        }
+        const int rows = qMin(size.height(), (PROBE_PIXELS + size.width() - 1) / size.width());
+        if (imageReader.supportsOption(QImageIOHandler::ClipRect)) {
+            imageReader.setClipRect(QRect(0, 0, size.width(), rows));
+        }
+        head = imageReader.read();
+        if (head.isNull()) {
+            qWarning() << "Cannot read image header:" << path << imageReader.errorString();
+            return ProbeResult::None;
+        }
+        if (head.format() != QImage::Format_RGB32 && head.format() != QImage::Format_ARGB32) {
+            head = head.convertToFormat(QImage::Format_RGB32);
+        }
+    }
+
+    if (ok) {
+        *ok = true;
+    }
+    return probeHead(head, qint64(size.width()) * size.height());
+}
+
+/**
+ * @brief Перевірка заголовка в перших пікселях зображення.
+ *
+ * Алгоритм:
+ * 1. Зчитуємо 128 бітів (43 пікселі) і перевіряємо сигнатуру (повідомлення,
+ *    файлу, фрагмента або навантаження з кодом Ріда-Соломона), версію та що заявлена довжина вміщується в зображення
+ *    повного розміру.
+ * 2. Інакше порівнюємо перші 9 символів (48 пікселів) з маркером
+ *    початку старого формату. Зашифрований старий формат без ключа
+ *    не розпізнається.
+ *
+ * @param head Перші рядки зображення у форматі RGB32 або ARGB32.
+ * @param pixels Кількість пікселів усього зображення.
+ * @return Наявність і тип навантаження.
+ */
+ProbeResult SteganographyEngine::probeHead(const QImage& head, qint64 pixels) {
+    const qint64 availableBits = qint64(head.width()) * head.height() * 3;
+
+    // ========== КРОК 1: Заголовок навантаження ==========
+    const qint64 headerBits = qint64(PAYLOAD_HEADER_SIZE) * 8;
+    if (availableBits < headerBits) {
+        return ProbeResult::None;
+    }
+
+    QByteArray bytes(PAYLOAD_HEADER_SIZE, '\0');
+    extractBitRange(head.constBits(), head.bytesPerLine(), head.width(), 0,
+                    reinterpret_cast<uchar*>(bytes.data()), 0, headerBits);
+
+    const PayloadHeader header = parseHeader(bytes);
+    const bool magic = header.magic == PAYLOAD_MAGIC || header.magic == PAYLOAD_FILE_MAGIC ||
+                       header.magic == PAYLOAD_SHARD_MAGIC || header.magic == PAYLOAD_ECC_MAGIC;
+    if (magic && knownVersion(header.version) && payloadFits(header, pixels)) {
+        return (header.flags & FLAG_ENCRYPTED) ? ProbeResult::Encrypted : ProbeResult::Plain;
+    }
+
+    // ========== КРОК 2: Маркер старого формату ==========
+    const int markerLength = START_MARKER.length();
+    const qint64 markerBits = qint64(markerLength) * 16;
+    if (availableBits < markerBits) {
+        return ProbeResult::None;
+    }
+
+    QByteArray marker(markerLength * 2, '\0');
+    extractBitRange(head.constBits(), head.bytesPerLine(), head.width(), 0,
+                    reinterpret_cast<uchar*>(marker.data()), 0, markerBits);
+
+    // Символи старого формату - 16 бітів, старший біт першим.
+    for (int i = 0; i < markerLength; ++i) {
+        const ushort unit = ushort((uchar(marker[2 * i]) << 8) | uchar(marker[2 * i + 1]));
+        if (QChar(unit) != START_MARKER[i]) {
+            return ProbeResult::None;
+        }
+    }
+
+    return ProbeResult::Plain;
+}
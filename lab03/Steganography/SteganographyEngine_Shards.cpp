@@ -0,0 +1,470 @@
+/*
+ * SteganographyEngine_Shards.cpp
+ *
+ * Реалізація розподілу повідомлення між кількома зображеннями.
+ * Навантаження ділиться на k фрагментів даних, до яких додаються
+ * m фрагментів парності Ріда-Соломона; кожен фрагмент записується
+ * в окреме зображення зі своїм заголовком і номером. Зображення
+ * обробляються паралельно, а повідомлення відновлюється з будь-яких
+ * k неушкоджених зображень набору.
+ */
+
+#include "SteganographyEngine.h"
+#include "KeyedPermutation.h"
+#include "ReedSolomon.h"
+#include <QDebug>
+#include <QHash>
+#include <QRandomGenerator>
+#include <QSemaphore>
+#include <QtEndian>
+#include <optional>
+#include <zlib.h>
+
+/* ============================================================================
+ *                      МЕТОДИ РОБОТИ З КІЛЬКОМА КОНТЕЙНЕРАМИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Розподіл повідомлення між кількома зображеннями.
+ *
+ * Алгоритм:
+ * 1. Формуємо звичайне навантаження (заголовок, стиснення, шифрування).
+ * 2. Доповнюємо його нулями до k однакових фрагментів даних
+ *    (k = кількість зображень - parityShards).
+ * 3. Обчислюємо m фрагментів парності Ріда-Соломона.
+ * 4. Перевіряємо, що фрагмент вміщується в найменше зображення.
+ * 5. Паралельно записуємо в кожне зображення заголовок "STES", запис
+ *    фрагмента (набір, номер, k, m, розмір навантаження) і дані фрагмента.
+ *
+ * Матричне вбудовування не підтримується: параметр коду зберігається
+ * в розширенні звичайного заголовка, а не заголовка фрагмента.
+ *
+ * @param images Зображення-контейнери (оригінали), порядок задає номери фрагментів.
+ * @param message Текстове повідомлення.
+ * @param parityShards Кількість фрагментів парності (0 - без відновлення).
+ * @param encrypt Чи потрібно шифрувати повідомлення.
+ * @return Модифіковані зображення в тому ж порядку або порожній список у разі помилки.
+ */
+QVector<QImage> SteganographyEngine::hideMessageShards(const QVector<QImage>& images,
+                                                       const QString& message,
+                                                       int parityShards, bool encrypt) {
+    const int carriers = images.size();
+    const int dataShards = carriers - parityShards;
+    if (images.isEmpty() || message.isEmpty()) {
+        qWarning() << "Empty image list or message!";
+        return QVector<QImage>();
+    }
+    if (carriers > MAX_CARRIERS || parityShards < 0 || dataShards < 1) {
+        qWarning() << "Invalid shard layout:" << carriers << "carriers," << parityShards << "parity";
+        return QVector<QImage>();
+    }
+    for (const QImage& image : images) {
+        if (image.isNull()) {
+            qWarning() << "Empty image in the carrier set!";
+            return QVector<QImage>();
+        }
+    }
+    if (matrixEmbedding) {
+        qWarning() << "Matrix embedding is not supported for sharded payloads!";
+        return QVector<QImage>();
+    }
+
+    // ========== КРОКИ 1-2: Навантаження та фрагменти даних ==========
+    QByteArray payload = buildPayload(message, encrypt);
+    const qint64 payloadSize = payload.size();
+    const qint64 shardSize = (payloadSize + dataShards - 1) / dataShards;
+    payload.append(QByteArray(dataShards * shardSize - payloadSize, '\0'));
+
+    QVector<QByteArray> shards;
+    for (int i = 0; i < dataShards; ++i) {
+        shards.append(payload.mid(i * shardSize, shardSize));
+    }
+
+    // ========== КРОК 3: Фрагменти парності ==========
+    shards += ReedSolomon(dataShards, parityShards).encode(shards);
+
+    // ========== КРОК 4: Перевіряємо ємність ==========
+    PayloadHeader header = shardHeader(encrypt);
+    header.length = quint32(shardSize);
+
+    for (int i = 0; i < carriers; ++i) {
+        const qint64 capacity = dataCapacity(header, qint64(images[i].width()) * images[i].height());
+        if (shardSize > capacity) {
+            qWarning() << "Message too long for this carrier set!";
+            qWarning() << "Carrier" << i << "required:" << shardSize << "Available:" << capacity;
+            return QVector<QImage>();
+        }
+    }
+
+    qDebug() << "Payload:" << payloadSize << "bytes in" << dataShards << "data and"
+             << parityShards << "parity shards of" << shardSize << "bytes";
+
+    // ========== КРОК 5: Паралельний запис фрагментів ==========
+    const quint32 setId = QRandomGenerator::global()->generate();
+    const qint64 headerBytes = qint64(PAYLOAD_HEADER_SIZE) + SHARD_RECORD_SIZE;
+    QVector<QImage> results(carriers);
+    QImage* resultData = results.data();
+
+    beginProgress(qint64(carriers) * (headerBytes + shardSize) * 8);
+    runCarriers(carriers, [&](int i) {
+        if (isCancelled()) {
+            return;
+        }
+
+        QImage resultImage = images[i].convertToFormat(alphaPlane ? QImage::Format_ARGB32
+                                                                  : QImage::Format_RGB32);
+        const QByteArray& shard = shards.at(i);
+
+        ShardRecord shardRecord;
+        shardRecord.setId = setId;
+        shardRecord.index = i;
+        shardRecord.dataShards = dataShards;
+        shardRecord.parityShards = parityShards;
+        shardRecord.payloadSize = quint32(payloadSize);
+        const QByteArray record = serializeShardRecord(shardRecord);
+
+        // CRC охоплює і запис фрагмента: пошкоджений номер не потрапить у відновлення.
+        PayloadHeader carrierHeader = header;
+        uLong crc = crc32(0L, reinterpret_cast<const Bytef*>(record.constData()), uInt(record.size()));
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(shard.constData()), uInt(shard.size()));
+        carrierHeader.crc = quint32(crc);
+
+        const qint64 totalPixels = qint64(resultImage.width()) * resultImage.height();
+        std::optional<KeyedPermutation> order;
+        if (carrierHeader.flags & FLAG_KEYED_ORDER) {
+            order.emplace(currentKey, quint64(totalPixels - dataStartPixel(carrierHeader)));
+        }
+
+        embedBytes(resultImage, serializeHeader(carrierHeader) + record);
+        embedFileChunk(resultImage, carrierHeader, reinterpret_cast<const uchar*>(shard.constData()),
+                       0, shardSize, order ? &*order : nullptr);
+        resultData[i] = resultImage;
+    });
+
+    const bool cancelled = isCancelled();
+    endProgress();
+    if (cancelled) {
+        qWarning() << "Hiding cancelled";
+        return QVector<QImage>();
+    }
+
+    qDebug() << "Sharded hiding completed successfully, set:" << Qt::hex << setId;
+
+    return results;
+}
+
+/**
+ * @brief Відновлення повідомлення з набору зображень.
+ *
+ * Алгоритм:
+ * 1. Паралельно зчитуємо заголовки фрагментів усіх зображень.
+ * 2. Обираємо набір з найбільшою кількістю зображень (зображення
+ *    інших наборів, без фрагмента або з іншими параметрами ігноруються).
+ * 3. Паралельно зчитуємо дані фрагментів і перевіряємо CRC-32;
+ *    пошкоджені (наприклад, перекодовані з втратами) - вважаються втраченими.
+ * 4. Відновлюємо втрачені фрагменти даних кодом Ріда-Соломона.
+ * 5. Розбираємо відновлене навантаження як звичайне (дешифрування, CRC).
+ *
+ * Порядок зображень не важливий: номер фрагмента записаний у ньому самому.
+ *
+ * @param images Зображення набору (будь-яка підмножина, будь-який порядок).
+ * @param decrypt Чи потрібно дешифрувати.
+ * @return Витягнуте повідомлення або повідомлення про помилку.
+ */
+QString SteganographyEngine::extractMessageShards(const QVector<QImage>& images, bool decrypt) {
+    if (images.isEmpty()) {
+        qWarning() << "Empty image list!";
+        return QString();
+    }
+
+    // ========== КРОК 1: Заголовки фрагментів ==========
+    const int count = images.size();
+    QVector<QImage> workImages(count);
+    QVector<PayloadHeader> headers(count);
+    QVector<ShardRecord> records(count);
+    QVector<char> found(count, 0);
+    QImage* workData = workImages.data();
+    PayloadHeader* headerData = headers.data();
+    ShardRecord* recordData = records.data();
+    char* foundData = found.data();
+
+    runCarriers(count, [&](int i) {
+        const QImage& image = images.at(i);
+        if (image.isNull()) {
+            return;
+        }
+        workData[i] = image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32
+                                                                    : QImage::Format_RGB32);
+        foundData[i] = readShardHeader(workData[i], headerData[i], recordData[i]);
+    });
+
+    // ========== КРОК 2: Найбільший набір ==========
+    QHash<quint32, int> setSizes;
+    int reference = -1;
+    for (int i = 0; i < count; ++i) {
+        if (!found[i]) {
+            qDebug() << "Carrier" << i << ": shard header not found";
+            continue;
+        }
+        const int size = ++setSizes[records[i].setId];
+        if (reference < 0 || size > setSizes[records[reference].setId]) {
+            reference = i;
+        }
+    }
+    if (reference < 0) {
+        qWarning() << "No shards found in the carrier set";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    const ShardRecord layout = records[reference];
+    const quint32 shardSize = headers[reference].length;
+    const int totalShards = layout.dataShards + layout.parityShards;
+
+    if ((headers[reference].flags & FLAG_KEYED_ORDER) && currentKey.isEmpty()) {
+        qWarning() << "Payload uses keyed pixel order, but no key was provided!";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    // Одне зображення на номер фрагмента; параметри мають збігатися з набором.
+    QVector<int> carrierOf(totalShards, -1);
+    int selected = 0;
+    for (int i = 0; i < count; ++i) {
+        const ShardRecord& record = records[i];
+        if (!found[i] || record.setId != layout.setId) {
+            continue;
+        }
+        if (record.dataShards != layout.dataShards || record.parityShards != layout.parityShards ||
+            record.payloadSize != layout.payloadSize || headers[i].length != shardSize ||
+            carrierOf[record.index] >= 0) {
+            qDebug() << "Carrier" << i << ": inconsistent or duplicate shard" << record.index;
+            continue;
+        }
+        carrierOf[record.index] = i;
+        ++selected;
+    }
+
+    // ========== КРОК 3: Дані фрагментів ==========
+    QVector<QByteArray> shards(totalShards);
+    QByteArray* shardData = shards.data();
+
+    beginProgress(qint64(selected) * shardSize * 8);
+    runCarriers(totalShards, [&](int index) {
+        const int i = carrierOf.at(index);
+        if (i < 0 || isCancelled()) {
+            return;
+        }
+
+        const QImage& workImage = workImages.at(i);
+        const PayloadHeader& header = headers.at(i);
+        const qint64 totalPixels = qint64(workImage.width()) * workImage.height();
+        std::optional<KeyedPermutation> order;
+        if (header.flags & FLAG_KEYED_ORDER) {
+            order.emplace(currentKey, quint64(totalPixels - dataStartPixel(header)));
+        }
+
+        QByteArray shard(shardSize, '\0');
+        extractFileChunk(workImage, header, reinterpret_cast<uchar*>(shard.data()),
+                         0, shardSize, order ? &*order : nullptr);
+
+        const QByteArray record = serializeShardRecord(records.at(i));
+        uLong crc = crc32(0L, reinterpret_cast<const Bytef*>(record.constData()), uInt(record.size()));
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(shard.constData()), uInt(shard.size()));
+        if (quint32(crc) != header.crc) {
+            qWarning() << "Carrier" << i << ": CRC mismatch, shard" << index << "treated as missing";
+            return;
+        }
+        shardData[index] = shard;
+    });
+
+    const bool cancelled = isCancelled();
+    endProgress();
+    if (cancelled) {
+        qWarning() << "Extraction cancelled";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    // ========== КРОК 4: Відновлення фрагментів даних ==========
+    int intact = 0;
+    for (const QByteArray& shard : shards) {
+        intact += shard.isEmpty() ? 0 : 1;
+    }
+    qDebug() << "Shard set" << Qt::hex << layout.setId << Qt::dec << ":" << intact << "of"
+             << totalShards << "shards intact," << layout.dataShards << "required";
+
+    if (!ReedSolomon(layout.dataShards, layout.parityShards).reconstruct(shards)) {
+        qWarning() << "Not enough intact carriers to reconstruct the payload!";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    QByteArray payload;
+    payload.reserve(qsizetype(layout.dataShards) * shardSize);
+    for (int j = 0; j < layout.dataShards; ++j) {
+        payload += shards[j];
+    }
+    payload.truncate(layout.payloadSize);
+
+    // ========== КРОК 5: Звичайне навантаження ==========
+    const PayloadHeader header = parseHeader(payload);
+    const qint64 headerBytes = qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize;
+    if (header.magic != PAYLOAD_MAGIC || !knownVersion(header.version) ||
+        headerBytes + header.length > payload.size()) {
+        qWarning() << "Invalid payload header in the reconstructed data!";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    return decodePayload(header, payload.mid(PAYLOAD_HEADER_SIZE, header.extensionSize),
+                         payload.mid(headerBytes, header.length), decrypt);
+}
+
+/**
+ * @brief Максимальна ємність набору зображень.
+ *
+ * Усі фрагменти однакові, тому ємність визначає найменше зображення:
+ * k × (ємність фрагмента) мінус заголовок і розширення навантаження.
+ *
+ * @param sizes Розміри зображень набору.
+ * @param parityShards Кількість фрагментів парності.
+ * @param encrypt Чи буде повідомлення зашифроване.
+ * @return Максимальна кількість байтів UTF-8 (0 - набір непридатний).
+ */
+qint64 SteganographyEngine::calculateShardedCapacity(const QVector<QSize>& sizes, int parityShards,
+                                                     bool encrypt) {
+    const int dataShards = sizes.size() - parityShards;
+    if (sizes.isEmpty() || sizes.size() > MAX_CARRIERS || parityShards < 0 || dataShards < 1 ||
+        matrixEmbedding) {
+        return 0;
+    }
+
+    const PayloadHeader header = shardHeader(encrypt);
+    qint64 shardCapacity = -1;
+    for (const QSize& size : sizes) {
+        const qint64 capacity = size.isEmpty()
+                                    ? 0 : dataCapacity(header, qint64(size.width()) * size.height());
+        shardCapacity = shardCapacity < 0 ? capacity : qMin(shardCapacity, capacity);
+    }
+
+    const PayloadHeader inner = layoutHeader(encrypt);
+    const qint64 maxBytes = qint64(dataShards) * qMax<qint64>(0, shardCapacity) -
+                            PAYLOAD_HEADER_SIZE - inner.extensionSize;
+
+    return qMax<qint64>(0, maxBytes);
+}
+
+/* ============================================================================
+ *                      ЗАГОЛОВОК ФРАГМЕНТА ТА ПАРАЛЕЛЬНА ОБРОБКА
+ * ============================================================================
+ */
+
+/**
+ * @brief Заголовок фрагмента без довжини та CRC для поточних налаштувань.
+ *
+ * Розміщення (біти на канал, альфа-канал, ключовий порядок) - як у
+ * звичайного навантаження. Шифрування належить навантаженню всередині
+ * фрагментів, тому прапорець шифрування в заголовку фрагмента лише
+ * інформує швидку перевірку, а розширення містить тільки запис фрагмента.
+ *
+ * @param encrypt Чи буде навантаження зашифроване.
+ * @return Заголовок.
+ */
+PayloadHeader SteganographyEngine::shardHeader(bool encrypt) const {
+    PayloadHeader header = layoutHeader(false);
+    header.magic = PAYLOAD_SHARD_MAGIC;
+    header.extensionSize = SHARD_RECORD_SIZE;
+    if (encrypt && !currentKey.isEmpty()) {
+        header.flags |= FLAG_ENCRYPTED;
+    }
+    return header;
+}
+
+/**
+ * @brief Зчитування та перевірка заголовка фрагмента.
+ *
+ * Розширення - запис фрагмента: ідентифікатор набору (u32), номер
+ * фрагмента (u8), кількість фрагментів даних і парності (u8, u8),
+ * розмір навантаження (u32).
+ *
+ * @param image Зображення RGB32 або ARGB32.
+ * @param header Заголовок фрагмента (вихідний параметр).
+ * @param record Запис фрагмента (вихідний параметр).
+ * @return true якщо заголовок коректний і фрагмент вміщується в зображення.
+ */
+bool SteganographyEngine::readShardHeader(const QImage& image, PayloadHeader& header,
+                                          ShardRecord& record) {
+    const qint64 pixels = qint64(image.width()) * image.height();
+    if (pixels * 3 / 8 < PAYLOAD_HEADER_SIZE + SHARD_RECORD_SIZE) {
+        return false;
+    }
+
+    header = parseHeader(extractBytes(image, 0, PAYLOAD_HEADER_SIZE));
+    if (header.magic != PAYLOAD_SHARD_MAGIC || !knownVersion(header.version) ||
+        header.extensionSize != SHARD_RECORD_SIZE || !payloadFits(header, pixels)) {
+        return false;
+    }
+
+    const QByteArray extension = extractBytes(image, PAYLOAD_HEADER_SIZE, SHARD_RECORD_SIZE);
+    const uchar* p = reinterpret_cast<const uchar*>(extension.constData());
+    record.setId = qFromBigEndian<quint32>(p);
+    record.index = p[4];
+    record.dataShards = p[5];
+    record.parityShards = p[6];
+    record.payloadSize = qFromBigEndian<quint32>(p + 7);
+
+    const int totalShards = record.dataShards + record.parityShards;
+    return record.dataShards >= 1 && totalShards <= MAX_CARRIERS && record.index < totalShards &&
+           qint64(record.payloadSize) <= qint64(record.dataShards) * header.length;
+}
+
+/**
+ * @brief Серіалізація запису фрагмента (11 байтів, big-endian).
+ *
+ * @param record Запис фрагмента.
+ * @return Байтове представлення запису.
+ */
+QByteArray SteganographyEngine::serializeShardRecord(const ShardRecord& record) {
+    QByteArray bytes(SHARD_RECORD_SIZE, '\0');
+    uchar* p = reinterpret_cast<uchar*>(bytes.data());
+
+    qToBigEndian<quint32>(record.setId, p);
+    p[4] = uchar(record.index);
+    p[5] = uchar(record.dataShards);
+    p[6] = uchar(record.parityShards);
+    qToBigEndian<quint32>(record.payloadSize, p + 7);
+
+    return bytes;
+}
+
+/**
+ * @brief Обробка кількох зображень паралельно.
+ *
+ * Зображення розподіляються в окремому пулі, а не в пулі смуг:
+ * завдання зображення саме чекає на свої смуги, і в спільному пулі
+ * всі потоки могли б зайняти завдання, що чекають. У послідовному
+ * режимі зображення обробляються по черзі в поточному потоці.
+ *
+ * @param count Кількість зображень.
+ * @param task Обробник зображення з номером i.
+ */
+void SteganographyEngine::runCarriers(int count, const std::function<void(int)>& task) {
+    const int threads = qMin(threadCount(), count);
+    if (threads <= 1) {
+        for (int i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    QThreadPool carrierPool;
+    carrierPool.setMaxThreadCount(threads);
+    QSemaphore finished;
+
+    for (int i = 0; i < count; ++i) {
+        carrierPool.start([&task, &finished, i] {
+            task(i);
+            finished.release();
+        });
+    }
+
+    // Чекаємо завершення всіх зображень.
+    finished.acquire(count);
+}
@@ -0,0 +1,313 @@
+/*
+ * SteganographyEngine_Steganalysis.cpp
+ *
+ * Реалізація статистичного стегоаналізу.
+ * Містить методи для виявлення довільного LSB-вбудовування
+ * та оцінки частки використаних молодших бітів.
+ */
+
+#include "SteganographyEngine.h"
+#include <QDebug>
+#include <QtMath>
+#include <QMutex>
+#include <QVector>
+#include <cmath>
+
+/* ============================================================================
+ *                      МЕТОДИ СТАТИСТИЧНОГО СТЕГОАНАЛІЗУ
+ * ============================================================================
+ */
+
+/**
+ * @brief Статистичний стегоаналіз зображення.
+ *
+ * Усі статистики збираються за один прохід по рядках (смугами паралельно):
+ *
+ * 1. Хі-квадрат атака: гістограми каналів для CHI_SQUARE_SEGMENTS
+ *    послідовних сегментів. LSB-вбудовування вирівнює частоти пар
+ *    значень (2k, 2k+1). Послідовне вбудовування (як у hideMessage)
+ *    починається з першого піксела, тому хі-квадрат обчислюється для
+ *    зростаючих префіксів зображення.
+ *
+ * 2. RS-аналіз: групи з 4 сусідніх значень каналу класифікуються як
+ *    регулярні (R) або сингулярні (S) за зміною гладкості після
+ *    інвертування молодших бітів маскою [0 1 1 0] (F1) та [0 -1 -1 0] (F-1).
+ *    Ті самі лічильники обчислюються для зображення з інвертованими LSB.
+ *
+ * 3. Аналіз пар пікселів: підрахунок множин пар сусідніх значень,
+ *    співвідношення яких змінюється при вбудовуванні.
+ *
+ * Внутрішні цикли працюють з цілими числами без розгалужень
+ * (порівняння додаються як 0/1), тому компілятор їх векторизує.
+ *
+ * @param image Зображення для аналізу.
+ * @return Оцінки частки вбудовування трьома методами.
+ */
+SteganalysisResult SteganographyEngine::analyzeStatistics(const QImage& image) {
+    SteganalysisResult result;
+
+    if (image.isNull() || image.width() < 4) {
+        qWarning() << "Image is too small for steganalysis!";
+        return result;
+    }
+
+    const QImage source = image.convertToFormat(QImage::Format_RGB32);
+    const int width = source.width();
+    const int height = source.height();
+    const int segments = qMin(CHI_SQUARE_SEGMENTS, height);
+
+    // Гістограми: [сегмент][канал][значення].
+    QVector<qint64> histograms(segments * 3 * 256, 0);
+    qint64 rsCounts[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    qint64 pairX = 0, pairY = 0, pairK = 0;
+    QMutex mutex;
+
+    // Інвертування молодшого біта "вниз": 2k -> 2k-1, 2k+1 -> 2k+2.
+    auto flipNegative = [](int value) { return ((value + 1) ^ 1) - 1; };
+
+    // Гладкість групи з 4 значень.
+    auto smoothness = [](int a, int b, int c, int d) {
+        return qAbs(b - a) + qAbs(c - b) + qAbs(d - c);
+    };
+
+    runBands(height, 1, PARALLEL_MIN_ROWS, [&](qint64 rowBegin, qint64 rowEnd) {
+        qint64 localHistogram[3][256] = {};
+        qint64 localRs[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+        qint64 localX = 0, localY = 0, localK = 0;
+        int currentSegment = int(rowBegin * segments / height);
+
+        // Перенесення гістограми сегмента до спільного масиву.
+        auto flushHistogram = [&]() {
+            QMutexLocker locker(&mutex);
+            qint64* target = histograms.data() + currentSegment * 3 * 256;
+            for (int c = 0; c < 3; ++c) {
+                for (int v = 0; v < 256; ++v) {
+                    target[c * 256 + v] += localHistogram[c][v];
+                    localHistogram[c][v] = 0;
+                }
+            }
+        };
+
+        QVector<int> channel(width);
+
+        for (qint64 y = rowBegin; y < rowEnd; ++y) {
+            const int segment = int(y * segments / height);
+            if (segment != currentSegment) {
+                flushHistogram();
+                currentSegment = segment;
+            }
+
+            const QRgb* line = reinterpret_cast<const QRgb*>(source.constScanLine(int(y)));
+
+            for (int c = 0; c < 3; ++c) {
+                const int shift = 16 - c * 8;
+                for (int x = 0; x < width; ++x) {
+                    channel[x] = (line[x] >> shift) & 0xFF;
+                    ++localHistogram[c][channel[x]];
+                }
+
+                // ========== Аналіз пар пікселів ==========
+                for (int x = 0; x + 1 < width; ++x) {
+                    const int r = channel[x];
+                    const int s = channel[x + 1];
+                    const int even = (s & 1) == 0;
+                    localX += (even & (r < s)) | (!even & (r > s));
+                    localY += (even & (r > s)) | (!even & (r < s));
+                    localK += (r >> 1) == (s >> 1);
+                }
+
+                // ========== RS-аналіз (групи по 4) ==========
+                for (int x = 0; x + 3 < width; x += 4) {
+                    const int v0 = channel[x];
+                    const int v1 = channel[x + 1];
+                    const int v2 = channel[x + 2];
+                    const int v3 = channel[x + 3];
+
+                    // Зображення як є.
+                    const int f = smoothness(v0, v1, v2, v3);
+                    const int fPositive = smoothness(v0, v1 ^ 1, v2 ^ 1, v3);
+                    const int fNegative = smoothness(v0, flipNegative(v1), flipNegative(v2), v3);
+                    localRs[0] += fPositive > f;
+                    localRs[1] += fPositive < f;
+                    localRs[2] += fNegative > f;
+                    localRs[3] += fNegative < f;
+
+                    // Зображення з інвертованими молодшими бітами.
+                    const int w0 = v0 ^ 1, w1 = v1 ^ 1, w2 = v2 ^ 1, w3 = v3 ^ 1;
+                    const int g = smoothness(w0, w1, w2, w3);
+                    const int gPositive = smoothness(w0, v1, v2, w3);
+                    const int gNegative = smoothness(w0, flipNegative(w1), flipNegative(w2), w3);
+                    localRs[4] += gPositive > g;
+                    localRs[5] += gPositive < g;
+                    localRs[6] += gNegative > g;
+                    localRs[7] += gNegative < g;
+                }
+            }
+        }
+
+        flushHistogram();
+
+        QMutexLocker locker(&mutex);
+        for (int i = 0; i < 8; ++i) {
+            rsCounts[i] += localRs[i];
+        }
+        pairX += localX;
+        pairY += localY;
+        pairK += localK;
+    });
+
+    // ========== КРОК 1: Хі-квадрат для зростаючих префіксів ==========
+    qint64 prefix[3][256] = {};
+    for (int segment = 0; segment < segments; ++segment) {
+        const qint64* segmentHistogram = histograms.constData() + segment * 3 * 256;
+        double chiSquare = 0.0;
+        int degrees = 0;
+
+        for (int c = 0; c < 3; ++c) {
+            for (int v = 0; v < 256; ++v) {
+                prefix[c][v] += segmentHistogram[c * 256 + v];
+            }
+
+            for (int v = 0; v < 256; v += 2) {
+                const double expected = (prefix[c][v] + prefix[c][v + 1]) / 2.0;
+                // Пари з малою частотою не дають надійної статистики.
+                if (expected < 5.0) {
+                    continue;
+                }
+                const double difference = prefix[c][v] - expected;
+                chiSquare += difference * difference / expected;
+                ++degrees;
+            }
+        }
+
+        const double probability = chiSquareProbability(chiSquare, degrees - 1);
+        if (segment == 0) {
+            result.chiSquareProbability = probability;
+        }
+        if (probability > 0.5) {
+            result.chiSquareRate = double(segment + 1) / segments;
+        } else {
+            break;
+        }
+    }
+
+    // ========== КРОК 2: RS-аналіз ==========
+    result.rsRate = estimateRsRate(rsCounts);
+
+    // ========== КРОК 3: Аналіз пар пікселів ==========
+    const qint64 pairs = qint64(width - 1) * height * 3;
+    result.samplePairRate = estimateSamplePairRate(pairX, pairY, pairK, pairs);
+
+    // ========== КРОК 4: Підсумкова оцінка ==========
+    // Хі-квадрат дає хибні спрацювання на зображеннях з гладкою гістограмою,
+    // тому рішення приймається за RS та аналізом пар пікселів.
+    result.estimatedRate = (result.rsRate + result.samplePairRate) / 2.0;
+    result.suspicious = result.estimatedRate > STEGANALYSIS_THRESHOLD;
+
+    return result;
+}
+
+/**
+ * @brief Ймовірність вбудовування за статистикою хі-квадрат.
+ *
+ * Повертає P(X > chiSquare) для розподілу хі-квадрат з degrees
+ * ступенями свободи. Для кількості ступенів свободи, що виникає тут
+ * (до 383), достатньо точна апроксимація Вільсона-Гілферті:
+ * (X/k)^(1/3) розподілена майже нормально з μ = 1 - 2/(9k), σ² = 2/(9k).
+ *
+ * Мале значення хі-квадрат означає вирівняні пари значень,
+ * тобто ймовірність вбудовування близька до 1.
+ *
+ * @param chiSquare Значення статистики хі-квадрат.
+ * @param degrees Кількість ступенів свободи.
+ * @return Ймовірність (0..1).
+ */
+double SteganographyEngine::chiSquareProbability(double chiSquare, int degrees) {
+    if (degrees < 1) {
+        return 0.0;
+    }
+
+    const double k = degrees;
+    const double variance = 2.0 / (9.0 * k);
+    const double z = (std::cbrt(chiSquare / k) - (1.0 - variance)) / qSqrt(variance);
+
+    return 0.5 * std::erfc(z / M_SQRT2);
+}
+
+/**
+ * @brief Оцінка частки вбудовування за статистикою RS-груп.
+ *
+ * Позначення (Fridrich, Goljan, Du):
+ * - d0 = R_M - S_M, d-0 = R_-M - S_-M для зображення.
+ * - d1, d-1 - те саме для зображення з інвертованими LSB.
+ *
+ * Частка вбудовування p знаходиться з квадратного рівняння
+ * 2(d1 + d0)x² + (d-0 - d-1 - d1 - 3d0)x + d0 - d-0 = 0,
+ * де береться менший за модулем корінь, а p = x / (x - 1/2).
+ *
+ * @param counts Лічильники R_M, S_M, R_-M, S_-M (зображення, потім інвертоване).
+ * @return Оцінка частки вбудовування (0..1).
+ */
+double SteganographyEngine::estimateRsRate(const qint64 counts[8]) {
+    const double d0 = double(counts[0] - counts[1]);
+    const double dn0 = double(counts[2] - counts[3]);
+    const double d1 = double(counts[4] - counts[5]);
+    const double dn1 = double(counts[6] - counts[7]);
+
+    const double a = 2.0 * (d1 + d0);
+    const double b = dn0 - dn1 - d1 - 3.0 * d0;
+    const double c = d0 - dn0;
+
+    double x = 0.0;
+    if (qAbs(a) < 1e-9) {
+        if (qAbs(b) < 1e-9) {
+            return 0.0;
+        }
+        x = -c / b;
+    } else {
+        const double discriminant = qMax(0.0, b * b - 4.0 * a * c);
+        const double root1 = (-b + qSqrt(discriminant)) / (2.0 * a);
+        const double root2 = (-b - qSqrt(discriminant)) / (2.0 * a);
+        x = qAbs(root1) < qAbs(root2) ? root1 : root2;
+    }
+
+    if (qAbs(x - 0.5) < 1e-9) {
+        return 1.0;
+    }
+
+    return qBound(0.0, x / (x - 0.5), 1.0);
+}
+
+/**
+ * @brief Оцінка частки вбудовування за статистикою пар пікселів.
+ *
+ * Для пар сусідніх значень (r, s):
+ * - X: s парне і r < s, або s непарне і r > s.
+ * - Y: s парне і r > s, або s непарне і r < s.
+ * - K: r та s відрізняються лише молодшим бітом (або рівні).
+ *
+ * У природних зображеннях |X| ≈ |Y|; вбудовування порушує цю рівність.
+ * Оцінка β - менший корінь рівняння 2K·β² + 2(2X - n)·β + (Y - X) = 0,
+ * частка вбудовування p = 2β.
+ *
+ * @param x Кількість пар множини X.
+ * @param y Кількість пар множини Y.
+ * @param k Кількість пар множини K.
+ * @param pairs Загальна кількість пар.
+ * @return Оцінка частки вбудовування (0..1).
+ */
+double SteganographyEngine::estimateSamplePairRate(qint64 x, qint64 y, qint64 k, qint64 pairs) {
+    if (k == 0) {
+        return 0.0;
+    }
+
+    const double a = 2.0 * k;
+    const double b = 2.0 * (2.0 * x - pairs);
+    const double c = double(y - x);
+    const double discriminant = qMax(0.0, b * b - 4.0 * a * c);
+
+    const double root1 = (-b + qSqrt(discriminant)) / (2.0 * a);
+    const double root2 = (-b - qSqrt(discriminant)) / (2.0 * a);
+
+    return qBound(0.0, 2.0 * qMin(root1, root2), 1.0);
+}
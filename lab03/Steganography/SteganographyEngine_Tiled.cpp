@@ -0,0 +1,337 @@
+/*
+ * SteganographyEngine_Tiled.cpp
+ *
+ * Реалізація поблокової обробки дуже великих зображень.
+ * Зображення читається та записується смугами рядків, тому
+ * пікова пам'ять не залежить від розміру зображення.
+ */
+
+#include "SteganographyEngine.h"
+#include "ImageStripReader.h"
+#include "PngStripWriter.h"
+#include <QDebug>
+#include <QFile>
+#include <numeric>
+
+/* ============================================================================
+ *                      МЕТОДИ ПОБЛОКОВОЇ ОБРОБКИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Приховування повідомлення з обробкою файлу смугами.
+ *
+ * Алгоритм:
+ * 1. Відкриваємо вхідний файл і зчитуємо лише розміри.
+ * 2. Формуємо навантаження та перевіряємо ємність.
+ * 3. Для кожної смуги рядків:
+ *    - зчитуємо смугу (RGB32);
+ *    - записуємо біти навантаження, що припадають на смугу;
+ *    - одразу дописуємо смугу у вихідний PNG.
+ *
+ * Смуга, що починається з рядка y0, містить біти носія
+ * [3 × width × y0, 3 × width × (y0 + rows)). Зміщення -3 × width × y0
+ * переводить номер біта носія в позицію всередині смуги.
+ * У режимі кількох бітів на канал дані записуються ядром бітових площин
+ * з першого піксела після заголовка. Альфа-канал не підтримується:
+ * вихідний файл записується як 8-бітний RGB PNG. Ключовий порядок
+ * пікселів також не підтримується: він розкидає дані по всьому
+ * зображенню, тоді як смуги записуються одна за одною.
+ *
+ * @param inputPath Шлях до вхідного зображення.
+ * @param outputPath Шлях до вихідного PNG.
+ * @param message Текстове повідомлення для приховування.
+ * @param encrypt Чи потрібно шифрувати повідомлення.
+ * @return true у разі успіху.
+ */
+bool SteganographyEngine::hideMessageTiled(const QString& inputPath,
+                                           const QString& outputPath,
+                                           const QString& message,
+                                           bool encrypt) {
+    if (message.isEmpty()) {
+        qWarning() << "Empty message!";
+        return false;
+    }
+
+    if (alphaPlane) {
+        qWarning() << "Alpha channel embedding is not supported in tiled mode!";
+        return false;
+    }
+
+    if (keyedOrder && !currentKey.isEmpty()) {
+        qWarning() << "Keyed pixel order is not supported in tiled mode!";
+        return false;
+    }
+
+    if (matrixEmbedding) {
+        qWarning() << "Matrix embedding is not supported in tiled mode!";
+        return false;
+    }
+
+    // ========== КРОК 1: Відкриваємо вхідний файл ==========
+    ImageStripReader reader(inputPath);
+    if (!reader.open()) {
+        qWarning() << "Cannot open image:" << inputPath << reader.errorString();
+        return false;
+    }
+
+    const int width = reader.size().width();
+    const int height = reader.size().height();
+
+    // ========== КРОК 2: Формуємо навантаження та перевіряємо ємність ==========
+    const QByteArray payload = buildPayload(message, encrypt);
+    const PayloadHeader header = parseHeader(payload);
+    const qint64 dataBytes = header.length;
+    const qint64 capacity = dataCapacity(header, qint64(width) * height);
+    qDebug() << "Payload:" << dataBytes << "bytes, available:" << capacity;
+
+    if (dataBytes > capacity) {
+        qWarning() << "Message too long for this image!";
+        qWarning() << "Required:" << dataBytes << "Available:" << capacity;
+        return false;
+    }
+
+    // 1 біт на канал: усе навантаження - суцільний потік бітів.
+    // Інакше потоком бітів записуються лише заголовок і розширення, а дані - площинами.
+    const qint64 headerBytes = qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize;
+    const bool planes = planeBits > 1;
+    const qint64 streamBits = planes ? headerBytes * 8 : qint64(payload.size()) * 8;
+    const qint64 planeDataBits = planes ? qint64(header.length) * 8 : 0;
+    const qint64 firstPixel = dataStartPixel(header);
+    const qint64 bitsPerPixel = qint64(planeBits) * 3;
+    const uchar* planeData = reinterpret_cast<const uchar*>(payload.constData()) + headerBytes;
+
+    PngStripWriter writer(outputPath);
+    if (!writer.open(width, height)) {
+        qWarning() << "Cannot create output file:" << outputPath << writer.errorString();
+        return false;
+    }
+
+    // ========== КРОК 3: Обробляємо смуги ==========
+    const int rows = tileRows(width);
+    const uchar* bytes = reinterpret_cast<const uchar*>(payload.constData());
+    qDebug() << "Tiled embedding:" << width << "x" << height << "," << rows << "rows per strip";
+
+    while (reader.currentRow() < height) {
+        const qint64 pixelBegin = qint64(reader.currentRow()) * width;
+        const qint64 stripBegin = pixelBegin * 3;
+
+        QImage strip = reader.readStrip(rows);
+        if (strip.isNull()) {
+            qWarning() << "Cannot read strip:" << reader.errorString();
+            return false;
+        }
+
+        uchar* pixels = strip.bits();
+        const qsizetype bytesPerLine = strip.bytesPerLine();
+        const qint64 pixelEnd = pixelBegin + qint64(strip.height()) * width;
+
+        // Біти потоку (1 біт на канал), що припадають на цю смугу.
+        const qint64 stripEnd = pixelEnd * 3;
+        const qint64 bitBegin = qMin(stripBegin, streamBits);
+        const qint64 bitEnd = qMin(stripEnd, streamBits);
+
+        if (bitBegin < bitEnd) {
+            // bitBegin кратний 3, тому межі смуг потоків збігаються з межами пікселів.
+            runBands(bitEnd - bitBegin, BAND_ALIGN_BITS, PARALLEL_MIN_BITS,
+                     [=](qint64 begin, qint64 end) {
+                embedBitRange(pixels, bytesPerLine, width, -stripBegin, bytes,
+                              bitBegin + begin, bitBegin + end);
+            });
+        }
+
+        // Біти даних у бітових площинах, що припадають на цю смугу.
+        const qint64 planeBegin = qMin(planeDataBits,
+                                       qMax<qint64>(0, pixelBegin - firstPixel) * bitsPerPixel);
+        const qint64 planeEnd = qMin(planeDataBits,
+                                     qMax<qint64>(0, pixelEnd - firstPixel) * bitsPerPixel);
+
+        if (planeBegin < planeEnd) {
+            const int bits = planeBits;
+            runBands(planeEnd - planeBegin, std::lcm(bitsPerPixel, qint64(8)), PARALLEL_MIN_BITS,
+                     [=](qint64 begin, qint64 end) {
+                embedPlaneRange(pixels, bytesPerLine, width, firstPixel - pixelBegin, planeData,
+                                planeBegin + begin, planeBegin + end, bits, 3);
+            });
+        }
+
+        if (!writer.writeStrip(strip)) {
+            qWarning() << "Cannot write strip:" << writer.errorString();
+            return false;
+        }
+    }
+
+    if (!writer.close()) {
+        qWarning() << "Cannot finish output file:" << writer.errorString();
+        return false;
+    }
+
+    qDebug() << "Total bytes hidden:" << payload.size();
+    qDebug() << "Tiled hiding completed successfully";
+
+    return true;
+}
+
+/**
+ * @brief Витягування повідомлення з обробкою файлу смугами.
+ *
+ * Алгоритм:
+ * 1. Зчитуємо смуги з початку зображення, доки не отримаємо заголовок.
+ * 2. Перевіряємо заголовок і визначаємо загальний розмір навантаження.
+ * 3. Продовжуємо читати смуги лише до кінця навантаження
+ *    (дані в кількох бітових площинах - ядром extractPlaneRange).
+ * 4. Дешифруємо, перевіряємо CRC-32 та декодуємо UTF-8.
+ *
+ * Якщо заголовок не знайдено, старий формат з маркерами витягується
+ * з повністю завантаженого зображення (його довжина заздалегідь невідома).
+ *
+ * @param inputPath Шлях до зображення.
+ * @param decrypt Чи потрібно розшифрувати повідомлення.
+ * @return Витягнуте повідомлення або повідомлення про помилку.
+ */
+QString SteganographyEngine::extractMessageTiled(const QString& inputPath, bool decrypt) {
+    ImageStripReader reader(inputPath);
+    if (!reader.open()) {
+        qWarning() << "Cannot open image:" << inputPath << reader.errorString();
+        return QString();
+    }
+
+    const int width = reader.size().width();
+    const int height = reader.size().height();
+    const int rows = tileRows(width);
+
+    // Потік бітів (1 біт на канал): спочатку потрібен лише заголовок.
+    QByteArray data(PAYLOAD_HEADER_SIZE, '\0');
+    qint64 neededBits = qint64(PAYLOAD_HEADER_SIZE) * 8;
+    qint64 bitsRead = 0;
+    bool headerFound = false;
+    PayloadHeader header;
+
+    // Дані в бітових площинах (режим кількох бітів на канал).
+    QByteArray planeData;
+    qint64 planeNeededBits = 0;
+    qint64 planeBitsRead = 0;
+    qint64 firstPixel = 0;
+    int bits = 1;
+
+    while (reader.currentRow() < height &&
+           (bitsRead < neededBits || planeBitsRead < planeNeededBits)) {
+        const qint64 pixelBegin = qint64(reader.currentRow()) * width;
+        const qint64 stripBegin = pixelBegin * 3;
+
+        const QImage strip = reader.readStrip(rows);
+        if (strip.isNull()) {
+            qWarning() << "Cannot read strip:" << reader.errorString();
+            return NOT_FOUND_MESSAGE;
+        }
+
+        const qint64 pixelEnd = pixelBegin + qint64(strip.height()) * width;
+        const qint64 stripEnd = pixelEnd * 3;
+
+        // Друга ітерація потрібна, якщо заголовок завершується в цій смузі,
+        // а дані навантаження продовжуються в ній же.
+        for (;;) {
+            const qint64 bitEnd = qMin(stripEnd, neededBits);
+            if (bitsRead < bitEnd) {
+                extractBitRange(strip.constBits(), strip.bytesPerLine(), width, -stripBegin,
+                                reinterpret_cast<uchar*>(data.data()), bitsRead, bitEnd);
+                bitsRead = bitEnd;
+            }
+
+            const qint64 planeEnd = qMin(planeNeededBits,
+                                         qMax<qint64>(0, pixelEnd - firstPixel) * bits * 3);
+            if (planeBitsRead < planeEnd) {
+                extractPlaneRange(strip.constBits(), strip.bytesPerLine(), width,
+                                  firstPixel - pixelBegin,
+                                  reinterpret_cast<uchar*>(planeData.data()),
+                                  planeBitsRead, planeEnd, bits, 3);
+                planeBitsRead = planeEnd;
+            }
+
+            if (headerFound || bitsRead < qint64(PAYLOAD_HEADER_SIZE) * 8) {
+                break;
+            }
+
+            // ========== Заголовок зчитано: перевіряємо ==========
+            header = parseHeader(data);
+            int channels = 3;
+            const bool planes = planeLayout(header, bits, channels);
+            const qint64 totalBytes = qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize + header.length;
+
+            // Код Ріда-Соломона виправляє помилки по всьому блоку.
+            if (header.magic == PAYLOAD_ECC_MAGIC) {
+                qDebug() << "Payload uses error correction, reading the whole image";
+                return extractMessage(QImage(inputPath), decrypt);
+            }
+
+            if (header.magic != PAYLOAD_MAGIC || !knownVersion(header.version) ||
+                !payloadFits(header, qint64(width) * height)) {
+                qDebug() << "Payload header not found, trying legacy marker format";
+                return extractLegacyMessage(QImage(inputPath).convertToFormat(QImage::Format_RGB32),
+                                            decrypt);
+            }
+
+            // Смуги не містять альфа-каналу - читаємо зображення повністю.
+            if (channels == 4) {
+                qDebug() << "Payload uses the alpha channel, reading the whole image";
+                return extractMessage(QImage(inputPath), decrypt);
+            }
+
+            // Ключовий порядок розкидає дані по всьому зображенню.
+            if (header.flags & FLAG_KEYED_ORDER) {
+                qDebug() << "Payload uses keyed pixel order, reading the whole image";
+                return extractMessage(QImage(inputPath), decrypt);
+            }
+
+            // Блоки коду Геммінга зчитуються з контейнера цілком.
+            if (matrixLayout(header)) {
+                qDebug() << "Payload uses matrix embedding, reading the whole image";
+                return extractMessage(QImage(inputPath), decrypt);
+            }
+
+            qDebug() << "Payload header found, length:" << header.length
+                     << "bytes, flags:" << header.flags;
+
+            headerFound = true;
+            if (!planes) {
+                data.append(QByteArray(totalBytes - PAYLOAD_HEADER_SIZE, '\0'));
+                neededBits = totalBytes * 8;
+            } else {
+                // Розширення заголовка - у потоці бітів, дані - у площинах.
+                data.append(QByteArray(header.extensionSize, '\0'));
+                neededBits = (qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize) * 8;
+                firstPixel = dataStartPixel(header);
+                planeData = QByteArray(header.length, '\0');
+                planeNeededBits = qint64(header.length) * 8;
+            }
+        }
+    }
+
+    if (!headerFound || bitsRead < neededBits || planeBitsRead < planeNeededBits) {
+        return NOT_FOUND_MESSAGE;
+    }
+
+    qDebug() << "Payload read from the first" << reader.currentRow() << "of" << height << "rows";
+
+    const QByteArray extension = data.mid(PAYLOAD_HEADER_SIZE, header.extensionSize);
+    if (planeNeededBits > 0) {
+        return decodePayload(header, extension, planeData, decrypt);
+    }
+
+    return decodePayload(header, extension,
+                         data.mid(PAYLOAD_HEADER_SIZE + header.extensionSize, header.length),
+                         decrypt);
+}
+
+/**
+ * @brief Кількість рядків у смузі для поблокової обробки.
+ *
+ * Смуга RGB32 займає не більше TILE_BYTES (але щонайменше один рядок).
+ *
+ * @param width Ширина зображення.
+ * @return Кількість рядків.
+ */
+int SteganographyEngine::tileRows(int width) const {
+    const qint64 rowBytes = qMax<qint64>(1, qint64(width) * 4);
+    return int(qBound<qint64>(1, TILE_BYTES / rowBytes, 1 << 20));
+}
@@ -0,0 +1,653 @@
+/*
+ * SteganographyEngine_Video.cpp
+ *
+ * Реалізація приховування повідомлень у молодших бітах площини
+ * яскравості (Y) кадрів нестисненого відео YUV4MPEG2.
+ * Файл відображається в пам'ять (Y4mFile) і змінюється на місці,
+ * кадри з даними обробляються паралельно.
+ */
+
+#include "SteganographyEngine.h"
+#include "KeyedPermutation.h"
+#include "Y4mFile.h"
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QtEndian>
+#include <QtMath>
+#include <optional>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define VIDEO_HAS_SSE2 1
+#include <emmintrin.h>
+#else
+#define VIDEO_HAS_SSE2 0
+#endif
+
+/// Пікселів за ітерацію векторного ядра (один регістр, 2 байти даних).
+static const qint64 SIMD_PIXELS = 16;
+
+/// Мінімальна кількість кадрів для паралельної обробки.
+static const qint64 PARALLEL_MIN_FRAMES = 2;
+
+/* ============================================================================
+ *                      ЯДРА ЗАПИСУ ТА ЗЧИТУВАННЯ ПІКСЕЛІВ
+ * ============================================================================
+ */
+
+/**
+ * @brief Розворот порядку бітів байта.
+ *
+ * @param value Байт.
+ * @return Байт з бітами у зворотному порядку.
+ */
+static inline uchar reverseBits(uint value) {
+    value = ((value & 0xF0) >> 4) | ((value & 0x0F) << 4);
+    value = ((value & 0xCC) >> 2) | ((value & 0x33) << 2);
+    value = ((value & 0xAA) >> 1) | ((value & 0x55) << 1);
+    return uchar(value);
+}
+
+/**
+ * @brief Запис діапазону бітів у молодші біти пікселів яскравості (ядро кадру).
+ *
+ * j-й піксель даних отримує біти [j × bits, (j + 1) × bits) потоку, старший
+ * біт - першим; неповне поле в кінці даних займає старші з bits бітів.
+ *
+ * Векторний шлях (1 біт, послідовний порядок): два байти даних
+ * розкладаються на 16 пікселів порівнянням з масками бітів (SSE2).
+ *
+ * @param luma Площина яскравості кадру.
+ * @param firstPixel Номер першого піксела даних.
+ * @param bytes Байти даних.
+ * @param bitBegin Перший біт діапазону (кратний 8).
+ * @param bitEnd Біт після останнього.
+ * @param bits Кількість бітів на піксель (1-4).
+ * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+ */
+static void embedLumaRange(uchar* luma, qint64 firstPixel, const uchar* bytes,
+                           qint64 bitBegin, qint64 bitEnd, int bits,
+                           const KeyedPermutation* order) {
+    qint64 k = bitBegin;
+
+#if VIDEO_HAS_SSE2
+    if (bits == 1 && !order) {
+        // Піксель 0 отримує біт 7 першого байта, піксель 15 - біт 0 другого.
+        const __m128i masks = _mm_setr_epi8(char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+                                            char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+        const __m128i keep = _mm_set1_epi8(char(0xFE));
+        const __m128i one = _mm_set1_epi8(1);
+
+        for (; k + SIMD_PIXELS <= bitEnd; k += SIMD_PIXELS) {
+            __m128i* out = reinterpret_cast<__m128i*>(luma + firstPixel + k);
+            const __m128i value = _mm_unpacklo_epi64(_mm_set1_epi8(char(bytes[k >> 3])),
+                                                     _mm_set1_epi8(char(bytes[(k >> 3) + 1])));
+            const __m128i bit = _mm_and_si128(
+                _mm_cmpeq_epi8(_mm_and_si128(value, masks), masks), one);
+            const __m128i pixels = _mm_loadu_si128(out);
+            _mm_storeu_si128(out, _mm_or_si128(_mm_and_si128(pixels, keep), bit));
+        }
+    }
+#endif
+
+    // Скалярний шлях (або залишок).
+    while (k < bitEnd) {
+        const qint64 j = k / bits;
+        const int fieldBits = int(qMin<qint64>(bits, bitEnd - k));
+
+        uint field = 0;
+        for (int b = 0; b < fieldBits; ++b, ++k) {
+            field = (field << 1) | ((bytes[k >> 3] >> (7 - (k & 7))) & 1);
+        }
+
+        const qint64 position = order ? qint64(order->map(quint64(j))) : j;
+        uchar* pixel = luma + firstPixel + position;
+        const int shift = bits - fieldBits;
+        const uint mask = ((1u << fieldBits) - 1) << shift;
+        *pixel = uchar((*pixel & ~mask) | (field << shift));
+    }
+}
+
+/**
+ * @brief Зчитування діапазону бітів з молодших бітів пікселів яскравості.
+ *
+ * Буфер bytes має бути обнулений: біти додаються через OR.
+ *
+ * Векторний шлях (1 біт, послідовний порядок): зсув на 7 бітів переносить
+ * молодший біт кожного байта в старший, _mm_movemask_epi8 збирає 16 бітів,
+ * порядок бітів у кожному байті розвертається (старший біт - перший піксель).
+ *
+ * @param luma Площина яскравості кадру.
+ * @param firstPixel Номер першого піксела даних.
+ * @param bytes Вихідні байти (обнулені).
+ * @param bitBegin Перший біт діапазону (кратний 8).
+ * @param bitEnd Біт після останнього.
+ * @param bits Кількість бітів на піксель (1-4).
+ * @param order Ключова перестановка пікселів даних (nullptr - послідовно).
+ */
+static void extractLumaRange(const uchar* luma, qint64 firstPixel, uchar* bytes,
+                             qint64 bitBegin, qint64 bitEnd, int bits,
+                             const KeyedPermutation* order) {
+    qint64 k = bitBegin;
+
+#if VIDEO_HAS_SSE2
+    if (bits == 1 && !order) {
+        for (; k + SIMD_PIXELS <= bitEnd; k += SIMD_PIXELS) {
+            // Біти, що переходять у сусідній байт, movemask не бачить.
+            const __m128i pixels = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(luma + firstPixel + k));
+            const int mask = _mm_movemask_epi8(_mm_slli_epi16(pixels, 7));
+            bytes[k >> 3] = reverseBits(uint(mask) & 0xFF);
+            bytes[(k >> 3) + 1] = reverseBits(uint(mask) >> 8);
+        }
+    }
+#endif
+
+    while (k < bitEnd) {
+        const qint64 j = k / bits;
+        const int fieldBits = int(qMin<qint64>(bits, bitEnd - k));
+        const qint64 position = order ? qint64(order->map(quint64(j))) : j;
+        const uint pixel = luma[firstPixel + position];
+
+        for (int b = 0; b < fieldBits; ++b, ++k) {
+            const uint bit = (pixel >> (bits - 1 - b)) & 1;
+            bytes[k >> 3] |= uchar(bit << (7 - (k & 7)));
+        }
+    }
+}
+
+/* ============================================================================
+ *                      МЕТОДИ ПРИХОВУВАННЯ В Y4M
+ * ============================================================================
+ */
+
+/**
+ * @brief Приховування повідомлення в площині яскравості кадрів Y4M.
+ *
+ * Алгоритм:
+ * 1. Формуємо навантаження; за ємністю кадру визначаємо найменшу
+ *    кількість кадрів і ділимо дані між ними порівну.
+ * 2. Копіюємо файл (потоково), якщо результат - інший файл.
+ * 3. Відображаємо файл результату в пам'ять для запису.
+ * 4. Записуємо частини даних у кадри паралельно (кадр - одна задача)
+ *    по bits бітів у піксель, в послідовному або ключовому порядку.
+ * 5. Записуємо заголовок і розширення (з діапазоном кадрів) по 1 біту
+ *    у перші пікселі кадру 0. Заголовок - останнім: якщо операцію
+ *    скасовано під час зміни файлу на місці, повідомлення не знаходиться.
+ *
+ * @param inputPath Шлях до вхідного Y4M.
+ * @param outputPath Шлях до вихідного Y4M (може збігатися з вхідним).
+ * @param message Текстове повідомлення для приховування.
+ * @param encrypt Чи потрібно шифрувати повідомлення.
+ * @param firstFrame Перший кадр для даних.
+ * @return true у разі успіху.
+ */
+bool SteganographyEngine::hideMessageY4m(const QString& inputPath, const QString& outputPath,
+                                         const QString& message, bool encrypt, int firstFrame) {
+    if (message.isEmpty()) {
+        qWarning() << "Empty message!";
+        return false;
+    }
+
+    // ========== КРОК 1: Навантаження та розподіл по кадрах ==========
+    QByteArray payload = buildPayload(message, videoHeader(encrypt));
+    const PayloadHeader header = parseHeader(payload);
+    const qint64 headerBytes = qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize;
+    const int bits = ((header.flags & FLAG_BITS_MASK) >> FLAG_BITS_SHIFT) + 1;
+
+    VideoRecord record;
+    record.firstFrame = firstFrame;
+    {
+        Y4mFile source(inputPath);
+        if (!source.open()) {
+            qWarning() << "Cannot read Y4M:" << inputPath << source.errorString();
+            return false;
+        }
+        if (firstFrame < 0 || firstFrame >= source.frameCount()) {
+            qWarning() << "First frame" << firstFrame << "is out of range, frames:"
+                       << source.frameCount();
+            return false;
+        }
+
+        // Кадр 0 менший на заголовок, тому частини рівняються за першим кадром.
+        const qint64 frameCapacity = videoFrameCapacity(header, source.lumaPixels(), firstFrame);
+        const qint64 framesLeft = source.frameCount() - firstFrame;
+        qDebug() << "Payload:" << header.length << "bytes, Y4M frame capacity:" << frameCapacity
+                 << "frames available:" << framesLeft << "bits per pixel:" << bits;
+
+        // Заголовок завжди в кадрі 0, навіть якщо дані починаються пізніше.
+        if (frameCapacity <= 0 || videoFrameCapacity(header, source.lumaPixels(), 0) < 0 ||
+            qint64(header.length) > frameCapacity * framesLeft) {
+            qWarning() << "Message too long for this file!";
+            qWarning() << "Required:" << header.length
+                       << "Available:" << qMax<qint64>(0, frameCapacity) * framesLeft;
+            return false;
+        }
+
+        record.frameCount = int((header.length + frameCapacity - 1) / frameCapacity);
+        record.frameBytes = quint32((header.length + record.frameCount - 1) / record.frameCount);
+    }
+
+    // Діапазон кадрів - після розширення шифру.
+    QByteArray recordBytes(VIDEO_RECORD_SIZE, '\0');
+    uchar* r = reinterpret_cast<uchar*>(recordBytes.data());
+    qToBigEndian<quint32>(quint32(record.firstFrame), r);
+    qToBigEndian<quint32>(quint32(record.frameCount), r + 4);
+    qToBigEndian<quint32>(record.frameBytes, r + 8);
+    payload.insert(int(headerBytes - VIDEO_RECORD_SIZE), recordBytes);
+
+    qDebug() << "Frames:" << record.firstFrame << "-" << record.firstFrame + record.frameCount - 1
+             << "," << record.frameBytes << "bytes per frame";
+
+    // ========== КРОК 2: Копія файлу ==========
+    const bool inPlace = QFileInfo(inputPath).absoluteFilePath() ==
+                         QFileInfo(outputPath).absoluteFilePath();
+    if (!inPlace) {
+        QFile::remove(outputPath);
+        if (!QFile::copy(inputPath, outputPath)) {
+            qWarning() << "Cannot copy Y4M to" << outputPath;
+            return false;
+        }
+    }
+
+    // ========== КРОК 3: Відображення для запису ==========
+    bool written = false;
+    {
+        Y4mFile target(outputPath);
+        if (!target.open(true)) {
+            qWarning() << "Cannot map Y4M for writing:" << outputPath << target.errorString();
+        } else {
+            const qint64 pixels = target.lumaPixels();
+            const qint64 headerPixels = headerBytes * 8;
+            const uchar* bytes = reinterpret_cast<const uchar*>(payload.constData());
+            const uchar* data = bytes + headerBytes;
+
+            // Кадр 0 має менше пікселів даних - для нього окрема перестановка.
+            std::optional<KeyedPermutation> order;
+            std::optional<KeyedPermutation> headerFrameOrder;
+            if (header.flags & FLAG_KEYED_ORDER) {
+                order.emplace(currentKey, quint64(pixels));
+                if (record.firstFrame == 0) {
+                    headerFrameOrder.emplace(currentKey, quint64(pixels - headerPixels));
+                }
+            }
+
+            // ========== КРОК 4: Дані по кадрах ==========
+            beginProgress(record.frameCount);
+            runBands(record.frameCount, 1, PARALLEL_MIN_FRAMES, [&](qint64 begin, qint64 end) {
+                for (qint64 i = begin; i < end; ++i) {
+                    const int frame = record.firstFrame + int(i);
+                    const qint64 offset = i * record.frameBytes;
+                    const qint64 chunk = qMin<qint64>(record.frameBytes, header.length - offset);
+                    const KeyedPermutation* permutation =
+                        frame == 0 ? (headerFrameOrder ? &*headerFrameOrder : nullptr)
+                                   : (order ? &*order : nullptr);
+
+                    embedLumaRange(target.luma(frame), frame == 0 ? headerPixels : 0,
+                                   data + offset, 0, chunk * 8, bits, permutation);
+                }
+            });
+
+            // ========== КРОК 5: Заголовок ==========
+            written = !isCancelled();
+            if (written) {
+                embedLumaRange(target.luma(0), 0, bytes, 0, headerPixels, 1, nullptr);
+            }
+            endProgress();
+        }
+    }
+
+    if (!written) {
+        if (!inPlace) {
+            QFile::remove(outputPath);
+        }
+        qWarning() << "Y4M hiding failed or was cancelled";
+        return false;
+    }
+
+    qDebug() << "Total bytes hidden:" << payload.size();
+    qDebug() << "Y4M hiding completed successfully";
+
+    return true;
+}
+
+/**
+ * @brief Витягування повідомлення з площини яскравості кадрів Y4M.
+ *
+ * Алгоритм:
+ * 1. Відкриваємо файл (заголовки кадрів, без читання площин).
+ * 2. Зчитуємо з кадру 0 заголовок і діапазон кадрів з даними.
+ * 3. Зчитуємо частини даних лише з цих кадрів, паралельно.
+ * 4. Дешифруємо, перевіряємо CRC-32 та декодуємо UTF-8.
+ *
+ * @param inputPath Шлях до Y4M.
+ * @param decrypt Чи потрібно розшифрувати повідомлення.
+ * @return Витягнуте повідомлення або повідомлення про помилку
+ *         (порожній рядок, якщо файл не вдалося прочитати).
+ */
+QString SteganographyEngine::extractMessageY4m(const QString& inputPath, bool decrypt) {
+    // ========== КРОК 1: Кадри ==========
+    Y4mFile video(inputPath);
+    if (!video.open()) {
+        qWarning() << "Cannot read Y4M:" << inputPath << video.errorString();
+        return QString();
+    }
+
+    // ========== КРОК 2: Заголовок та діапазон кадрів ==========
+    PayloadHeader header;
+    QByteArray extension;
+    VideoRecord record;
+    if (!readVideoHeader(video, header, extension, record)) {
+        qDebug() << "Y4M payload header not found";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    const int bits = ((header.flags & FLAG_BITS_MASK) >> FLAG_BITS_SHIFT) + 1;
+    qDebug() << "Y4M payload header found, length:" << header.length << "bytes in frames"
+             << record.firstFrame << "-" << record.firstFrame + record.frameCount - 1
+             << ", bits per pixel:" << bits << "flags:" << header.flags;
+
+    // ========== КРОК 3: Дані з кадрів діапазону ==========
+    // Порядок пікселів визначається ключем - без нього дані не знайти.
+    const qint64 pixels = video.lumaPixels();
+    const qint64 headerPixels = (qint64(PAYLOAD_HEADER_SIZE) + header.extensionSize) * 8;
+    std::optional<KeyedPermutation> order;
+    std::optional<KeyedPermutation> headerFrameOrder;
+    if (header.flags & FLAG_KEYED_ORDER) {
+        if (currentKey.isEmpty()) {
+            qWarning() << "Payload uses keyed pixel order, but no key was provided!";
+            return NOT_FOUND_MESSAGE;
+        }
+        order.emplace(currentKey, quint64(pixels));
+        if (record.firstFrame == 0) {
+            headerFrameOrder.emplace(currentKey, quint64(pixels - headerPixels));
+        }
+    }
+
+    QByteArray data(header.length, '\0');
+    uchar* bytes = reinterpret_cast<uchar*>(data.data());
+
+    beginProgress(record.frameCount);
+    runBands(record.frameCount, 1, PARALLEL_MIN_FRAMES, [&](qint64 begin, qint64 end) {
+        for (qint64 i = begin; i < end; ++i) {
+            const int frame = record.firstFrame + int(i);
+            const qint64 offset = i * record.frameBytes;
+            const qint64 chunk = qMin<qint64>(record.frameBytes, header.length - offset);
+            const KeyedPermutation* permutation =
+                frame == 0 ? (headerFrameOrder ? &*headerFrameOrder : nullptr)
+                           : (order ? &*order : nullptr);
+
+            extractLumaRange(video.constLuma(frame), frame == 0 ? headerPixels : 0,
+                             bytes + offset, 0, chunk * 8, bits, permutation);
+        }
+    });
+
+    const bool cancelled = isCancelled();
+    endProgress();
+    if (cancelled) {
+        qWarning() << "Extraction cancelled";
+        return NOT_FOUND_MESSAGE;
+    }
+
+    // ========== КРОК 4: Дешифруємо та перевіряємо ==========
+    return decodePayload(header, extension, data, decrypt);
+}
+
+/**
+ * @brief Ємність файлу Y4M у поточному режимі.
+ *
+ * Усі кадри несуть однакову частину даних, тому ємність - ємність
+ * першого кадру діапазону, помножена на кількість кадрів до кінця файлу.
+ *
+ * @param inputPath Шлях до Y4M.
+ * @param encrypt Чи буде повідомлення зашифроване.
+ * @param firstFrame Перший кадр для даних.
+ * @return Максимальна кількість байтів даних (-1, якщо файл не прочитано).
+ */
+qint64 SteganographyEngine::calculateY4mCapacity(const QString& inputPath, bool encrypt,
+                                                 int firstFrame) {
+    Y4mFile video(inputPath);
+    if (!video.open()) {
+        qWarning() << "Cannot read Y4M:" << inputPath << video.errorString();
+        return -1;
+    }
+    const PayloadHeader layout = videoHeader(encrypt);
+    if (firstFrame < 0 || firstFrame >= video.frameCount() ||
+        videoFrameCapacity(layout, video.lumaPixels(), 0) < 0) {
+        return 0;
+    }
+
+    const qint64 frameCapacity = videoFrameCapacity(layout, video.lumaPixels(), firstFrame);
+    return qMax<qint64>(0, frameCapacity) * (video.frameCount() - firstFrame);
+}
+
+/* ============================================================================
+ *                          АНАЛІЗ ЗМІН
+ * ============================================================================
+ */
+
+/**
+ * @brief Аналіз змін між оригінальним і модифікованим відео Y4M.
+ *
+ * Площини яскравості кадрів обгортаються в QImage (Format_Grayscale8,
+ * без копіювання) і порівнюються calculateQualityMetrics(), як
+ * зображення в analyzeChanges(). Порівнюються лише кадр 0 і кадри
+ * з діапазону в заголовку модифікованого файлу: інші кадри не змінюються.
+ *
+ * Підсумки:
+ * - MSE і SSIM - середні по порівняних кадрах.
+ * - PSNR - за середнім MSE, minPsnr - найгірший кадр.
+ *
+ * @param originalPath Шлях до оригінального Y4M.
+ * @param modifiedPath Шлях до модифікованого Y4M.
+ * @param message Приховане повідомлення.
+ * @return Структура з результатами аналізу.
+ */
+VideoAnalysisResult SteganographyEngine::analyzeVideoChanges(const QString& originalPath,
+                                                             const QString& modifiedPath,
+                                                             const QString& message) {
+    VideoAnalysisResult result;
+
+    Y4mFile original(originalPath);
+    Y4mFile modified(modifiedPath);
+    if (!original.open() || !modified.open()) {
+        qWarning() << "Cannot analyze Y4M:" << original.errorString() << modified.errorString();
+        return result;
+    }
+
+    // ========== Формат ==========
+    result.width = original.width();
+    result.height = original.height();
+    result.frameCount = original.frameCount();
+    result.frameRate = original.frameRate();
+    if (result.frameRate > 0) {
+        result.duration = result.frameCount / result.frameRate;
+    }
+    result.originalFileSize = QFileInfo(originalPath).size();
+    result.modifiedFileSize = QFileInfo(modifiedPath).size();
+
+    // ========== Інформація про повідомлення ==========
+    result.message = message;
+    result.messageLength = message.length();
+    result.messageBytes = message.toUtf8().size();
+    result.hasMessage = !message.isEmpty();
+    result.storedBytes = storedMessageSize(message);
+    result.compressed = result.storedBytes < result.messageBytes;
+
+    // Шифрування вибирається для кожного повідомлення, тому режим і розмір
+    // розширення беремо із записаного заголовка (без нього - без шифрування).
+    PayloadHeader header;
+    QByteArray extension;
+    VideoRecord record;
+    const bool headerFound = readVideoHeader(modified, header, extension, record);
+    const PayloadHeader layout = headerFound ? header : videoHeader(false);
+    const qint64 pixels = original.lumaPixels();
+    result.lsbBits = ((layout.flags & FLAG_BITS_MASK) >> FLAG_BITS_SHIFT) + 1;
+    result.keyedOrder = (layout.flags & FLAG_KEYED_ORDER) != 0;
+    result.bitsUsed = (qint64(PAYLOAD_HEADER_SIZE) + layout.extensionSize + result.storedBytes) * 8;
+    result.maxCapacity = qMax<qint64>(0, videoFrameCapacity(layout, pixels, 0)) * result.frameCount;
+    if (result.maxCapacity > 0) {
+        result.capacityUsed = (result.storedBytes / result.maxCapacity) * 100.0;
+    }
+
+    if (modified.width() != original.width() || modified.height() != original.height() ||
+        modified.frameCount() != original.frameCount()) {
+        qWarning() << "Cannot compare Y4M files with different formats!";
+        return result;
+    }
+
+    // ========== Кадри для порівняння ==========
+    QVector<int> compared;
+    if (headerFound) {
+        result.firstFrame = record.firstFrame;
+        result.framesUsed = record.frameCount;
+        if (record.firstFrame > 0) {
+            compared.append(0);
+        }
+        for (int i = 0; i < record.frameCount; ++i) {
+            compared.append(record.firstFrame + i);
+        }
+    } else {
+        for (int frame = 0; frame < result.frameCount; ++frame) {
+            compared.append(frame);
+        }
+    }
+
+    // ========== Метрики якості по кадрах ==========
+    // Кожен кадр - смугами рядків паралельно, кадри - по черзі.
+    double mseSum = 0.0;
+    double ssimSum = 0.0;
+    result.minPsnr = 100.0;
+
+    for (int frame : compared) {
+        const QImage first(original.constLuma(frame), result.width, result.height,
+                           result.width, QImage::Format_Grayscale8);
+        const QImage second(modified.constLuma(frame), result.width, result.height,
+                            result.width, QImage::Format_Grayscale8);
+
+        ImageAnalysisResult metrics;
+        calculateQualityMetrics(first, second, metrics);
+
+        VideoFrameQuality quality;
+        quality.frame = frame;
+        quality.psnr = metrics.psnr;
+        quality.mse = metrics.mse;
+        quality.ssim = metrics.ssim;
+        quality.modifiedPixels = metrics.modifiedPixels;
+        result.frames.append(quality);
+
+        mseSum += metrics.mse;
+        ssimSum += metrics.ssim;
+        result.modifiedPixels += metrics.modifiedPixels;
+        result.minPsnr = qMin(result.minPsnr, metrics.psnr);
+    }
+
+    result.mse = mseSum / compared.size();
+    result.ssim = ssimSum / compared.size();
+    result.psnr = result.mse == 0 ? 100.0 : 10.0 * log10(255.0 * 255.0 / result.mse);
+
+    if (result.modifiedPixels > 0) {
+        result.embeddingEfficiency = double(result.bitsUsed) / result.modifiedPixels;
+    }
+
+    return result;
+}
+
+/* ============================================================================
+ *                          РОЗМІЩЕННЯ ДАНИХ
+ * ============================================================================
+ */
+
+/**
+ * @brief Заголовок навантаження Y4M без довжини та CRC.
+ *
+ * Як audioHeader(), але розширення завжди містить діапазон кадрів
+ * (після даних шифру, якщо вони є).
+ *
+ * @param encrypt Чи буде навантаження зашифроване.
+ * @return Заголовок.
+ */
+PayloadHeader SteganographyEngine::videoHeader(bool encrypt) const {
+    PayloadHeader header = audioHeader(encrypt);
+    header.extensionSize += VIDEO_RECORD_SIZE;
+    return header;
+}
+
+/**
+ * @brief Ємність одного кадру для даних.
+ *
+ * Заголовок і розширення займають по 1 біту в перших (16 + розширення) × 8
+ * пікселях кадру 0; решта пікселів несе по k бітів.
+ *
+ * @param layout Заголовок з прапорцями режиму та розміром розширення.
+ * @param pixels Кількість пікселів площини яскравості.
+ * @param frame Номер кадру (кадр 0 містить і заголовок).
+ * @return Кількість байтів (від'ємна, якщо не вміщується заголовок).
+ */
+qint64 SteganographyEngine::videoFrameCapacity(const PayloadHeader& layout, qint64 pixels,
+                                               int frame) const {
+    const qint64 headerBytes = qint64(PAYLOAD_HEADER_SIZE) + layout.extensionSize;
+    const qint64 dataPixels = frame == 0 ? pixels - headerBytes * 8 : pixels;
+    if (dataPixels <= 0) {
+        return -headerBytes;
+    }
+
+    const int bits = ((layout.flags & FLAG_BITS_MASK) >> FLAG_BITS_SHIFT) + 1;
+    return dataPixels * bits / 8;
+}
+
+/**
+ * @brief Зчитування та перевірка заголовка навантаження з кадру 0.
+ *
+ * Розширення - дані шифру (якщо є) та діапазон кадрів: перший
+ * кадр (u32), кількість кадрів (u32), байтів на кадр (u32). Діапазон
+ * має вміщатися у файл, а частини - покривати рівно header.length байтів.
+ *
+ * @param video Відкритий файл Y4M.
+ * @param header Заголовок навантаження (вихідний параметр).
+ * @param extension Розширення заголовка (вихідний параметр).
+ * @param record Діапазон кадрів з даними (вихідний параметр).
+ * @return true якщо заголовок коректний і дані вміщуються в кадри.
+ */
+bool SteganographyEngine::readVideoHeader(const Y4mFile& video, PayloadHeader& header,
+                                          QByteArray& extension, VideoRecord& record) {
+    const qint64 pixels = video.lumaPixels();
+    if (pixels < qint64(PAYLOAD_HEADER_SIZE) * 8) {
+        return false;
+    }
+
+    QByteArray headerBytes(PAYLOAD_HEADER_SIZE, '\0');
+    extractLumaRange(video.constLuma(0), 0, reinterpret_cast<uchar*>(headerBytes.data()),
+                     0, qint64(PAYLOAD_HEADER_SIZE) * 8, 1, nullptr);
+
+    header = parseHeader(headerBytes);
+    const int cipherSize = cipherExtensionSize(header);
+    if (header.magic != PAYLOAD_MAGIC || !knownVersion(header.version) ||
+        header.extensionSize != cipherSize + VIDEO_RECORD_SIZE ||
+        videoFrameCapacity(header, pixels, 0) < 0) {
+        return false;
+    }
+
+    extension = QByteArray(header.extensionSize, '\0');
+    extractLumaRange(video.constLuma(0), qint64(PAYLOAD_HEADER_SIZE) * 8,
+                     reinterpret_cast<uchar*>(extension.data()),
+                     0, qint64(header.extensionSize) * 8, 1, nullptr);
+
+    const uchar* r = reinterpret_cast<const uchar*>(extension.constData()) + cipherSize;
+    const quint32 firstFrame = qFromBigEndian<quint32>(r);
+    const quint32 frameCount = qFromBigEndian<quint32>(r + 4);
+    record.frameBytes = qFromBigEndian<quint32>(r + 8);
+
+    const quint32 frames = quint32(video.frameCount());
+    if (firstFrame >= frames || frameCount == 0 || frameCount > frames - firstFrame) {
+        return false;
+    }
+    record.firstFrame = int(firstFrame);
+    record.frameCount = int(frameCount);
+
+    const qint64 length = header.length;
+    return record.frameBytes > 0 &&
+           qint64(record.frameBytes) <= videoFrameCapacity(header, pixels, record.firstFrame) &&
+           qint64(frameCount - 1) * record.frameBytes < length &&
+           qint64(frameCount) * record.frameBytes >= length;
+}
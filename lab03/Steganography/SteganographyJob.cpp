@@ -0,0 +1,287 @@
+/*
+ * SteganographyJob.cpp
+ *
+ * Реалізація фонового завдання стеганографії.
+ */
+
+#include "SteganographyJob.h"
+#include "PngWriter.h"
+#include <QImageReader>
+#include <QFileInfo>
+#include <QDir>
+#include <QDebug>
+
+/**
+ * @brief Конструктор.
+ *
+ * @param kind Тип завдання.
+ * @param image Зображення.
+ * @param message Повідомлення для приховування.
+ * @param useKey Шифрувати або дешифрувати поточним ключем.
+ * @param parent Батьківський об'єкт.
+ */
+SteganographyJob::SteganographyJob(Kind kind, const QImage& image, const QString& message,
+                                   bool useKey, QObject* parent)
+    : QObject(parent),
+    jobKind(kind),
+    image(image),
+    parityCount(0),
+    text(message),
+    useKey(useKey),
+    lastPercent(-1),
+    cancelRequested(0)
+{
+    // Завдання видаляє власник після сигналу завершення.
+    setAutoDelete(false);
+
+    stegoEngine.setProgressHandler([this](qint64 done, qint64 total) {
+        reportProgress(done, total);
+    });
+}
+
+/**
+ * @brief Движок завдання для налаштування перед запуском.
+ * @return Посилання на движок.
+ */
+SteganographyEngine& SteganographyJob::engine() {
+    return stegoEngine;
+}
+
+/**
+ * @brief Тип завдання.
+ * @return Hide або Extract.
+ */
+SteganographyJob::Kind SteganographyJob::kind() const {
+    return jobKind;
+}
+
+/**
+ * @brief Вхідне зображення завдання.
+ * @return Зображення.
+ */
+QImage SteganographyJob::sourceImage() const {
+    return image;
+}
+
+/**
+ * @brief Файл вхідного зображення.
+ * @return Шлях (порожній, якщо зображення передане в конструктор).
+ */
+QString SteganographyJob::sourcePath() const {
+    return imagePath;
+}
+
+/**
+ * @brief Повідомлення для приховування.
+ * @return Повідомлення.
+ */
+QString SteganographyJob::message() const {
+    return text;
+}
+
+/**
+ * @brief Встановлення файлу вхідного зображення.
+ *
+ * @param path Шлях до файлу.
+ * @param preview Піраміда перегляду файлу.
+ */
+void SteganographyJob::setSource(const QString& path, const ImagePreview& preview) {
+    imagePath = path;
+    inputPreview = preview;
+}
+
+/**
+ * @brief Встановлення набору зображень для розподіленого повідомлення.
+ *
+ * @param paths Файли зображень набору.
+ * @param parityShards Кількість фрагментів парності.
+ * @param outputDirectory Каталог для результатів.
+ */
+void SteganographyJob::setCarriers(const QStringList& paths, int parityShards,
+                                   const QString& outputDirectory) {
+    carrierPaths = paths;
+    parityCount = parityShards;
+    outputDir = outputDirectory;
+}
+
+/**
+ * @brief Файли, збережені завданням приховування набору.
+ * @return Шляхи в порядку набору.
+ */
+QStringList SteganographyJob::savedPaths() const {
+    return outputPaths;
+}
+
+/**
+ * @brief Піраміда перегляду вхідного зображення.
+ * @return Піраміда.
+ */
+ImagePreview SteganographyJob::sourcePreview() const {
+    return inputPreview;
+}
+
+/**
+ * @brief Піраміда перегляду результату приховування.
+ * @return Піраміда.
+ */
+ImagePreview SteganographyJob::resultPreview() const {
+    return outputPreview;
+}
+
+/**
+ * @brief Встановлення ключа шифрування завдання.
+ * @param key Ключ.
+ */
+void SteganographyJob::setKey(const QString& key) {
+    jobKey = key;
+    stegoEngine.setKey(key);
+}
+
+/**
+ * @brief Ключ шифрування завдання.
+ * @return Ключ.
+ */
+QString SteganographyJob::key() const {
+    return jobKey;
+}
+
+/**
+ * @brief Скасування завдання.
+ */
+void SteganographyJob::cancel() {
+    cancelRequested.storeRelaxed(1);
+    stegoEngine.cancel();
+}
+
+/**
+ * @brief Виконання завдання в робочому потоці.
+ *
+ * Скасоване до початку завдання одразу повідомляє про завершення.
+ * Повне зображення декодується лише тут - тоді, коли воно потрібне движку.
+ */
+void SteganographyJob::run() {
+    if (!carrierPaths.isEmpty()) {
+        runCarrierSet();
+        return;
+    }
+
+    if (image.isNull() && !imagePath.isEmpty() && !cancelRequested.loadRelaxed()) {
+        QImageReader reader(imagePath);
+        image = reader.read();
+        if (image.isNull()) {
+            qWarning() << "Job failed to load" << imagePath << ":" << reader.errorString();
+        }
+    }
+
+    if (jobKind == Kind::Hide) {
+        QImage result;
+        if (!cancelRequested.loadRelaxed() && !image.isNull()) {
+            result = stegoEngine.hideMessage(image, text, useKey);
+        }
+        if (!result.isNull()) {
+            // Перегляд будується тут, щоб потік інтерфейсу не масштабував повне зображення.
+            outputPreview = ImagePreview::fromImage(result);
+        }
+        const bool cancelled = cancelRequested.loadRelaxed() != 0;
+        emit hideFinished(cancelled ? QImage() : result, cancelled);
+    } else {
+        QString result;
+        if (!cancelRequested.loadRelaxed() && !image.isNull()) {
+            // Збереження в JPEG руйнує молодші біти пікселів, тому для JPEG
+            // спершу шукаємо повідомлення в коефіцієнтах DCT.
+            // Кожна спроба рахує прогрес з нуля, тому відсоток скидається перед нею.
+            if (QImageReader::imageFormat(imagePath) == "jpeg") {
+                lastPercent.storeRelaxed(-1);
+                result = stegoEngine.extractMessageJpeg(imagePath, useKey);
+            }
+            // endProgress() скидає запит скасування движка, тому скасоване
+            // витягування з коефіцієнтів не переходить до пікселів.
+            if ((result.isNull() || result == SteganographyEngine::NOT_FOUND_MESSAGE) &&
+                !cancelRequested.loadRelaxed()) {
+                lastPercent.storeRelaxed(-1);
+                result = stegoEngine.extractMessage(image, useKey);
+            }
+        }
+        const bool cancelled = cancelRequested.loadRelaxed() != 0;
+        emit extractFinished(cancelled ? QString() : result, cancelled);
+    }
+}
+
+/**
+ * @brief Виконання завдання для набору зображень.
+ *
+ * Результати зберігаються як "<ім'я>_<номер>.png": номер у назві
+ * розрізняє однойменні файли з різних каталогів. Якщо хоч один файл
+ * не збережено, завдання завершується з помилкою.
+ */
+void SteganographyJob::runCarrierSet() {
+    QVector<QImage> images;
+    for (const QString& path : std::as_const(carrierPaths)) {
+        if (cancelRequested.loadRelaxed()) {
+            break;
+        }
+        QImageReader reader(path);
+        const QImage carrier = reader.read();
+        if (carrier.isNull()) {
+            qWarning() << "Job failed to load" << path << ":" << reader.errorString();
+        } else if (image.isNull()) {
+            // Перше прочитане зображення - для перевірки завантаження у вікні.
+            image = carrier;
+        }
+        images.append(carrier);
+    }
+
+    if (jobKind == Kind::Hide) {
+        QVector<QImage> results;
+        if (!cancelRequested.loadRelaxed() && images.size() == carrierPaths.size()) {
+            results = stegoEngine.hideMessageShards(images, text, parityCount, useKey);
+        }
+
+        for (int i = 0; i < results.size() && !cancelRequested.loadRelaxed(); ++i) {
+            const QString path = QDir(outputDir).filePath(
+                QString("%1_%2.png").arg(QFileInfo(carrierPaths[i]).completeBaseName()).arg(i + 1));
+            PngWriter writer(path);
+            if (!writer.write(results[i])) {
+                qWarning() << "Job failed to save" << path;
+                outputPaths.clear();
+                results.clear();
+                break;
+            }
+            outputPaths.append(path);
+        }
+
+        const QImage result = results.isEmpty() ? QImage() : results.first();
+        if (!result.isNull()) {
+            outputPreview = ImagePreview::fromImage(result);
+        }
+        const bool cancelled = cancelRequested.loadRelaxed() != 0;
+        emit hideFinished(cancelled ? QImage() : result, cancelled);
+    } else {
+        QString result;
+        if (!cancelRequested.loadRelaxed() && !images.isEmpty()) {
+            result = stegoEngine.extractMessageShards(images, useKey);
+        }
+        const bool cancelled = cancelRequested.loadRelaxed() != 0;
+        emit extractFinished(cancelled ? QString() : result, cancelled);
+    }
+}
+
+/**
+ * @brief Перерахунок прогресу у відсотки та надсилання сигналу.
+ *
+ * @param done Виконана робота.
+ * @param total Загальна робота.
+ */
+void SteganographyJob::reportProgress(qint64 done, qint64 total) {
+    const int percent = int(qMin<qint64>(100, done * 100 / qMax<qint64>(1, total)));
+
+    // Надсилаємо лише новий більший відсоток (смуги завершуються в різних потоках).
+    int previous = lastPercent.loadRelaxed();
+    while (percent > previous) {
+        if (lastPercent.testAndSetRelaxed(previous, percent)) {
+            emit progressChanged(percent);
+            return;
+        }
+        previous = lastPercent.loadRelaxed();
+    }
+}
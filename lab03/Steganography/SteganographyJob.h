@@ -0,0 +1,223 @@
+/*
+ * SteganographyJob.h
+ *
+ * Заголовочний файл фонового завдання стеганографії.
+ * Приховування або витягування виконується в пулі потоків, а прогрес
+ * та результат передаються в потік інтерфейсу сигналами.
+ *
+ * Основні можливості:
+ * - Власний движок з налаштуваннями, скопійованими під час постановки в чергу.
+ * - Реальний прогрес (оброблені біти / загальна кількість) у відсотках.
+ * - Кооперативне скасування (до початку або під час виконання).
+ * - Повне декодування вхідного файлу та побудова перегляду результату
+ *   в робочому потоці.
+ * - Набір зображень для повідомлення, розподіленого між кількома
+ *   контейнерами (приховування зберігає результати в каталог).
+ */
+
+#ifndef STEGANOGRAPHYJOB_H
+#define STEGANOGRAPHYJOB_H
+
+#include <QObject>
+#include <QRunnable>
+#include <QImage>
+#include <QString>
+#include <QStringList>
+#include <QAtomicInt>
+#include "SteganographyEngine.h"
+#include "ImagePreview.h"
+
+/**
+ * @class SteganographyJob
+ * @brief Фонове завдання приховування або витягування повідомлення.
+ *
+ * Завдання створюється в потоці інтерфейсу, налаштовується через engine()
+ * і запускається в QThreadPool. Сигнали надсилаються з робочих потоків,
+ * тому отримувачі в потоці інтерфейсу отримують їх через чергу подій.
+ * Завдання не видаляється пулом: після сигналу завершення його слід
+ * видалити через deleteLater().
+ */
+class SteganographyJob : public QObject, public QRunnable {
+    Q_OBJECT
+
+public:
+    /**
+     * @enum Kind
+     * @brief Тип завдання.
+     */
+    enum class Kind {
+        Hide,     ///< Приховування повідомлення.
+        Extract   ///< Витягування повідомлення.
+    };
+
+    /**
+     * @brief Конструктор.
+     *
+     * @param kind Тип завдання.
+     * @param image Зображення (порожнє - буде прочитане з setSource()).
+     * @param message Повідомлення для приховування (для витягування - порожнє).
+     * @param useKey Шифрувати (Hide) або дешифрувати (Extract) поточним ключем.
+     * @param parent Батьківський об'єкт.
+     */
+    SteganographyJob(Kind kind, const QImage& image, const QString& message,
+                     bool useKey, QObject* parent = nullptr);
+
+    /**
+     * @brief Движок завдання для налаштування перед запуском.
+     * @return Посилання на движок.
+     */
+    SteganographyEngine& engine();
+
+    /**
+     * @brief Тип завдання.
+     * @return Hide або Extract.
+     */
+    Kind kind() const;
+
+    /**
+     * @brief Вхідне зображення завдання.
+     * @return Зображення.
+     */
+    QImage sourceImage() const;
+
+    /**
+     * @brief Файл вхідного зображення.
+     * @return Шлях (порожній, якщо зображення передане в конструктор).
+     */
+    QString sourcePath() const;
+
+    /**
+     * @brief Встановлення файлу вхідного зображення.
+     *
+     * Якщо зображення не передане в конструктор, воно декодується
+     * з файлу на початку run(), а не в потоці інтерфейсу.
+     *
+     * @param path Шлях до файлу.
+     * @param preview Піраміда перегляду цього файлу (для показу результату).
+     */
+    void setSource(const QString& path, const ImagePreview& preview);
+
+    /**
+     * @brief Встановлення набору зображень для розподіленого повідомлення.
+     *
+     * Завдання приховування розподіляє повідомлення між усіма
+     * зображеннями набору і зберігає результати у форматі PNG
+     * в outputDirectory; завдання витягування відновлює повідомлення
+     * з набору (нечитабельні файли вважаються втраченими фрагментами).
+     * Першим у наборі має бути файл із setSource(), якщо його задано.
+     *
+     * @param paths Файли зображень набору.
+     * @param parityShards Кількість фрагментів парності (лише для приховування).
+     * @param outputDirectory Каталог для результатів (лише для приховування).
+     */
+    void setCarriers(const QStringList& paths, int parityShards = 0,
+                     const QString& outputDirectory = QString());
+
+    /**
+     * @brief Файли, збережені завданням приховування набору.
+     * @return Шляхи в порядку набору (порожній список - набір не збережено).
+     */
+    QStringList savedPaths() const;
+
+    /**
+     * @brief Піраміда перегляду вхідного зображення.
+     * @return Піраміда, передана в setSource().
+     */
+    ImagePreview sourcePreview() const;
+
+    /**
+     * @brief Піраміда перегляду результату приховування.
+     * @return Піраміда (порожня, якщо приховування не вдалося).
+     */
+    ImagePreview resultPreview() const;
+
+    /**
+     * @brief Повідомлення для приховування.
+     * @return Повідомлення (для витягування - порожнє).
+     */
+    QString message() const;
+
+    /**
+     * @brief Встановлення ключа шифрування завдання.
+     * @param key Ключ.
+     */
+    void setKey(const QString& key);
+
+    /**
+     * @brief Ключ шифрування завдання.
+     * @return Ключ (порожній, якщо не встановлений).
+     */
+    QString key() const;
+
+    /**
+     * @brief Скасування завдання (потокобезпечне).
+     *
+     * Завдання в черзі завершується одразу, поточне - після смуг,
+     * що вже виконуються.
+     */
+    void cancel();
+
+    /**
+     * @brief Виконання завдання в робочому потоці.
+     */
+    void run() override;
+
+signals:
+    /**
+     * @brief Зміна прогресу.
+     * @param percent Відсоток виконання (0-100).
+     */
+    void progressChanged(int percent);
+
+    /**
+     * @brief Завершення приховування.
+     * @param result Зображення з повідомленням (пусте у разі помилки або скасування).
+     * @param cancelled Чи було завдання скасоване.
+     */
+    void hideFinished(const QImage& result, bool cancelled);
+
+    /**
+     * @brief Завершення витягування.
+     * @param message Витягнуте повідомлення (порожнє при скасуванні).
+     * @param cancelled Чи було завдання скасоване.
+     */
+    void extractFinished(const QString& message, bool cancelled);
+
+private:
+    /**
+     * @brief Перерахунок прогресу у відсотки та надсилання сигналу.
+     *
+     * Викликається з потоків пулу движка; сигнал надсилається лише
+     * при збільшенні відсотка, щоб не переповнювати чергу подій.
+     *
+     * @param done Виконана робота.
+     * @param total Загальна робота.
+     */
+    void reportProgress(qint64 done, qint64 total);
+
+    /**
+     * @brief Виконання завдання для набору зображень.
+     *
+     * Декодує всі файли набору, викликає движок для набору і
+     * (для приховування) зберігає результати.
+     */
+    void runCarrierSet();
+
+    Kind jobKind;                  ///< Тип завдання.
+    QImage image;                  ///< Вхідне зображення.
+    QString imagePath;             ///< Файл вхідного зображення.
+    ImagePreview inputPreview;     ///< Перегляд вхідного зображення.
+    ImagePreview outputPreview;    ///< Перегляд результату приховування.
+    QStringList carrierPaths;      ///< Файли набору зображень.
+    int parityCount;               ///< Кількість фрагментів парності набору.
+    QString outputDir;             ///< Каталог для результатів набору.
+    QStringList outputPaths;       ///< Збережені результати набору.
+    QString text;                  ///< Повідомлення для приховування.
+    QString jobKey;                ///< Ключ шифрування.
+    bool useKey;                   ///< Шифрувати або дешифрувати.
+    SteganographyEngine stegoEngine;  ///< Движок завдання.
+    QAtomicInt lastPercent;        ///< Останній надісланий відсоток.
+    QAtomicInt cancelRequested;    ///< Запит на скасування.
+};
+
+#endif // STEGANOGRAPHYJOB_H
@@ -30,7 +30,7 @@
  * @brief Конструктор головного вікна.
  *
  * Виконує повну ініціалізацію вікна:
- * 1. Створює об'єкт движка стеганографії.
+ * 1. Створює об'єкт движка стеганографії (у паралельному режимі).
  * 2. Налаштовує графічний інтерфейс.
  * 3. Застосовує темну тему.
  * 4. Встановлює параметри вікна.
@@ -39,8 +39,27 @@
  */
 SteganographyWindow::SteganographyWindow(QWidget *parent)
     : QMainWindow(parent),
-    stegoEngine(new SteganographyEngine())
+    stegoEngine(new SteganographyEngine()),
+    imageLoader(new ImageLoader(this)),
+    hidePreviewRequest(0),
+    extractPreviewRequest(0),
+    analysisOriginalRequest(0),
+    analysisModifiedRequest(0)
 {
+    // Обробляємо великі зображення смугами на всіх ядрах процесора.
+    stegoEngine->setParallelMode(true);
+
+    // Фонові завдання виконуються по одному: кожне вже займає всі ядра.
+    jobPool.setMaxThreadCount(1);
+
+    // Зображення декодуються у фоні; результати приходять сигналами.
+    connect(imageLoader, &ImageLoader::previewReady,
+            this, &SteganographyWindow::onPreviewReady);
+    connect(imageLoader, &ImageLoader::imageReady,
+            this, &SteganographyWindow::onImageReady);
+    connect(imageLoader, &ImageLoader::loadFailed,
+            this, &SteganographyWindow::onImageLoadFailed);
+
     // Створюємо та налаштовуємо UI.
     setupUI();
 
@@ -60,9 +79,18 @@ SteganographyWindow::SteganographyWindow(QWidget *parent)
 /**
  * @brief Деструктор.
  *
- * Звільняє виділену пам'ять.
+ * Скасовує фонові завдання, чекає їх завершення та звільняє виділену пам'ять.
  */
 SteganographyWindow::~SteganographyWindow() {
+    // Завдання посилаються на вікно сигналами - зупиняємо їх до знищення.
+    for (SteganographyJob* job : std::as_const(hideJobs)) {
+        job->cancel();
+    }
+    for (SteganographyJob* job : std::as_const(extractJobs)) {
+        job->cancel();
+    }
+    jobPool.waitForDone();
+
     // Видаляємо об'єкт движка стеганографії.
     delete stegoEngine;
 }
@@ -200,3 +228,32 @@ void SteganographyWindow::displayImagePreview(QLabel* label,
                                    Qt::KeepAspectRatio,
                                    Qt::SmoothTransformation));
 }
+
+/**
+ * @brief Відображення попереднього перегляду з піраміди.
+ *
+ * @param label Мітка для відображення.
+ * @param preview Піраміда перегляду.
+ */
+void SteganographyWindow::displayImagePreview(QLabel* label, const ImagePreview& preview) {
+    if (label == nullptr || preview.isNull()) {
+        return;
+    }
+
+    label->setPixmap(QPixmap::fromImage(preview.scaled(label->size())));
+}
+
+/**
+ * @brief Зміна розміру вікна.
+ *
+ * Мітки вкладок приховування та витягування розтягуються разом з вікном,
+ * тому перегляд оновлюється з піраміди під новий розмір.
+ *
+ * @param event Подія зміни розміру.
+ */
+void SteganographyWindow::resizeEvent(QResizeEvent* event) {
+    QMainWindow::resizeEvent(event);
+
+    displayImagePreview(hide_imageLabel, originalPreview);
+    displayImagePreview(extract_imageLabel, extractPreview);
+}
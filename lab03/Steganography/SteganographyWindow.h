@@ -24,7 +24,15 @@
 #include <QTableWidget>
 #include <QProgressBar>
 #include <QCheckBox>
+#include <QSpinBox>
+#include <QComboBox>
+#include <QThreadPool>
+#include <QList>
 #include "SteganographyEngine.h"
+#include "SteganographyJob.h"
+#include "ImageLoader.h"
+#include "ImagePreview.h"
+#include "LsbVisualizer.h"
 
 /**
  * @class SteganographyWindow
@@ -55,6 +63,16 @@ public:
      */
     ~SteganographyWindow();
 
+protected:
+    /**
+     * @brief Зміна розміру вікна.
+     *
+     * Перемальовує попередній перегляд з пірамід (без повних зображень).
+     *
+     * @param event Подія зміни розміру.
+     */
+    void resizeEvent(QResizeEvent* event) override;
+
 private slots:
     // ========== Обробники подій (Slots) ==========
 
@@ -128,6 +146,75 @@ private slots:
      */
     void clearExtractTab();
 
+    // ========== Фонові завдання ==========
+
+    /**
+     * @brief Оновлення прогресу поточного завдання приховування.
+     * @param percent Відсоток виконання.
+     */
+    void onHideProgress(int percent);
+
+    /**
+     * @brief Завершення завдання приховування.
+     *
+     * Відображає результат і зберігає пару "оригінал - повідомлення"
+     * для аналізу.
+     *
+     * @param result Зображення з повідомленням (пусте у разі помилки).
+     * @param cancelled Чи було завдання скасоване.
+     */
+    void onHideFinished(const QImage& result, bool cancelled);
+
+    /**
+     * @brief Оновлення прогресу поточного завдання витягування.
+     * @param percent Відсоток виконання.
+     */
+    void onExtractProgress(int percent);
+
+    /**
+     * @brief Завершення завдання витягування.
+     * @param message Витягнуте повідомлення.
+     * @param cancelled Чи було завдання скасоване.
+     */
+    void onExtractFinished(const QString& message, bool cancelled);
+
+    /**
+     * @brief Скасування всіх завдань приховування (поточного та в черзі).
+     */
+    void cancelHideJobs();
+
+    /**
+     * @brief Скасування всіх завдань витягування (поточного та в черзі).
+     */
+    void cancelExtractJobs();
+
+    // ========== Фонове завантаження зображень ==========
+
+    /**
+     * @brief Попередній перегляд вибраного файлу готовий.
+     * @param requestId Номер запиту.
+     * @param path Шлях до файлу.
+     * @param preview Піраміда перегляду.
+     */
+    void onPreviewReady(int requestId, const QString& path, const ImagePreview& preview);
+
+    /**
+     * @brief Повне зображення для вкладки аналізу готове.
+     * @param requestId Номер запиту.
+     * @param path Шлях до файлу.
+     * @param image Повне зображення.
+     * @param preview Піраміда перегляду.
+     */
+    void onImageReady(int requestId, const QString& path, const QImage& image,
+                      const ImagePreview& preview);
+
+    /**
+     * @brief Не вдалося завантажити вибраний файл.
+     * @param requestId Номер запиту.
+     * @param path Шлях до файлу.
+     */
+    void onImageLoadFailed(int requestId, const QString& path);
+
 private:
     // ========== Методи створення UI ==========
 
@@ -179,6 +266,16 @@ private:
      */
     void displayImagePreview(QLabel* label, const QImage& image, const QString& info);
 
+    /**
+     * @brief Відображення попереднього перегляду з піраміди.
+     *
+     * Масштабується найближчий рівень піраміди, а не повне зображення.
+     *
+     * @param label Мітка для відображення.
+     * @param preview Піраміда перегляду.
+     */
+    void displayImagePreview(QLabel* label, const ImagePreview& preview);
+
     /**
      * @brief Відображення результатів аналізу в таблиці.
      * @param result Структура з результатами.
@@ -191,6 +288,49 @@ private:
      */
     QIcon createProgramIcon();
 
+    /**
+     * @brief Застосування налаштувань вкладки приховування до движка.
+     *
+     * Використовується і для перевірки ємності, і для движка завдання,
+     * тому обидва бачать однакові параметри.
+     *
+     * @param engine Движок для налаштування.
+     */
+    void applyHideSettings(SteganographyEngine& engine) const;
+
+    /**
+     * @brief Вибір набору зображень для повідомлення, що не вміщується в одне.
+     *
+     * Послідовно запитує додаткові зображення, кількість фрагментів
+     * парності та каталог для результатів і перевіряє ємність набору.
+     *
+     * @param storedBytes Розмір повідомлення після стиснення.
+     * @param encrypt Чи буде повідомлення зашифроване.
+     * @param carriers Файли набору, перший - поточне зображення (вихідний параметр).
+     * @param parityShards Кількість фрагментів парності (вихідний параметр).
+     * @param outputDirectory Каталог для результатів (вихідний параметр).
+     * @return false якщо користувач скасував вибір або набір замалий.
+     */
+    bool selectCarrierSet(qint64 storedBytes, bool encrypt, QStringList& carriers,
+                          int& parityShards, QString& outputDirectory);
+
+    /**
+     * @brief Збереження результату приховування у форматі JPEG.
+     *
+     * Перекодування пікселів у JPEG знищило б повідомлення, тому воно
+     * повторно вбудовується в коефіцієнти DCT оригіналу (лише якщо
+     * оригінал - JPEG); інакше користувачу пропонується PNG.
+     *
+     * @param fileName Шлях до вихідного JPEG.
+     * @return true у разі успіху.
+     */
+    bool saveJpegResult(const QString& fileName);
+
+    /**
+     * @brief Оновлення прогрес-барів, міток черги та кнопок скасування.
+     */
+    void updateJobStatus();
+
     // ========== UI елементи ==========
 
     /// Головний віджет з вкладками.
@@ -240,9 +380,36 @@ private:
     /// Поле показу згенерованого ключа.
     QLineEdit* hide_generatedKeyEdit;
 
+    /// Кількість молодших бітів на канал (1-4).
+    QSpinBox* hide_bitsPerChannelSpinBox;
+
+    /// Чекбокс "Використовувати альфа-канал".
+    QCheckBox* hide_alphaCheckBox;
+
+    /// Чекбокс "Перемішувати пікселі ключем" (діє разом із шифруванням).
+    QCheckBox* hide_keyedOrderCheckBox;
+
+    /// Чекбокс "Стискати повідомлення" (deflate перед вбудовуванням).
+    QCheckBox* hide_compressCheckBox;
+
+    /// Чекбокс "Матричне вбудовування" (коди Геммінга, 1 біт на канал).
+    QCheckBox* hide_matrixCheckBox;
+
+    /// Символів парності коду Ріда-Соломона (0 - без коду).
+    QSpinBox* hide_eccSpinBox;
+
     /// Прогрес-бар процесу приховування.
     QProgressBar* hide_progressBar;
 
+    /// Кнопка скасування завдань приховування.
+    QPushButton* hide_cancelBtn;
+
+    /// Мітка кількості завдань приховування в черзі.
+    QLabel* hide_queueLabel;
+
+    /// Кнопка збереження результату (активна після успішного приховування).
+    QPushButton* hide_saveBtn;
+
     // ===== ВКЛАДКА 2: ВИТЯГУВАННЯ =====
 
     /// Мітка для показу зображення з повідомленням.
@@ -272,6 +439,12 @@ private:
     /// Прогрес-бар процесу витягування.
     QProgressBar* extract_progressBar;
 
+    /// Кнопка скасування завдань витягування.
+    QPushButton* extract_cancelBtn;
+
+    /// Мітка кількості завдань витягування в черзі.
+    QLabel* extract_queueLabel;
+
     // ===== ВКЛАДКА 3: АНАЛІЗ ЗОБРАЖЕННЯ =====
 
     /// Таблиця порівняльних даних.
@@ -289,6 +462,12 @@ private:
     /// Кнопка запуску аналізу.
     QPushButton* analyzeBtn;
 
+    /// Перегляд бітових площин та теплової карти різниці.
+    LsbVisualizer* analysis_visualizer;
+
+    /// Вибір режиму перегляду (площина каналу або різниця).
+    QComboBox* analysis_planeCombo;
+
     // ===== ВКЛАДКА 4: ПОКРОКОВИЙ АЛГОРИТМ =====
 
     /// Текстове поле з поясненням алгоритму.
@@ -299,17 +478,58 @@ private:
     /// Об'єкт движка стеганографії.
     SteganographyEngine* stegoEngine;
 
-    /// Оригінальне зображення.
-    QImage originalImage;
+    /// Фоновий завантажувач зображень.
+    ImageLoader* imageLoader;
+
+    /// Перегляд вибраного оригіналу (повне зображення декодує завдання).
+    ImagePreview originalPreview;
 
     /// Модифіковане зображення (з повідомленням).
     QImage modifiedImage;
 
+    /// Перегляд модифікованого зображення.
+    ImagePreview modifiedPreview;
+
+    /// Перегляд зображення для витягування.
+    ImagePreview extractPreview;
+
+    /// Номери запитів завантажувача, результат яких ще очікується
+    /// (0 - немає; результати інших запитів застарілі й ігноруються).
+    int hidePreviewRequest;
+    int extractPreviewRequest;
+    int analysisOriginalRequest;
+    int analysisModifiedRequest;
+
+    /// Оригінал, з якого отримано modifiedImage (для аналізу).
+    QImage hiddenSourceImage;
+
+    /// Повідомлення, приховане в modifiedImage (для аналізу).
+    QString hiddenMessage;
+
+    /// Файл оригіналу та ключ останнього приховування
+    /// (для повторного вбудовування в коефіцієнти DCT при збереженні в JPEG).
+    QString hiddenSourcePath;
+    QString hiddenKey;
+
+    /// Пул фонових завдань (один потік: завдання виконуються по черзі,
+    /// а паралельність забезпечує движок всередині завдання).
+    QThreadPool jobPool;
+
+    /// Завдання приховування (перше - поточне, решта - в черзі).
+    QList<SteganographyJob*> hideJobs;
+
+    /// Завдання витягування (перше - поточне, решта - в черзі).
+    QList<SteganographyJob*> extractJobs;
+
     /// Шлях до поточного зображення (приховування).
     QString currentImagePath;
 
     /// Шлях до зображення для витягування.
     QString extractImagePath;
+
+    /// Набір зображень для витягування розподіленого повідомлення
+    /// (порожній - вибране одне зображення).
+    QStringList extractCarrierPaths;
 };
 
 #endif // STEGANOGRAPHYWINDOW_H
@@ -8,6 +8,10 @@
 #include "SteganographyWindow.h"
 #include <QTableWidget>
 #include <QTableWidgetItem>
+#include <QFileDialog>
+#include <QImageReader>
+#include <QInputDialog>
+#include <QMessageBox>
 
 /*
  * ============================================================================
@@ -252,9 +256,9 @@ void SteganographyWindow::displayAnalysisResults(const ImageAnalysisResult& resu
     analysisTable->setItem(3, 0, new QTableWidgetItem("Використана ємність"));
     analysisTable->setItem(3, 1, new QTableWidgetItem("-"));
     analysisTable->setItem(3, 2, new QTableWidgetItem(
-                                     QString("%1% (%2/%3)")
+                                     QString("%1% (%2/%3 байт)")
                                          .arg(result.capacityUsed, 0, 'f', 2)
-                                         .arg(result.messageLength)
+                                         .arg(result.storedBytes)
                                          .arg(result.maxCapacity, 0, 'f', 0)
                                      ));
 
@@ -272,19 +276,60 @@ void SteganographyWindow::displayAnalysisResults(const ImageAnalysisResult& resu
                                      QString("%1").arg(result.mse, 0, 'f', 4)
                                      ));
 
-    // Рядок 6: Змінених пікселів.
-    analysisTable->setItem(6, 0, new QTableWidgetItem("Змінених пікселів"));
+    // Рядок 6: MSE по каналах.
+    analysisTable->setItem(6, 0, new QTableWidgetItem("MSE по каналах (R/G/B)"));
     analysisTable->setItem(6, 1, new QTableWidgetItem("-"));
     analysisTable->setItem(6, 2, new QTableWidgetItem(
+                                     QString("%1 / %2 / %3")
+                                         .arg(result.mseRed, 0, 'f', 4)
+                                         .arg(result.mseGreen, 0, 'f', 4)
+                                         .arg(result.mseBlue, 0, 'f', 4)
+                                     ));
+
+    // Рядок 7: SSIM (структурна схожість).
+    analysisTable->setItem(7, 0, new QTableWidgetItem("SSIM (структурна схожість)"));
+    analysisTable->setItem(7, 1, new QTableWidgetItem("1.0000"));
+    analysisTable->setItem(7, 2, new QTableWidgetItem(
+                                     QString("%1").arg(result.ssim, 0, 'f', 4)
+                                     ));
+
+    // Рядок 8: Змінених пікселів.
+    analysisTable->setItem(8, 0, new QTableWidgetItem("Змінених пікселів"));
+    analysisTable->setItem(8, 1, new QTableWidgetItem("-"));
+    analysisTable->setItem(8, 2, new QTableWidgetItem(
                                      QString("%1").arg(result.modifiedPixels)
                                      ));
 
-    // Рядок 7: Візуальна різниця.
-    analysisTable->setItem(7, 0, new QTableWidgetItem("Візуальна різниця"));
-    analysisTable->setItem(7, 1, new QTableWidgetItem("-"));
+    // Рядок 9: Оцінка вбудовування (RS / аналіз пар пікселів).
+    const SteganalysisResult& originalStats = result.originalSteganalysis;
+    const SteganalysisResult& modifiedStats = result.modifiedSteganalysis;
+    analysisTable->setItem(9, 0, new QTableWidgetItem("Оцінка вбудовування (RS/SPA)"));
+    analysisTable->setItem(9, 1, new QTableWidgetItem(
+                                     QString("%1% / %2%")
+                                         .arg(originalStats.rsRate * 100.0, 0, 'f', 1)
+                                         .arg(originalStats.samplePairRate * 100.0, 0, 'f', 1)
+                                     ));
+    analysisTable->setItem(9, 2, new QTableWidgetItem(
+                                     QString("%1% / %2%")
+                                         .arg(modifiedStats.rsRate * 100.0, 0, 'f', 1)
+                                         .arg(modifiedStats.samplePairRate * 100.0, 0, 'f', 1)
+                                     ));
+
+    // Рядок 10: Хі-квадрат атака.
+    analysisTable->setItem(10, 0, new QTableWidgetItem("Хі-квадрат (ймовірність)"));
+    analysisTable->setItem(10, 1, new QTableWidgetItem(
+                                      QString("%1").arg(originalStats.chiSquareProbability, 0, 'f', 3)
+                                      ));
+    analysisTable->setItem(10, 2, new QTableWidgetItem(
+                                      QString("%1").arg(modifiedStats.chiSquareProbability, 0, 'f', 3)
+                                      ));
+
+    // Рядок 11: Візуальна різниця.
+    analysisTable->setItem(11, 0, new QTableWidgetItem("Візуальна різниця"));
+    analysisTable->setItem(11, 1, new QTableWidgetItem("-"));
     QString visualDiff = result.psnr > 40 ? "Непомітна ✅" :
                              result.psnr > 30 ? "Мінімальна" : "Помітна";
-    analysisTable->setItem(7, 2, new QTableWidgetItem(visualDiff));
+    analysisTable->setItem(11, 2, new QTableWidgetItem(visualDiff));
 
     // ========== ФОРМУВАННЯ ДЕТАЛЬНОГО HTML-ЗВІТУ ==========
     QString details = "<div style='color: #e0e0e0; font-family: Arial;'>";
@@ -300,8 +345,15 @@ void SteganographyWindow::displayAnalysisResults(const ImageAnalysisResult& resu
                    .arg(result.originalHeight)
                    .arg(result.originalWidth * result.originalHeight);
 
-    details += QString("<p><b>Довжина повідомлення:</b> %1 символів</p>")
-                   .arg(result.messageLength);
+    details += QString("<p><b>Довжина повідомлення:</b> %1 символів (%2 байт UTF-8)</p>")
+                   .arg(result.messageLength)
+                   .arg(result.messageBytes);
+
+    if (result.compressed) {
+        details += QString("<p><b>Після стиснення (deflate):</b> %1 байт (у %2 раз(и) менше)</p>")
+                       .arg(result.storedBytes)
+                       .arg(double(result.messageBytes) / result.storedBytes, 0, 'f', 2);
+    }
 
     details += QString(
                    "<p><b>Використано бітів:</b> %1 / %2 (з 3 бітів на піксель)</p>"
@@ -331,8 +383,15 @@ void SteganographyWindow::displayAnalysisResults(const ImageAnalysisResult& resu
                    "</p>";
     }
 
-    details += QString("<p><b>MSE (Mean Squared Error):</b> %1</p>")
-                   .arg(result.mse, 0, 'f', 4);
+    details += QString("<p><b>MSE (Mean Squared Error):</b> %1 "
+                       "(R: %2, G: %3, B: %4)</p>")
+                   .arg(result.mse, 0, 'f', 4)
+                   .arg(result.mseRed, 0, 'f', 4)
+                   .arg(result.mseGreen, 0, 'f', 4)
+                   .arg(result.mseBlue, 0, 'f', 4);
+
+    details += QString("<p><b>SSIM (Structural Similarity Index):</b> %1</p>")
+                   .arg(result.ssim, 0, 'f', 6);
 
     details += QString("<p><b>Змінених пікселів:</b> %1 (%2%)</p>")
                    .arg(result.modifiedPixels)
@@ -340,12 +399,63 @@ void SteganographyWindow::displayAnalysisResults(const ImageAnalysisResult& resu
                             (result.originalWidth * result.originalHeight), 0, 'f', 2);
     details += "</div>";
 
-    // ========== Блок 3: Використання ємності ==========
+    // ========== Блок 3: Статистичний стегоаналіз ==========
+    details += "<div style='background: rgba(0, 206, 209, 0.1); "
+               "padding: 15px; border-radius: 8px; margin: 10px 0;'>";
+    details += "<h4 style='color: #00E5E8;'>Статистичний стегоаналіз</h4>";
+    details += QString("<p><b>RS-аналіз:</b> оригінал %1%, модифіковане %2%</p>")
+                   .arg(originalStats.rsRate * 100.0, 0, 'f', 2)
+                   .arg(modifiedStats.rsRate * 100.0, 0, 'f', 2);
+    details += QString("<p><b>Аналіз пар пікселів (SPA):</b> оригінал %1%, модифіковане %2%</p>")
+                   .arg(originalStats.samplePairRate * 100.0, 0, 'f', 2)
+                   .arg(modifiedStats.samplePairRate * 100.0, 0, 'f', 2);
+    details += QString("<p><b>Хі-квадрат атака:</b> ймовірність %1, "
+                       "вбудовування виявлено в перших %2% зображення</p>")
+                   .arg(modifiedStats.chiSquareProbability, 0, 'f', 3)
+                   .arg(modifiedStats.chiSquareRate * 100.0, 0, 'f', 1);
+
+    // Інтерпретація результату стегоаналізу.
+    if (modifiedStats.suspicious) {
+        details += QString("<p style='color: #f87171;'>"
+                           "❌ Статистичний аналіз виявляє LSB-вбудовування "
+                           "(оцінка %1% молодших бітів)."
+                           "</p>").arg(modifiedStats.estimatedRate * 100.0, 0, 'f', 2);
+    } else {
+        details += "<p style='color: #4ade80;'>"
+                   "✅ Статистичний аналіз не виявляє вбудовування."
+                   "</p>";
+    }
+    details += "</div>";
+
+    // ========== Блок 4: Використання ємності ==========
     details += "<div style='background: rgba(0, 206, 209, 0.1); "
                "padding: 15px; border-radius: 8px; margin: 10px 0;'>";
     details += "<h4 style='color: #00E5E8;'>Використання ємності</h4>";
-    details += QString("<p><b>Максимальна ємність:</b> %1 символів</p>")
+    details += QString("<p><b>Максимальна ємність:</b> %1 байт</p>")
                    .arg(result.maxCapacity, 0, 'f', 0);
+    if (result.compressed) {
+        details += QString("<p><b>Ефективна ємність (зі стисненням):</b> ~%1 байт UTF-8</p>")
+                       .arg(result.effectiveCapacity, 0, 'f', 0);
+    }
+    details += QString("<p><b>Режим вбудовування:</b> %1 біт(и) на канал (%2)</p>")
+                   .arg(result.bitsPerChannel)
+                   .arg(result.alphaUsed ? "R, G, B, A" : "R, G, B");
+    details += QString("<p><b>Порядок пікселів:</b> %1</p>")
+                   .arg(result.keyedOrder ? "ключовий (псевдовипадковий)" : "послідовний");
+    if (result.hammingP > 0) {
+        const int p = result.hammingP;
+        details += QString("<p><b>Матричне вбудовування:</b> код Геммінга p = %1 "
+                           "(%2 біт(и) даних у блоці з %3 молодших бітів)</p>")
+                       .arg(p)
+                       .arg(p)
+                       .arg((1 << p) - 1);
+        details += QString("<p><b>Очікувана ефективність:</b> %1 біт(и) на зміну</p>")
+                       .arg(p / (1.0 - 1.0 / (1 << p)), 0, 'f', 2);
+    }
+    details += QString("<p><b>Ефективність вбудовування:</b> %1 біт(и) на змінений канал "
+                       "(%2 змінених значень каналів)</p>")
+                   .arg(result.embeddingEfficiency, 0, 'f', 2)
+                   .arg(result.changedChannels);
 
     details += QString("<p><b>Використано:</b> %1% ємності</p>")
                    .arg(result.capacityUsed, 0, 'f', 2);
@@ -366,7 +476,7 @@ void SteganographyWindow::displayAnalysisResults(const ImageAnalysisResult& resu
     }
     details += "</div>";
 
-    // ========== Блок 4: Пояснення LSB методу ==========
+    // ========== Блок 5: Пояснення LSB методу ==========
     details += "<div style='background: rgba(0, 206, 209, 0.15); "
                "padding: 15px; border-radius: 8px; margin: 10px 0;'>";
     details += "<h4 style='color: #00CED1;'>Чому використовуються молодші біти?</h4>";
@@ -381,7 +491,7 @@ void SteganographyWindow::displayAnalysisResults(const ImageAnalysisResult& resu
     details += "</ul>";
     details += "</div>";
 
-    // ========== Блок 5: Висновки ==========
+    // ========== Блок 6: Висновки ==========
     details += "<div style='background: rgba(0, 206, 209, 0.12); "
                "padding: 15px; border-radius: 8px; margin: 10px 0;'>";
     details += "<h4 style='color: #00CED1;'>Висновки</h4>";
@@ -393,7 +503,8 @@ void SteganographyWindow::displayAnalysisResults(const ImageAnalysisResult& resu
                    .arg(result.messageLength);
 
     details += QString("<li><b>Стійкість до виявлення:</b> %1</li>")
-                   .arg(result.capacityUsed < 50 ? "Висока ✅" : "Середня ⚠️");
+                   .arg(modifiedStats.suspicious ? "Низька ❌" :
+                            result.capacityUsed < 50 ? "Висока ✅" : "Середня ⚠️");
     details += "</ul>";
     details += "</div>";
 
@@ -426,18 +537,18 @@ void SteganographyWindow::showStepByStepAlgorithm() {
     algorithm += "<div style='background: rgba(0, 206, 209, 0.1); "
                  "padding: 20px; border-radius: 10px; margin: 15px 0;'>";
     algorithm += "<h3 style='color: #00E5E8;'>Етап 1: Підготовка повідомлення</h3>";
-    algorithm += "<p><b>Крок 1.1:</b> Додаємо маркери початку та кінця</p>";
+    algorithm += "<p><b>Крок 1.1:</b> Кодуємо текст у байти UTF-8</p>";
     algorithm += "<pre style='background: #2a2a2a; padding: 10px; border-radius: 5px;'>";
-    algorithm += "Оригінальне повідомлення: \"Привіт\"\n";
-    algorithm += "З маркерами: \"&lt;&lt;START&gt;&gt;Привіт&lt;&lt;END&gt;&gt;\"";
+    algorithm += "Символ 'П' (Unicode: 1055) → D0 9F → 11010000 10011111\n";
+    algorithm += "Символ 'р' (Unicode: 1088) → D1 80 → 11010001 10000000\n";
+    algorithm += "Символ 'A' (Unicode: 65)   → 41    → 01000001\n";
+    algorithm += "...та інші символи";
     algorithm += "</pre>";
 
-    algorithm += "<p><b>Крок 1.2:</b> Конвертуємо текст у двійковий формат (UTF-16)</p>";
+    algorithm += "<p><b>Крок 1.2:</b> Додаємо двійковий заголовок (16 байтів)</p>";
     algorithm += "<pre style='background: #2a2a2a; padding: 10px; border-radius: 5px;'>";
-    algorithm += "Символ 'П' (Unicode: 1055) → 0000010000011111\n";
-    algorithm += "Символ 'р' (Unicode: 1088) → 0000010001000000\n";
-    algorithm += "Символ 'и' (Unicode: 1080) → 0000010000111000\n";
-    algorithm += "...та інші символи";
+    algorithm += "[\"STEG\" | версія | прапорці | розширення | довжина | CRC-32] + дані\n";
+    algorithm += " 4 байти   1        1          2            4         4";
     algorithm += "</pre>";
     algorithm += "</div>";
 
@@ -517,18 +628,17 @@ void SteganographyWindow::showStepByStepAlgorithm() {
     algorithm += "Витягнуті біти: 1, 1, 0";
     algorithm += "</pre>";
 
-    algorithm += "<p><b>Крок 5.2:</b> Групуємо біти по 16 (один символ UTF-16)</p>";
+    algorithm += "<p><b>Крок 5.2:</b> Зчитуємо заголовок (перші 128 бітів)</p>";
     algorithm += "<pre style='background: #2a2a2a; padding: 10px; border-radius: 5px;'>";
-    algorithm += "Біти: 0000010000011111...\n";
+    algorithm += "Сигнатура: \"STEG\" ✓\n";
+    algorithm += "Довжина: 12 байтів\n";
     algorithm += "      ↓\n";
-    algorithm += "0000010000011111 → 1055 (Unicode) → 'П'\n";
-    algorithm += "0000010001000000 → 1088 (Unicode) → 'р'\n";
-    algorithm += "...та інші";
+    algorithm += "Зчитуємо рівно 12 × 8 = 96 бітів даних і зупиняємося";
     algorithm += "</pre>";
 
-    algorithm += "<p><b>Крок 5.3:</b> Шукаємо маркери та витягуємо текст</p>";
+    algorithm += "<p><b>Крок 5.3:</b> Перевіряємо CRC-32 та декодуємо UTF-8</p>";
     algorithm += "<pre style='background: #2a2a2a; padding: 10px; border-radius: 5px;'>";
-    algorithm += "Знайдено: \"&lt;&lt;START&gt;&gt;Привіт&lt;&lt;END&gt;&gt;...\"\n";
+    algorithm += "D0 9F D1 80 D0 B8 D0 B2 D1 96 D1 82\n";
     algorithm += "           ↓\n";
     algorithm += "Витягнуте повідомлення: \"Привіт\"";
     algorithm += "</pre>";
@@ -542,10 +652,10 @@ void SteganographyWindow::showStepByStepAlgorithm() {
 
     algorithm += "<p><b>Крок 1:</b> Конвертуємо 'A' в двійковий формат</p>";
     algorithm += "<pre style='background: #2a2a2a; padding: 10px; border-radius: 5px;'>";
-    algorithm += "'A' → Unicode 65 → 0000000001000001 (16 біт)";
+    algorithm += "'A' → UTF-8 0x41 → 01000001 (8 біт)";
     algorithm += "</pre>";
 
-    algorithm += "<p><b>Крок 2:</b> Приховуємо в 6 пікселях (3 канали × 6 = 18 біт, потрібно 16)</p>";
+    algorithm += "<p><b>Крок 2:</b> Приховуємо в 3 пікселях (3 канали × 3 = 9 біт, потрібно 8)</p>";
     algorithm += "<table style='border-collapse: collapse; width: 100%; margin: 10px 0;'>";
     algorithm += "<tr style='background: rgba(0, 206, 209, 0.2);'>";
     algorithm += "<th style='padding: 8px; border: 1px solid #555;'>Піксель</th>";
@@ -565,8 +675,8 @@ void SteganographyWindow::showStepByStepAlgorithm() {
     algorithm += "<td style='padding: 8px; border: 1px solid #555;'>0</td>";
     algorithm += "<td style='padding: 8px; border: 1px solid #555;'>G</td>";
     algorithm += "<td style='padding: 8px; border: 1px solid #555;'>200 (11001000)</td>";
-    algorithm += "<td style='padding: 8px; border: 1px solid #555; color: #4ade80;'>0</td>";
-    algorithm += "<td style='padding: 8px; border: 1px solid #555;'>200 (11001000)</td>";
+    algorithm += "<td style='padding: 8px; border: 1px solid #555; color: #4ade80;'>1</td>";
+    algorithm += "<td style='padding: 8px; border: 1px solid #555;'>201 (11001001)</td>";
     algorithm += "</tr>";
     algorithm += "<tr style='background: rgba(0, 206, 209, 0.05);'>";
     algorithm += "<td style='padding: 8px; border: 1px solid #555;'>0</td>";
@@ -600,9 +710,10 @@ void SteganographyWindow::showStepByStepAlgorithm() {
     algorithm += "<p>Для підвищення безпеки можна зашифрувати повідомлення перед приховуванням:</p>";
     algorithm += "<ol>";
     algorithm += "<li>Генеруємо ключ на основі персональних даних (SHA-256)</li>";
-    algorithm += "<li>Шифруємо текст за допомогою XOR-шифру</li>";
-    algorithm += "<li>Приховуємо зашифрований текст у зображенні</li>";
-    algorithm += "<li>При витягуванні: спочатку витягуємо, потім розшифровуємо</li>";
+    algorithm += "<li>Виводимо ключ шифру функцією scrypt (сіль і параметри - у заголовку)</li>";
+    algorithm += "<li>Шифруємо текст потоковим шифром ChaCha20 і обчислюємо тег Poly1305</li>";
+    algorithm += "<li>Приховуємо зашифрований текст у зображенні (nonce і тег - після заголовка)</li>";
+    algorithm += "<li>При витягуванні: спочатку перевіряємо тег, потім розшифровуємо</li>";
     algorithm += "</ol>";
     algorithm += "<p><b>Приклад генерації ключа:</b></p>";
     algorithm += "<pre style='background: #2a2a2a; padding: 10px; border-radius: 5px;'>";
@@ -633,3 +744,190 @@ void SteganographyWindow::showStepByStepAlgorithm() {
     // Встановлюємо HTML-контент.
     algorithmEdit->setHtml(algorithm);
 }
+
+/*
+ * ============================================================================
+ * НАЛАШТУВАННЯ ДВИЖКА ТА СТАН ЗАВДАНЬ
+ * ============================================================================
+ */
+
+/**
+ * @brief Застосування налаштувань вкладки приховування до движка.
+ *
+ * @param engine Движок для налаштування.
+ */
+void SteganographyWindow::applyHideSettings(SteganographyEngine& engine) const {
+    engine.setBitsPerChannel(hide_bitsPerChannelSpinBox->value(),
+                             hide_alphaCheckBox->isChecked());
+
+    // Ключовий порядок пікселів потребує ключа, тому діє лише з шифруванням.
+    engine.setKeyedOrdering(hide_encryptCheckBox->isChecked() &&
+                            hide_keyedOrderCheckBox->isChecked());
+    engine.setCompressionEnabled(hide_compressCheckBox->isChecked());
+    engine.setMatrixEmbedding(hide_matrixCheckBox->isChecked());
+    engine.setErrorCorrection(hide_eccSpinBox->value());
+}
+
+/**
+ * @brief Вибір набору зображень для повідомлення, що не вміщується в одне.
+ *
+ * Алгоритм:
+ * 1. Додаткові зображення (поточне зображення - перше в наборі).
+ * 2. Кількість фрагментів парності - скільки зображень набору можна
+ *    втратити або пошкодити без втрати повідомлення.
+ * 3. Перевірка ємності за розмірами із заголовків файлів (без декодування).
+ * 4. Каталог для збереження результатів.
+ *
+ * @param storedBytes Розмір повідомлення після стиснення.
+ * @param encrypt Чи буде повідомлення зашифроване.
+ * @param carriers Файли набору (вихідний параметр).
+ * @param parityShards Кількість фрагментів парності (вихідний параметр).
+ * @param outputDirectory Каталог для результатів (вихідний параметр).
+ * @return false якщо користувач скасував вибір або набір замалий.
+ */
+bool SteganographyWindow::selectCarrierSet(qint64 storedBytes, bool encrypt, QStringList& carriers,
+                                           int& parityShards, QString& outputDirectory) {
+    if (hide_matrixCheckBox->isChecked()) {
+        QMessageBox::warning(
+            this,
+            "Помилка",
+            "Матричне вбудовування не підтримується для набору зображень!"
+            );
+        return false;
+    }
+
+    // ========== КРОК 1: Додаткові зображення ==========
+    const QStringList extra = QFileDialog::getOpenFileNames(
+        this,
+        "Виберіть додаткові зображення для набору",
+        "",
+        "Images (*.png *.jpg *.jpeg *.bmp)"
+        );
+
+    if (extra.isEmpty()) {
+        return false;
+    }
+
+    carriers = QStringList{currentImagePath};
+    for (const QString& path : extra) {
+        if (!carriers.contains(path)) {
+            carriers.append(path);
+        }
+    }
+
+    // ========== КРОК 2: Фрагменти парності ==========
+    bool ok = false;
+    parityShards = QInputDialog::getInt(
+        this,
+        "Фрагменти парності",
+        QString("Скільки зображень з %1 можна втратити\n"
+                "без втрати повідомлення?").arg(carriers.size()),
+        qMin(1, int(carriers.size()) - 1),
+        0,
+        int(carriers.size()) - 1,
+        1,
+        &ok
+        );
+
+    if (!ok) {
+        return false;
+    }
+
+    // ========== КРОК 3: Ємність набору ==========
+    QVector<QSize> sizes;
+    for (const QString& path : std::as_const(carriers)) {
+        sizes.append(QImageReader(path).size());
+    }
+
+    qint64 capacity = stegoEngine->calculateShardedCapacity(sizes, parityShards, encrypt);
+    if (storedBytes > capacity) {
+        QMessageBox::warning(
+            this,
+            "Помилка",
+            QString("Набір зображень замалий!\n\n"
+                    "Ємність набору: %1 байт\n"
+                    "Ваше повідомлення: %2 байт")
+                .arg(capacity)
+                .arg(storedBytes)
+            );
+        return false;
+    }
+
+    // ========== КРОК 4: Каталог результатів ==========
+    outputDirectory = QFileDialog::getExistingDirectory(
+        this,
+        "Каталог для збереження зображень набору"
+        );
+
+    return !outputDirectory.isEmpty();
+}
+
+/**
+ * @brief Збереження результату приховування у форматі JPEG.
+ *
+ * Повідомлення повторно вбудовується в коефіцієнти DCT оригіналу
+ * з тим самим ключем. Коефіцієнти обробляються без декодування
+ * пікселів, тому операція швидка і виконується в потоці інтерфейсу.
+ *
+ * @param fileName Шлях до вихідного JPEG.
+ * @return true у разі успіху.
+ */
+bool SteganographyWindow::saveJpegResult(const QString& fileName) {
+    if (hiddenMessage.isEmpty() || QImageReader::imageFormat(hiddenSourcePath) != "jpeg") {
+        QMessageBox::warning(
+            this,
+            "Попередження",
+            "Стиснення JPEG з втратами знищить приховане повідомлення.\n"
+            "Збережіть результат у PNG або виберіть JPEG як вхідне зображення - "
+            "тоді повідомлення буде записане в коефіцієнти DCT без перекодування."
+            );
+        return false;
+    }
+
+    SteganographyEngine engine;
+    applyHideSettings(engine);
+    if (hiddenKey.isEmpty()) {
+        engine.setKeyedOrdering(false);
+    } else {
+        engine.setKey(hiddenKey);
+    }
+
+    if (!engine.hideMessageJpeg(hiddenSourcePath, fileName, hiddenMessage, !hiddenKey.isEmpty())) {
+        QMessageBox::critical(
+            this,
+            "Помилка",
+            "Не вдалося приховати повідомлення в коефіцієнтах DCT.\n"
+            "Повідомлення задовге для цього JPEG або файл пошкоджений."
+            );
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Оновлення прогрес-барів, міток черги та кнопок скасування.
+ *
+ * Прогрес-бар і кнопка скасування видимі, поки є хоча б одне завдання;
+ * мітка черги - коли крім поточного є завдання, що очікують.
+ */
+void SteganographyWindow::updateJobStatus() {
+    const bool hideBusy = !hideJobs.isEmpty();
+    if (hideBusy && !hide_progressBar->isVisible()) {
+        hide_progressBar->setValue(0);
+    }
+    hide_progressBar->setVisible(hideBusy);
+    hide_cancelBtn->setVisible(hideBusy);
+    hide_cancelBtn->setEnabled(hideBusy);
+    hide_queueLabel->setVisible(hideJobs.size() > 1);
+    hide_queueLabel->setText(QString("У черзі: %1").arg(hideJobs.size() - 1));
+
+    const bool extractBusy = !extractJobs.isEmpty();
+    if (extractBusy && !extract_progressBar->isVisible()) {
+        extract_progressBar->setValue(0);
+    }
+    extract_progressBar->setVisible(extractBusy);
+    extract_cancelBtn->setVisible(extractBusy);
+    extract_cancelBtn->setEnabled(extractBusy);
+    extract_queueLabel->setVisible(extractJobs.size() > 1);
+    extract_queueLabel->setText(QString("У черзі: %1").arg(extractJobs.size() - 1));
+}
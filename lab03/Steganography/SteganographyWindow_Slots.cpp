@@ -11,6 +11,7 @@
 #include <QPixmap>
 #include <QClipboard>
 #include <QApplication>
+#include <QDebug>
 
 /*
  * ============================================================================
@@ -21,8 +22,8 @@
 /**
  * @brief Вибір вхідного зображення для приховування.
  *
- * Відкриває діалог вибору файлу, завантажує зображення
- * та відображає інформацію про його ємність.
+ * Відкриває діалог вибору файлу та запускає фонове завантаження
+ * попереднього перегляду.
  */
 void SteganographyWindow::selectInputImage() {
     // Відкриваємо діалог вибору файлу.
@@ -38,49 +39,16 @@ void SteganographyWindow::selectInputImage() {
         return;
     }
 
-    // Завантажуємо зображення.
-    originalImage.load(fileName);
+    // Зберігаємо шлях.
+    currentImagePath = fileName;
+    hide_imagePathEdit->setText(fileName);
 
-    if (!originalImage.isNull()) {
-        // Зберігаємо шлях.
-        currentImagePath = fileName;
-        hide_imagePathEdit->setText(fileName);
-
-        // ========== Відображаємо попередній перегляд ==========
-        QPixmap pixmap = QPixmap::fromImage(originalImage);
-        hide_imageLabel->setPixmap(
-            pixmap.scaled(hide_imageLabel->size(),
-                          Qt::KeepAspectRatio,
-                          Qt::SmoothTransformation)
-            );
-
-        // Оновлюємо зображення у вкладці аналізу.
-        analysis_originalImageLabel->setPixmap(
-            pixmap.scaled(analysis_originalImageLabel->size(),
-                          Qt::KeepAspectRatio,
-                          Qt::SmoothTransformation)
-            );
-
-        // ========== Обчислюємо та показуємо ємність ==========
-        int maxCapacity = stegoEngine->calculateMaxCapacity(originalImage);
-
-        QMessageBox::information(
-            this,
-            "Інформація про зображення",
-            QString("Зображення завантажено!\n\n"
-                    "Розмір: %1 x %2 пікселів\n"
-                    "Максимальна ємність: %3 символів")
-                .arg(originalImage.width())
-                .arg(originalImage.height())
-                .arg(maxCapacity)
-            );
-    } else {
-        QMessageBox::warning(
-            this,
-            "Помилка",
-            "Не вдалося завантажити зображення!"
-            );
-    }
+    // Попередній перегляд декодується у фоні (зменшеним); повне зображення
+    // прочитає завдання приховування. Результат - у onPreviewReady().
+    originalPreview = ImagePreview();
+    hide_imageLabel->clear();
+    hide_imageLabel->setText("Завантаження...");
+    hidePreviewRequest = imageLoader->requestPreview(fileName);
 }
 
 /**
@@ -92,10 +60,13 @@ void SteganographyWindow::selectInputImage() {
  * 3. Генерація ключа (якщо потрібне шифрування).
  * 4. Приховування повідомлення.
  * 5. Відображення результату.
+ *
+ * Повідомлення, що не вміщується в зображення, можна розподілити
+ * між кількома зображеннями (див. selectCarrierSet()).
  */
 void SteganographyWindow::hideMessage() {
     // ========== КРОК 1: Перевірка наявності зображення ==========
-    if (originalImage.isNull()) {
+    if (currentImagePath.isEmpty() || originalPreview.isNull()) {
         QMessageBox::warning(
             this,
             "Помилка",
@@ -116,25 +87,39 @@ void SteganographyWindow::hideMessage() {
     }
 
     // ========== КРОК 3: Перевірка ємності ==========
-    int maxCapacity = stegoEngine->calculateMaxCapacity(originalImage);
-    if (message.length() > maxCapacity) {
-        QMessageBox::warning(
+    // Ємність залежить від кількості бітів на канал, альфа-каналу,
+    // стиснення та матричного режиму.
+    applyHideSettings(*stegoEngine);
+    // Розмір відомий із заголовка файлу, піксели для цього не потрібні.
+    qint64 maxCapacity = stegoEngine->calculateMaxCapacity(originalPreview.fullSize(),
+                                                           hide_encryptCheckBox->isChecked());
+
+    // Порівнюємо з ємністю розмір даних після стиснення.
+    qint64 messageBytes = message.toUtf8().size();
+    qint64 storedBytes = stegoEngine->storedMessageSize(message);
+    bool sharded = false;
+    if (storedBytes > maxCapacity) {
+        int result = QMessageBox::question(
             this,
-            "Помилка",
+            "Попередження",
             QString("Повідомлення занадто довге!\n\n"
-                    "Максимальна довжина: %1 символів\n"
-                    "Ваше повідомлення: %2 символів")
+                    "Максимальний розмір: %1 байт\n"
+                    "Ваше повідомлення: %2 байт (%3 байт UTF-8)\n\n"
+                    "Розподілити повідомлення між кількома зображеннями?")
                 .arg(maxCapacity)
-                .arg(message.length())
+                .arg(storedBytes)
+                .arg(messageBytes),
+            QMessageBox::Yes | QMessageBox::No
             );
-        return;
-    }
 
-    // ========== КРОК 4: Показуємо прогрес ==========
-    hide_progressBar->setVisible(true);
-    hide_progressBar->setValue(30);
+        if (result == QMessageBox::No) {
+            return;
+        }
+
+        sharded = true;
+    }
 
-    // ========== КРОК 5: Генеруємо ключ (якщо потрібно) ==========
+    // ========== КРОК 4: Генеруємо ключ (якщо потрібно) ==========
     bool encrypt = hide_encryptCheckBox->isChecked();
     QString generatedKey;
 
@@ -152,7 +137,6 @@ void SteganographyWindow::hideMessage() {
                 "Помилка",
                 "Для шифрування заповніть персональні дані!"
                 );
-            hide_progressBar->setVisible(false);
             return;
         }
 
@@ -163,7 +147,6 @@ void SteganographyWindow::hideMessage() {
             birthDate,
             phone
             );
-        hide_progressBar->setValue(50);
 
         // Відображаємо згенерований ключ.
         hide_generatedKeyEdit->setText(generatedKey);
@@ -172,54 +155,39 @@ void SteganographyWindow::hideMessage() {
         hide_generatedKeyEdit->clear();
     }
 
-    // ========== КРОК 6: Приховуємо повідомлення ==========
-    modifiedImage = stegoEngine->hideMessage(originalImage, message, encrypt);
-    hide_progressBar->setValue(80);
-
-    // ========== КРОК 7: Обробка результату ==========
-    if (!modifiedImage.isNull()) {
-        // Відображаємо результат.
-        QPixmap pixmap = QPixmap::fromImage(modifiedImage);
-        hide_resultImageLabel->setPixmap(
-            pixmap.scaled(hide_resultImageLabel->size(),
-                          Qt::KeepAspectRatio,
-                          Qt::SmoothTransformation)
-            );
-
-        // Оновлюємо вкладку аналізу.
-        analysis_modifiedImageLabel->setPixmap(
-            pixmap.scaled(analysis_modifiedImageLabel->size(),
-                          Qt::KeepAspectRatio,
-                          Qt::SmoothTransformation)
-            );
-
-        hide_progressBar->setValue(100);
-
-        // Формуємо повідомлення про успіх.
-        QString successMsg = "Повідомлення успішно приховано!\n\n";
-
-        if (encrypt && !generatedKey.isEmpty()) {
-            successMsg += QString(
-                              "Ваш ключ шифрування: %1\n\n"
-                              "⚠️ ВАЖЛИВО: Збережіть цей ключ!\n"
-                              "Він знадобиться для розшифрування повідомлення.\n\n"
-                              ).arg(generatedKey);
-        }
-
-        successMsg += "Перейдіть до вкладки 'Аналіз зображення' "
-                      "для детального аналізу.";
+    // Набір зображень вибирається після ключа: ємність залежить від шифрування.
+    QStringList carriers;
+    int parityShards = 0;
+    QString outputDirectory;
+    if (sharded && !selectCarrierSet(storedBytes, encrypt, carriers, parityShards,
+                                     outputDirectory)) {
+        return;
+    }
 
-        QMessageBox::information(this, "Успіх", successMsg);
-    } else {
-        QMessageBox::critical(
-            this,
-            "Помилка",
-            "Не вдалося приховати повідомлення!"
-            );
+    // ========== КРОК 5: Ставимо завдання в чергу ==========
+    // Завдання має власний движок із копією налаштувань, тому зміна
+    // параметрів у формі не впливає на вже поставлені завдання.
+    // Повне зображення завдання декодує саме, у робочому потоці.
+    SteganographyJob* job = new SteganographyJob(SteganographyJob::Kind::Hide,
+                                                 QImage(), message, encrypt, this);
+    job->setSource(currentImagePath, originalPreview);
+    if (sharded) {
+        job->setCarriers(carriers, parityShards, outputDirectory);
+    }
+    job->engine().setParallelMode(true);
+    applyHideSettings(job->engine());
+    if (encrypt) {
+        job->setKey(generatedKey);
     }
 
-    // Приховуємо прогрес-бар.
-    hide_progressBar->setVisible(false);
+    connect(job, &SteganographyJob::progressChanged,
+            this, &SteganographyWindow::onHideProgress);
+    connect(job, &SteganographyJob::hideFinished,
+            this, &SteganographyWindow::onHideFinished);
+
+    hideJobs.append(job);
+    jobPool.start(job);
+    updateJobStatus();
 }
 
 /**
@@ -241,10 +209,17 @@ void SteganographyWindow::clearHideTab() {
     hide_resultImageLabel->clear();
     hide_resultImageLabel->setText("Результат з'явиться\nпісля приховування");
 
-    // Очищуємо зображення.
-    originalImage = QImage();
+    // Очищуємо зображення (результати запитів, що ще виконуються, ігноруються).
+    originalPreview = ImagePreview();
+    modifiedPreview = ImagePreview();
+    hidePreviewRequest = 0;
     modifiedImage = QImage();
+    hiddenSourceImage = QImage();
+    hiddenMessage.clear();
+    hiddenSourcePath.clear();
+    hiddenKey.clear();
     currentImagePath.clear();
+    hide_saveBtn->setEnabled(false);
 }
 
 /*
@@ -256,43 +231,37 @@ void SteganographyWindow::clearHideTab() {
 /**
  * @brief Вибір зображення для витягування повідомлення.
  *
- * Відкриває діалог вибору файлу та завантажує зображення.
+ * Відкриває діалог вибору файлу та запускає завантаження перегляду.
+ * Вибір кількох файлів задає набір зображень розподіленого повідомлення.
  */
 void SteganographyWindow::selectExtractImage() {
-    // Відкриваємо діалог вибору файлу.
-    QString fileName = QFileDialog::getOpenFileName(
+    // Відкриваємо діалог вибору файлів (кілька - набір розподіленого повідомлення).
+    QStringList fileNames = QFileDialog::getOpenFileNames(
         this,
-        "Виберіть зображення",
+        "Виберіть зображення (або всі зображення набору)",
         "",
         "Images (*.png *.jpg *.jpeg *.bmp)"
         );
 
-    if (fileName.isEmpty()) {
+    if (fileNames.isEmpty()) {
         return;
     }
 
-    // Завантажуємо зображення.
-    QImage image;
-    image.load(fileName);
-
-    if (!image.isNull()) {
-        extractImagePath = fileName;
-        extract_imagePathEdit->setText(fileName);
-
-        // Відображаємо попередній перегляд.
-        QPixmap pixmap = QPixmap::fromImage(image);
-        extract_imageLabel->setPixmap(
-            pixmap.scaled(extract_imageLabel->size(),
-                          Qt::KeepAspectRatio,
-                          Qt::SmoothTransformation)
-            );
-    } else {
-        QMessageBox::warning(
-            this,
-            "Помилка",
-            "Не вдалося завантажити зображення!"
-            );
-    }
+    // Перегляд показує перше зображення набору.
+    QString fileName = fileNames.first();
+    extractImagePath = fileName;
+    extractCarrierPaths = fileNames.size() > 1 ? fileNames : QStringList();
+    extract_imagePathEdit->setText(fileNames.size() > 1
+                                       ? QString("Набір з %1 зображень: %2")
+                                             .arg(fileNames.size())
+                                             .arg(fileNames.join("; "))
+                                       : fileName);
+
+    // Попередній перегляд - у фоні, результат у onPreviewReady().
+    extractPreview = ImagePreview();
+    extract_imageLabel->clear();
+    extract_imageLabel->setText("Завантаження...");
+    extractPreviewRequest = imageLoader->requestPreview(fileName);
 }
 
 /**
@@ -315,33 +284,17 @@ void SteganographyWindow::extractMessage() {
         return;
     }
 
-    // Завантажуємо зображення.
-    QImage image;
-    image.load(extractImagePath);
-
-    if (image.isNull()) {
-        QMessageBox::warning(
-            this,
-            "Помилка",
-            "Не вдалося завантажити зображення!"
-            );
-        return;
-    }
-
-    // ========== КРОК 2: Показуємо прогрес ==========
-    extract_progressBar->setVisible(true);
-    extract_progressBar->setValue(30);
-
     bool decrypt = extract_decryptCheckBox->isChecked();
+    QString key;
 
-    // ========== КРОК 3: Встановлюємо ключ (якщо потрібно) ==========
+    // ========== КРОК 2: Визначаємо ключ (якщо потрібно) ==========
     if (decrypt) {
         // Перевіряємо чи введений ключ вручну.
         QString manualKey = extract_keyEdit->text().trimmed();
 
         if (!manualKey.isEmpty()) {
             // Використовуємо введений ключ.
-            stegoEngine->setKey(manualKey);
+            key = manualKey;
         } else {
             // Пробуємо згенерувати ключ з персональних даних.
             QString firstName = hide_firstNameEdit->text();
@@ -360,14 +313,13 @@ void SteganographyWindow::extractMessage() {
                     );
 
                 if (result == QMessageBox::No) {
-                    extract_progressBar->setVisible(false);
                     return;
                 }
 
                 decrypt = false;
             } else {
                 // Генеруємо ключ.
-                QString generatedKey = stegoEngine->generateKey(
+                key = stegoEngine->generateKey(
                     firstName,
                     lastName,
                     birthDate,
@@ -377,19 +329,205 @@ void SteganographyWindow::extractMessage() {
                 QMessageBox::information(
                     this,
                     "Згенерований ключ",
-                    QString("Використовується ключ: %1").arg(generatedKey)
+                    QString("Використовується ключ: %1").arg(key)
                     );
             }
         }
     }
 
-    extract_progressBar->setValue(60);
+    // ========== КРОК 3: Ставимо завдання в чергу ==========
+    // Зображення декодує завдання у робочому потоці.
+    SteganographyJob* job = new SteganographyJob(SteganographyJob::Kind::Extract,
+                                                 QImage(), QString(), decrypt, this);
+    job->setSource(extractImagePath, extractPreview);
+    if (!extractCarrierPaths.isEmpty()) {
+        job->setCarriers(extractCarrierPaths);
+    }
+    job->engine().setParallelMode(true);
+    if (decrypt) {
+        job->setKey(key);
+    }
 
-    // ========== КРОК 4: Витягуємо повідомлення ==========
-    QString message = stegoEngine->extractMessage(image, decrypt);
-    extract_progressBar->setValue(100);
+    connect(job, &SteganographyJob::progressChanged,
+            this, &SteganographyWindow::onExtractProgress);
+    connect(job, &SteganographyJob::extractFinished,
+            this, &SteganographyWindow::onExtractFinished);
+
+    extractJobs.append(job);
+    jobPool.start(job);
+    updateJobStatus();
+}
+
+/**
+ * @brief Очищення всіх полів вкладки витягування.
+ */
+void SteganographyWindow::clearExtractTab() {
+    extract_imagePathEdit->clear();
+    extract_imageLabel->clear();
+    extract_imageLabel->setText("Натисніть кнопку\nдля вибору зображення");
+    extract_messageEdit->clear();
+    extract_keyEdit->clear();
+    extractImagePath.clear();
+    extractCarrierPaths.clear();
+    extractPreview = ImagePreview();
+    extractPreviewRequest = 0;
+}
+
+/*
+ * ============================================================================
+ * ФОНОВІ ЗАВДАННЯ
+ * ============================================================================
+ */
+
+/**
+ * @brief Оновлення прогресу поточного завдання приховування.
+ * @param percent Відсоток виконання.
+ */
+void SteganographyWindow::onHideProgress(int percent) {
+    // Сигнали завдань у черзі не надходять, тож це завжди поточне завдання.
+    hide_progressBar->setValue(percent);
+}
+
+/**
+ * @brief Завершення завдання приховування.
+ *
+ * @param result Зображення з повідомленням (пусте у разі помилки).
+ * @param cancelled Чи було завдання скасоване.
+ */
+void SteganographyWindow::onHideFinished(const QImage& result, bool cancelled) {
+    SteganographyJob* job = qobject_cast<SteganographyJob*>(sender());
+    if (!job) {
+        return;
+    }
+
+    hideJobs.removeOne(job);
+    job->deleteLater();
+
+    // Наступне завдання з черги почне прогрес з нуля.
+    hide_progressBar->setValue(0);
+    updateJobStatus();
+
+    if (cancelled) {
+        qDebug() << "Hide job cancelled";
+        return;
+    }
+
+    if (job->sourceImage().isNull()) {
+        QMessageBox::warning(
+            this,
+            "Помилка",
+            "Не вдалося завантажити зображення!"
+            );
+        return;
+    }
+
+    if (result.isNull()) {
+        QMessageBox::critical(
+            this,
+            "Помилка",
+            "Не вдалося приховати повідомлення!"
+            );
+        return;
+    }
+
+    // Набір зображень завдання вже зберегло; аналіз пари "оригінал -
+    // повідомлення" для окремого фрагмента не має сенсу.
+    const QStringList savedPaths = job->savedPaths();
+    if (!savedPaths.isEmpty()) {
+        hide_saveBtn->setEnabled(false);
+        modifiedPreview = job->resultPreview();
+        displayImagePreview(hide_resultImageLabel, modifiedPreview);
+
+        QString successMsg = QString("Повідомлення розподілено між %1 зображеннями:\n%2\n\n")
+                                 .arg(savedPaths.size())
+                                 .arg(savedPaths.join('\n'));
+        if (!job->key().isEmpty()) {
+            successMsg += QString(
+                              "Ваш ключ шифрування: %1\n\n"
+                              "⚠️ ВАЖЛИВО: Збережіть цей ключ!\n"
+                              "Він знадобиться для розшифрування повідомлення.\n\n"
+                              ).arg(job->key());
+        }
+        successMsg += "Для витягування виберіть усі (або достатню кількість) зображень набору.";
+
+        QMessageBox::information(this, "Успіх", successMsg);
+        return;
+    }
+
+    // Зберігаємо результат разом з оригіналом і повідомленням для аналізу.
+    modifiedImage = result;
+    hiddenSourceImage = job->sourceImage();
+    hiddenMessage = job->message();
+    hiddenSourcePath = job->sourcePath();
+    hiddenKey = job->key();
+    hide_saveBtn->setEnabled(true);
+
+    // Відображаємо результат з пірамід, побудованих завданням.
+    modifiedPreview = job->resultPreview();
+    displayImagePreview(hide_resultImageLabel, modifiedPreview);
+
+    // Оновлюємо вкладку аналізу.
+    displayImagePreview(analysis_originalImageLabel, job->sourcePreview());
+    displayImagePreview(analysis_modifiedImageLabel, modifiedPreview);
+
+    // Формуємо повідомлення про успіх.
+    QString successMsg = "Повідомлення успішно приховано!\n\n";
+
+    if (!job->key().isEmpty()) {
+        successMsg += QString(
+                          "Ваш ключ шифрування: %1\n\n"
+                          "⚠️ ВАЖЛИВО: Збережіть цей ключ!\n"
+                          "Він знадобиться для розшифрування повідомлення.\n\n"
+                          ).arg(job->key());
+    }
+
+    successMsg += "Перейдіть до вкладки 'Аналіз зображення' "
+                  "для детального аналізу.";
+
+    QMessageBox::information(this, "Успіх", successMsg);
+}
+
+/**
+ * @brief Оновлення прогресу поточного завдання витягування.
+ * @param percent Відсоток виконання.
+ */
+void SteganographyWindow::onExtractProgress(int percent) {
+    extract_progressBar->setValue(percent);
+}
+
+/**
+ * @brief Завершення завдання витягування.
+ *
+ * @param message Витягнуте повідомлення.
+ * @param cancelled Чи було завдання скасоване.
+ */
+void SteganographyWindow::onExtractFinished(const QString& message, bool cancelled) {
+    SteganographyJob* job = qobject_cast<SteganographyJob*>(sender());
+    if (!job) {
+        return;
+    }
+
+    extractJobs.removeOne(job);
+    job->deleteLater();
+
+    // Наступне завдання з черги почне прогрес з нуля.
+    extract_progressBar->setValue(0);
+    updateJobStatus();
+
+    if (cancelled) {
+        qDebug() << "Extract job cancelled";
+        return;
+    }
+
+    if (job->sourceImage().isNull()) {
+        QMessageBox::warning(
+            this,
+            "Помилка",
+            "Не вдалося завантажити зображення!"
+            );
+        return;
+    }
 
-    // ========== КРОК 5: Відображаємо результат ==========
     extract_messageEdit->setPlainText(message);
 
     if (message != "Повідомлення не знайдено") {
@@ -406,20 +544,141 @@ void SteganographyWindow::extractMessage() {
             "Якщо повідомлення було зашифроване, перевірте правильність ключа."
             );
     }
+}
+
+/**
+ * @brief Скасування всіх завдань приховування.
+ *
+ * Завдання в черзі завершуються одразу після старту, поточне - після
+ * смуг, що вже обробляються. Сигнали завершення прибирають їх зі списку.
+ */
+void SteganographyWindow::cancelHideJobs() {
+    for (SteganographyJob* job : std::as_const(hideJobs)) {
+        job->cancel();
+    }
+    hide_cancelBtn->setEnabled(false);
+}
+
+/**
+ * @brief Скасування всіх завдань витягування.
+ */
+void SteganographyWindow::cancelExtractJobs() {
+    for (SteganographyJob* job : std::as_const(extractJobs)) {
+        job->cancel();
+    }
+    extract_cancelBtn->setEnabled(false);
+}
+
+/*
+ * ============================================================================
+ * ФОНОВЕ ЗАВАНТАЖЕННЯ ЗОБРАЖЕНЬ
+ * ============================================================================
+ */
+
+/**
+ * @brief Попередній перегляд вибраного файлу готовий.
+ *
+ * Для вкладки приховування також показує ємність, обчислену за
+ * розміром повного зображення з заголовка файлу.
+ *
+ * @param requestId Номер запиту.
+ * @param path Шлях до файлу.
+ * @param preview Піраміда перегляду.
+ */
+void SteganographyWindow::onPreviewReady(int requestId, const QString& path,
+                                         const ImagePreview& preview) {
+    if (requestId == hidePreviewRequest) {
+        hidePreviewRequest = 0;
+        originalPreview = preview;
+
+        // ========== Відображаємо попередній перегляд ==========
+        displayImagePreview(hide_imageLabel, originalPreview);
+
+        // Оновлюємо зображення у вкладці аналізу.
+        displayImagePreview(analysis_originalImageLabel, originalPreview);
+
+        // ========== Обчислюємо та показуємо ємність ==========
+        const QSize size = originalPreview.fullSize();
+        qint64 maxCapacity = stegoEngine->calculateMaxCapacity(size);
+
+        QMessageBox::information(
+            this,
+            "Інформація про зображення",
+            QString("Зображення завантажено!\n\n"
+                    "Розмір: %1 x %2 пікселів\n"
+                    "Максимальна ємність: %3 байт (UTF-8)")
+                .arg(size.width())
+                .arg(size.height())
+                .arg(maxCapacity)
+            );
+    } else if (requestId == extractPreviewRequest) {
+        extractPreviewRequest = 0;
+        extractPreview = preview;
+        displayImagePreview(extract_imageLabel, extractPreview);
+    } else {
+        qDebug() << "Stale preview ignored:" << path;
+    }
+}
 
-    extract_progressBar->setVisible(false);
+/**
+ * @brief Повне зображення для вкладки аналізу готове.
+ *
+ * Зображення, завантажені на вкладці аналізу, замінюють пару з
+ * останнього приховування; повідомлення тоді береться з форми.
+ *
+ * @param requestId Номер запиту.
+ * @param path Шлях до файлу.
+ * @param image Повне зображення.
+ * @param preview Піраміда перегляду.
+ */
+void SteganographyWindow::onImageReady(int requestId, const QString& path,
+                                       const QImage& image, const ImagePreview& preview) {
+    if (requestId == analysisOriginalRequest) {
+        analysisOriginalRequest = 0;
+        hiddenSourceImage = image;
+        hiddenMessage.clear();
+        displayImagePreview(analysis_originalImageLabel, preview);
+    } else if (requestId == analysisModifiedRequest) {
+        analysisModifiedRequest = 0;
+        modifiedImage = image;
+        modifiedPreview = preview;
+        hiddenMessage.clear();
+        displayImagePreview(analysis_modifiedImageLabel, preview);
+    } else {
+        qDebug() << "Stale image ignored:" << path;
+    }
 }
 
 /**
- * @brief Очищення всіх полів вкладки витягування.
+ * @brief Не вдалося завантажити вибраний файл.
+ *
+ * @param requestId Номер запиту.
+ * @param path Шлях до файлу.
  */
-void SteganographyWindow::clearExtractTab() {
-    extract_imagePathEdit->clear();
-    extract_imageLabel->clear();
-    extract_imageLabel->setText("Натисніть кнопку\nдля вибору зображення");
-    extract_messageEdit->clear();
-    extract_keyEdit->clear();
-    extractImagePath.clear();
+void SteganographyWindow::onImageLoadFailed(int requestId, const QString& path) {
+    if (requestId == hidePreviewRequest) {
+        hidePreviewRequest = 0;
+        currentImagePath.clear();
+        hide_imagePathEdit->clear();
+        hide_imageLabel->setText("Натисніть кнопку\nдля вибору зображення");
+    } else if (requestId == extractPreviewRequest) {
+        extractPreviewRequest = 0;
+        extractImagePath.clear();
+        extract_imagePathEdit->clear();
+        extract_imageLabel->setText("Натисніть кнопку\nдля вибору зображення");
+    } else if (requestId == analysisOriginalRequest) {
+        analysisOriginalRequest = 0;
+    } else if (requestId == analysisModifiedRequest) {
+        analysisModifiedRequest = 0;
+    } else {
+        return;
+    }
+
+    QMessageBox::warning(
+        this,
+        "Помилка",
+        QString("Не вдалося завантажити зображення!\n%1").arg(path)
+        );
 }
 
 /*
@@ -435,8 +694,8 @@ void SteganographyWindow::clearExtractTab() {
  * обчислює метрики якості та відображає результати.
  */
 void SteganographyWindow::analyzeImage() {
-    // Перевірка наявності зображень.
-    if (originalImage.isNull() || modifiedImage.isNull()) {
+    // Перевірка наявності зображень (аналізуємо пару з останнього приховування).
+    if (hiddenSourceImage.isNull() || modifiedImage.isNull()) {
         QMessageBox::warning(
             this,
             "Помилка",
@@ -445,18 +704,20 @@ void SteganographyWindow::analyzeImage() {
         return;
     }
 
-    // Отримуємо повідомлення.
-    QString message = hide_messageEdit->toPlainText();
-
-    // Виконуємо аналіз.
+    // Виконуємо аналіз. Поля форми могли змінитися після постановки
+    // завдання, тому використовуємо збережені оригінал і повідомлення.
+    // Для зображень, завантажених на вкладці аналізу, - текст з форми.
     ImageAnalysisResult result = stegoEngine->analyzeChanges(
-        originalImage,
+        hiddenSourceImage,
         modifiedImage,
-        message
+        hiddenMessage.isEmpty() ? hide_messageEdit->toPlainText() : hiddenMessage
         );
 
     // Відображаємо результати.
     displayAnalysisResults(result);
+
+    // Площини та різниця обчислюються віджетом по видимих тайлах.
+    analysis_visualizer->setImages(hiddenSourceImage, modifiedImage);
 }
 
 /*
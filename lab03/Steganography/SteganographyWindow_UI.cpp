@@ -6,6 +6,7 @@
  */
 
 #include "SteganographyWindow.h"
+#include "PngWriter.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
@@ -13,6 +14,7 @@
 #include <QHeaderView>
 #include <QMessageBox>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QClipboard>
 #include <QApplication>
 
@@ -193,6 +195,71 @@ QWidget* SteganographyWindow::createHideTab() {
     hide_messageEdit->setMinimumHeight(150);
     messageLayout->addWidget(hide_messageEdit);
 
+    // --- Режим вбудовування: бітів на канал та альфа-канал ---
+    QHBoxLayout* planesLayout = new QHBoxLayout();
+
+    QLabel* bitsLabel = new QLabel("Бітів на канал:", this);
+    bitsLabel->setStyleSheet(labelStyle);
+    planesLayout->addWidget(bitsLabel);
+
+    hide_bitsPerChannelSpinBox = new QSpinBox(this);
+    hide_bitsPerChannelSpinBox->setRange(1, 4);
+    hide_bitsPerChannelSpinBox->setValue(1);
+    hide_bitsPerChannelSpinBox->setToolTip(
+        "Більше бітів - більша ємність, але зміни помітніші");
+    planesLayout->addWidget(hide_bitsPerChannelSpinBox);
+
+    hide_alphaCheckBox = new QCheckBox("Використовувати альфа-канал", this);
+    hide_alphaCheckBox->setStyleSheet(
+        "QCheckBox { color: #00E5E8; font-weight: bold; }"
+        );
+    planesLayout->addWidget(hide_alphaCheckBox);
+
+    hide_keyedOrderCheckBox = new QCheckBox("Перемішувати пікселі ключем", this);
+    hide_keyedOrderCheckBox->setStyleSheet(
+        "QCheckBox { color: #00E5E8; font-weight: bold; }"
+        );
+    hide_keyedOrderCheckBox->setToolTip(
+        "Дані розміщуються в псевдовипадковому порядку пікселів, "
+        "що визначається ключем шифрування");
+    planesLayout->addWidget(hide_keyedOrderCheckBox);
+
+    hide_compressCheckBox = new QCheckBox("Стискати повідомлення", this);
+    hide_compressCheckBox->setStyleSheet(
+        "QCheckBox { color: #00E5E8; font-weight: bold; }"
+        );
+    hide_compressCheckBox->setToolTip(
+        "Текст стискається deflate перед вбудовуванням: "
+        "більше тексту в тому ж зображенні та менше змінених пікселів");
+    hide_compressCheckBox->setChecked(true);
+    planesLayout->addWidget(hide_compressCheckBox);
+
+    hide_matrixCheckBox = new QCheckBox("Матричне вбудовування", this);
+    hide_matrixCheckBox->setStyleSheet(
+        "QCheckBox { color: #00E5E8; font-weight: bold; }"
+        );
+    hide_matrixCheckBox->setToolTip(
+        "Коди Геммінга: не більше однієї зміни на блок молодших бітів, "
+        "тому змінюється менше пікселів (лише 1 біт на канал)");
+    planesLayout->addWidget(hide_matrixCheckBox);
+
+    QLabel* eccLabel = new QLabel("Парність RS:", this);
+    eccLabel->setStyleSheet(labelStyle);
+    planesLayout->addWidget(eccLabel);
+
+    hide_eccSpinBox = new QSpinBox(this);
+    hide_eccSpinBox->setRange(0, 64);
+    hide_eccSpinBox->setSingleStep(2);
+    hide_eccSpinBox->setValue(0);
+    hide_eccSpinBox->setSpecialValueText("вимк.");
+    hide_eccSpinBox->setToolTip(
+        "Символів парності коду Ріда-Соломона на слово з 255 байтів: "
+        "виправляється до половини стільки пошкоджених байтів у кожному слові");
+    planesLayout->addWidget(hide_eccSpinBox);
+    planesLayout->addStretch();
+
+    messageLayout->addLayout(planesLayout);
+
     leftLayout->addWidget(messageGroup);
 
     // ========== Кнопки дій ==========
@@ -336,16 +403,42 @@ QWidget* SteganographyWindow::createHideTab() {
     resultImageCenterLayout->addStretch();
     resultImageLayout->addLayout(resultImageCenterLayout);
 
-    // Прогрес-бар.
+    // Прогрес-бар, черга та скасування фонових завдань.
+    QHBoxLayout* hideProgressLayout = new QHBoxLayout();
     hide_progressBar = new QProgressBar(this);
     hide_progressBar->setVisible(false);
-    resultImageLayout->addWidget(hide_progressBar);
+    hideProgressLayout->addWidget(hide_progressBar, 1);
+
+    hide_queueLabel = new QLabel(this);
+    hide_queueLabel->setStyleSheet("color: #aaaaaa; font-size: 11px;");
+    hide_queueLabel->setVisible(false);
+    hideProgressLayout->addWidget(hide_queueLabel);
+
+    hide_cancelBtn = new QPushButton("Скасувати", this);
+    hide_cancelBtn->setVisible(false);
+    hide_cancelBtn->setStyleSheet(
+        "QPushButton {"
+        "   background: #3a3a3a;"
+        "   color: #ffffff;"
+        "   font-size: 12px;"
+        "   border: 1px solid #dc2626;"
+        "   border-radius: 6px;"
+        "   padding: 4px 12px;"
+        "}"
+        "QPushButton:hover {"
+        "   background: #dc2626;"
+        "}"
+        );
+    connect(hide_cancelBtn, &QPushButton::clicked,
+            this, &SteganographyWindow::cancelHideJobs);
+    hideProgressLayout->addWidget(hide_cancelBtn);
+    resultImageLayout->addLayout(hideProgressLayout);
 
     // Кнопка збереження результату.
-    QPushButton* saveBtn = new QPushButton("Зберегти результат", this);
-    saveBtn->setMinimumHeight(40);
-    saveBtn->setEnabled(false);
-    saveBtn->setStyleSheet(
+    hide_saveBtn = new QPushButton("Зберегти результат", this);
+    hide_saveBtn->setMinimumHeight(40);
+    hide_saveBtn->setEnabled(false);
+    hide_saveBtn->setStyleSheet(
         "QPushButton {"
         "   background: qlineargradient(x1:0, y1:0, x2:1, y2:0,"
         "       stop:0 #4ade80, stop:1 #22c55e);"
@@ -365,7 +458,7 @@ QWidget* SteganographyWindow::createHideTab() {
         );
 
     // Обробник збереження.
-    connect(saveBtn, &QPushButton::clicked, [this, saveBtn]() {
+    connect(hide_saveBtn, &QPushButton::clicked, [this]() {
         if (modifiedImage.isNull()) return;
 
         QString fileName = QFileDialog::getSaveFileName(
@@ -376,20 +469,41 @@ QWidget* SteganographyWindow::createHideTab() {
             );
 
         if (!fileName.isEmpty()) {
-            if (modifiedImage.save(fileName)) {
+            // JPEG з втратами руйнує молодші біти пікселів: повідомлення
+            // записується в коефіцієнти DCT оригіналу (saveJpegResult).
+            const QString suffix = QFileInfo(fileName).suffix().toLower();
+            if (suffix == "jpg" || suffix == "jpeg") {
+                if (saveJpegResult(fileName)) {
+                    QMessageBox::information(this, "Успіх",
+                                             "Зображення успішно збережено!");
+                }
+                return;
+            }
+
+            // PNG стискається паралельно (PngWriter), інші формати - QImage::save.
+            bool saved = false;
+            if (suffix == "png") {
+                PngWriter writer(fileName);
+                saved = writer.write(modifiedImage);
+                if (!saved) {
+                    QMessageBox::warning(this, "Помилка",
+                                         "Не вдалося зберегти зображення: " + writer.errorString());
+                }
+            } else {
+                saved = modifiedImage.save(fileName);
+            }
+
+            if (saved) {
                 QMessageBox::information(this, "Успіх",
                                          "Зображення успішно збережено!");
             }
         }
     });
-    resultImageLayout->addWidget(saveBtn);
+    resultImageLayout->addWidget(hide_saveBtn);
 
-    // Активація кнопки збереження.
-    connect(hide_hideBtn, &QPushButton::clicked, [saveBtn]() {
-        saveBtn->setEnabled(true);
-    });
-    connect(hide_selectImageBtn, &QPushButton::clicked, [saveBtn]() {
-        saveBtn->setEnabled(false);
+    // Кнопка активується після успішного завершення завдання (onHideFinished).
+    connect(hide_selectImageBtn, &QPushButton::clicked, [this]() {
+        hide_saveBtn->setEnabled(false);
     });
 
     rightLayout->addWidget(resultImageGroup);
@@ -637,11 +751,37 @@ QWidget* SteganographyWindow::createExtractTab() {
 
     rightLayout->addWidget(imageGroup);
 
-    // ========== Прогрес-бар ==========
+    // ========== Прогрес-бар, черга та скасування ==========
+    QHBoxLayout* extractProgressLayout = new QHBoxLayout();
     extract_progressBar = new QProgressBar(this);
     extract_progressBar->setVisible(false);
     extract_progressBar->setMinimumHeight(30);
-    rightLayout->addWidget(extract_progressBar);
+    extractProgressLayout->addWidget(extract_progressBar, 1);
+
+    extract_queueLabel = new QLabel(this);
+    extract_queueLabel->setStyleSheet("color: #aaaaaa; font-size: 11px;");
+    extract_queueLabel->setVisible(false);
+    extractProgressLayout->addWidget(extract_queueLabel);
+
+    extract_cancelBtn = new QPushButton("Скасувати", this);
+    extract_cancelBtn->setVisible(false);
+    extract_cancelBtn->setStyleSheet(
+        "QPushButton {"
+        "   background: #3a3a3a;"
+        "   color: #ffffff;"
+        "   font-size: 12px;"
+        "   border: 1px solid #dc2626;"
+        "   border-radius: 6px;"
+        "   padding: 4px 12px;"
+        "}"
+        "QPushButton:hover {"
+        "   background: #dc2626;"
+        "}"
+        );
+    connect(extract_cancelBtn, &QPushButton::clicked,
+            this, &SteganographyWindow::cancelExtractJobs);
+    extractProgressLayout->addWidget(extract_cancelBtn);
+    rightLayout->addLayout(extractProgressLayout);
 
     rightLayout->addStretch();
 
@@ -745,16 +885,9 @@ QWidget* SteganographyWindow::createAnalysisTab() {
             "Images (*.png *.jpg *.jpeg *.bmp)"
             );
 
+        // Для аналізу потрібне повне зображення; декодується у фоні (onImageReady).
         if (!fileName.isEmpty()) {
-            originalImage.load(fileName);
-            if (!originalImage.isNull()) {
-                QPixmap pixmap = QPixmap::fromImage(originalImage);
-                analysis_originalImageLabel->setPixmap(
-                    pixmap.scaled(analysis_originalImageLabel->size(),
-                                  Qt::KeepAspectRatio,
-                                  Qt::SmoothTransformation)
-                    );
-            }
+            analysisOriginalRequest = imageLoader->requestImage(fileName);
         }
     });
     origGroupLayout->addWidget(loadOrigBtn);
@@ -826,15 +959,7 @@ QWidget* SteganographyWindow::createAnalysisTab() {
             );
 
         if (!fileName.isEmpty()) {
-            modifiedImage.load(fileName);
-            if (!modifiedImage.isNull()) {
-                QPixmap pixmap = QPixmap::fromImage(modifiedImage);
-                analysis_modifiedImageLabel->setPixmap(
-                    pixmap.scaled(analysis_modifiedImageLabel->size(),
-                                  Qt::KeepAspectRatio,
-                                  Qt::SmoothTransformation)
-                    );
-            }
+            analysisModifiedRequest = imageLoader->requestImage(fileName);
         }
     });
     modGroupLayout->addWidget(loadModBtn);
@@ -894,7 +1019,7 @@ QWidget* SteganographyWindow::createAnalysisTab() {
 
     analysisTable = new QTableWidget(this);
     analysisTable->setColumnCount(3);
-    analysisTable->setRowCount(8);
+    analysisTable->setRowCount(12);
     analysisTable->setHorizontalHeaderLabels({
         "Параметр",
         "Оригінал",
@@ -908,7 +1033,11 @@ QWidget* SteganographyWindow::createAnalysisTab() {
         "Використана ємність",
         "PSNR (якість)",
         "MSE (помилка)",
+        "MSE по каналах (R/G/B)",
+        "SSIM (структурна схожість)",
         "Змінених пікселів",
+        "Оцінка вбудовування (RS/SPA)",
+        "Хі-квадрат (ймовірність)",
         "Візуальна різниця"
     };
     analysisTable->setVerticalHeaderLabels(rowHeaders);
@@ -966,6 +1095,50 @@ QWidget* SteganographyWindow::createAnalysisTab() {
 
     bottomLayout->addWidget(detailsGroup, 1);
 
+    // ========== Бітові площини та карта різниці ==========
+    QGroupBox* planesGroup = new QGroupBox("Бітові площини та карта різниці", this);
+    QVBoxLayout* planesGroupLayout = new QVBoxLayout(planesGroup);
+
+    QHBoxLayout* planesControlsLayout = new QHBoxLayout();
+    QLabel* planeLabel = new QLabel("Показати:", this);
+    planeLabel->setStyleSheet(labelStyle);
+    planesControlsLayout->addWidget(planeLabel);
+
+    analysis_planeCombo = new QComboBox(this);
+    analysis_planeCombo->addItem("Різниця (теплова карта)", int(BitPlaneRenderer::Mode::Difference));
+    analysis_planeCombo->addItem("Молодший біт: червоний (R)", int(BitPlaneRenderer::Mode::Red));
+    analysis_planeCombo->addItem("Молодший біт: зелений (G)", int(BitPlaneRenderer::Mode::Green));
+    analysis_planeCombo->addItem("Молодший біт: синій (B)", int(BitPlaneRenderer::Mode::Blue));
+    analysis_planeCombo->addItem("Молодший біт: альфа (A)", int(BitPlaneRenderer::Mode::Alpha));
+    planesControlsLayout->addWidget(analysis_planeCombo);
+
+    QPushButton* fitBtn = new QPushButton("Вписати", this);
+    planesControlsLayout->addWidget(fitBtn);
+
+    QLabel* planesHintLabel = new QLabel(
+        "Колесо - масштаб, перетягування - зсув, подвійне клацання - вписати",
+        this
+        );
+    planesHintLabel->setStyleSheet("color: #888888; font-size: 11px;");
+    planesHintLabel->setWordWrap(true);
+    planesControlsLayout->addStretch();
+    planesGroupLayout->addLayout(planesControlsLayout);
+    planesGroupLayout->addWidget(planesHintLabel);
+
+    // Тайли обчислюються лише для видимої області, тому великі зображення
+    // не сповільнюють інтерфейс.
+    analysis_visualizer = new LsbVisualizer(this);
+    planesGroupLayout->addWidget(analysis_visualizer);
+
+    connect(analysis_planeCombo, &QComboBox::currentIndexChanged, [this]() {
+        analysis_visualizer->setMode(
+            BitPlaneRenderer::Mode(analysis_planeCombo->currentData().toInt()));
+    });
+    connect(fitBtn, &QPushButton::clicked,
+            analysis_visualizer, &LsbVisualizer::fitToView);
+
+    bottomLayout->addWidget(planesGroup, 1);
+
     mainLayout->addLayout(bottomLayout);
 
     return analysisTab;
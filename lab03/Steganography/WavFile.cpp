@@ -0,0 +1,254 @@
+/*
+ * WavFile.cpp
+ *
+ * Реалізація розбору заголовка RIFF/WAVE та відображення відліків PCM.
+ * Читаються лише заголовки блоків (кілька десятків байтів), блок data
+ * відображається в пам'ять цілком.
+ */
+
+#include "WavFile.h"
+#include <QtEndian>
+
+/// Формат WAVE_FORMAT_PCM.
+static const quint16 WAVE_FORMAT_PCM = 0x0001;
+
+/// Формат WAVE_FORMAT_EXTENSIBLE (підформат - у GUID).
+static const quint16 WAVE_FORMAT_EXTENSIBLE = 0xFFFE;
+
+/// Мінімальний розмір блока fmt (PCMWAVEFORMAT).
+static const quint32 FORMAT_MIN_SIZE = 16;
+
+/// Розмір блока fmt з підформатом (WAVEFORMATEXTENSIBLE).
+static const quint32 FORMAT_EXTENSIBLE_SIZE = 40;
+
+/// Зсув GUID підформату в блоці fmt.
+static const int SUBFORMAT_OFFSET = 24;
+
+/* ============================================================================
+ *                      КОНСТРУКТОР ТА ДЕСТРУКТОР
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор.
+ * @param fileName Шлях до файлу WAV.
+ */
+WavFile::WavFile(const QString& fileName)
+    : file(fileName) {
+}
+
+/**
+ * @brief Деструктор.
+ */
+WavFile::~WavFile() {
+    if (mapped) {
+        file.unmap(mapped);
+    }
+}
+
+/* ============================================================================
+ *                          РОЗБІР ЗАГОЛОВКА
+ * ============================================================================
+ */
+
+/**
+ * @brief Розбір заголовка та відображення відліків.
+ *
+ * Алгоритм:
+ * 1. Перевіряємо заголовок RIFF/WAVE.
+ * 2. Обходимо блоки (з вирівнюванням на 2 байти): fmt розбираємо,
+ *    невідомі пропускаємо, на data зупиняємося.
+ * 3. Відображаємо цілі кадри блока data в пам'ять. Розмір блока
+ *    обмежується розміром файлу (записувачі потоків лишають його завеликим).
+ *
+ * @param writable true - відліки можна змінювати (зміни пишуться у файл).
+ * @return true у разі успіху.
+ */
+bool WavFile::open(bool writable) {
+    if (mapped) {
+        error = "File is already open";
+        return false;
+    }
+    if (!file.open(writable ? QIODevice::ReadWrite : QIODevice::ReadOnly)) {
+        error = file.errorString();
+        return false;
+    }
+
+    // ========== КРОК 1: RIFF/WAVE ==========
+    const QByteArray riff = file.read(12);
+    if (riff.size() != 12 || !riff.startsWith("RIFF") || riff.mid(8, 4) != "WAVE") {
+        error = "Not a RIFF/WAVE file";
+        return false;
+    }
+
+    // ========== КРОК 2: Блоки ==========
+    bool formatRead = false;
+    quint32 dataSize = 0;
+    for (;;) {
+        const QByteArray chunk = file.read(8);
+        if (chunk.size() != 8) {
+            error = "No data chunk";
+            return false;
+        }
+
+        const QByteArray id = chunk.left(4);
+        const quint32 size = qFromLittleEndian<quint32>(chunk.constData() + 4);
+
+        if (id == "fmt ") {
+            if (!readFormat(size)) {
+                return false;
+            }
+            formatRead = true;
+        } else if (id == "data") {
+            dataSize = size;
+            break;
+        } else if (!file.seek(file.pos() + qint64(size) + (size & 1))) {
+            error = "Truncated chunk";
+            return false;
+        }
+    }
+
+    if (!formatRead) {
+        error = "Data chunk precedes format chunk";
+        return false;
+    }
+
+    // ========== КРОК 3: Відображення ==========
+    const qint64 dataOffset = file.pos();
+    const qint64 frameBytes = qint64(channelCount) * sampleBytes();
+    const qint64 dataBytes = qMin<qint64>(dataSize, file.size() - dataOffset);
+    const qint64 frames = dataBytes / frameBytes;
+    if (frames <= 0) {
+        error = "No samples";
+        return false;
+    }
+
+    mapped = file.map(dataOffset, frames * frameBytes);
+    if (!mapped) {
+        error = file.errorString();
+        return false;
+    }
+
+    samplesTotal = frames * channelCount;
+    return true;
+}
+
+/**
+ * @brief Розбір блока fmt.
+ *
+ * Підтримується лише цілочисельний PCM з 16 або 24 бітами на відлік
+ * (для EXTENSIBLE - підформат KSDATAFORMAT_SUBTYPE_PCM). Вирівнювання
+ * кадру має дорівнювати канали × байти відліку (без доповнення).
+ *
+ * @param chunkSize Розмір блока.
+ * @return true якщо формат підтримується.
+ */
+bool WavFile::readFormat(quint32 chunkSize) {
+    if (chunkSize < FORMAT_MIN_SIZE) {
+        error = "Invalid format chunk";
+        return false;
+    }
+
+    const QByteArray format = file.read(qMin(chunkSize, FORMAT_EXTENSIBLE_SIZE));
+    if (format.size() < int(FORMAT_MIN_SIZE) ||
+        !file.seek(file.pos() + qint64(chunkSize) - format.size() + (chunkSize & 1))) {
+        error = "Truncated format chunk";
+        return false;
+    }
+
+    const char* data = format.constData();
+    quint16 tag = qFromLittleEndian<quint16>(data);
+    channelCount = qFromLittleEndian<quint16>(data + 2);
+    rate = int(qFromLittleEndian<quint32>(data + 4));
+    const quint16 blockAlign = qFromLittleEndian<quint16>(data + 12);
+    sampleBits = qFromLittleEndian<quint16>(data + 14);
+
+    if (tag == WAVE_FORMAT_EXTENSIBLE && format.size() == int(FORMAT_EXTENSIBLE_SIZE)) {
+        // Перші 2 байти GUID підформату - код формату.
+        tag = qFromLittleEndian<quint16>(data + SUBFORMAT_OFFSET);
+    }
+
+    if (tag != WAVE_FORMAT_PCM) {
+        error = QString("Unsupported WAV format 0x%1 (PCM only)").arg(tag, 4, 16, QChar('0'));
+        return false;
+    }
+    if (sampleBits != 16 && sampleBits != 24) {
+        error = QString("Unsupported sample size: %1 bits (16 or 24 only)").arg(sampleBits);
+        return false;
+    }
+    if (channelCount <= 0 || blockAlign != channelCount * sampleBytes()) {
+        error = "Invalid channel layout";
+        return false;
+    }
+
+    return true;
+}
+
+/* ============================================================================
+ *                              ДОСТУП ДО ДАНИХ
+ * ============================================================================
+ */
+
+/**
+ * @brief Кількість каналів.
+ * @return Кількість каналів.
+ */
+int WavFile::channels() const {
+    return channelCount;
+}
+
+/**
+ * @brief Частота дискретизації.
+ * @return Кадрів за секунду.
+ */
+int WavFile::sampleRate() const {
+    return rate;
+}
+
+/**
+ * @brief Розрядність відліку.
+ * @return 16 або 24.
+ */
+int WavFile::bitsPerSample() const {
+    return sampleBits;
+}
+
+/**
+ * @brief Розмір відліку в байтах.
+ * @return 2 або 3.
+ */
+int WavFile::sampleBytes() const {
+    return sampleBits == 24 ? PCM24_BYTES : PCM16_BYTES;
+}
+
+/**
+ * @brief Кількість відліків усіх каналів.
+ * @return Кількість відліків (кадри × канали).
+ */
+qint64 WavFile::sampleCount() const {
+    return samplesTotal;
+}
+
+/**
+ * @brief Відліки для зміни.
+ * @return Початок блока data.
+ */
+uchar* WavFile::samples() {
+    return mapped;
+}
+
+/**
+ * @brief Відліки для читання.
+ * @return Початок блока data.
+ */
+const uchar* WavFile::constSamples() const {
+    return mapped;
+}
+
+/**
+ * @brief Опис останньої помилки.
+ * @return Текст помилки.
+ */
+QString WavFile::errorString() const {
+    return error;
+}
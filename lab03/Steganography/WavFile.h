@@ -0,0 +1,124 @@
+/*
+ * WavFile.h
+ *
+ * Заголовочний файл доступу до відліків нестисненого PCM файлу WAV.
+ *
+ * Основні можливості:
+ * - Розбір заголовка RIFF/WAVE (блоки fmt та data), без читання відліків.
+ * - 16- та 24-бітний цілочисельний PCM (WAVE_FORMAT_PCM та EXTENSIBLE).
+ * - Відображення блока data в пам'ять (QFile::map) для читання або
+ *   зміни на місці: файл ніколи не завантажується в QByteArray.
+ */
+
+#ifndef WAVFILE_H
+#define WAVFILE_H
+
+#include <QString>
+#include <QFile>
+
+/**
+ * @class WavFile
+ * @brief Відліки PCM файлу WAV, відображені в пам'ять.
+ *
+ * Відліки каналів чергуються (кадр за кадром) і зберігаються у форматі
+ * little-endian, тому молодший байт відліку - перший. Пам'ять процесу
+ * не залежить від розміру файлу: сторінки підвантажує операційна система,
+ * а змінені сторінки записуються у файл при знятті відображення.
+ */
+class WavFile {
+public:
+    /**
+     * @brief Конструктор.
+     * @param fileName Шлях до файлу WAV.
+     */
+    explicit WavFile(const QString& fileName);
+
+    /**
+     * @brief Деструктор.
+     *
+     * Знімає відображення (змінені відліки записуються у файл).
+     */
+    ~WavFile();
+
+    /**
+     * @brief Розбір заголовка та відображення відліків.
+     *
+     * @param writable true - відліки можна змінювати (зміни пишуться у файл).
+     * @return true у разі успіху.
+     */
+    bool open(bool writable = false);
+
+    /**
+     * @brief Кількість каналів.
+     * @return Кількість каналів.
+     */
+    int channels() const;
+
+    /**
+     * @brief Частота дискретизації.
+     * @return Кадрів за секунду.
+     */
+    int sampleRate() const;
+
+    /**
+     * @brief Розрядність відліку.
+     * @return 16 або 24.
+     */
+    int bitsPerSample() const;
+
+    /**
+     * @brief Розмір відліку в байтах.
+     * @return 2 або 3.
+     */
+    int sampleBytes() const;
+
+    /**
+     * @brief Кількість відліків усіх каналів.
+     * @return Кількість відліків (кадри × канали).
+     */
+    qint64 sampleCount() const;
+
+    /**
+     * @brief Відліки для зміни (лише після open(true)).
+     * @return Початок блока data.
+     */
+    uchar* samples();
+
+    /**
+     * @brief Відліки для читання.
+     * @return Початок блока data.
+     */
+    const uchar* constSamples() const;
+
+    /**
+     * @brief Опис останньої помилки.
+     * @return Текст помилки.
+     */
+    QString errorString() const;
+
+    /// Розмір відліку 16-бітного PCM у байтах.
+    static constexpr int PCM16_BYTES = 2;
+
+    /// Розмір відліку 24-бітного PCM у байтах.
+    static constexpr int PCM24_BYTES = 3;
+
+private:
+    /**
+     * @brief Розбір блока fmt.
+     *
+     * @param chunkSize Розмір блока.
+     * @return true якщо формат підтримується.
+     */
+    bool readFormat(quint32 chunkSize);
+
+    // ========== Дані ==========
+    QFile file;                     ///< Файл WAV.
+    QString error;                  ///< Опис останньої помилки.
+    uchar* mapped = nullptr;        ///< Відображений блок data.
+    int channelCount = 0;           ///< Кількість каналів.
+    int rate = 0;                   ///< Частота дискретизації.
+    int sampleBits = 0;             ///< Розрядність відліку.
+    qint64 samplesTotal = 0;        ///< Кількість відліків усіх каналів.
+};
+
+#endif // WAVFILE_H
@@ -0,0 +1,291 @@
+/*
+ * Y4mFile.cpp
+ *
+ * Реалізація розбору заголовків YUV4MPEG2 та відображення кадрів.
+ * Файл відображається в пам'ять цілком, а заголовки кадрів читаються
+ * прямо з відображення - по одному рядку на кадр.
+ */
+
+#include "Y4mFile.h"
+#include <cstring>
+
+/// Сигнатура заголовка потоку.
+static const char STREAM_MAGIC[] = "YUV4MPEG2";
+
+/// Сигнатура заголовка кадру.
+static const char FRAME_MAGIC[] = "FRAME";
+
+/**
+ * @brief Розмір площин кольоровості кадру для параметра C.
+ *
+ * Підтримуються лише 8-бітні формати (1 байт на відлік). Для 4:4:4
+ * з альфа-каналом альфа-площина рахується разом з U і V.
+ *
+ * @param colorspace Значення параметра C (без літери).
+ * @param width Ширина кадру.
+ * @param height Висота кадру.
+ * @return Кількість байтів (-1 - формат не підтримується).
+ */
+static qint64 chromaPlaneBytes(const QByteArray& colorspace, qint64 width, qint64 height) {
+    if (colorspace == "420" || colorspace == "420jpeg" ||
+        colorspace == "420paldv" || colorspace == "420mpeg2") {
+        return 2 * ((width + 1) / 2) * ((height + 1) / 2);
+    }
+    if (colorspace == "422") {
+        return 2 * ((width + 1) / 2) * height;
+    }
+    if (colorspace == "411") {
+        return 2 * ((width + 3) / 4) * height;
+    }
+    if (colorspace == "444") {
+        return 2 * width * height;
+    }
+    if (colorspace == "444alpha") {
+        return 3 * width * height;
+    }
+    if (colorspace == "mono") {
+        return 0;
+    }
+    return -1;
+}
+
+/**
+ * @brief Пошук кінця рядка заголовка у відображенні.
+ *
+ * @param data Початок рядка.
+ * @param available Кількість байтів до кінця файлу.
+ * @return Довжина рядка без "\n" (-1 - рядок не завершено).
+ */
+static qint64 headerLineLength(const uchar* data, qint64 available) {
+    const qint64 limit = qMin(available, Y4mFile::MAX_HEADER_LINE);
+    const void* end = memchr(data, '\n', size_t(limit));
+    return end ? static_cast<const uchar*>(end) - data : -1;
+}
+
+/* ============================================================================
+ *                      КОНСТРУКТОР ТА ДЕСТРУКТОР
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор.
+ * @param fileName Шлях до файлу Y4M.
+ */
+Y4mFile::Y4mFile(const QString& fileName)
+    : file(fileName) {
+}
+
+/**
+ * @brief Деструктор.
+ */
+Y4mFile::~Y4mFile() {
+    if (mapped) {
+        file.unmap(mapped);
+    }
+}
+
+/* ============================================================================
+ *                          РОЗБІР ЗАГОЛОВКІВ
+ * ============================================================================
+ */
+
+/**
+ * @brief Розбір заголовків та відображення кадрів.
+ *
+ * Алгоритм:
+ * 1. Відображаємо файл у пам'ять.
+ * 2. Розбираємо рядок заголовка потоку "YUV4MPEG2 W.. H.. ...".
+ * 3. Послідовно проходимо кадри: перевіряємо рядок "FRAME..." і
+ *    запам'ятовуємо зсув площини Y; наступний кадр - через площини.
+ *    Неповний останній кадр (файл, що ще записується) відкидається.
+ *
+ * @param writable true - кадри можна змінювати (зміни пишуться у файл).
+ * @return true у разі успіху.
+ */
+bool Y4mFile::open(bool writable) {
+    if (mapped) {
+        error = "File is already open";
+        return false;
+    }
+    if (!file.open(writable ? QIODevice::ReadWrite : QIODevice::ReadOnly)) {
+        error = file.errorString();
+        return false;
+    }
+
+    // ========== КРОК 1: Відображення ==========
+    const qint64 fileSize = file.size();
+    if (fileSize <= qint64(sizeof(STREAM_MAGIC))) {
+        error = "Not a YUV4MPEG2 file";
+        return false;
+    }
+
+    mapped = file.map(0, fileSize);
+    if (!mapped) {
+        error = file.errorString();
+        return false;
+    }
+
+    // ========== КРОК 2: Заголовок потоку ==========
+    const qint64 streamLine = headerLineLength(mapped, fileSize);
+    if (streamLine < 0 || memcmp(mapped, STREAM_MAGIC, sizeof(STREAM_MAGIC) - 1) != 0) {
+        error = "Not a YUV4MPEG2 file";
+        return false;
+    }
+    if (!readStreamHeader(QByteArray(reinterpret_cast<const char*>(mapped), int(streamLine)))) {
+        return false;
+    }
+
+    // ========== КРОК 3: Кадри ==========
+    const qint64 frameBytes = lumaPixels() + chromaBytes;
+    qint64 position = streamLine + 1;
+
+    while (position < fileSize) {
+        const uchar* frame = mapped + position;
+        const qint64 frameLine = headerLineLength(frame, fileSize - position);
+        if (frameLine < 0 || memcmp(frame, FRAME_MAGIC, sizeof(FRAME_MAGIC) - 1) != 0) {
+            error = QString("Invalid frame header at offset %1").arg(position);
+            return false;
+        }
+
+        const qint64 lumaOffset = position + frameLine + 1;
+        if (lumaOffset + frameBytes > fileSize) {
+            break;
+        }
+        lumaOffsets.append(lumaOffset);
+        position = lumaOffset + frameBytes;
+    }
+
+    if (lumaOffsets.isEmpty()) {
+        error = "No frames";
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Розбір параметрів заголовка потоку.
+ *
+ * Параметри розділені пробілами, перша літера - назва. Обов'язкові
+ * W і H; F (частота кадрів) - опціонально; C за замовчуванням 420jpeg.
+ * I (розгортка), A (пропорції пікселя) та X на розміщення не впливають.
+ *
+ * @param line Рядок заголовка без "\n".
+ * @return true якщо формат підтримується.
+ */
+bool Y4mFile::readStreamHeader(const QByteArray& line) {
+    QByteArray colorspace = "420jpeg";
+
+    const QList<QByteArray> tokens = line.split(' ');
+    for (const QByteArray& token : tokens.mid(1)) {
+        if (token.isEmpty()) {
+            continue;
+        }
+        const QByteArray value = token.mid(1);
+        switch (token.at(0)) {
+        case 'W':
+            frameWidth = value.toInt();
+            break;
+        case 'H':
+            frameHeight = value.toInt();
+            break;
+        case 'F': {
+            const QList<QByteArray> rate = value.split(':');
+            if (rate.size() == 2) {
+                rateNumerator = rate.at(0).toInt();
+                rateDenominator = rate.at(1).toInt();
+            }
+            break;
+        }
+        case 'C':
+            colorspace = value;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (frameWidth <= 0 || frameHeight <= 0) {
+        error = "Invalid frame size";
+        return false;
+    }
+
+    chromaBytes = chromaPlaneBytes(colorspace, frameWidth, frameHeight);
+    if (chromaBytes < 0) {
+        error = QString("Unsupported colorspace: C%1 (8-bit only)").arg(QString::fromLatin1(colorspace));
+        return false;
+    }
+
+    return true;
+}
+
+/* ============================================================================
+ *                              ДОСТУП ДО ДАНИХ
+ * ============================================================================
+ */
+
+/**
+ * @brief Ширина кадру.
+ * @return Ширина в пікселях.
+ */
+int Y4mFile::width() const {
+    return frameWidth;
+}
+
+/**
+ * @brief Висота кадру.
+ * @return Висота в пікселях.
+ */
+int Y4mFile::height() const {
+    return frameHeight;
+}
+
+/**
+ * @brief Кількість повних кадрів.
+ * @return Кількість кадрів.
+ */
+int Y4mFile::frameCount() const {
+    return int(lumaOffsets.size());
+}
+
+/**
+ * @brief Частота кадрів.
+ * @return Кадрів за секунду (0, якщо не вказана).
+ */
+double Y4mFile::frameRate() const {
+    return rateDenominator > 0 ? double(rateNumerator) / rateDenominator : 0.0;
+}
+
+/**
+ * @brief Кількість пікселів площини яскравості.
+ * @return Ширина × висота.
+ */
+qint64 Y4mFile::lumaPixels() const {
+    return qint64(frameWidth) * frameHeight;
+}
+
+/**
+ * @brief Площина яскравості кадру для зміни.
+ * @param frame Номер кадру.
+ * @return Початок площини Y.
+ */
+uchar* Y4mFile::luma(int frame) {
+    return mapped + lumaOffsets.at(frame);
+}
+
+/**
+ * @brief Площина яскравості кадру для читання.
+ * @param frame Номер кадру.
+ * @return Початок площини Y.
+ */
+const uchar* Y4mFile::constLuma(int frame) const {
+    return mapped + lumaOffsets.at(frame);
+}
+
+/**
+ * @brief Опис останньої помилки.
+ * @return Текст помилки.
+ */
+QString Y4mFile::errorString() const {
+    return error;
+}
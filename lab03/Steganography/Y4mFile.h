@@ -0,0 +1,131 @@
+/*
+ * Y4mFile.h
+ *
+ * Заголовочний файл доступу до кадрів нестисненого відео YUV4MPEG2 (Y4M).
+ *
+ * Основні можливості:
+ * - Розбір заголовка потоку (W, H, F, C) та заголовків кадрів FRAME.
+ * - 8-бітні формати кольоровості 4:2:0, 4:2:2, 4:1:1, 4:4:4 та mono.
+ * - Відображення файлу в пам'ять (QFile::map) для читання або зміни
+ *   на місці: кадри ніколи не завантажуються в QByteArray.
+ * - Прямий доступ до площини яскравості (Y) будь-якого кадру.
+ */
+
+#ifndef Y4MFILE_H
+#define Y4MFILE_H
+
+#include <QString>
+#include <QFile>
+#include <QVector>
+
+/**
+ * @class Y4mFile
+ * @brief Кадри файлу YUV4MPEG2, відображені в пам'ять.
+ *
+ * Кадр складається з рядка "FRAME[ параметри]\n" і площин Y, U, V
+ * (у такому порядку, без вирівнювання рядків). Під час відкриття
+ * заголовки кадрів переглядаються послідовно (по одній сторінці на кадр),
+ * і запам'ятовуються зсуви площин Y, тому далі будь-який кадр доступний
+ * без читання попередніх. Змінені сторінки записуються у файл при
+ * знятті відображення.
+ */
+class Y4mFile {
+public:
+    /**
+     * @brief Конструктор.
+     * @param fileName Шлях до файлу Y4M.
+     */
+    explicit Y4mFile(const QString& fileName);
+
+    /**
+     * @brief Деструктор.
+     *
+     * Знімає відображення (змінені кадри записуються у файл).
+     */
+    ~Y4mFile();
+
+    /**
+     * @brief Розбір заголовків та відображення кадрів.
+     *
+     * @param writable true - кадри можна змінювати (зміни пишуться у файл).
+     * @return true у разі успіху.
+     */
+    bool open(bool writable = false);
+
+    /**
+     * @brief Ширина кадру.
+     * @return Ширина в пікселях.
+     */
+    int width() const;
+
+    /**
+     * @brief Висота кадру.
+     * @return Висота в пікселях.
+     */
+    int height() const;
+
+    /**
+     * @brief Кількість повних кадрів.
+     * @return Кількість кадрів.
+     */
+    int frameCount() const;
+
+    /**
+     * @brief Частота кадрів.
+     * @return Кадрів за секунду (0, якщо не вказана).
+     */
+    double frameRate() const;
+
+    /**
+     * @brief Кількість пікселів площини яскравості.
+     * @return Ширина × висота.
+     */
+    qint64 lumaPixels() const;
+
+    /**
+     * @brief Площина яскравості кадру для зміни (лише після open(true)).
+     *
+     * @param frame Номер кадру.
+     * @return Початок площини Y (рядки по width() байтів).
+     */
+    uchar* luma(int frame);
+
+    /**
+     * @brief Площина яскравості кадру для читання.
+     *
+     * @param frame Номер кадру.
+     * @return Початок площини Y (рядки по width() байтів).
+     */
+    const uchar* constLuma(int frame) const;
+
+    /**
+     * @brief Опис останньої помилки.
+     * @return Текст помилки.
+     */
+    QString errorString() const;
+
+    /// Максимальна довжина рядка заголовка потоку або кадру.
+    static constexpr qint64 MAX_HEADER_LINE = 4096;
+
+private:
+    /**
+     * @brief Розбір параметрів заголовка потоку.
+     *
+     * @param line Рядок заголовка без "\n".
+     * @return true якщо формат підтримується.
+     */
+    bool readStreamHeader(const QByteArray& line);
+
+    // ========== Дані ==========
+    QFile file;                     ///< Файл Y4M.
+    QString error;                  ///< Опис останньої помилки.
+    uchar* mapped = nullptr;        ///< Відображений файл.
+    int frameWidth = 0;             ///< Ширина кадру.
+    int frameHeight = 0;            ///< Висота кадру.
+    int rateNumerator = 0;          ///< Чисельник частоти кадрів.
+    int rateDenominator = 0;        ///< Знаменник частоти кадрів.
+    qint64 chromaBytes = 0;         ///< Розмір площин кольоровості кадру.
+    QVector<qint64> lumaOffsets;    ///< Зсуви площин Y кадрів у файлі.
+};
+
+#endif // Y4MFILE_H
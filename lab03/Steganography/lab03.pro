@@ -10,15 +10,65 @@ CONFIG += c++17
 
 SOURCES += \
     Main.cpp \
+    BitPlaneRenderer.cpp \
+    ChaCha20Poly1305.cpp \
+    ImageLoader.cpp \
+    ImagePreview.cpp \
+    ImageStripReader.cpp \
+    JpegCoefficients.cpp \
+    KeyedPermutation.cpp \
+    LsbVisualizer.cpp \
+    PngStripWriter.cpp \
+    PngWriter.cpp \
+    ReedSolomon.cpp \
+    Scrypt.cpp \
     SteganographyEngine.cpp \
+    SteganographyEngine_Audio.cpp \
+    SteganographyEngine_BitPlanes.cpp \
+    SteganographyEngine_Cipher.cpp \
+    SteganographyEngine_Compression.cpp \
+    SteganographyEngine_Ecc.cpp \
+    SteganographyEngine_File.cpp \
+    SteganographyEngine_Jpeg.cpp \
+    SteganographyEngine_Matrix.cpp \
+    SteganographyEngine_Probe.cpp \
+    SteganographyEngine_Shards.cpp \
+    SteganographyEngine_Steganalysis.cpp \
+    SteganographyEngine_Tiled.cpp \
+    SteganographyEngine_Video.cpp \
+    SteganographyJob.cpp \
     SteganographyWindow.cpp \
     SteganographyWindow_Helpers.cpp \
     SteganographyWindow_Slots.cpp \
-    SteganographyWindow_UI.cpp
+    SteganographyWindow_UI.cpp \
+    WavFile.cpp \
+    Y4mFile.cpp
 
 HEADERS += \
+    BitPlaneRenderer.h \
+    ChaCha20Poly1305.h \
+    ImageLoader.h \
+    ImagePreview.h \
+    ImageStripReader.h \
+    JpegErrorManager.h \
+    JpegCoefficients.h \
+    KeyedPermutation.h \
+    LsbVisualizer.h \
+    PngStripWriter.h \
+    PngWriter.h \
+    ReedSolomon.h \
+    Scrypt.h \
     SteganographyEngine.h \
-    SteganographyWindow.h
+    SteganographyJob.h \
+    SteganographyWindow.h \
+    WavFile.h \
+    Y4mFile.h
+
+# zlib: потокове читання та запис PNG смугами, паралельний запис PNG, стиснення файлів.
+LIBS += -lz
+
+# libjpeg: читання та запис коефіцієнтів DCT без перекодування JPEG.
+LIBS += -ljpeg
 
 # Default rules for deployment.
 qnx: target.path = /tmp/$${TARGET}/bin
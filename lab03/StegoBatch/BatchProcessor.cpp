@@ -0,0 +1,811 @@
+/*
+ * BatchProcessor.cpp
+ *
+ * Реалізація конвеєра пакетної обробки зображень.
+ * Містить стадії декодування, обробки та запису, а також
+ * збір списку файлів з каталогів і списків.
+ */
+
+#include "BatchProcessor.h"
+#include "ImageStripReader.h"
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QImageReader>
+#include <QJsonDocument>
+#include <QSet>
+#include <QElapsedTimer>
+#include <QThread>
+#include <QTextStream>
+#include <cstdio>
+
+/* ============================================================================
+ *                              КОНСТРУКТОР
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор конвеєра.
+ *
+ * Налаштовує розміри пулів потоків та глибину конвеєра.
+ * Движки задач працюють у послідовному режимі: паралелізм
+ * забезпечується одночасною обробкою кількох файлів.
+ *
+ * @param options Параметри пакетної обробки.
+ */
+BatchProcessor::BatchProcessor(const BatchOptions& options)
+    : options(options) {
+    const int ideal = QThread::idealThreadCount();
+
+    // Обчислення - по ядру на потік; введення/виведення - менше потоків.
+    const int computeThreads = options.computeThreads > 0 ? options.computeThreads : ideal;
+    const int decodeThreads = options.decodeThreads > 0 ? options.decodeThreads
+                                                        : qMax(2, ideal / 2);
+    const int writeThreads = options.writeThreads > 0 ? options.writeThreads
+                                                      : qMax(2, ideal / 2);
+
+    decodePool.setMaxThreadCount(decodeThreads);
+    computePool.setMaxThreadCount(computeThreads);
+    writePool.setMaxThreadCount(writeThreads);
+
+    // Ядра, не зайняті потоками запису, стискають блоки одного PNG.
+    pngThreads = qMax(1, ideal / writeThreads);
+
+    // Достатньо зображень, щоб усі стадії були зайняті, але не більше.
+    const int depth = options.queueDepth > 0
+                          ? options.queueDepth
+                          : decodeThreads + computeThreads + writeThreads;
+    pipelineSlots.release(depth);
+}
+
+/* ============================================================================
+ *                              ЗАПУСК ОБРОБКИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Запуск обробки всіх файлів.
+ *
+ * Головний потік лише подає файли в конвеєр. Перед подачею він чекає
+ * вільного місця, тому в пам'яті одночасно не більше queueDepth зображень.
+ * Кожна стадія після завершення ставить наступну в чергу свого пулу.
+ *
+ * @return Кількість файлів, оброблених з помилкою.
+ */
+int BatchProcessor::run() {
+    const QVector<BatchInput> files = collectFiles(options.inputs, options.recursive);
+    if (files.isEmpty()) {
+        qWarning() << "No input images found!";
+        return 0;
+    }
+
+    const bool writesFiles = options.operation == BatchOperation::Embed ||
+                             (options.operation == BatchOperation::Extract &&
+                              !options.outputDirectory.isEmpty());
+    if (writesFiles && !QDir().mkpath(options.outputDirectory)) {
+        qWarning() << "Cannot create output directory:" << options.outputDirectory;
+        return int(files.size());
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // Стегоаналізу потрібне все зображення, тому він завжди декодує повністю.
+    const bool tiled = options.tiled && options.operation != BatchOperation::Analyze;
+    const bool jpeg = options.jpeg && (options.operation == BatchOperation::Embed ||
+                                       options.operation == BatchOperation::Extract);
+
+    // Вихідні шляхи вже зайняті embed (без урахування регістру, бо
+    // файлові системи Windows і macOS регістр не розрізняють).
+    QSet<QString> outputs;
+
+    for (const BatchInput& input : files) {
+        pipelineSlots.acquire();
+        const QString path = input.path;
+        const QString suffix = QFileInfo(path).suffix().toLower();
+
+        // ========== Вихідний файл embed ==========
+        QString output;
+        if (options.operation == BatchOperation::Embed) {
+            QString outputSuffix = "png";
+            if (suffix == "wav" || suffix == "y4m") {
+                outputSuffix = suffix;
+            } else if (jpeg) {
+                outputSuffix = "jpg";
+            }
+            output = outputPath(input, outputSuffix);
+
+            // a.png та a.jpg або dir1/a.png та dir2/a.png з однаковим
+            // результатом не перезаписують один одного мовчки.
+            QString error;
+            const QString outputKey = output.toLower();
+            if (outputs.contains(outputKey)) {
+                error = "output file already written by another input: " + output;
+            } else if (!QDir().mkpath(QFileInfo(output).path())) {
+                error = "cannot create output directory";
+            }
+
+            if (!error.isEmpty()) {
+                QJsonObject record;
+                record["file"] = path;
+                record["op"] = operationName();
+                record["status"] = "error";
+                record["error"] = error;
+                failures.fetchAndAddRelaxed(1);
+                finish(record);
+                continue;
+            }
+            outputs.insert(outputKey);
+        }
+
+        // ========== Стадії ==========
+        if (suffix == "wav") {
+            computePool.start([this, path, output]() { audioStage(path, output); });
+        } else if (suffix == "y4m") {
+            computePool.start([this, path, output]() { videoStage(path, output); });
+        } else if (options.operation == BatchOperation::Probe) {
+            computePool.start([this, path]() { probeStage(path); });
+        } else if (jpeg) {
+            computePool.start([this, path, output]() { jpegStage(path, output); });
+        } else if (tiled) {
+            computePool.start([this, path, output]() { tiledStage(path, output); });
+        } else {
+            decodePool.start([this, path, output]() { decodeStage(path, output); });
+        }
+    }
+
+    // Стадії ставлять наступні в чергу, тому чекаємо в порядку конвеєра.
+    decodePool.waitForDone();
+    computePool.waitForDone();
+    writePool.waitForDone();
+
+    qInfo().noquote() << QString("Processed %1 files in %2 ms, %3 failed")
+                             .arg(files.size())
+                             .arg(timer.elapsed())
+                             .arg(failures.loadRelaxed());
+
+    return failures.loadRelaxed();
+}
+
+/**
+ * @brief Збір списку файлів зображень.
+ *
+ * @param inputs Файли, каталоги та списки файлів.
+ * @param recursive Обхід підкаталогів.
+ * @return Список файлів з шляхами відносно вхідних каталогів.
+ */
+QVector<BatchInput> BatchProcessor::collectFiles(const QStringList& inputs, bool recursive) {
+    const QStringList filters = {"*.png", "*.bmp", "*.jpg", "*.jpeg", "*.wav", "*.y4m"};
+    QVector<BatchInput> files;
+
+    for (const QString& input : inputs) {
+        const QFileInfo info(input);
+
+        // ========== Каталог ==========
+        if (info.isDir()) {
+            QDirIterator it(input, filters, QDir::Files,
+                            recursive ? QDirIterator::Subdirectories
+                                      : QDirIterator::NoIteratorFlags);
+            const QDir root(input);
+            while (it.hasNext()) {
+                const QString file = it.next();
+                files.append({file, root.relativeFilePath(file)});
+            }
+            continue;
+        }
+
+        // ========== Список файлів (один шлях на рядок) ==========
+        const QString suffix = info.suffix().toLower();
+        if (suffix == "txt" || suffix == "lst") {
+            QFile list(input);
+            if (!list.open(QIODevice::ReadOnly | QIODevice::Text)) {
+                qWarning() << "Cannot open file list:" << input;
+                continue;
+            }
+            QTextStream stream(&list);
+            while (!stream.atEnd()) {
+                const QString line = stream.readLine().trimmed();
+                if (!line.isEmpty()) {
+                    files.append({line, QFileInfo(line).fileName()});
+                }
+            }
+            continue;
+        }
+
+        // ========== Окремий файл ==========
+        files.append({input, info.fileName()});
+    }
+
+    return files;
+}
+
+/* ============================================================================
+ *                              СТАДІЇ КОНВЕЄРА
+ * ============================================================================
+ */
+
+/**
+ * @brief Стадія 1: декодування зображення.
+ * @param path Шлях до файлу.
+ * @param output Шлях вихідного файлу (embed).
+ */
+void BatchProcessor::decodeStage(const QString& path, const QString& output) {
+    QElapsedTimer timer;
+    timer.start();
+
+    QImageReader reader(path);
+    QImage image = reader.read();
+
+    if (image.isNull()) {
+        QJsonObject record;
+        record["file"] = path;
+        record["op"] = operationName();
+        record["status"] = "error";
+        record["error"] = reader.errorString();
+        failures.fetchAndAddRelaxed(1);
+        finish(record);
+        return;
+    }
+
+    // Перетворення формату - частина декодування, а не обробки.
+    image = image.convertToFormat(QImage::Format_RGB32);
+    const qint64 decodeMs = timer.elapsed();
+
+    computePool.start([this, path, output, image, decodeMs]() {
+        computeStage(path, output, image, decodeMs);
+    });
+}
+
+/**
+ * @brief Стадія 2: виконання операції над зображенням.
+ * @param path Шлях до файлу.
+ * @param output Шлях вихідного файлу (embed).
+ * @param image Декодоване зображення.
+ * @param decodeMs Час декодування в мілісекундах.
+ */
+void BatchProcessor::computeStage(const QString& path, const QString& output,
+                                  const QImage& image, qint64 decodeMs) {
+    QElapsedTimer timer;
+    timer.start();
+
+    SteganographyEngine engine;
+    configure(engine);
+
+    QJsonObject record;
+    record["file"] = path;
+    record["op"] = operationName();
+    record["width"] = image.width();
+    record["height"] = image.height();
+    record["decode_ms"] = decodeMs;
+
+    const bool useKey = !options.key.isEmpty();
+
+    switch (options.operation) {
+    case BatchOperation::Embed: {
+        const bool filePayload = !options.payloadFile.isEmpty();
+        const qint64 capacity = engine.calculateMaxCapacity(image, useKey);
+        record["capacity"] = capacity;
+
+        QImage modified;
+        if (filePayload) {
+            record["bytes"] = QFileInfo(options.payloadFile).size();
+            modified = engine.hideFile(image, options.payloadFile, useKey);
+        } else {
+            record["bytes"] = qint64(options.message.toUtf8().size());
+            record["stored_bytes"] = engine.storedMessageSize(options.message);
+            modified = engine.hideMessage(image, options.message, useKey);
+        }
+        record["process_ms"] = timer.elapsed();
+
+        if (modified.isNull()) {
+            record["status"] = "error";
+            record["error"] = filePayload ? "cannot embed file" : "message too long";
+            failures.fetchAndAddRelaxed(1);
+            break;
+        }
+
+        // Звільняємо місце лише після запису.
+        writePool.start([this, output, modified, record]() {
+            writeStage(output, modified, record);
+        });
+        return;
+    }
+
+    case BatchOperation::Extract: {
+        // Прихований файл записується у вихідний каталог (якщо його задано).
+        QString fileName;
+        qint64 fileSize = 0;
+        if (!options.outputDirectory.isEmpty() && engine.hiddenFileInfo(image, &fileName, &fileSize)) {
+            const QString extracted = engine.extractFile(image, options.outputDirectory, useKey);
+            record["process_ms"] = timer.elapsed();
+            record["file_name"] = fileName;
+            record["file_size"] = fileSize;
+
+            if (extracted.isEmpty()) {
+                record["status"] = "error";
+                record["error"] = "cannot extract file";
+                failures.fetchAndAddRelaxed(1);
+            } else {
+                record["status"] = "ok";
+                record["output"] = extracted;
+            }
+            break;
+        }
+
+        const QString message = engine.extractMessage(image, useKey);
+        record["process_ms"] = timer.elapsed();
+
+        if (message == SteganographyEngine::NOT_FOUND_MESSAGE) {
+            record["status"] = "not_found";
+        } else {
+            record["status"] = "ok";
+            record["message"] = message;
+        }
+        break;
+    }
+
+    case BatchOperation::Probe:
+        // Перевірка заголовка не декодує зображення (probeStage).
+        break;
+
+    case BatchOperation::Analyze: {
+        const SteganalysisResult stats = engine.analyzeStatistics(image);
+        record["process_ms"] = timer.elapsed();
+        record["status"] = "ok";
+        record["chi_square"] = stats.chiSquareProbability;
+        record["chi_square_rate"] = stats.chiSquareRate;
+        record["rs_rate"] = stats.rsRate;
+        record["spa_rate"] = stats.samplePairRate;
+        record["rate"] = stats.estimatedRate;
+        record["suspicious"] = stats.suspicious;
+        break;
+    }
+    }
+
+    finish(record);
+}
+
+/**
+ * @brief Стадія 3: запис зображення з прихованим повідомленням.
+ *
+ * Завжди PNG: стиснення з втратами пошкодило б молодші біти.
+ * PngWriter стискає блоки рядків паралельно (pngThreads потоків).
+ *
+ * @param path Шлях до вихідного файлу.
+ * @param image Зображення для запису.
+ * @param record Результат попередніх стадій.
+ */
+void BatchProcessor::writeStage(const QString& path, const QImage& image, QJsonObject record) {
+    QElapsedTimer timer;
+    timer.start();
+
+    PngWriter writer(path);
+    writer.setCompressionLevel(options.pngLevel);
+    writer.setFilter(options.pngFilter);
+    writer.setThreadCount(pngThreads);
+
+    const bool saved = writer.write(image);
+    record["write_ms"] = timer.elapsed();
+    record["output"] = path;
+
+    if (saved) {
+        record["status"] = "ok";
+    } else {
+        record["status"] = "error";
+        record["error"] = "cannot write output";
+        failures.fetchAndAddRelaxed(1);
+    }
+
+    finish(record);
+}
+
+/**
+ * @brief Поблокова обробка файлу (замість трьох стадій).
+ *
+ * Читання, обробка та запис PNG виконуються смугами в одному потоці,
+ * тому окремі стадії декодування та запису не використовуються.
+ *
+ * @param path Шлях до файлу.
+ * @param output Шлях вихідного файлу (embed).
+ */
+void BatchProcessor::tiledStage(const QString& path, const QString& output) {
+    // Смугами читаються лише PNG та базовий JPEG; решта файлів йде
+    // звичайним конвеєром. decodeStage викликається в цьому ж потоці,
+    // бо пул декодування вже може бути дочеканий.
+    {
+        ImageStripReader reader(path);
+        if (!reader.open()) {
+            qWarning() << "Tiled mode unavailable, using normal processing:" << path
+                       << reader.errorString();
+            decodeStage(path, output);
+            return;
+        }
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    SteganographyEngine engine;
+    configure(engine);
+
+    QJsonObject record;
+    record["file"] = path;
+    record["op"] = operationName();
+    record["tiled"] = true;
+
+    const bool useKey = !options.key.isEmpty();
+
+    switch (options.operation) {
+    case BatchOperation::Embed: {
+        record["bytes"] = qint64(options.message.toUtf8().size());
+        record["output"] = output;
+
+        const bool saved = engine.hideMessageTiled(path, output, options.message, useKey);
+        record["process_ms"] = timer.elapsed();
+
+        if (saved) {
+            record["status"] = "ok";
+        } else {
+            record["status"] = "error";
+            record["error"] = "cannot embed";
+            failures.fetchAndAddRelaxed(1);
+        }
+        break;
+    }
+
+    case BatchOperation::Extract: {
+        const QString message = engine.extractMessageTiled(path, useKey);
+        record["process_ms"] = timer.elapsed();
+
+        if (message.isNull()) {
+            record["status"] = "error";
+            record["error"] = "cannot read image";
+            failures.fetchAndAddRelaxed(1);
+        } else if (message == SteganographyEngine::NOT_FOUND_MESSAGE) {
+            record["status"] = "not_found";
+        } else {
+            record["status"] = "ok";
+            record["message"] = message;
+        }
+        break;
+    }
+
+    case BatchOperation::Probe:
+    case BatchOperation::Analyze:
+        break;
+    }
+
+    finish(record);
+}
+
+/**
+ * @brief Обробка коефіцієнтів DCT файлу JPEG (замість трьох стадій).
+ *
+ * Декодування пікселів і кодування PNG не потрібні, тому файл
+ * обробляється однією задачею пулу обробки.
+ *
+ * @param path Шлях до файлу.
+ * @param output Шлях вихідного файлу (embed).
+ */
+void BatchProcessor::jpegStage(const QString& path, const QString& output) {
+    QElapsedTimer timer;
+    timer.start();
+
+    SteganographyEngine engine;
+    configure(engine);
+
+    QJsonObject record;
+    record["file"] = path;
+    record["op"] = operationName();
+    record["jpeg"] = true;
+
+    const bool useKey = !options.key.isEmpty();
+
+    switch (options.operation) {
+    case BatchOperation::Embed: {
+        record["bytes"] = qint64(options.message.toUtf8().size());
+        record["output"] = output;
+
+        const bool saved = engine.hideMessageJpeg(path, output, options.message, useKey);
+        record["process_ms"] = timer.elapsed();
+
+        if (saved) {
+            record["status"] = "ok";
+        } else {
+            record["status"] = "error";
+            record["error"] = "cannot embed";
+            failures.fetchAndAddRelaxed(1);
+        }
+        break;
+    }
+
+    case BatchOperation::Extract: {
+        const QString message = engine.extractMessageJpeg(path, useKey);
+        record["process_ms"] = timer.elapsed();
+
+        if (message.isNull()) {
+            record["status"] = "error";
+            record["error"] = "cannot read jpeg";
+            failures.fetchAndAddRelaxed(1);
+        } else if (message == SteganographyEngine::NOT_FOUND_MESSAGE) {
+            record["status"] = "not_found";
+        } else {
+            record["status"] = "ok";
+            record["message"] = message;
+        }
+        break;
+    }
+
+    case BatchOperation::Probe:
+    case BatchOperation::Analyze:
+        break;
+    }
+
+    finish(record);
+}
+
+/**
+ * @brief Обробка відліків файлу WAV (замість трьох стадій).
+ *
+ * Відліки відображаються в пам'ять і змінюються на місці в копії файлу,
+ * тому файл обробляється однією задачею пулу обробки. Для embed у JSON
+ * додаються SNR та кількість змінених відліків.
+ *
+ * @param path Шлях до файлу.
+ * @param output Шлях вихідного файлу (embed).
+ */
+void BatchProcessor::audioStage(const QString& path, const QString& output) {
+    QElapsedTimer timer;
+    timer.start();
+
+    SteganographyEngine engine;
+    configure(engine);
+
+    QJsonObject record;
+    record["file"] = path;
+    record["op"] = operationName();
+    record["audio"] = true;
+
+    const bool useKey = !options.key.isEmpty();
+
+    switch (options.operation) {
+    case BatchOperation::Embed: {
+        record["bytes"] = qint64(options.message.toUtf8().size());
+        record["output"] = output;
+
+        const bool saved = !options.message.isEmpty() &&
+                           engine.hideMessageWav(path, output, options.message, useKey);
+        record["process_ms"] = timer.elapsed();
+
+        if (saved) {
+            const AudioAnalysisResult analysis =
+                engine.analyzeAudioChanges(path, output, options.message);
+            record["status"] = "ok";
+            record["snr_db"] = analysis.snr;
+            record["changed_samples"] = analysis.modifiedSamples;
+        } else {
+            record["status"] = "error";
+            record["error"] = options.message.isEmpty() ? "payload files are not supported for audio"
+                                                        : "cannot embed";
+            failures.fetchAndAddRelaxed(1);
+        }
+        break;
+    }
+
+    case BatchOperation::Extract: {
+        const QString message = engine.extractMessageWav(path, useKey);
+        record["process_ms"] = timer.elapsed();
+
+        if (message.isNull()) {
+            record["status"] = "error";
+            record["error"] = "cannot read wav";
+            failures.fetchAndAddRelaxed(1);
+        } else if (message == SteganographyEngine::NOT_FOUND_MESSAGE) {
+            record["status"] = "not_found";
+        } else {
+            record["status"] = "ok";
+            record["message"] = message;
+        }
+        break;
+    }
+
+    case BatchOperation::Probe:
+    case BatchOperation::Analyze:
+        record["status"] = "error";
+        record["error"] = "operation is not supported for audio";
+        failures.fetchAndAddRelaxed(1);
+        break;
+    }
+
+    finish(record);
+}
+
+/**
+ * @brief Обробка кадрів відео Y4M (замість трьох стадій).
+ *
+ * Кадри відображаються в пам'ять і змінюються на місці в копії файлу;
+ * кадри з даними движок обробляє паралельно сам. Для embed у JSON
+ * додаються PSNR, кількість змінених пікселів і кадрів з даними.
+ *
+ * @param path Шлях до файлу.
+ * @param output Шлях вихідного файлу (embed).
+ */
+void BatchProcessor::videoStage(const QString& path, const QString& output) {
+    QElapsedTimer timer;
+    timer.start();
+
+    SteganographyEngine engine;
+    configure(engine);
+
+    QJsonObject record;
+    record["file"] = path;
+    record["op"] = operationName();
+    record["video"] = true;
+
+    const bool useKey = !options.key.isEmpty();
+
+    switch (options.operation) {
+    case BatchOperation::Embed: {
+        record["bytes"] = qint64(options.message.toUtf8().size());
+        record["output"] = output;
+
+        const bool saved = !options.message.isEmpty() &&
+                           engine.hideMessageY4m(path, output, options.message, useKey);
+        record["process_ms"] = timer.elapsed();
+
+        if (saved) {
+            const VideoAnalysisResult analysis =
+                engine.analyzeVideoChanges(path, output, options.message);
+            record["status"] = "ok";
+            record["psnr_db"] = analysis.psnr;
+            record["changed_pixels"] = analysis.modifiedPixels;
+            record["frames_used"] = analysis.framesUsed;
+        } else {
+            record["status"] = "error";
+            record["error"] = options.message.isEmpty() ? "payload files are not supported for video"
+                                                        : "cannot embed";
+            failures.fetchAndAddRelaxed(1);
+        }
+        break;
+    }
+
+    case BatchOperation::Extract: {
+        const QString message = engine.extractMessageY4m(path, useKey);
+        record["process_ms"] = timer.elapsed();
+
+        if (message.isNull()) {
+            record["status"] = "error";
+            record["error"] = "cannot read y4m";
+            failures.fetchAndAddRelaxed(1);
+        } else if (message == SteganographyEngine::NOT_FOUND_MESSAGE) {
+            record["status"] = "not_found";
+        } else {
+            record["status"] = "ok";
+            record["message"] = message;
+        }
+        break;
+    }
+
+    case BatchOperation::Probe:
+    case BatchOperation::Analyze:
+        record["status"] = "error";
+        record["error"] = "operation is not supported for video";
+        failures.fetchAndAddRelaxed(1);
+        break;
+    }
+
+    finish(record);
+}
+
+/**
+ * @brief Перевірка заголовка без декодування файлу (замість трьох стадій).
+ *
+ * Декодуються лише перші рядки зображення з заголовком навантаження,
+ * тому час не залежить від розміру файлу.
+ *
+ * @param path Шлях до файлу.
+ */
+void BatchProcessor::probeStage(const QString& path) {
+    QElapsedTimer timer;
+    timer.start();
+
+    SteganographyEngine engine;
+    configure(engine);
+
+    QJsonObject record;
+    record["file"] = path;
+    record["op"] = operationName();
+
+    bool readable = false;
+    const ProbeResult result = engine.probeFile(path, &readable);
+    record["process_ms"] = timer.elapsed();
+
+    if (!readable) {
+        record["status"] = "error";
+        record["error"] = "cannot read image";
+        failures.fetchAndAddRelaxed(1);
+    } else {
+        record["status"] = "ok";
+        record["found"] = result != ProbeResult::None;
+        record["encrypted"] = result == ProbeResult::Encrypted;
+    }
+
+    finish(record);
+}
+
+/* ============================================================================
+ *                              ДОПОМІЖНІ МЕТОДИ
+ * ============================================================================
+ */
+
+/**
+ * @brief Налаштування движка задачі за параметрами обробки.
+ *
+ * Движок зберігає стан поточної операції (прогрес, скасування), тому
+ * задачі, що виконуються одночасно, не можуть використовувати спільний.
+ *
+ * @param engine Движок задачі.
+ */
+void BatchProcessor::configure(SteganographyEngine& engine) const {
+    engine.setParallelMode(false);
+    engine.setBitsPerChannel(options.bitsPerChannel, options.alpha);
+    engine.setKeyedOrdering(options.keyedOrder);
+    engine.setCompressionEnabled(options.compress);
+    engine.setMatrixEmbedding(options.matrix);
+    engine.setErrorCorrection(options.eccParity);
+    if (!options.key.isEmpty()) {
+        engine.setKey(options.key);
+    }
+}
+
+/**
+ * @brief Вивід результату для файлу та звільнення місця в конвеєрі.
+ *
+ * Формат - JSON Lines: один компактний JSON-об'єкт на рядок.
+ *
+ * @param record Результат обробки файлу.
+ */
+void BatchProcessor::finish(const QJsonObject& record) {
+    const QByteArray line = QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n';
+
+    {
+        QMutexLocker locker(&outputMutex);
+        std::fwrite(line.constData(), 1, size_t(line.size()), stdout);
+        std::fflush(stdout);
+    }
+
+    pipelineSlots.release();
+}
+
+/**
+ * @brief Назва операції для виводу.
+ * @return Рядок "embed", "extract", "probe" або "analyze".
+ */
+QString BatchProcessor::operationName() const {
+    switch (options.operation) {
+    case BatchOperation::Embed:   return "embed";
+    case BatchOperation::Extract: return "extract";
+    case BatchOperation::Probe:   return "probe";
+    case BatchOperation::Analyze: return "analyze";
+    }
+    return QString();
+}
+
+/**
+ * @brief Шлях вихідного файлу для embed.
+ *
+ * Підкаталоги вхідного каталогу зберігаються, тому однакові імена
+ * з різних підкаталогів (-r) не перезаписують одне одного.
+ *
+ * @param input Вхідний файл.
+ * @param suffix Розширення вихідного файлу.
+ * @return Шлях у вихідному каталозі зі збереженням підкаталогів
+ *         вхідного файлу та заданим розширенням.
+ */
+QString BatchProcessor::outputPath(const BatchInput& input, const QString& suffix) const {
+    const QFileInfo relative(input.relative);
+    const QString name = QDir(relative.path()).filePath(relative.completeBaseName() + '.' + suffix);
+    return QDir::cleanPath(QDir(options.outputDirectory).filePath(name));
+}
@@ -0,0 +1,245 @@
+/*
+ * BatchProcessor.h
+ *
+ * Заголовочний файл пакетної обробки зображень.
+ * Містить клас конвеєра для приховування, витягування, перевірки
+ * та аналізу великої кількості зображень без графічного інтерфейсу.
+ *
+ * Основні можливості:
+ * - Обробка каталогів та списків файлів.
+ * - Обмежений конвеєр: декодування → обробка → запис.
+ * - Окремі пули потоків для введення/виведення та обчислень.
+ * - Машиночитаний результат (один JSON-рядок на файл).
+ */
+
+#ifndef BATCHPROCESSOR_H
+#define BATCHPROCESSOR_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QImage>
+#include <QJsonObject>
+#include <QMutex>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include "SteganographyEngine.h"
+#include "PngWriter.h"
+
+/**
+ * @enum BatchOperation
+ * @brief Операція, що виконується над кожним файлом.
+ */
+enum class BatchOperation {
+    Embed,    ///< Приховування повідомлення та запис результату.
+    Extract,  ///< Витягування повідомлення.
+    Probe,    ///< Перевірка наявності повідомлення.
+    Analyze   ///< Статистичний стегоаналіз.
+};
+
+/**
+ * @struct BatchOptions
+ * @brief Параметри пакетної обробки.
+ */
+struct BatchOptions {
+    BatchOperation operation = BatchOperation::Probe;  ///< Операція.
+    QStringList inputs;        ///< Файли та каталоги для обробки.
+    QString outputDirectory;   ///< Каталог для результатів (embed) або прихованих файлів (extract).
+    QString message;           ///< Повідомлення для приховування (embed).
+    QString payloadFile;       ///< Файл для приховування замість повідомлення (embed).
+    QString key;               ///< Ключ шифрування (порожній - без шифрування).
+    bool recursive = false;    ///< Обхід підкаталогів.
+    int decodeThreads = 0;     ///< Потоки декодування (0 - автоматично).
+    int computeThreads = 0;    ///< Потоки обробки (0 - автоматично).
+    int writeThreads = 0;      ///< Потоки запису (0 - автоматично).
+    int queueDepth = 0;        ///< Максимум зображень у конвеєрі (0 - автоматично).
+    bool tiled = false;        ///< Поблокова обробка файлів (дуже великі зображення).
+    bool jpeg = false;         ///< Коефіцієнти DCT файлів JPEG (embed, extract).
+    int bitsPerChannel = 1;    ///< Молодших бітів на канал для embed (1-4).
+    bool alpha = false;        ///< Вбудовування також в альфа-канал (embed).
+    bool keyedOrder = false;   ///< Ключовий порядок пікселів (embed, потребує ключа).
+    bool compress = false;     ///< Стиснення повідомлення deflate (embed).
+    bool matrix = false;       ///< Матричне вбудовування кодами Геммінга (embed).
+    int eccParity = 0;         ///< Символів парності Ріда-Соломона на слово (embed, 0 - без коду).
+    int pngLevel = 6;          ///< Рівень стиснення zlib вихідних PNG (0-9).
+    PngFilter pngFilter = PngFilter::Adaptive;  ///< Фільтр рядків вихідних PNG.
+};
+
+/**
+ * @struct BatchInput
+ * @brief Вхідний файл пакетної обробки.
+ */
+struct BatchInput {
+    QString path;      ///< Шлях до файлу.
+    QString relative;  ///< Шлях відносно вхідного каталогу (для окремих файлів - ім'я).
+};
+
+/**
+ * @class BatchProcessor
+ * @brief Конвеєр пакетної обробки зображень.
+ *
+ * Кожен файл проходить три стадії, кожна у власному пулі потоків:
+ * 1. Декодування (читання з диска та розпакування зображення).
+ * 2. Обробка (операція SteganographyEngine).
+ * 3. Запис (паралельне кодування PNG та збереження, лише для embed).
+ *
+ * Кількість зображень, що одночасно знаходяться в конвеєрі, обмежена
+ * семафором, тому пам'ять не залежить від кількості файлів.
+ * Для кожного файлу в stdout виводиться один JSON-рядок з результатом.
+ */
+class BatchProcessor {
+public:
+    /**
+     * @brief Конструктор конвеєра.
+     * @param options Параметри пакетної обробки.
+     */
+    explicit BatchProcessor(const BatchOptions& options);
+
+    /**
+     * @brief Запуск обробки всіх файлів.
+     *
+     * Блокує виклик до завершення всіх стадій.
+     *
+     * @return Кількість файлів, оброблених з помилкою.
+     */
+    int run();
+
+    /**
+     * @brief Збір списку файлів зображень.
+     *
+     * Каталоги розгортаються у файли з підтримуваними розширеннями (зображення, WAV та Y4M),
+     * файли зі списками (*.txt, *.lst) - у перелічені в них шляхи.
+     *
+     * @param inputs Файли, каталоги та списки файлів.
+     * @param recursive Обхід підкаталогів.
+     * @return Список файлів з шляхами відносно вхідних каталогів.
+     */
+    static QVector<BatchInput> collectFiles(const QStringList& inputs, bool recursive);
+
+private:
+    // ========== Стадії конвеєра ==========
+
+    /**
+     * @brief Стадія 1: декодування зображення.
+     * @param path Шлях до файлу.
+     * @param output Шлях вихідного файлу (embed).
+     */
+    void decodeStage(const QString& path, const QString& output);
+
+    /**
+     * @brief Стадія 2: виконання операції над зображенням.
+     * @param path Шлях до файлу.
+     * @param output Шлях вихідного файлу (embed).
+     * @param image Декодоване зображення.
+     * @param decodeMs Час декодування в мілісекундах.
+     */
+    void computeStage(const QString& path, const QString& output,
+                      const QImage& image, qint64 decodeMs);
+
+    /**
+     * @brief Стадія 3: запис зображення з прихованим повідомленням.
+     * @param path Шлях до вихідного файлу.
+     * @param image Зображення для запису.
+     * @param record Результат попередніх стадій.
+     */
+    void writeStage(const QString& path, const QImage& image, QJsonObject record);
+
+    /**
+     * @brief Поблокова обробка файлу (замість трьох стадій).
+     *
+     * Файл читається та записується смугами в пулі обробки,
+     * зображення повністю в пам'ять не завантажується.
+     *
+     * @param path Шлях до файлу.
+     * @param output Шлях вихідного файлу (embed).
+     */
+    void tiledStage(const QString& path, const QString& output);
+
+    /**
+     * @brief Обробка коефіцієнтів DCT файлу JPEG (замість трьох стадій).
+     *
+     * Пікселі не декодуються: читаються та записуються лише
+     * квантовані коефіцієнти, результат зберігається у форматі JPEG.
+     *
+     * @param path Шлях до файлу.
+     * @param output Шлях вихідного файлу (embed).
+     */
+    void jpegStage(const QString& path, const QString& output);
+
+    /**
+     * @brief Обробка відліків файлу WAV (замість трьох стадій).
+     *
+     * Embed та extract у молодших бітах відліків PCM, відображених
+     * у пам'ять; результат embed зберігається у форматі WAV.
+     *
+     * @param path Шлях до файлу.
+     * @param output Шлях вихідного файлу (embed).
+     */
+    void audioStage(const QString& path, const QString& output);
+
+    /**
+     * @brief Обробка кадрів відео Y4M (замість трьох стадій).
+     *
+     * Embed та extract у молодших бітах площини яскравості кадрів,
+     * відображених у пам'ять; результат embed зберігається у форматі Y4M.
+     *
+     * @param path Шлях до файлу.
+     * @param output Шлях вихідного файлу (embed).
+     */
+    void videoStage(const QString& path, const QString& output);
+
+    /**
+     * @brief Перевірка заголовка без декодування файлу (замість трьох стадій).
+     *
+     * Зчитуються лише перші рядки зображення (SteganographyEngine::probeFile).
+     *
+     * @param path Шлях до файлу.
+     */
+    void probeStage(const QString& path);
+
+    // ========== Допоміжні методи ==========
+
+    /**
+     * @brief Налаштування движка задачі за параметрами обробки.
+     *
+     * Движок зберігає стан поточної операції (прогрес, скасування),
+     * тому кожна задача пулу створює власний.
+     *
+     * @param engine Движок задачі.
+     */
+    void configure(SteganographyEngine& engine) const;
+
+    /**
+     * @brief Вивід результату для файлу та звільнення місця в конвеєрі.
+     * @param record Результат обробки файлу.
+     */
+    void finish(const QJsonObject& record);
+
+    /**
+     * @brief Назва операції для виводу.
+     * @return Рядок "embed", "extract", "probe" або "analyze".
+     */
+    QString operationName() const;
+
+    /**
+     * @brief Шлях вихідного файлу для embed.
+     * @param input Вхідний файл.
+     * @param suffix Розширення вихідного файлу.
+     * @return Шлях у вихідному каталозі зі збереженням підкаталогів
+     *         вхідного файлу та заданим розширенням.
+     */
+    QString outputPath(const BatchInput& input, const QString& suffix) const;
+
+    // ========== Дані ==========
+    BatchOptions options;         ///< Параметри обробки.
+    QThreadPool decodePool;       ///< Пул потоків декодування.
+    QThreadPool computePool;      ///< Пул потоків обробки.
+    QThreadPool writePool;        ///< Пул потоків запису.
+    int pngThreads = 1;           ///< Потоки стиснення одного PNG.
+    QSemaphore pipelineSlots;     ///< Вільні місця в конвеєрі.
+    QMutex outputMutex;           ///< Захист stdout від перемішування рядків.
+    QAtomicInt failures;          ///< Кількість помилок.
+};
+
+#endif // BATCHPROCESSOR_H
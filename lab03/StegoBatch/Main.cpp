@@ -0,0 +1,198 @@
+/*
+ * Main.cpp
+ *
+ * Головний файл пакетної обробки (командний рядок).
+ * Точка входу в програму stegobatch.
+ *
+ * Приклади:
+ *   stegobatch embed -m "Текст" -o out/ images/
+ *   stegobatch extract -k КЛЮЧ out/
+ *   stegobatch probe -r archive/ > probe.jsonl
+ *   stegobatch analyze files.txt
+ *   stegobatch embed --tiled -m "Текст" -o out/ huge.png
+ *   stegobatch embed --jpeg -m "Текст" -o out/ photos/
+ *   stegobatch embed --bits 2 -m "Текст" -k КЛЮЧ -o out/ recordings/
+ *   stegobatch extract -k КЛЮЧ out/clip.y4m
+ *   stegobatch embed --png-level 1 --png-filter up -m "Текст" -o out/ images/
+ *   stegobatch embed --ecc 16 -m "Текст" -o out/ images/
+ *   stegobatch embed --payload archive.zip -k КЛЮЧ -o out/ images/
+ *   stegobatch extract -k КЛЮЧ -o files/ out/
+ */
+
+#include "BatchProcessor.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QDebug>
+
+/**
+ * @brief Головна функція програми.
+ * @param argc Кількість аргументів командного рядка.
+ * @param argv Масив аргументів командного рядка.
+ * @return 0 - успіх, 1 - є помилки обробки, 2 - неправильні аргументи.
+ */
+int main(int argc, char *argv[]) {
+    // Графічний інтерфейс не потрібен, достатньо QCoreApplication.
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("stegobatch");
+
+    // ========== КРОК 1: Опис аргументів ==========
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Пакетна LSB-стеганографія. Для кожного файлу виводиться один JSON-рядок.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("operation", "embed | extract | probe | analyze");
+    parser.addPositionalArgument("inputs", "Файли, каталоги або списки файлів (*.txt, *.lst).",
+                                 "inputs...");
+
+    QCommandLineOption outputOption({"o", "output"},
+                                    "Каталог для результатів embed (extract - для прихованих файлів).",
+                                    "dir");
+    QCommandLineOption messageOption({"m", "message"}, "Повідомлення для приховування.", "text");
+    QCommandLineOption messageFileOption("message-file", "Файл з повідомленням (UTF-8).", "file");
+    QCommandLineOption payloadOption("payload", "Довільний файл для приховування (embed).", "file");
+    QCommandLineOption keyOption({"k", "key"}, "Ключ шифрування/дешифрування.", "key");
+    QCommandLineOption recursiveOption({"r", "recursive"}, "Обхід підкаталогів.");
+    QCommandLineOption decodeOption("decode-threads", "Потоки декодування.", "n", "0");
+    QCommandLineOption computeOption("compute-threads", "Потоки обробки.", "n", "0");
+    QCommandLineOption writeOption("write-threads", "Потоки запису.", "n", "0");
+    QCommandLineOption queueOption("queue", "Максимум зображень у конвеєрі.", "n", "0");
+    QCommandLineOption tiledOption("tiled", "Поблокова обробка дуже великих зображень.");
+    QCommandLineOption jpegOption("jpeg", "Коефіцієнти DCT файлів JPEG без перекодування (embed, extract).");
+    QCommandLineOption bitsOption("bits", "Молодших бітів на канал для embed (1-4).", "n", "1");
+    QCommandLineOption alphaOption("alpha", "Вбудовування також в альфа-канал (embed).");
+    QCommandLineOption shuffleOption("shuffle", "Ключовий порядок пікселів (embed, потребує --key).");
+    QCommandLineOption compressOption("compress", "Стиснення повідомлення deflate (embed).");
+    QCommandLineOption matrixOption("matrix", "Матричне вбудовування кодами Геммінга (embed).");
+    QCommandLineOption eccOption("ecc", "Символів парності Ріда-Соломона на слово (embed, 2-64).",
+                                 "n", "0");
+    QCommandLineOption pngLevelOption("png-level", "Рівень стиснення PNG (0-9).", "n", "6");
+    QCommandLineOption pngFilterOption("png-filter",
+                                       "Фільтр рядків PNG: none | sub | up | average | paeth | adaptive.",
+                                       "filter", "adaptive");
+
+    parser.addOptions({outputOption, messageOption, messageFileOption, payloadOption, keyOption,
+                       recursiveOption, decodeOption, computeOption, writeOption,
+                       queueOption, tiledOption, jpegOption, bitsOption, alphaOption, shuffleOption,
+                       compressOption, matrixOption, eccOption, pngLevelOption, pngFilterOption});
+    parser.process(app);
+
+    // ========== КРОК 2: Перевірка аргументів ==========
+    const QStringList positional = parser.positionalArguments();
+    if (positional.size() < 2) {
+        qWarning().noquote() << parser.helpText();
+        return 2;
+    }
+
+    BatchOptions options;
+    const QString operation = positional.first();
+    if (operation == "embed") {
+        options.operation = BatchOperation::Embed;
+    } else if (operation == "extract") {
+        options.operation = BatchOperation::Extract;
+    } else if (operation == "probe") {
+        options.operation = BatchOperation::Probe;
+    } else if (operation == "analyze") {
+        options.operation = BatchOperation::Analyze;
+    } else {
+        qWarning() << "Unknown operation:" << operation;
+        return 2;
+    }
+
+    options.inputs = positional.mid(1);
+    options.outputDirectory = parser.value(outputOption);
+    options.key = parser.value(keyOption);
+    options.recursive = parser.isSet(recursiveOption);
+    options.decodeThreads = parser.value(decodeOption).toInt();
+    options.computeThreads = parser.value(computeOption).toInt();
+    options.writeThreads = parser.value(writeOption).toInt();
+    options.queueDepth = parser.value(queueOption).toInt();
+    options.tiled = parser.isSet(tiledOption);
+    options.jpeg = parser.isSet(jpegOption);
+    options.bitsPerChannel = parser.value(bitsOption).toInt();
+    options.alpha = parser.isSet(alphaOption);
+    options.keyedOrder = parser.isSet(shuffleOption);
+    options.compress = parser.isSet(compressOption);
+    options.matrix = parser.isSet(matrixOption);
+    options.eccParity = parser.value(eccOption).toInt();
+    options.payloadFile = parser.value(payloadOption);
+
+    bool levelOk = false;
+    options.pngLevel = parser.value(pngLevelOption).toInt(&levelOk);
+    if (!levelOk || options.pngLevel < 0 || options.pngLevel > 9) {
+        qWarning() << "--png-level must be between 0 and 9";
+        return 2;
+    }
+
+    const QString pngFilter = parser.value(pngFilterOption);
+    if (pngFilter == "none") {
+        options.pngFilter = PngFilter::None;
+    } else if (pngFilter == "sub") {
+        options.pngFilter = PngFilter::Sub;
+    } else if (pngFilter == "up") {
+        options.pngFilter = PngFilter::Up;
+    } else if (pngFilter == "average") {
+        options.pngFilter = PngFilter::Average;
+    } else if (pngFilter == "paeth") {
+        options.pngFilter = PngFilter::Paeth;
+    } else if (pngFilter == "adaptive") {
+        options.pngFilter = PngFilter::Adaptive;
+    } else {
+        qWarning() << "Unknown --png-filter:" << pngFilter;
+        return 2;
+    }
+
+    if (parser.isSet(messageFileOption)) {
+        QFile file(parser.value(messageFileOption));
+        if (!file.open(QIODevice::ReadOnly)) {
+            qWarning() << "Cannot open message file:" << file.fileName();
+            return 2;
+        }
+        options.message = QString::fromUtf8(file.readAll());
+    } else {
+        options.message = parser.value(messageOption);
+    }
+
+    if (options.operation == BatchOperation::Embed &&
+        ((options.message.isEmpty() && options.payloadFile.isEmpty()) ||
+         options.outputDirectory.isEmpty())) {
+        qWarning() << "embed requires --message (or --message-file, --payload) and --output";
+        return 2;
+    }
+
+    if (!options.payloadFile.isEmpty() && (options.tiled || options.matrix)) {
+        qWarning() << "--payload is not supported with --tiled or --matrix";
+        return 2;
+    }
+
+    if (options.jpeg && (options.tiled || !options.payloadFile.isEmpty())) {
+        qWarning() << "--jpeg is not supported with --tiled or --payload";
+        return 2;
+    }
+
+    if (options.eccParity != 0 &&
+        (options.eccParity < 2 || options.eccParity > 64 || options.eccParity % 2 != 0)) {
+        qWarning() << "--ecc must be an even number between 2 and 64";
+        return 2;
+    }
+
+    if (options.eccParity != 0 &&
+        (options.tiled || options.jpeg || !options.payloadFile.isEmpty() || options.matrix)) {
+        qWarning() << "--ecc is not supported with --tiled, --jpeg, --payload or --matrix";
+        return 2;
+    }
+
+    if (options.bitsPerChannel < 1 || options.bitsPerChannel > 4) {
+        qWarning() << "--bits must be between 1 and 4";
+        return 2;
+    }
+
+    if (options.keyedOrder && options.key.isEmpty()) {
+        qWarning() << "--shuffle requires --key";
+        return 2;
+    }
+
+    // ========== КРОК 3: Обробка ==========
+    BatchProcessor processor(options);
+    return processor.run() > 0 ? 1 : 0;
+}
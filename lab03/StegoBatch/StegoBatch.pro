@@ -0,0 +1,63 @@
+QT       += core gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = stegobatch
+
+# Движок стеганографії спільний з графічною програмою.
+INCLUDEPATH += ../Steganography
+
+SOURCES += \
+    Main.cpp \
+    BatchProcessor.cpp \
+    ../Steganography/ChaCha20Poly1305.cpp \
+    ../Steganography/ImageStripReader.cpp \
+    ../Steganography/JpegCoefficients.cpp \
+    ../Steganography/KeyedPermutation.cpp \
+    ../Steganography/PngStripWriter.cpp \
+    ../Steganography/PngWriter.cpp \
+    ../Steganography/ReedSolomon.cpp \
+    ../Steganography/Scrypt.cpp \
+    ../Steganography/SteganographyEngine.cpp \
+    ../Steganography/SteganographyEngine_Audio.cpp \
+    ../Steganography/SteganographyEngine_BitPlanes.cpp \
+    ../Steganography/SteganographyEngine_Cipher.cpp \
+    ../Steganography/SteganographyEngine_Compression.cpp \
+    ../Steganography/SteganographyEngine_Ecc.cpp \
+    ../Steganography/SteganographyEngine_File.cpp \
+    ../Steganography/SteganographyEngine_Jpeg.cpp \
+    ../Steganography/SteganographyEngine_Matrix.cpp \
+    ../Steganography/SteganographyEngine_Probe.cpp \
+    ../Steganography/SteganographyEngine_Shards.cpp \
+    ../Steganography/SteganographyEngine_Steganalysis.cpp \
+    ../Steganography/SteganographyEngine_Tiled.cpp \
+    ../Steganography/SteganographyEngine_Video.cpp \
+    ../Steganography/WavFile.cpp \
+    ../Steganography/Y4mFile.cpp
+
+HEADERS += \
+    BatchProcessor.h \
+    ../Steganography/ChaCha20Poly1305.h \
+    ../Steganography/ImageStripReader.h \
+    ../Steganography/JpegErrorManager.h \
+    ../Steganography/JpegCoefficients.h \
+    ../Steganography/KeyedPermutation.h \
+    ../Steganography/PngStripWriter.h \
+    ../Steganography/PngWriter.h \
+    ../Steganography/ReedSolomon.h \
+    ../Steganography/Scrypt.h \
+    ../Steganography/SteganographyEngine.h \
+    ../Steganography/WavFile.h \
+    ../Steganography/Y4mFile.h
+
+# zlib: потокове читання та запис PNG смугами, паралельний запис PNG, стиснення файлів.
+LIBS += -lz
+
+# libjpeg: читання та запис коефіцієнтів DCT без перекодування JPEG.
+LIBS += -ljpeg
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target
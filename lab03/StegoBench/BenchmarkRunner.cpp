@@ -0,0 +1,424 @@
+/*
+ * BenchmarkRunner.cpp
+ *
+ * Реалізація вимірювання продуктивності движка стеганографії.
+ */
+
+#include "BenchmarkRunner.h"
+#include <QDebug>
+#include <QFile>
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QThread>
+#include <QStringList>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+/// Ключ для операцій з шифруванням та ключовим порядком.
+static const char* const BENCHMARK_KEY = "benchmark-key";
+
+/* ============================================================================
+ *                              КОНСТРУКТОР
+ * ============================================================================
+ */
+
+/**
+ * @brief Конструктор.
+ * @param options Параметри вимірювання.
+ */
+BenchmarkRunner::BenchmarkRunner(const BenchmarkOptions& options)
+    : options(options),
+    tableHeaderPrinted(false)
+{
+}
+
+/* ============================================================================
+ *                              ЗАПУСК ВИМІРЮВАНЬ
+ * ============================================================================
+ */
+
+/**
+ * @brief Виконання всіх вимірювань.
+ *
+ * Контейнер генерується один раз на розмір; для кожної кількості потоків
+ * створюється окремий движок. Результат приховування з одного вимірювання
+ * використовується як вхід для витягування та аналізу.
+ *
+ * @return Кількість операцій з невірним результатом.
+ */
+int BenchmarkRunner::run() {
+    int failures = 0;
+
+    for (double megapixels : std::as_const(options.megapixels)) {
+        // ========== КРОК 1: Контейнер ==========
+        const QImage carrier = generateCarrier(megapixels);
+        if (carrier.isNull()) {
+            qWarning() << "Failed to allocate carrier of" << megapixels << "MP";
+            ++failures;
+            continue;
+        }
+
+        for (int threads : std::as_const(options.threads)) {
+            SteganographyEngine engine;
+            configure(engine, threads);
+
+            // ========== КРОК 2: Ємність (не залежить від повідомлення) ==========
+            if (!measure("capacity", carrier, 0, threads, [&]() {
+                    return engine.calculateMaxCapacity(carrier) > 0;
+                })) {
+                ++failures;
+            }
+
+            for (qint64 payload : std::as_const(options.payloadBytes)) {
+                const QString message = generateMessage(payload);
+
+                // Порівнюємо з ємністю з урахуванням шифрування (вона менша).
+                if (engine.storedMessageSize(message) > engine.calculateMaxCapacity(carrier, true)) {
+                    skip(carrier, payload, threads, "capacity");
+                    continue;
+                }
+
+                // ========== КРОК 3: Приховування ==========
+                QImage stego;
+                QImage stegoEncrypted;
+                bool ok = measure("hide", carrier, payload, threads, [&]() {
+                    stego = engine.hideMessage(carrier, message, false);
+                    return !stego.isNull();
+                });
+                ok = measure("hide_encrypted", carrier, payload, threads, [&]() {
+                    stegoEncrypted = engine.hideMessage(carrier, message, true);
+                    return !stegoEncrypted.isNull();
+                }) && ok;
+
+                if (!ok) {
+                    ++failures;
+                    continue;
+                }
+
+                // ========== КРОК 4: Витягування та перевірка ==========
+                if (!measure("extract", carrier, payload, threads, [&]() {
+                        return engine.extractMessage(stego, false) == message;
+                    })) {
+                    ++failures;
+                }
+                if (!measure("extract_decrypt", carrier, payload, threads, [&]() {
+                        return engine.extractMessage(stegoEncrypted, true) == message;
+                    })) {
+                    ++failures;
+                }
+                if (!measure("has_hidden", carrier, payload, threads, [&]() {
+                        return engine.hasHiddenMessage(stego);
+                    })) {
+                    ++failures;
+                }
+
+                // ========== КРОК 5: Аналіз ==========
+                measure("analyze", carrier, payload, threads, [&]() {
+                    engine.analyzeChanges(carrier, stego, message);
+                    return true;
+                });
+            }
+        }
+    }
+
+    return failures;
+}
+
+/* ============================================================================
+ *                              ВИМІРЮВАННЯ
+ * ============================================================================
+ */
+
+/**
+ * @brief Вимірювання однієї операції.
+ *
+ * @param name Назва операції.
+ * @param carrier Контейнер.
+ * @param payload Розмір повідомлення.
+ * @param threads Кількість потоків.
+ * @param operation Операція.
+ * @return true якщо всі повтори дали правильний результат.
+ */
+bool BenchmarkRunner::measure(const QString& name, const QImage& carrier, qint64 payload,
+                              int threads, const std::function<bool()>& operation) {
+    QList<qint64> times;
+    qint64 peakRss = 0;
+    bool ok = true;
+
+    const int repeats = qMax(1, options.repeats);
+    for (int i = 0; i < repeats; ++i) {
+        resetPeakRss();
+
+        QElapsedTimer timer;
+        timer.start();
+        ok = operation() && ok;
+        times.append(timer.nsecsElapsed());
+
+        peakRss = qMax(peakRss, peakRssBytes());
+    }
+
+    std::sort(times.begin(), times.end());
+    const double medianSeconds = times[times.size() / 2] / 1e9;
+    const double pixels = double(carrier.width()) * carrier.height();
+
+    QJsonObject record;
+    record["operation"] = name;
+    record["mode"] = modeName();
+    record["width"] = carrier.width();
+    record["height"] = carrier.height();
+    record["megapixels"] = pixels / 1e6;
+    record["payload_bytes"] = payload;
+    record["threads"] = threads > 0 ? threads : QThread::idealThreadCount();
+    record["repeats"] = repeats;
+    record["ms"] = medianSeconds * 1e3;
+    record["ms_min"] = times.first() / 1e6;
+    record["mpx_per_s"] = medianSeconds > 0 ? pixels / 1e6 / medianSeconds : 0.0;
+    if (payload > 0) {
+        record["mb_per_s"] = medianSeconds > 0 ? payload / 1e6 / medianSeconds : 0.0;
+    }
+    record["peak_rss_mb"] = peakRss / 1048576.0;
+    record["ok"] = ok;
+    emitRecord(record);
+
+    if (!ok) {
+        qWarning() << "Benchmark operation produced a wrong result:" << name
+                   << carrier.size() << payload << "bytes";
+    }
+    return ok;
+}
+
+/**
+ * @brief Запис про пропущену комбінацію.
+ *
+ * @param carrier Контейнер.
+ * @param payload Розмір повідомлення.
+ * @param threads Кількість потоків.
+ * @param reason Причина.
+ */
+void BenchmarkRunner::skip(const QImage& carrier, qint64 payload, int threads,
+                           const QString& reason) {
+    QJsonObject record;
+    record["operation"] = "skip";
+    record["mode"] = modeName();
+    record["width"] = carrier.width();
+    record["height"] = carrier.height();
+    record["megapixels"] = double(carrier.width()) * carrier.height() / 1e6;
+    record["payload_bytes"] = payload;
+    record["threads"] = threads > 0 ? threads : QThread::idealThreadCount();
+    record["reason"] = reason;
+    emitRecord(record);
+}
+
+/* ============================================================================
+ *                              ВХІДНІ ДАНІ
+ * ============================================================================
+ */
+
+/**
+ * @brief Генерація синтетичного контейнера.
+ *
+ * Плавний градієнт з шумом у 4 молодших бітах: гладкі ділянки як у
+ * фотографії, а молодші біти - випадкові.
+ *
+ * @param megapixels Розмір у мегапікселях.
+ * @return Зображення.
+ */
+QImage BenchmarkRunner::generateCarrier(double megapixels) const {
+    const int width = qMax(1, qRound(std::sqrt(megapixels * 1e6 * 4.0 / 3.0)));
+    const int height = qMax(1, qRound(width * 3.0 / 4.0));
+
+    QImage image(width, height, options.alpha ? QImage::Format_ARGB32 : QImage::Format_RGB32);
+    if (image.isNull()) {
+        return image;
+    }
+
+    for (int y = 0; y < height; ++y) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < width; ++x) {
+            // Хеш координат (murmur3 finalizer).
+            quint32 h = quint32(x) * 0x9E3779B1u ^ quint32(y) * 0x85EBCA77u;
+            h ^= h >> 16;
+            h *= 0x7FEB352Du;
+            h ^= h >> 15;
+            h *= 0x846CA68Bu;
+            h ^= h >> 16;
+
+            const int red = qMin(255, int(qint64(x) * 240 / width) + int(h & 0x0f));
+            const int green = qMin(255, int(qint64(y) * 240 / height) + int((h >> 4) & 0x0f));
+            const int blue = qMin(255, 128 + int((h >> 8) & 0x0f));
+            const int alpha = options.alpha ? 0xf0 | int((h >> 12) & 0x0f) : 0xff;
+            line[x] = qRgba(red, green, blue, alpha);
+        }
+    }
+
+    return image;
+}
+
+/**
+ * @brief Генерація повідомлення заданого розміру.
+ *
+ * Літери з псевдовипадковими пробілами: deflate стискає такий текст
+ * приблизно як звичайний, тому режим стиснення вимірюється реалістично.
+ *
+ * @param bytes Розмір у байтах.
+ * @return Повідомлення.
+ */
+QString BenchmarkRunner::generateMessage(qint64 bytes) {
+    QByteArray text(bytes, Qt::Uninitialized);
+    quint32 state = 0x12345678u;
+    for (qint64 i = 0; i < bytes; ++i) {
+        state = state * 1664525u + 1013904223u;
+        const quint32 r = state >> 24;
+        text[i] = (r % 7 == 0) ? ' ' : char('a' + r % 26);
+    }
+    return QString::fromLatin1(text);
+}
+
+/* ============================================================================
+ *                              НАЛАШТУВАННЯ ТА ВИВІД
+ * ============================================================================
+ */
+
+/**
+ * @brief Налаштування движка відповідно до параметрів.
+ * @param engine Движок.
+ * @param threads Кількість потоків.
+ */
+void BenchmarkRunner::configure(SteganographyEngine& engine, int threads) const {
+    engine.setParallelMode(threads != 1, qMax(0, threads));
+    engine.setKey(BENCHMARK_KEY);
+    engine.setBitsPerChannel(options.bitsPerChannel, options.alpha);
+    engine.setKeyedOrdering(options.keyedOrder);
+    engine.setCompressionEnabled(options.compress);
+    engine.setMatrixEmbedding(options.matrix);
+}
+
+/**
+ * @brief Опис режиму движка для виводу.
+ * @return Опис режиму.
+ */
+QString BenchmarkRunner::modeName() const {
+    QStringList parts;
+    parts << QString("bits=%1").arg(options.bitsPerChannel);
+    if (options.alpha) parts << "alpha";
+    if (options.keyedOrder) parts << "keyed";
+    if (options.compress) parts << "compress";
+    if (options.matrix) parts << "matrix";
+    return parts.join(' ');
+}
+
+/**
+ * @brief Вивід результату.
+ * @param record Результат вимірювання.
+ */
+void BenchmarkRunner::emitRecord(const QJsonObject& record) {
+    QByteArray line;
+
+    if (!options.table) {
+        line = QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n';
+    } else {
+        if (!tableHeaderPrinted) {
+            line += QString::asprintf("%-16s %7s %6s %7s %10s %10s %9s %9s %9s\n",
+                                      "operation", "MP", "thr", "payload", "ms", "ms_min",
+                                      "MB/s", "Mpx/s", "RSS MB").toUtf8();
+            tableHeaderPrinted = true;
+        }
+
+        const QString operation = record["operation"].toString();
+        if (operation == "skip") {
+            line += QString::asprintf("%-16s %7.1f %6d %7lld  (%s)\n", "skip",
+                                      record["megapixels"].toDouble(),
+                                      record["threads"].toInt(),
+                                      qint64(record["payload_bytes"].toDouble()),
+                                      qPrintable(record["reason"].toString())).toUtf8();
+        } else {
+            line += QString::asprintf("%-16s %7.1f %6d %7lld %10.2f %10.2f %9.2f %9.1f %9.1f%s\n",
+                                      qPrintable(operation),
+                                      record["megapixels"].toDouble(),
+                                      record["threads"].toInt(),
+                                      qint64(record["payload_bytes"].toDouble()),
+                                      record["ms"].toDouble(),
+                                      record["ms_min"].toDouble(),
+                                      record["mb_per_s"].toDouble(),
+                                      record["mpx_per_s"].toDouble(),
+                                      record["peak_rss_mb"].toDouble(),
+                                      record["ok"].toBool() ? "" : "  WRONG RESULT").toUtf8();
+        }
+    }
+
+    std::fwrite(line.constData(), 1, size_t(line.size()), stdout);
+    std::fflush(stdout);
+}
+
+/* ============================================================================
+ *                              ПАМ'ЯТЬ ПРОЦЕСУ
+ * ============================================================================
+ */
+
+/**
+ * @brief Пікове використання пам'яті процесом.
+ *
+ * Linux - VmHWM з /proc/self/status (скидається resetPeakRss),
+ * Windows - PeakWorkingSetSize, інші Unix - ru_maxrss (за весь час).
+ *
+ * @return Байтів.
+ */
+qint64 BenchmarkRunner::peakRssBytes() {
+#if defined(Q_OS_LINUX)
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        // Файли /proc мають нульовий розмір, тому читаємо весь вміст.
+        const QList<QByteArray> lines = status.readAll().split('\n');
+        for (const QByteArray& line : lines) {
+            if (line.startsWith("VmHWM:")) {
+                // Формат: "VmHWM:    123456 kB".
+                return line.mid(6).trimmed().split(' ').first().toLongLong() * 1024;
+            }
+        }
+    }
+    return 0;
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return qint64(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#elif defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(Q_OS_MACOS)
+    return qint64(usage.ru_maxrss);          // байти
+#else
+    return qint64(usage.ru_maxrss) * 1024;   // кілобайти
+#endif
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief Скидання пікового значення RSS до поточного.
+ * @return true якщо пік скинуто.
+ */
+bool BenchmarkRunner::resetPeakRss() {
+#if defined(Q_OS_LINUX)
+    // "5" скидає VmHWM до поточного RSS (Linux 4.0+).
+    QFile clearRefs("/proc/self/clear_refs");
+    if (!clearRefs.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    return clearRefs.write("5") == 1;
+#else
+    return false;
+#endif
+}
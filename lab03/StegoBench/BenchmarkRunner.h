@@ -0,0 +1,150 @@
+/*
+ * BenchmarkRunner.h
+ *
+ * Заголовочний файл вимірювання продуктивності движка стеганографії.
+ * Генерує синтетичні зображення-контейнери заданого розміру та вимірює
+ * основні операції SteganographyEngine для різних розмірів повідомлення
+ * і кількості потоків.
+ *
+ * Основні можливості:
+ * - Контейнери від 0.3 до 50 Мп (детермінований шум, однаковий між запусками).
+ * - Пропускна здатність: МБ/с повідомлення та Мпікс/с зображення.
+ * - Пікове використання пам'яті (RSS) під час кожної операції.
+ * - Машиночитаний результат (один JSON-рядок на вимірювання) або таблиця.
+ */
+
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+#include <QString>
+#include <QList>
+#include <QImage>
+#include <QJsonObject>
+#include <functional>
+#include "SteganographyEngine.h"
+
+/**
+ * @struct BenchmarkOptions
+ * @brief Параметри вимірювання.
+ */
+struct BenchmarkOptions {
+    QList<double> megapixels = {0.3, 2.0, 12.0, 50.0};  ///< Розміри контейнерів (Мп).
+    QList<qint64> payloadBytes = {1024, 65536, 1048576}; ///< Розміри повідомлень (байтів).
+    QList<int> threads = {1, 0};  ///< Кількість потоків (1 - послідовно, 0 - усі ядра).
+    int repeats = 3;              ///< Повторів кожної операції (звітується медіана).
+    int bitsPerChannel = 1;       ///< Молодших бітів на канал (1-4).
+    bool alpha = false;           ///< Вбудовування також в альфа-канал.
+    bool keyedOrder = false;      ///< Ключовий порядок пікселів.
+    bool compress = false;        ///< Стиснення повідомлення deflate.
+    bool matrix = false;          ///< Матричне вбудовування кодами Геммінга.
+    bool table = false;           ///< Вивід таблицею замість JSON-рядків.
+};
+
+/**
+ * @class BenchmarkRunner
+ * @brief Вимірювання операцій движка на синтетичних контейнерах.
+ *
+ * Для кожної комбінації (розмір контейнера × кількість потоків ×
+ * розмір повідомлення) вимірюються: hideMessage (без шифрування та з ним),
+ * extractMessage (без дешифрування та з ним), analyzeChanges,
+ * calculateMaxCapacity і hasHiddenMessage. Повідомлення, що не вміщуються
+ * в контейнер, пропускаються з відповідною позначкою.
+ */
+class BenchmarkRunner {
+public:
+    /**
+     * @brief Конструктор.
+     * @param options Параметри вимірювання.
+     */
+    explicit BenchmarkRunner(const BenchmarkOptions& options);
+
+    /**
+     * @brief Виконання всіх вимірювань.
+     * @return Кількість операцій, що завершились помилкою (наприклад, витягнуто не те).
+     */
+    int run();
+
+    /**
+     * @brief Пікове використання пам'яті процесом (з останнього скидання).
+     * @return Байтів (0, якщо платформа не підтримується).
+     */
+    static qint64 peakRssBytes();
+
+    /**
+     * @brief Скидання пікового значення RSS до поточного.
+     *
+     * Підтримується лише в Linux (/proc/self/clear_refs); на інших
+     * платформах пік накопичується за весь час роботи процесу.
+     *
+     * @return true якщо пік скинуто.
+     */
+    static bool resetPeakRss();
+
+private:
+    /**
+     * @brief Генерація синтетичного контейнера.
+     *
+     * Пікселі - хеш координат (шум, схожий на фотографію за статистикою
+     * молодших бітів); для однакового розміру результат однаковий.
+     *
+     * @param megapixels Розмір у мегапікселях (пропорції 4:3).
+     * @return Зображення ARGB32 (RGB32 без альфа-режиму).
+     */
+    QImage generateCarrier(double megapixels) const;
+
+    /**
+     * @brief Генерація повідомлення заданого розміру (ASCII, 1 байт на символ).
+     * @param bytes Розмір у байтах.
+     * @return Повідомлення.
+     */
+    static QString generateMessage(qint64 bytes);
+
+    /**
+     * @brief Вимірювання однієї операції.
+     *
+     * Операція виконується options.repeats разів; звітується медіана та
+     * мінімум часу, а пік RSS - максимальний за всі повтори.
+     *
+     * @param name Назва операції.
+     * @param carrier Контейнер (для розміру).
+     * @param payload Розмір повідомлення в байтах (0 - не застосовується).
+     * @param threads Кількість потоків движка.
+     * @param operation Операція; повертає false у разі невірного результату.
+     * @return true якщо всі повтори дали правильний результат.
+     */
+    bool measure(const QString& name, const QImage& carrier, qint64 payload, int threads,
+                 const std::function<bool()>& operation);
+
+    /**
+     * @brief Запис про пропущену комбінацію.
+     * @param carrier Контейнер.
+     * @param payload Розмір повідомлення.
+     * @param threads Кількість потоків.
+     * @param reason Причина.
+     */
+    void skip(const QImage& carrier, qint64 payload, int threads, const QString& reason);
+
+    /**
+     * @brief Налаштування движка відповідно до параметрів.
+     * @param engine Движок.
+     * @param threads Кількість потоків (1 - послідовно).
+     */
+    void configure(SteganographyEngine& engine, int threads) const;
+
+    /**
+     * @brief Опис режиму движка для виводу.
+     * @return Рядок на зразок "bits=2 alpha keyed".
+     */
+    QString modeName() const;
+
+    /**
+     * @brief Вивід результату (JSON-рядок або рядок таблиці).
+     * @param record Результат вимірювання.
+     */
+    void emitRecord(const QJsonObject& record);
+
+    BenchmarkOptions options;   ///< Параметри вимірювання.
+    bool tableHeaderPrinted;    ///< Чи виведено заголовок таблиці.
+};
+
+#endif // BENCHMARKRUNNER_H
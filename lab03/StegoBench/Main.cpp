@@ -0,0 +1,171 @@
+/*
+ * Main.cpp
+ *
+ * Головний файл вимірювання продуктивності (командний рядок).
+ * Точка входу в програму stegobench.
+ *
+ * Приклади:
+ *   stegobench > baseline.jsonl
+ *   stegobench --table --sizes 0.3,12 --payloads 1K,1M --threads 1,4,0
+ *   stegobench --table --matrix --compress --sizes 50
+ *   stegobench --selftest
+ */
+
+#include "BenchmarkRunner.h"
+#include "ChaCha20Poly1305.h"
+#include "Scrypt.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+
+/**
+ * @brief Розбір розміру з необов'язковим суфіксом K або M (степені 1024).
+ * @param text Рядок, наприклад "64K".
+ * @param ok Результат розбору.
+ * @return Кількість байтів.
+ */
+static qint64 parseByteSize(QString text, bool* ok) {
+    text = text.trimmed().toUpper();
+    qint64 multiplier = 1;
+    if (text.endsWith('K')) {
+        multiplier = 1024;
+        text.chop(1);
+    } else if (text.endsWith('M')) {
+        multiplier = 1024 * 1024;
+        text.chop(1);
+    }
+    const qint64 value = text.toLongLong(ok);
+    return value * multiplier;
+}
+
+/**
+ * @brief Перевірка криптографічних примітивів на тестових векторах RFC.
+ *
+ * Векторний шлях ChaCha20 перевіряється лише на процесорі з AVX2.
+ *
+ * @return Кількість невдалих перевірок.
+ */
+static int runSelfTest() {
+    int failures = 0;
+    auto report = [&failures](const QString& name, bool passed) {
+        qInfo().noquote() << name + ": " + (passed ? "ok" : "FAILED");
+        if (!passed) {
+            ++failures;
+        }
+    };
+
+    report("ChaCha20-Poly1305 scalar (RFC 8439 2.8.2)", ChaCha20Poly1305::selfTest(false));
+    if (ChaCha20Poly1305::hasVectorPath()) {
+        report("ChaCha20-Poly1305 AVX2 (RFC 8439 2.8.2)", ChaCha20Poly1305::selfTest(true));
+    } else {
+        qInfo().noquote() << "ChaCha20-Poly1305 AVX2 (RFC 8439 2.8.2): skipped, no AVX2";
+    }
+    report("scrypt (RFC 7914 12)", Scrypt::selfTest());
+
+    return failures;
+}
+
+/**
+ * @brief Головна функція програми.
+ * @param argc Кількість аргументів командного рядка.
+ * @param argv Масив аргументів командного рядка.
+ * @return 0 - успіх, 1 - невірний результат операції, 2 - неправильні аргументи.
+ */
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("stegobench");
+
+    // ========== КРОК 1: Опис аргументів ==========
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Вимірювання продуктивності SteganographyEngine на синтетичних контейнерах. "
+        "Для кожного вимірювання виводиться один JSON-рядок.");
+    parser.addHelpOption();
+
+    QCommandLineOption sizesOption("sizes", "Розміри контейнерів у мегапікселях.", "list",
+                                   "0.3,2,12,50");
+    QCommandLineOption payloadsOption("payloads", "Розміри повідомлень (суфікси K, M).", "list",
+                                      "1K,64K,1M");
+    QCommandLineOption threadsOption("threads", "Кількість потоків (0 - усі ядра).", "list",
+                                     "1,0");
+    QCommandLineOption repeatOption("repeat", "Повторів кожної операції (медіана).", "n", "3");
+    QCommandLineOption bitsOption("bits", "Молодших бітів на канал (1-4).", "n", "1");
+    QCommandLineOption alphaOption("alpha", "Вбудовування також в альфа-канал.");
+    QCommandLineOption shuffleOption("shuffle", "Ключовий порядок пікселів.");
+    QCommandLineOption compressOption("compress", "Стиснення повідомлення deflate.");
+    QCommandLineOption matrixOption("matrix", "Матричне вбудовування кодами Геммінга.");
+    QCommandLineOption tableOption("table", "Вивід таблицею замість JSON-рядків.");
+    QCommandLineOption selfTestOption("selftest",
+                                      "Перевірка шифру та scrypt на тестових векторах RFC.");
+
+    parser.addOptions({sizesOption, payloadsOption, threadsOption, repeatOption, bitsOption,
+                       alphaOption, shuffleOption, compressOption, matrixOption, tableOption,
+                       selfTestOption});
+    parser.process(app);
+
+    if (parser.isSet(selfTestOption)) {
+        return runSelfTest() > 0 ? 1 : 0;
+    }
+
+    // ========== КРОК 2: Перевірка аргументів ==========
+    BenchmarkOptions options;
+    bool ok = true;
+
+    options.megapixels.clear();
+    for (const QString& item : parser.value(sizesOption).split(',', Qt::SkipEmptyParts)) {
+        const double value = item.toDouble(&ok);
+        if (!ok || value <= 0.0) {
+            qWarning() << "Invalid size:" << item;
+            return 2;
+        }
+        options.megapixels.append(value);
+    }
+
+    options.payloadBytes.clear();
+    for (const QString& item : parser.value(payloadsOption).split(',', Qt::SkipEmptyParts)) {
+        const qint64 value = parseByteSize(item, &ok);
+        if (!ok || value <= 0) {
+            qWarning() << "Invalid payload size:" << item;
+            return 2;
+        }
+        options.payloadBytes.append(value);
+    }
+
+    options.threads.clear();
+    for (const QString& item : parser.value(threadsOption).split(',', Qt::SkipEmptyParts)) {
+        const int value = item.toInt(&ok);
+        if (!ok || value < 0) {
+            qWarning() << "Invalid thread count:" << item;
+            return 2;
+        }
+        options.threads.append(value);
+    }
+
+    options.repeats = parser.value(repeatOption).toInt();
+    options.bitsPerChannel = parser.value(bitsOption).toInt();
+    options.alpha = parser.isSet(alphaOption);
+    options.keyedOrder = parser.isSet(shuffleOption);
+    options.compress = parser.isSet(compressOption);
+    options.matrix = parser.isSet(matrixOption);
+    options.table = parser.isSet(tableOption);
+
+    if (options.megapixels.isEmpty() || options.payloadBytes.isEmpty() ||
+        options.threads.isEmpty()) {
+        qWarning() << "--sizes, --payloads and --threads must not be empty";
+        return 2;
+    }
+
+    if (options.bitsPerChannel < 1 || options.bitsPerChannel > 4) {
+        qWarning() << "--bits must be between 1 and 4";
+        return 2;
+    }
+
+    if (options.repeats < 1) {
+        qWarning() << "--repeat must be positive";
+        return 2;
+    }
+
+    // ========== КРОК 3: Вимірювання ==========
+    BenchmarkRunner runner(options);
+    return runner.run() > 0 ? 1 : 0;
+}